@@ -35,7 +35,8 @@ enum ClutterType {
 
 struct ClutterResults{
     //distances (km), heights (asl)(m), and zone types of the profile points in the height gain model
-    PathProfile::Path modifiedPath;
+    //(view of the input path without the clutter segments, it shares the ownership of the input view)
+    PathProfile::PathView modifiedPath;
     //Tx,Rx Antenna height above ground level (m) in the height gain model
     ITUR_P452::TxRxPair modifiedHeights_m;
     //Additional clutter shielding losses at Tx,Rx (dB)
@@ -45,14 +46,21 @@ struct ClutterResults{
 /// @brief Main entry point to execute height gain model calculations 
 ///        (returns modified path, modified antenna heights, additional clutter losses)
 /// @param freq_GHz             Transmitting Frequency (GHz) 
-/// @param path                 distances (km), heights (asl_m), and zone types of the profile points
+/// @param path                 distances (km), heights (asl_m), and zone types of the profile points. A Path converts to a 
+///                             view that does not own it, so the path must outlive the returned modified path 
+///                             (temporary paths are rejected, wrap them in a shared_ptr view instead)
 /// @param height_tx_m          Tx Antenna center height above ground level (m)
 /// @param height_rx_m          Rx Antenna center height above ground level (m)
 /// @param tx_clutterType       Clutter Category Type at tx 
 /// @param rx_clutterType       Clutter Category Type at rx 
-ClutterResults calculateClutterModel(const double& freq_GHz, const PathProfile::Path& path, 
+ClutterResults calculateClutterModel(const double& freq_GHz, const PathProfile::PathView& path, 
         const double& height_tx_m, const double& height_rx_m, const ClutterType& tx_clutterType, 
         const ClutterType& rx_clutterType);
+
+/// @brief Not available: the modified path would view a temporary path that is destroyed at the end of the call
+ClutterResults calculateClutterModel(const double& freq_GHz, PathProfile::Path&& path, 
+        const double& height_tx_m, const double& height_rx_m, const ClutterType& tx_clutterType, 
+        const ClutterType& rx_clutterType) = delete;
     
 /// @brief fetch Nominal Height (m) and Distance(km) values for clutter type using table 4
 /// @param tx_clutterType Clutter Type at Tx
@@ -0,0 +1,137 @@
+#include "gtest/gtest.h"
+#include "ClutterModel/ClutterLoss.h"
+#include "MainModel/PathProfile.h"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+	//true if calculateClutterModel can be called with a path of this type
+	template<typename PathType>
+	concept AcceptsClutterPath = requires(PathType&& path){
+		ClutterModel::calculateClutterModel(2.0, std::forward<PathType>(path), 3.0, 3.0, ClutterModel::ClutterType::Urban,
+				ClutterModel::ClutterType::Urban);
+	};
+
+	//uneven spacing, so the clutter distances fall between points and on points
+	PathProfile::Path buildPath(const std::size_t& numPoints, const double& stepDistance_km){
+		PathProfile::Path path;
+		double distance_km = 0;
+		for (std::size_t pointInd = 0; pointInd < numPoints; pointInd++) {
+			path.push_back(PathProfile::ProfilePoint(distance_km, 10.0*pointInd,
+					pointInd%3==0 ? PathProfile::ZoneType::Inland : PathProfile::ZoneType::CoastalLand));
+			distance_km += (pointInd%2==0) ? stepDistance_km : 0.5*stepDistance_km;
+		}
+		return path;
+	}
+
+	//copy of the profile points between the clutter segments, as the height gain model used to build it
+	PathProfile::Path buildExpectedTrimmedPath(const PathProfile::Path& path, const double& tx_clutter_dist_km,
+			const double& rx_clutter_dist_km, const bool& trimTx, const bool& trimRx){
+		std::size_t index1 = 0;
+		std::size_t index2 = path.size();
+		if(trimTx){
+			while(index1<path.size() && path[index1].d_km<tx_clutter_dist_km){
+				index1++;
+			}
+		}
+		if(trimRx){
+			index2 = 0;
+			while(index2<path.size() && path[index2].d_km<=path.back().d_km-rx_clutter_dist_km){
+				index2++;
+			}
+		}
+		PathProfile::Path trimmedPath;
+		for (std::size_t pointInd = index1; pointInd < index2; pointInd++) {
+			trimmedPath.push_back(PathProfile::ProfilePoint(path[pointInd].d_km-path[index1].d_km, path[pointInd].h_asl_m,
+					path[pointInd].zone));
+		}
+		return trimmedPath;
+	}
+}
+
+//The trimmed view must hold the same points as a trimmed copy, for every clutter type and point spacing
+TEST(ClutterTrimmingTests, trimmedViewTest){
+	const std::vector<double> STEP_DISTANCE_KM_LIST = {0.003, 0.01, 0.02, 0.05, 0.15};
+	const double HEIGHT_M = 3.0;
+	for (const double& stepDistance_km : STEP_DISTANCE_KM_LIST) {
+		const PathProfile::Path PATH = buildPath(200, stepDistance_km);
+		for (int clutterInd = ClutterModel::ClutterType::NoClutter; clutterInd <= ClutterModel::ClutterType::IndustrialZone; clutterInd++) {
+			const auto CLUTTER_TYPE = static_cast<ClutterModel::ClutterType>(clutterInd);
+			const auto [clutterHeight_m, clutterDistance_km] = ClutterModel::fetchNominalClutterValues(CLUTTER_TYPE);
+			const auto RESULTS = ClutterModel::calculateClutterModel(2.0, PATH, HEIGHT_M, 20.0, CLUTTER_TYPE,
+					ClutterModel::ClutterType::NoClutter);
+			const auto EXPECTED_PATH = buildExpectedTrimmedPath(PATH, clutterDistance_km, 0.0, clutterHeight_m>HEIGHT_M, false);
+
+			const PathProfile::PathView& modifiedPath = RESULTS.modifiedPath;
+			ASSERT_EQ(EXPECTED_PATH.size(), modifiedPath.size()) << stepDistance_km << " " << clutterInd;
+			for (std::size_t pointInd = 0; pointInd < EXPECTED_PATH.size(); pointInd++) {
+				EXPECT_EQ(EXPECTED_PATH[pointInd].d_km, modifiedPath[pointInd].d_km);
+				EXPECT_EQ(EXPECTED_PATH[pointInd].h_asl_m, modifiedPath[pointInd].h_asl_m);
+				EXPECT_EQ(EXPECTED_PATH[pointInd].zone, modifiedPath[pointInd].zone);
+			}
+
+			//trim both ends
+			const auto BOTH_RESULTS = ClutterModel::calculateClutterModel(2.0, PATH, HEIGHT_M, HEIGHT_M, CLUTTER_TYPE, CLUTTER_TYPE);
+			const auto BOTH_EXPECTED_PATH = buildExpectedTrimmedPath(PATH, clutterDistance_km, clutterDistance_km,
+					clutterHeight_m>HEIGHT_M, clutterHeight_m>HEIGHT_M);
+			ASSERT_EQ(BOTH_EXPECTED_PATH.size(), BOTH_RESULTS.modifiedPath.size());
+			std::size_t pointInd = 0;
+			for (const auto& point : BOTH_RESULTS.modifiedPath) {
+				EXPECT_EQ(BOTH_EXPECTED_PATH[pointInd].d_km, point.d_km);
+				EXPECT_EQ(BOTH_EXPECTED_PATH[pointInd].h_asl_m, point.h_asl_m);
+				pointInd++;
+			}
+		}
+	}
+}
+
+//A temporary path would leave the modified path dangling, so only lvalue paths and views are accepted
+static_assert(!AcceptsClutterPath<PathProfile::Path>);
+static_assert(AcceptsClutterPath<const PathProfile::Path&>);
+static_assert(AcceptsClutterPath<PathProfile::Path&>);
+static_assert(AcceptsClutterPath<PathProfile::PathView>);
+
+//A view built from a shared path keeps it alive, and so do the views trimmed from it
+TEST(ClutterTrimmingTests, sharedOwnershipTest){
+	auto sharedPath = std::make_shared<const PathProfile::Path>(buildPath(100, 0.02));
+	const PathProfile::Path EXPECTED_PATH = buildExpectedTrimmedPath(*sharedPath, 0.05, 0.05, true, true);
+
+	auto results = ClutterModel::calculateClutterModel(2.0, PathProfile::PathView(sharedPath), 3.0, 3.0,
+			ClutterModel::ClutterType::MixedTreeForest, ClutterModel::ClutterType::MixedTreeForest);
+	sharedPath.reset();
+
+	const PathProfile::PathView modifiedPath = results.modifiedPath;
+	results = ClutterModel::ClutterResults();
+	ASSERT_EQ(EXPECTED_PATH.size(), modifiedPath.size());
+	EXPECT_EQ(0.0, modifiedPath.front().d_km);
+	EXPECT_EQ(EXPECTED_PATH.back().d_km, modifiedPath.back().d_km);
+	EXPECT_EQ(EXPECTED_PATH.back().h_asl_m, modifiedPath.at(modifiedPath.size()-1).h_asl_m);
+	EXPECT_EQ(EXPECTED_PATH.calcLongestContiguousInlandDistance_km(), modifiedPath.calcLongestContiguousInlandDistance_km());
+}
+
+TEST(ClutterTrimmingTests, pathViewTest){
+	const PathProfile::Path PATH = buildPath(10, 0.1);
+	const PathProfile::PathView VIEW(PATH);
+	EXPECT_EQ(PATH.size(), VIEW.size());
+	EXPECT_EQ(PATH.calcFracOverSea(), VIEW.calcFracOverSea());
+	EXPECT_EQ(PATH.calcTimePercentBeta0(45.0), VIEW.calcTimePercentBeta0(45.0));
+
+	//nested views measure distances from their own first point
+	const PathProfile::PathView SUB_VIEW = VIEW.subView(2, 8).subView(1, 4);
+	ASSERT_EQ(3u, SUB_VIEW.size());
+	EXPECT_EQ(PATH[3].d_km, SUB_VIEW.distanceOffset_km());
+	EXPECT_EQ(PATH[5].d_km-PATH[3].d_km, SUB_VIEW.back().d_km);
+	EXPECT_EQ(PATH[4].h_asl_m, SUB_VIEW.begin()[1].h_asl_m);
+	EXPECT_EQ(PATH[4].h_asl_m, (SUB_VIEW.end()-2)->h_asl_m);
+	EXPECT_EQ(3, SUB_VIEW.end()-SUB_VIEW.begin());
+	EXPECT_TRUE(SUB_VIEW.begin()<SUB_VIEW.end());
+
+	EXPECT_TRUE(VIEW.subView(4, 4).empty());
+	EXPECT_TRUE(PathProfile::PathView().empty());
+	EXPECT_THROW(VIEW.subView(5, 4), std::out_of_range);
+	EXPECT_THROW(VIEW.subView(0, 11), std::out_of_range);
+	EXPECT_THROW(SUB_VIEW.at(3), std::out_of_range);
+}
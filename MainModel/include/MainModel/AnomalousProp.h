@@ -2,6 +2,7 @@
 #define ANOMOLOUS_PROP_H
 
 #include "gtest/gtest.h"
+#include <memory>
 #include "PathProfile.h"
 #include "Helpers.h"
 
@@ -38,28 +39,39 @@ public:
         const double& frac_over_sea
     );
 
+    /// @brief Anomalous Propagation Model on a view of a path (no copy of the profile), 
+    ///        the viewed path must outlive the model unless the view shares its ownership
+    AnomalousProp(PathProfile::PathView path, const double& freq_GHz,
+        const double& height_tx_asl_m, const double& height_rx_asl_m,
+        const double& temp_K, const double& dryPressure_hPa, const double& dist_coast_tx_km,
+        const double& dist_coast_rx_km, const double& p_percent,
+        const double& b0_percent, const double& eff_radius_med_km, 
+        const ITUR_P452::HorizonAnglesAndDistances& horizonVals,
+        const double& frac_over_sea
+    );
+
     /// @brief get calculated loss value
     /// @return Transmission Loss with ducting and layer reflection (dB)
     double calcAnomalousPropLoss_dB() const;
 
 private:
     //direct inputs
-    const PathProfile::Path& m_path; //Contains vector of terrain profile distances from Tx (km) and heights (amsl) (m)
-    const double& m_freq_GHz;        //Frequency (GHz)
-    const double& m_height_tx_asl_m; //Tx Antenna height (asl_m)
-    const double& m_height_rx_asl_m; //Rx Antenna height (asl_m)
-    const double& m_temp_K;          //Temperature (K)
-    const double& m_dryPressure_hPa; //Dry air pressure (hPa)
-    const double& m_dist_coast_tx_km;//Distance over land from Tx to the coast along the profile path (km) (0 for terminal at sea)
-    const double& m_dist_coast_rx_km;//Distance over land from Rx to the coast along the profile path (km) (0 for terminal at sea)
-    const double& m_p_percent;       //Annual percentage of time not exceeded
-
-    const double& m_b0_percent;         //Time percentage that the refractivity gradient exceeds 100 N-Units/km
-    const double& m_eff_radius_med_km;  //Median effective Earth's radius (km)
-    const ITUR_P452::HorizonAnglesAndDistances& m_horizonVals; //Tx and Rx Horizon Elevation Angles (mrad) and Tx and Rx Horizon Distances (km)
+    PathProfile::PathView m_path;                    //Contains vector of terrain profile distances from Tx (km) and heights (amsl) (m)
+    double m_freq_GHz;               //Frequency (GHz)
+    double m_height_tx_asl_m;        //Tx Antenna height (asl_m)
+    double m_height_rx_asl_m;        //Rx Antenna height (asl_m)
+    double m_temp_K;                 //Temperature (K)
+    double m_dryPressure_hPa;        //Dry air pressure (hPa)
+    double m_dist_coast_tx_km;       //Distance over land from Tx to the coast along the profile path (km) (0 for terminal at sea)
+    double m_dist_coast_rx_km;       //Distance over land from Rx to the coast along the profile path (km) (0 for terminal at sea)
+    double m_p_percent;              //Annual percentage of time not exceeded
+
+    double m_b0_percent;                //Time percentage that the refractivity gradient exceeds 100 N-Units/km
+    double m_eff_radius_med_km;         //Median effective Earth's radius (km)
+    ITUR_P452::HorizonAnglesAndDistances m_horizonVals;        //Tx and Rx Horizon Elevation Angles (mrad) and Tx and Rx Horizon Distances (km)
 
     //Consider making this a data member of the path class that gets calculated once
-    const double& m_frac_over_sea;      //Fraction of the path over sea
+    double m_frac_over_sea;             //Fraction of the path over sea
 
     //calculated internally, exposed for better debugging
     double m_d_tot_km;                              //Distance between Tx and Rx antennas (km)
@@ -37,21 +37,21 @@ public:
 
 private:
     //direct inputs
-    const double& m_d_tot_km;        //Distance between Tx and Rx antennas (km)
-    const double& m_height_tx_asl_m; //Tx Antenna height (asl_m)
-    const double& m_height_rx_asl_m; //Rx Antenna height (asl_m)
-    const double& m_freq_GHz;        //Frequency (GHz)
-    const double& m_temp_K;          //Temperature (K)
-    const double& m_dryPressure_hPa; //Dry air pressure (hPa)
-    const double& m_p_percent;       //Annual percentage of time not exceeded
+    double m_d_tot_km;               //Distance between Tx and Rx antennas (km)
+    double m_height_tx_asl_m;        //Tx Antenna height (asl_m)
+    double m_height_rx_asl_m;        //Rx Antenna height (asl_m)
+    double m_freq_GHz;               //Frequency (GHz)
+    double m_temp_K;                 //Temperature (K)
+    double m_dryPressure_hPa;        //Dry air pressure (hPa)
+    double m_p_percent;              //Annual percentage of time not exceeded
 
-    const double& m_b0_percent;      //Time percentage that the refractivity gradient exceeds 100 N-Units/km
+    double m_b0_percent;             //Time percentage that the refractivity gradient exceeds 100 N-Units/km
 
     // Note: For LOS path, these distances are from the antenna to the Bullington point from the diffraction method for 50% time
-    const ITUR_P452::TxRxPair& m_horizonDists_km; //Tx and Rx Horizon Distances (km)
+    ITUR_P452::TxRxPair m_horizonDists_km;        //Tx and Rx Horizon Distances (km)
 
     //Consider making this a data member of the path class that gets calculated once
-    const double& m_frac_over_sea;      //Fraction of the path over sea
+    double m_frac_over_sea;             //Fraction of the path over sea
 
     double m_freeSpaceWithGasLoss_dB;   //Free space transmission loss with gas attenuation
     double m_basicTransmissionLoss_p_percent_dB;    //free space loss with gas atten and multipath focusing correction for p percent of time
@@ -0,0 +1,127 @@
+#ifndef ITUR_P452_BOUNDED_QUEUE_H
+#define ITUR_P452_BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ITUR_P452{
+
+    /// @brief Fixed capacity lock-free ring buffer between one producer thread and one consumer thread.
+    /// tryPush/tryPop never block. push/pop wait (on an atomic, without a mutex) while the queue is full/empty.
+    /// After close(), push fails and pop drains the remaining items, then fails
+    template<typename T>
+    class BoundedQueue{
+    public:
+        /// @param capacity Maximum number of queued items, must be positive
+        explicit BoundedQueue(const std::size_t& capacity): m_items(capacity){
+            if(capacity==0){
+                throw std::invalid_argument("ERROR: BoundedQueue::BoundedQueue(): The capacity must be positive");
+            }
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        /// @brief Add an item if the queue is not full (producer thread only). The item is only moved from on success,
+        ///        so a failed push can be retried with the same item
+        /// @return false if the queue is full or closed
+        bool tryPush(T&& item){
+            return tryPushItem(std::move(item));
+        }
+
+        /// @brief Add a copy of an item if the queue is not full (producer thread only)
+        /// @return false if the queue is full or closed
+        bool tryPush(const T& item){
+            return tryPushItem(item);
+        }
+
+        /// @brief Remove the oldest item if the queue is not empty (consumer thread only)
+        /// @return false if the queue is empty
+        bool tryPop(T& out_item){
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            if(head==m_tail.load(std::memory_order_acquire)){
+                return false;
+            }
+            out_item = std::move(m_items[head%m_items.size()]);
+            m_head.store(head+1, std::memory_order_release);
+            signal();
+            return true;
+        }
+
+        /// @brief Add an item, waiting while the queue is full (producer thread only)
+        /// @return false if the queue is closed
+        bool push(T item){
+            while(true){
+                const uint32_t version = m_version.load(std::memory_order_acquire);
+                if(m_isClosed.load(std::memory_order_acquire)){
+                    return false;
+                }
+                if(tryPush(std::move(item))){
+                    return true;
+                }
+                m_version.wait(version, std::memory_order_acquire);
+            }
+        }
+
+        /// @brief Remove the oldest item, waiting while the queue is empty (consumer thread only)
+        /// @return false if the queue is closed and empty
+        bool pop(T& out_item){
+            while(true){
+                const uint32_t version = m_version.load(std::memory_order_acquire);
+                if(tryPop(out_item)){
+                    return true;
+                }
+                if(m_isClosed.load(std::memory_order_acquire)){
+                    //items pushed before close() are visible once the flag is
+                    return tryPop(out_item);
+                }
+                m_version.wait(version, std::memory_order_acquire);
+            }
+        }
+
+        /// @brief Stop accepting items and wake up the waiting threads (any thread)
+        void close(){
+            m_isClosed.store(true, std::memory_order_release);
+            signal();
+        }
+
+        bool isClosed() const {return m_isClosed.load(std::memory_order_acquire);}
+
+        /// @brief Number of queued items (exact from the producer or consumer thread, a snapshot from other threads)
+        std::size_t size() const {return m_tail.load(std::memory_order_acquire)-m_head.load(std::memory_order_acquire);}
+        std::size_t capacity() const {return m_items.size();}
+
+    private:
+        //the item is only moved into its slot once the slot is known to be free
+        template<typename U>
+        bool tryPushItem(U&& item){
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if(m_isClosed.load(std::memory_order_acquire) || tail-m_head.load(std::memory_order_acquire)==m_items.size()){
+                return false;
+            }
+            m_items[tail%m_items.size()] = std::forward<U>(item);
+            m_tail.store(tail+1, std::memory_order_release);
+            signal();
+            return true;
+        }
+
+        //every change of the queue state bumps the version, so a waiting thread cannot miss it
+        void signal(){
+            m_version.fetch_add(1, std::memory_order_release);
+            m_version.notify_all();
+        }
+
+        std::vector<T> m_items;
+        alignas(64) std::atomic<std::size_t> m_head{0};     //next item to pop, written by the consumer
+        alignas(64) std::atomic<std::size_t> m_tail{0};     //next slot to push, written by the producer
+        alignas(64) std::atomic<uint32_t> m_version{0};
+        std::atomic<bool> m_isClosed{false};
+    };
+
+}//end namespace ITUR_P452
+#endif /* ITUR_P452_BOUNDED_QUEUE_H */
@@ -2,6 +2,7 @@
 #define DIFFRACTION_LOSS_H
 
 #include "gtest/gtest.h"
+#include <memory>
 #include "PathProfile.h"
 #include "Helpers.h"
 #include "Common/Enumerations.h"
@@ -34,6 +35,12 @@ public:
             const double& freq_GHz, const double& deltaN, const Enumerations::PolarizationType& pol, 
             const double& p_percent, const double&b0_percent, const double& frac_over_sea);
 
+    /// @brief Diffraction Loss model on a view of a path (no copy of the profile), 
+    ///        the viewed path must outlive the model unless the view shares its ownership
+    DiffractionLoss(PathProfile::PathView path, const double& height_tx_asl_m, const double& height_rx_asl_m,
+            const double& freq_GHz, const double& deltaN, const Enumerations::PolarizationType& pol, 
+            const double& p_percent, const double&b0_percent, const double& frac_over_sea);
+
     /// @brief Diffraction Loss model from Section 4.5.4
     /// @param out_diff_loss_median_dB Returns diffraction loss not exceeded for 50 percentof time
     /// @param out_diff_loss_p_percent_dB Returns diffraction loss not exceeded for p percent of time
@@ -41,17 +48,17 @@ public:
 
 private:
     //direct inputs
-    const PathProfile::Path& m_path; //Contains distance (km) and height (asl)(m) profile points
-    const double& m_height_tx_asl_m; //Tx Antenna height (m)
-    const double& m_height_rx_asl_m; //Rx Antenna height (m)
-    const double& m_freq_GHz;        //Frequency (GHz)
-    const double& m_deltaN;          //Average radio-refractive index lapse-rate through the lowest 1km of the atmosphere (positive value) 
-    const Enumerations::PolarizationType& m_pol; //Polarization type (horizontal or vertical)
-    const double& m_p_percent;       // Percentage of time not exceeded (%), 0<p<=50
+    PathProfile::PathView m_path;                    //Contains distance (km) and height (asl)(m) profile points
+    double m_height_tx_asl_m;        //Tx Antenna height (m)
+    double m_height_rx_asl_m;        //Rx Antenna height (m)
+    double m_freq_GHz;               //Frequency (GHz)
+    double m_deltaN;                 //Average radio-refractive index lapse-rate through the lowest 1km of the atmosphere (positive value) 
+    Enumerations::PolarizationType m_pol;        //Polarization type (horizontal or vertical)
+    double m_p_percent;              // Percentage of time not exceeded (%), 0<p<=50
 
     //intermediate inputs
-    const double& m_b0_percent;      //Time percentage that the refractivity gradient (DELTA-N) exceeds 100 N-units/km in the first 100 m of the lower atmosphere (%)
-    const double& m_frac_over_sea;   //Fraction of the path over sea
+    double m_b0_percent;             //Time percentage that the refractivity gradient (DELTA-N) exceeds 100 N-units/km in the first 100 m of the lower atmosphere (%)
+    double m_frac_over_sea;          //Fraction of the path over sea
 
     //Calculated intermediate values
     double m_d_tot_km;                //Total great circle path distance from tx to rx (km)
@@ -65,9 +72,11 @@ private:
     /// @param height_tx_asl_m  Tx Antenna height (asl) (m)
     /// @param height_rx_asl_m  Rx Antenna height (asl) (m)
     /// @param eff_radius_p_km  Effective Earth radius for time percentage (km)
+    /// @param isZeroHeightProfile  Take the heights of all profile points as 0 (smooth earth profile of the Delta-Bullington model)
     /// @return Loss from Bullington component (dB)
-    double calcBullingtonLoss_dB(const PathProfile::Path& path, const double& height_tx_asl_m,
-                                    const double& height_rx_asl_m, const double& eff_radius_p_km) const;
+    double calcBullingtonLoss_dB(const PathProfile::PathView& path, const double& height_tx_asl_m,
+                                    const double& height_rx_asl_m, const double& eff_radius_p_km, 
+                                    const bool& isZeroHeightProfile=false) const;
 
     /// @brief Delta-Bullington diffraction loss model from Section 4.2.3
     /// @param eff_radius_p_km      Effective Earth radius for time percentage (km)
@@ -0,0 +1,57 @@
+#ifndef ITUR_P452_EVALUATOR_H
+#define ITUR_P452_EVALUATOR_H
+
+#include "MainModel/PathProfile.h"
+#include "ClutterModel/ClutterLoss.h"
+#include "Common/Enumerations.h"
+
+#include <cstddef>
+
+namespace ITUR_P452{
+
+    struct ClearAirIntermediates;
+
+    /// @brief Evaluator of the clear air model for many links. The model works on a view of the caller's path instead of
+    /// copying it, so an evaluation makes no heap allocations.
+    /// The evaluator also owns a scratch input path that callers fill for each link (P452::calculateP452Loss_dB builds its
+    /// path there with createP452Path). Refilling it keeps its memory, so it only allocates for a link longer than any before
+    /// it, or than reserve() made room for. An evaluator must only be used by one thread at a time, use one per worker thread.
+    class Evaluator{
+    public:
+        Evaluator() = default;
+
+        /// @brief Scratch input path, callers may fill it (e.g. with P452::createP452Path) and pass it to 
+        ///        calcTotalClearAirAttenuation. It is not changed by the evaluator
+        /// @return Input path kept between links
+        PathProfile::Path& inputPath();
+
+        /// @brief Reserve the scratch input path for profiles of up to numPoints points, so filling it never allocates
+        /// @param numPoints    Number of profile points
+        void reserve(const std::size_t& numPoints);
+
+        /// @brief Basic transmission loss, same as TotalClearAirAttenuation(...).calcTotalClearAirAttenuation(), 
+        ///        see TotalClearAirAttenuation for the parameters
+        /// @return total transmission loss for clear air conditions (dB)
+        double calcTotalClearAirAttenuation(const double& freq_GHz, const double& p_percent, const PathProfile::Path& path_TxToRx, 
+            const double& height_tx_m, const double& height_rx_m, const double& centerLatitude_deg, const double& txHorizonGain_dBi, 
+            const double& rxHorizonGain_dBi, const Enumerations::PolarizationType& pol, const double& dist_coast_tx_km, 
+            const double& dist_coast_rx_km, const double& deltaN, const double& surfaceRefractivity,
+            const double& temp_K, const double& dryPressure_hPa, const ClutterModel::ClutterType& tx_clutterType, 
+            const ClutterModel::ClutterType& rx_clutterType);
+
+        /// @brief Intermediate values of the clear air model, same as TotalClearAirAttenuation(...).calcIntermediates(),
+        ///        see TotalClearAirAttenuation for the parameters
+        /// @return path parameters, submodel outputs, blending parameters and total loss of one evaluation
+        ClearAirIntermediates calcIntermediates(const double& freq_GHz, const double& p_percent, const PathProfile::Path& path_TxToRx, 
+            const double& height_tx_m, const double& height_rx_m, const double& centerLatitude_deg, const double& txHorizonGain_dBi, 
+            const double& rxHorizonGain_dBi, const Enumerations::PolarizationType& pol, const double& dist_coast_tx_km, 
+            const double& dist_coast_rx_km, const double& deltaN, const double& surfaceRefractivity,
+            const double& temp_K, const double& dryPressure_hPa, const ClutterModel::ClutterType& tx_clutterType, 
+            const ClutterModel::ClutterType& rx_clutterType);
+
+    private:
+        PathProfile::Path m_inputPath;  //input path filled by the caller
+    };
+
+}//end namespace ITUR_P452
+#endif /* ITUR_P452_EVALUATOR_H */
@@ -26,7 +26,7 @@ namespace ITUR_P452::Helpers{
     ///        WARNING Does not account for Eq 168
     /// @param path Contains vector of terrain profile distances from Tx (km) and heights (amsl) (m)
     /// @return Tx,Rx endpoint heights for the smooth-earth surface (amsl) (m)
-    TxRxPair calcLeastSquaresSmoothEarthTxRxHeights_helper_amsl_m(const PathProfile::Path& path);
+    TxRxPair calcLeastSquaresSmoothEarthTxRxHeights_helper_amsl_m(const PathProfile::PathView& path);
 
     /// @brief Annex 1 Attachment 2 Section 4,5 Calculating Antenna Horizon Elevation Angle and Horizon Distances
     /// @param path                 Contains vector of terrain profile distances from Tx (km) and heights (amsl) (m)
@@ -35,7 +35,7 @@ namespace ITUR_P452::Helpers{
     /// @param eff_radius_med_km    Median effective Earth's radius (km)
     /// @param freq_GHz             Frequency (GHz)
     /// @return Antenna Horizon Distances (km) and Horizon Elevation Angles (mrad)
-    HorizonAnglesAndDistances calcHorizonAnglesAndDistances(const PathProfile::Path& path, const double& height_tx_asl_m,
+    HorizonAnglesAndDistances calcHorizonAnglesAndDistances(const PathProfile::PathView& path, const double& height_tx_asl_m,
                                 const double& height_rx_asl_m, const double& eff_radius_med_km, const double& freq_GHz);
     
     /// @brief Calculates the path angular distance from the path profile analysis results
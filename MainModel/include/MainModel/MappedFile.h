@@ -0,0 +1,40 @@
+#ifndef ITUR_P452_MAPPED_FILE_H
+#define ITUR_P452_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ITUR_P452{
+    /// @brief Read-only view of a whole file. The file is memory-mapped where supported (POSIX),
+    /// otherwise its contents are read into an internal buffer
+    class MappedFile {
+    public:
+        /// @brief Map a file for reading, throws std::runtime_error if the file cannot be opened
+        /// @param filePath Path to the file
+        explicit MappedFile(const std::string& filePath);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// @brief First byte of the file contents (nullptr for an empty file)
+        const char* data() const {return m_data;}
+        /// @brief Size of the file contents (bytes)
+        std::size_t size() const {return m_size;}
+        /// @brief Path used to open the file
+        const std::string& path() const {return m_path;}
+
+    private:
+        std::string m_path;
+        const char* m_data;
+        std::size_t m_size;
+        bool m_isMapped;            //true if m_data points to an mmap region that needs to be unmapped
+        std::vector<char> m_buffer; //fallback storage when memory mapping is not available
+
+        void release();
+    };//end class MappedFile
+}//end namespace ITUR_P452
+#endif /* ITUR_P452_MAPPED_FILE_H */
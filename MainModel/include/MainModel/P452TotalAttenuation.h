@@ -11,8 +11,90 @@
 #include "Common/GeodeticCoord.h"
 #include "Common/Enumerations.h"
 
+#include <array>
+#include <cstddef>
+#include <memory>
+
 namespace ITUR_P452{
 
+/// @brief Every intermediate value of one evaluation of the clear air model (Section 4.6), for diagnosing single links
+struct ClearAirIntermediates{
+    //path parameters, after the height gain model
+    double d_tot_km;                                //Distance between Tx and Rx along the modified path (km)
+    double height_tx_asl_m;                         //Tx Antenna height above sea level in the height gain model (m)
+    double height_rx_asl_m;                         //Rx Antenna height above sea level in the height gain model (m)
+    double fracOverSea;                             //Fraction of the path over sea (omega)
+    double b0_percent;                              //Time percentage that the refractivity gradient exceeds 100 N-Units/km (beta0)
+    double effEarthRadius_med_km;                   //Median effective Earth's radius (km)
+    double horizonAngle_tx_mrad;                    //Tx Horizon Elevation Angle (mrad)
+    double horizonAngle_rx_mrad;                    //Rx Horizon Elevation Angle (mrad)
+    double horizonDist_tx_km;                       //Tx Horizon Distance (km)
+    double horizonDist_rx_km;                       //Rx Horizon Distance (km)
+
+    //submodel outputs
+    double freeSpaceWithGasLoss_dB;                 //Equation 8 (Lbfsg)
+    double basicTransmissionLoss_p_percent_dB;      //Equation 11 (Lb0p)
+    double basicTransmissionLoss_b0_percent_dB;     //Equation 12 (Lb0b)
+    double diffractionLoss_median_dB;               //Ld50, diffraction loss not exceeded for 50 percent of time
+    double diffractionLoss_p_percent_dB;            //Ldp, diffraction loss not exceeded for p percent of time
+    double anomalousPropagationLoss_dB;             //Lba, ducting and layer reflection
+    double tropoScatterLoss_dB;                     //Lbs, troposcatter
+    double tx_clutterLoss_dB;                       //Aht, clutter shielding loss at Tx
+    double rx_clutterLoss_dB;                       //Ahr, clutter shielding loss at Rx
+
+    //blending of the submodel outputs
+    double basicWithMedianDiffractionLoss_dB;       //Equation 43 (Lbd50)
+    double basicWithDiffractionLoss_p_percent_dB;   //Equation 44 (Lbd)
+    double minLossWithOverSeaSubPathDiffraction_dB; //Equation 60 (Lminb0p)
+    double minLossWithAnomalousPropagation_dB;      //Equation 61 (Lminbap)
+    double pathBlendingInterpolationParameter;      //Equation 59 (Fk)
+    double diffractionAndAnomalousPropagationLoss_dB;           //Equation 62 (Lbda)
+    double slopeInterpolationParameter;             //Equation 58 (Fj)
+    double modifiedDiffractionAndAnomalousPropagationLoss_dB;   //Equation 63 (Lbam)
+    double totalLoss_dB;                            //Equation 64 (Lb), including the clutter losses
+};
+
+/// @brief Name and member of one value of ClearAirIntermediates
+struct ClearAirIntermediateField{
+    const char* name;
+    double ClearAirIntermediates::* value;
+};
+
+/// Every value of ClearAirIntermediates in declaration order, named like the members (e.g. for columnar output)
+inline constexpr std::array<ClearAirIntermediateField, 28> CLEAR_AIR_INTERMEDIATE_FIELDS{{
+    {"d_tot_km", &ClearAirIntermediates::d_tot_km},
+    {"height_tx_asl_m", &ClearAirIntermediates::height_tx_asl_m},
+    {"height_rx_asl_m", &ClearAirIntermediates::height_rx_asl_m},
+    {"fracOverSea", &ClearAirIntermediates::fracOverSea},
+    {"b0_percent", &ClearAirIntermediates::b0_percent},
+    {"effEarthRadius_med_km", &ClearAirIntermediates::effEarthRadius_med_km},
+    {"horizonAngle_tx_mrad", &ClearAirIntermediates::horizonAngle_tx_mrad},
+    {"horizonAngle_rx_mrad", &ClearAirIntermediates::horizonAngle_rx_mrad},
+    {"horizonDist_tx_km", &ClearAirIntermediates::horizonDist_tx_km},
+    {"horizonDist_rx_km", &ClearAirIntermediates::horizonDist_rx_km},
+    {"freeSpaceWithGasLoss_dB", &ClearAirIntermediates::freeSpaceWithGasLoss_dB},
+    {"basicTransmissionLoss_p_percent_dB", &ClearAirIntermediates::basicTransmissionLoss_p_percent_dB},
+    {"basicTransmissionLoss_b0_percent_dB", &ClearAirIntermediates::basicTransmissionLoss_b0_percent_dB},
+    {"diffractionLoss_median_dB", &ClearAirIntermediates::diffractionLoss_median_dB},
+    {"diffractionLoss_p_percent_dB", &ClearAirIntermediates::diffractionLoss_p_percent_dB},
+    {"anomalousPropagationLoss_dB", &ClearAirIntermediates::anomalousPropagationLoss_dB},
+    {"tropoScatterLoss_dB", &ClearAirIntermediates::tropoScatterLoss_dB},
+    {"tx_clutterLoss_dB", &ClearAirIntermediates::tx_clutterLoss_dB},
+    {"rx_clutterLoss_dB", &ClearAirIntermediates::rx_clutterLoss_dB},
+    {"basicWithMedianDiffractionLoss_dB", &ClearAirIntermediates::basicWithMedianDiffractionLoss_dB},
+    {"basicWithDiffractionLoss_p_percent_dB", &ClearAirIntermediates::basicWithDiffractionLoss_p_percent_dB},
+    {"minLossWithOverSeaSubPathDiffraction_dB", &ClearAirIntermediates::minLossWithOverSeaSubPathDiffraction_dB},
+    {"minLossWithAnomalousPropagation_dB", &ClearAirIntermediates::minLossWithAnomalousPropagation_dB},
+    {"pathBlendingInterpolationParameter", &ClearAirIntermediates::pathBlendingInterpolationParameter},
+    {"diffractionAndAnomalousPropagationLoss_dB", &ClearAirIntermediates::diffractionAndAnomalousPropagationLoss_dB},
+    {"slopeInterpolationParameter", &ClearAirIntermediates::slopeInterpolationParameter},
+    {"modifiedDiffractionAndAnomalousPropagationLoss_dB", &ClearAirIntermediates::modifiedDiffractionAndAnomalousPropagationLoss_dB},
+    {"totalLoss_dB", &ClearAirIntermediates::totalLoss_dB},
+}};
+
+static_assert(sizeof(ClearAirIntermediates)==CLEAR_AIR_INTERMEDIATE_FIELDS.size()*sizeof(double),
+        "CLEAR_AIR_INTERMEDIATE_FIELDS must list every value of ClearAirIntermediates");
+
 //Section 4.6  Basic transmission loss between the two stations
 class TotalClearAirAttenuation {
 public:
@@ -34,7 +116,7 @@ public:
     /// @param dryPressure_hPa      Dry air pressure (hPa)
     /// @param tx_clutterType       Clutter Category Type at Tx 
     /// @param rx_clutterType       Clutter Category Type at Rx 
-    TotalClearAirAttenuation(const double& freq_GHz, const double& p_percent, const PathProfile::Path path_TxToRx, 
+    TotalClearAirAttenuation(const double& freq_GHz, const double& p_percent, const PathProfile::Path& path_TxToRx, 
             const double& height_tx_m, const double& height_rx_m, const double& centerLatitude_deg, const double& txHorizonGain_dBi, 
             const double& rxHorizonGain_dBi, const Enumerations::PolarizationType& pol, const double& dist_coast_tx_km, 
             const double& dist_coast_rx_km, const double& deltaN, const double& surfaceRefractivity,
@@ -45,13 +127,31 @@ public:
     /// @return total transmission loss for clear air conditions
     double calcTotalClearAirAttenuation() const;
 
+    /// @brief Same calculation as calcTotalClearAirAttenuation, returning the path parameters, the submodel outputs
+    ///        and the blending parameters along with the total loss
+    /// @return intermediate values of this evaluation, totalLoss_dB equals calcTotalClearAirAttenuation()
+    ClearAirIntermediates calcIntermediates() const;
+
 private:
+    friend class Evaluator;
+
+    /// @brief Same as the public constructor, on a view of the path. The public constructor shares a copy of the path 
+    ///        with the view, Evaluator passes a view of its input path so no profile memory is allocated
+    /// @param path_TxToRx          View of the terrain profile, the model must not outlive the viewed path
+    TotalClearAirAttenuation(const double& freq_GHz, const double& p_percent, const PathProfile::PathView& path_TxToRx, 
+            const double& height_tx_m, const double& height_rx_m, const double& centerLatitude_deg, const double& txHorizonGain_dBi, 
+            const double& rxHorizonGain_dBi, const Enumerations::PolarizationType& pol, const double& dist_coast_tx_km, 
+            const double& dist_coast_rx_km, const double& deltaN, const double& surfaceRefractivity,
+            const double& temp_K, const double& dryPressure_hPa, const ClutterModel::ClutterType& tx_clutterType, 
+            const ClutterModel::ClutterType& rx_clutterType);
+
     //common direct inputs
-    const double& m_freq_GHz;       //Frequency (GHz)
-    const double& m_p_percent;      //Percentage of time not exceeded (%), 0<p<=50
+    double m_freq_GHz;              //Frequency (GHz)
+    double m_p_percent;             //Percentage of time not exceeded (%), 0<p<=50
 
     //height gain model variables
-    PathProfile::Path m_mod_path;   //distances (km), heights (asl)(m), and zone types of the profile points in the height gain model
+    PathProfile::PathView m_mod_path; //distances (km), heights (asl)(m), and zone types of the profile points in the height gain model
+                                      //(view of the immutable input path, shared with the submodels and with copies of this object)
     double m_height_tx_asl_m;       //Tx Antenna center height above ground level (m)
     double m_height_rx_asl_m;       //Rx Antenna center height above ground level (m)
     double m_d_tot_km;              //Great Circle Distance between Tx and Rx antennas along modified path (km)
@@ -83,7 +183,7 @@ private:
     /// @param height_rx_m          Rx Antenna height (m)
     /// @param tx_clutterType       Clutter Category Type at Tx
     /// @param rx_clutterType       Clutter Category Type at Rx
-    void pre_calcPathParameters(const PathProfile::Path& path, const double& deltaN, const double& centerLatitude_deg,
+    void pre_calcPathParameters(const PathProfile::PathView& path, const double& deltaN, const double& centerLatitude_deg,
             const double& height_tx_m, const double& height_rx_m, const ClutterModel::ClutterType& tx_clutterType, 
             const ClutterModel::ClutterType& rx_clutterType);
 
@@ -109,7 +209,7 @@ private:
     /// @param height_tx_asl_m Tx Antenna height above sea level (m)
     /// @param height_rx_asl_m Rx Antenna height above sea level (m)
     /// @return Slope Interpolation Parameter
-    static double calcSlopeInterpolationParameter(const PathProfile::Path& path_TxToRx, const double& effEarthRadius_med_km,
+    static double calcSlopeInterpolationParameter(const PathProfile::PathView& path_TxToRx, const double& effEarthRadius_med_km,
             const double& height_tx_asl_m,const double& height_rx_asl_m);
     
     /// @brief calculate Path Blending interpolation parameter used in Section 4.6
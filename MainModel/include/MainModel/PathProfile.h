@@ -1,6 +1,10 @@
 #ifndef PATH_PROFILE_H
 #define PATH_PROFILE_H
 
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -14,6 +18,9 @@ namespace PathProfile{
 		Sea = 3,
 	};
 
+    /// Smallest number of points of a profile the clear air model evaluates (the two terminals)
+    constexpr std::size_t MIN_PROFILE_POINTS = 2;
+
     /// @brief          A point along the profile path
     /// @param d_km     Distance (km)
     /// @param h_asl_m  Height above sea level (m)
@@ -48,5 +55,97 @@ namespace PathProfile{
         /// @return the longest contiguous inland distance (km)
         double calcLongestContiguousInlandDistance_km() const;
     };
+
+    /// @brief Read-only window of consecutive points of a Path, with distances measured from the first point of the window.
+    /// A view is an index range and a distance offset, so trimming a path (e.g. in the clutter model) does not copy it.
+    /// Views built from a Path reference do not keep the path alive, views built from a shared_ptr share its ownership.
+    /// Points are returned by value with the offset already subtracted from the distance.
+    class PathView{
+        public:
+        /// Random access iterator over the points of a view
+        class const_iterator{
+            public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = ProfilePoint;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = ProfilePoint;
+
+            /// Allows it->d_km on points returned by value
+            struct ArrowProxy{
+                ProfilePoint point;
+                const ProfilePoint* operator->() const{return &point;}
+            };
+
+            const_iterator() = default;
+            const_iterator(const ProfilePoint* point, const double& offset_km): m_point{point}, m_offset_km{offset_km}{}
+
+            ProfilePoint operator*() const{
+                return ProfilePoint(m_point->d_km-m_offset_km, m_point->h_asl_m, m_point->zone);
+            }
+            ArrowProxy operator->() const{return ArrowProxy{**this};}
+            ProfilePoint operator[](const difference_type& n) const{return *(*this+n);}
+
+            const_iterator& operator++(){++m_point; return *this;}
+            const_iterator operator++(int){const_iterator it = *this; ++m_point; return it;}
+            const_iterator& operator--(){--m_point; return *this;}
+            const_iterator operator--(int){const_iterator it = *this; --m_point; return it;}
+            const_iterator& operator+=(const difference_type& n){m_point+=n; return *this;}
+            const_iterator& operator-=(const difference_type& n){m_point-=n; return *this;}
+            friend const_iterator operator+(const_iterator it, const difference_type& n){return it+=n;}
+            friend const_iterator operator+(const difference_type& n, const_iterator it){return it+=n;}
+            friend const_iterator operator-(const_iterator it, const difference_type& n){return it-=n;}
+            friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs){return lhs.m_point-rhs.m_point;}
+            friend bool operator==(const const_iterator& lhs, const const_iterator& rhs){return lhs.m_point==rhs.m_point;}
+            friend std::strong_ordering operator<=>(const const_iterator& lhs, const const_iterator& rhs){
+                return lhs.m_point<=>rhs.m_point;
+            }
+
+            private:
+            const ProfilePoint* m_point = nullptr;
+            double m_offset_km = 0.0;
+        };
+
+        /// @brief Empty view
+        PathView();
+        /// @brief View of the whole path, which must outlive the view
+        PathView(const Path& path);
+        /// @brief View of the whole path, sharing its ownership
+        PathView(std::shared_ptr<const Path> path);
+
+        /// @brief View of the points [firstInd, endInd) of this view, keeping the ownership of this view.
+        ///        Distances of the new view start at 0 at its first point
+        /// @param firstInd First point of the new view
+        /// @param endInd   One past the last point of the new view (firstInd<=endInd<=size())
+        /// @return Trimmed view
+        PathView subView(const std::size_t& firstInd, const std::size_t& endInd) const;
+
+        const_iterator begin() const{return const_iterator(m_points, m_offset_km);}
+        const_iterator end() const{return const_iterator(m_points+m_size, m_offset_km);}
+        const_iterator cbegin() const{return begin();}
+        const_iterator cend() const{return end();}
+        std::size_t size() const{return m_size;}
+        bool empty() const{return m_size==0;}
+        ProfilePoint operator[](const std::size_t& pointInd) const{return begin()[pointInd];}
+        ProfilePoint front() const{return *begin();}
+        ProfilePoint back() const{return *(end()-1);}
+        /// @brief Point with bounds checking, throws std::out_of_range
+        ProfilePoint at(const std::size_t& pointInd) const;
+        /// @brief Distance of the first point of the view in the underlying path (km)
+        double distanceOffset_km() const{return m_offset_km;}
+
+        /// @brief Same as Path::calcFracOverSea
+        double calcFracOverSea() const;
+        /// @brief Same as Path::calcTimePercentBeta0
+        double calcTimePercentBeta0(const double& centerLatitude_deg) const;
+        /// @brief Same as Path::calcLongestContiguousInlandDistance_km
+        double calcLongestContiguousInlandDistance_km() const;
+
+        private:
+        std::shared_ptr<const Path> m_owner;    //keeps the path alive, empty for views of a Path reference
+        const ProfilePoint* m_points;           //first point of the view
+        std::size_t m_size;                     //number of points
+        double m_offset_km;                     //distance of the first point in the underlying path (km)
+    };
 }
 #endif /* PATH_PROFILE_H */
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef PROFILE_ARCHIVE_H
+#define PROFILE_ARCHIVE_H
+
+#include "PathProfile.h"
+#include "MappedFile.h"
+#include "ProfileCsvReader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+//Binary profile archive layout (native byte order, all sections 8 byte aligned):
+//  header        magic "P452PRF1", version, height encoding, profile count, point count,
+//                height scale/offset and the byte offsets of the sections below
+//  index         uint64 point offsets, one per profile plus one (profile i is [offset[i], offset[i+1]))
+//  distances     float64 column (km)
+//  heights       float64 column (m), or int16 column with height_m = raw*scale + offset
+//  zones         uint8 column (PathProfile::ZoneType, 0 if not specified)
+namespace PathProfile{
+
+    /// Storage type of the height column
+    enum class HeightEncoding : uint32_t {
+        Float64 = 0,
+        Int16 = 1,
+    };
+
+    /// @brief Non-owning view of one profile stored in a ProfileArchive
+    /// The view is only valid while the archive it came from is alive
+    class ProfileView{
+    public:
+        ProfileView(std::span<const double> distances_km, std::span<const double> heights_m,
+                std::span<const int16_t> rawHeights, const double& heightScale_m, const double& heightOffset_m,
+                std::span<const uint8_t> zones);
+
+        std::size_t size() const {return m_distances_km.size();}
+        bool empty() const {return m_distances_km.empty();}
+
+        /// @brief Distance from Tx of a profile point (km)
+        double d_km(const std::size_t& index) const {return m_distances_km[index];}
+        /// @brief Height above sea level of a profile point (m), decoded if the archive stores int16 heights
+        double h_asl_m(const std::size_t& index) const{
+            return m_heights_m.empty() ? m_rawHeights[index]*m_heightScale_m+m_heightOffset_m : m_heights_m[index];
+        }
+        /// @brief Zone type of a profile point (0 if not specified)
+        ZoneType zone(const std::size_t& index) const {return static_cast<ZoneType>(m_zones[index]);}
+        ProfilePoint operator[](const std::size_t& index) const {return ProfilePoint(d_km(index), h_asl_m(index), zone(index));}
+
+        /// Direct access to the stored columns (only one of the height columns is populated)
+        std::span<const double> distances_km() const {return m_distances_km;}
+        std::span<const double> heights_m() const {return m_heights_m;}
+        std::span<const int16_t> rawHeights() const {return m_rawHeights;}
+        std::span<const uint8_t> zones() const {return m_zones;}
+
+        /// @brief Copy the profile into a path, reusing the existing capacity of out_path
+        /// @param out_path Returns the profile points
+        void copyTo(Path& out_path) const;
+
+        /// @brief Create a path holding a copy of the profile
+        Path toPath() const;
+
+    private:
+        std::span<const double> m_distances_km;
+        std::span<const double> m_heights_m;
+        std::span<const int16_t> m_rawHeights;
+        double m_heightScale_m;
+        double m_heightOffset_m;
+        std::span<const uint8_t> m_zones;
+    };
+
+    /// @brief Read-only, memory-mapped archive of profiles.
+    /// Opening an archive validates the header and section sizes and scans the profile index once (O(number of profiles),
+    /// the profile points are not read). Profiles are then accessed in O(1) through the index
+    class ProfileArchive{
+    public:
+        /// @brief Open an archive written by ProfileArchiveWriter, throws std::runtime_error if the file is invalid
+        /// @param archivePath Path to the archive
+        explicit ProfileArchive(const std::string& archivePath);
+
+        /// @brief Number of profiles in the archive
+        std::size_t size() const {return m_numProfiles;}
+        /// @brief Total number of profile points in the archive
+        std::size_t numPoints() const {return m_numPoints;}
+        HeightEncoding heightEncoding() const {return m_heightEncoding;}
+
+        /// @brief View of the profile at the given index (no bounds check)
+        ProfileView operator[](const std::size_t& profileInd) const;
+        /// @brief View of the profile at the given index, throws std::out_of_range if the index is invalid
+        ProfileView at(const std::size_t& profileInd) const;
+
+    private:
+        ITUR_P452::MappedFile m_file;
+        HeightEncoding m_heightEncoding;
+        std::size_t m_numProfiles;
+        std::size_t m_numPoints;
+        double m_heightScale_m;
+        double m_heightOffset_m;
+        const uint64_t* m_pointOffsets;
+        const double* m_distances_km;
+        const double* m_heights_m;
+        const int16_t* m_rawHeights;
+        const uint8_t* m_zones;
+    };
+
+    /// @brief Builds a profile archive. Columns are collected in memory and written by finish()
+    class ProfileArchiveWriter{
+    public:
+        /// @param archivePath      Path of the archive to write
+        /// @param heightEncoding   Storage type of the height column
+        /// @param heightScale_m    Height resolution for int16 heights (m), heights must stay within +-32767*scale
+        ProfileArchiveWriter(const std::string& archivePath, const HeightEncoding& heightEncoding=HeightEncoding::Float64,
+                const double& heightScale_m=1.0);
+
+        /// @brief Add a profile to the archive, throws std::out_of_range if an int16 height cannot be represented
+        void append(const Path& path);
+
+        /// @brief Write the archive file
+        void finish();
+
+    private:
+        std::string m_archivePath;
+        HeightEncoding m_heightEncoding;
+        double m_heightScale_m;
+        std::vector<uint64_t> m_pointOffsets;
+        std::vector<double> m_distances_km;
+        std::vector<double> m_heights_m;
+        std::vector<int16_t> m_rawHeights;
+        std::vector<uint8_t> m_zones;
+    };
+
+    /// @brief Convert csv profile files (in the format accepted by Path(std::string csvPath),
+    ///        optionally with several profiles per file) into a single profile archive
+    /// @param csvPathList      Csv files, profiles are archived in file order
+    /// @param archivePath      Path of the archive to write
+    /// @param heightEncoding   Storage type of the height column
+    /// @param heightScale_m    Height resolution for int16 heights (m)
+    /// @param mapping          Header names of the csv columns
+    /// @return Number of profiles written
+    std::size_t convertCsvToProfileArchive(const std::vector<std::string>& csvPathList, const std::string& archivePath,
+            const HeightEncoding& heightEncoding=HeightEncoding::Float64, const double& heightScale_m=1.0,
+            const CsvColumnMapping& mapping=CsvColumnMapping());
+}
+#endif /* PROFILE_ARCHIVE_H */
@@ -0,0 +1,79 @@
+#ifndef PROFILE_CSV_READER_H
+#define PROFILE_CSV_READER_H
+
+#include "PathProfile.h"
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PathProfile{
+
+    /// @brief Header names of the columns holding the profile values.
+    /// An empty name selects the column used by Path(std::string csvPath): distance is column 1,
+    /// height is column 2 and the integer zone type is column 4 (only if the header has at least 4 columns)
+    struct CsvColumnMapping{
+        std::string distanceColumn;
+        std::string heightColumn;
+        std::string zoneColumn;
+    };
+
+    /// @brief Fast reader for csv profile files using a memory-mapped file and std::from_chars
+    /// A file may contain several profiles separated by blank lines. A header line is only accepted as the first line of
+    /// the file or right after a blank line, if none of its fields is a number and it names the mapped columns.
+    /// Profiles without their own header reuse the previous header.
+    /// Parse errors throw std::runtime_error naming the file and line number
+    class ProfileCsvReader{
+    public:
+        /// @brief Open a csv profile file
+        /// @param csvPath  Path to the csv file
+        /// @param mapping  Header names of the distance, height and zone columns
+        explicit ProfileCsvReader(const std::string& csvPath, const CsvColumnMapping& mapping = CsvColumnMapping());
+
+        /// @brief Parse the next profile in the file. The existing capacity of out_path is reused
+        /// @param out_path Returns the profile points
+        /// @return false if there are no more profiles in the file
+        bool readNext(Path& out_path);
+
+        /// @brief Parse all remaining profiles in the file
+        /// @return List of profiles
+        std::vector<Path> readAll();
+
+        /// @brief Line number (starting at 1) of the last line that was read
+        std::size_t lineNumber() const {return m_lineNumber;}
+
+    private:
+        ITUR_P452::MappedFile m_file;
+        CsvColumnMapping m_mapping;
+        const char* m_cursor;       //start of the next unread line
+        const char* m_end;          //end of the file contents
+        std::size_t m_lineNumber;   //last line read
+        bool m_atProfileStart;      //true at the start of the file and after a blank line (a header may follow)
+
+        //column indices resolved from the latest header
+        bool m_hasHeader;
+        std::size_t m_numColumns;
+        std::size_t m_distanceIndex;
+        std::size_t m_heightIndex;
+        std::size_t m_zoneIndex;
+        bool m_hasZone;
+
+        /// @brief Return the next line without the line terminator and advance the cursor
+        std::string_view nextLine();
+
+        /// @brief True if the line can be a header: no field is a number and the mapped columns are named
+        bool isHeaderLine(std::string_view line) const;
+
+        /// @brief Resolve the column indices from a header line
+        void parseHeader(std::string_view line);
+
+        /// @brief Parse a data line into a profile point
+        ProfilePoint parsePoint(std::string_view line) const;
+
+        /// @brief Throw a parse error for the current line
+        [[noreturn]] void throwParseError(const std::string& message) const;
+    };
+}
+#endif /* PROFILE_CSV_READER_H */
@@ -0,0 +1,47 @@
+#ifndef PROFILE_DECIMATION_H
+#define PROFILE_DECIMATION_H
+
+#include "PathProfile.h"
+
+#include <vector>
+
+namespace PathProfile{
+
+    /// @brief Settings for decimateProfile
+    struct ProfileDecimationOptions{
+        /// Maximum vertical distance (m) between a removed point and the straight line joining the kept points around it
+        double heightTolerance_m = 1.0;
+        /// Tx and Rx antenna heights above ground (m), used to find the horizon and Bullington points
+        double txHeight_m = 10.0;
+        double rxHeight_m = 10.0;
+        /// Frequency (GHz) used to find the Bullington point of line of sight paths
+        double freq_GHz = 2.0;
+        /// Effective Earth radii (km) for which the horizon and Bullington points are kept.
+        /// The defaults cover the median radius of a standard atmosphere (k=4/3) and the radius exceeded for b0% of time (k=3),
+        /// the median radius of the actual path (calcMedianEffectiveRadius_km) can be added for an exact match of the horizons
+        std::vector<double> effectiveRadiusList_km = {6371.0*4.0/3.0, 6371.0*3.0};
+        /// Points closer than this distance (km) to either terminal are always kept, so the clutter model
+        /// (nominal clutter distances of up to 0.1 km) trims the same part of the path
+        double terminalDistance_km = 0.2;
+    };
+
+    /// @brief Remove profile points that have little effect on the loss.
+    /// The following points are always kept:
+    ///   - the end points, the points within options.terminalDistance_km of them and the first point beyond that distance
+    ///   - the points on both sides of every zone change (the sea fraction, beta0 and inland distances are unchanged)
+    ///   - the horizon points seen from Tx and Rx and the Bullington point for each effective Earth radius
+    /// The remaining points are removed with the Douglas-Peucker method using the vertical distance, so every removed point
+    /// is within options.heightTolerance_m of the linearly interpolated decimated profile. The least-squares smooth-earth
+    /// heights and the terrain roughness therefore change by at most the height tolerance.
+    /// @param path     Profile to decimate, distances must be increasing
+    /// @param options  Decimation settings
+    /// @return Decimated profile (a subset of the points of path, in the same order)
+    Path decimateProfile(const Path& path, const ProfileDecimationOptions& options=ProfileDecimationOptions());
+
+    /// @brief Find the points decimateProfile keeps, without copying the profile
+    /// @param path         Profile to decimate, distances must be increasing
+    /// @param options      Decimation settings
+    /// @param out_keepList Returns one flag per profile point, true if the point is kept
+    void findDecimatedPoints(const Path& path, const ProfileDecimationOptions& options, std::vector<bool>& out_keepList);
+}
+#endif /* PROFILE_DECIMATION_H */
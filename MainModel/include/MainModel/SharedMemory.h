@@ -0,0 +1,48 @@
+#ifndef ITUR_P452_SHARED_MEMORY_H
+#define ITUR_P452_SHARED_MEMORY_H
+
+#include <cstddef>
+#include <string>
+
+namespace ITUR_P452{
+    /// @brief Named POSIX shared memory segment (shm_open) mapped into the process, so read-only data loaded once
+    /// can be used by several worker processes without a copy per process. The process that creates the segment
+    /// removes its name when the segment is destroyed; processes that already mapped it keep their mapping.
+    /// Not available on Windows (create and open throw std::runtime_error)
+    class SharedMemorySegment {
+    public:
+        /// @brief Create a new segment, writable by this process, throws std::runtime_error if the name exists
+        /// @param name Segment name, starting with '/' (e.g. "/p452_tiles_1234")
+        /// @param size Size of the segment (bytes), must be positive
+        static SharedMemorySegment create(const std::string& name, const std::size_t& size);
+
+        /// @brief Map an existing segment read-only, throws std::runtime_error if it does not exist
+        /// @param name Segment name used by create()
+        static SharedMemorySegment open(const std::string& name);
+
+        ~SharedMemorySegment();
+
+        SharedMemorySegment(SharedMemorySegment&& other) noexcept;
+        SharedMemorySegment& operator=(SharedMemorySegment&& other) noexcept;
+        SharedMemorySegment(const SharedMemorySegment&) = delete;
+        SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+        /// @brief Start of the segment, writable only in the creating process
+        char* data() {return m_isWritable ? m_data : nullptr;}
+        const char* data() const {return m_data;}
+        std::size_t size() const {return m_size;}
+        const std::string& name() const {return m_name;}
+
+    private:
+        SharedMemorySegment(const std::string& name, char* data, const std::size_t& size, const bool& isWritable);
+
+        std::string m_name;
+        char* m_data;
+        std::size_t m_size;
+        bool m_isWritable;
+        long m_creatorProcessId;    //process that removes the name, 0 if the segment was opened
+
+        void release();
+    };//end class SharedMemorySegment
+}//end namespace ITUR_P452
+#endif /* ITUR_P452_SHARED_MEMORY_H */
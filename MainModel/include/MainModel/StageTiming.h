@@ -0,0 +1,110 @@
+#ifndef ITUR_P452_STAGE_TIMING_H
+#define ITUR_P452_STAGE_TIMING_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ITUR_P452{
+
+    /// @brief Stages of one TotalClearAirAttenuation evaluation, in calculation order
+    /// (scoped, several stage names are also namespace and type names)
+    enum class ModelStage{
+        EffectiveRadius = 0,        //median effective earth radius (pre_calcPathParameters)
+        PathStatistics,             //fraction of the path over sea and beta0 time percentage
+        ClutterModel,               //height gain model, modified path and clutter losses
+        HorizonAnglesAndDistances,  //horizon elevation angles and distances of the modified path
+        BasicPropagation,           //free space loss with gas attenuation and multipath corrections (calculateSubModels)
+        Diffraction,                //delta Bullington diffraction loss
+        AnomalousPropagation,       //ducting and layer reflection loss
+        Troposcatter                //tropospheric scatter loss
+    };
+
+    constexpr std::size_t NUM_MODEL_STAGES = static_cast<std::size_t>(ModelStage::Troposcatter)+1;
+
+    /// @brief Name of a model stage as used in the JSON output (e.g. "diffraction")
+    const char* modelStageName(const ModelStage& stage);
+
+    /// @brief Calls and cumulative time of one model stage
+    struct StageTiming{
+        std::uint64_t numCalls = 0;
+        double totalTime_s = 0;     //cumulative time (s)
+
+        /// @brief Mean time of a call (s), 0 if the stage was never called
+        double meanTime_s() const {return numCalls>0 ? totalTime_s/numCalls : 0.0;}
+    };
+
+    /// @brief Stage timings summed over every thread that evaluated the model
+    struct ModelStageStats{
+        bool isEnabled = false;     //false if the library was built without P452_STAGE_TIMING, all timings are then 0
+        std::array<StageTiming, NUM_MODEL_STAGES> stages;  //indexed by ModelStage
+
+        const StageTiming& operator[](const ModelStage& stage) const {return stages[static_cast<std::size_t>(stage)];}
+
+        /// @brief Timings as a JSON object:
+        ///        {"enabled":true,"stages":{"effectiveRadius":{"calls":N,"total_s":T,"mean_s":M},...}}
+        std::string toJson() const;
+    };
+
+    /// @brief True if the library was built with P452_STAGE_TIMING (CMake option of the same name)
+    constexpr bool isStageTimingEnabled(){
+#ifdef P452_STAGE_TIMING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /// @brief Sum the stage counters of every thread, including threads that have exited since the last reset.
+    ///        Can be called while other threads evaluate the model
+    ModelStageStats collectModelStageStats();
+
+    /// @brief Set the stage counters of every thread to 0
+    void resetModelStageStats();
+
+    /// @brief Add one call of a stage to the counters of the calling thread
+    /// @param stage        Model stage
+    /// @param time_ns      Time of the call (ns)
+    void recordModelStage(const ModelStage& stage, const std::uint64_t& time_ns);
+
+    /// @brief Times consecutive stages of a calculation: the time from the construction (or the last next() call)
+    ///        to the next next() call (or the destruction) is added to the current stage.
+    ///        Without P452_STAGE_TIMING the timer is empty and compiles to nothing
+    class ModelStageTimer{
+    public:
+#ifdef P452_STAGE_TIMING
+        explicit ModelStageTimer(const ModelStage& firstStage):
+            m_stage{firstStage}, m_start{std::chrono::steady_clock::now()}{}
+
+        ~ModelStageTimer(){record(std::chrono::steady_clock::now());}
+
+        void next(const ModelStage& stage){
+            const auto now = std::chrono::steady_clock::now();
+            record(now);
+            m_stage = stage;
+            m_start = now;
+        }
+#else
+        explicit ModelStageTimer(const ModelStage&){}
+
+        void next(const ModelStage&){}
+#endif
+
+        ModelStageTimer(const ModelStageTimer&) = delete;
+        ModelStageTimer& operator=(const ModelStageTimer&) = delete;
+
+#ifdef P452_STAGE_TIMING
+    private:
+        void record(const std::chrono::steady_clock::time_point& now) const{
+            recordModelStage(m_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(now-m_start).count());
+        }
+
+        ModelStage m_stage;
+        std::chrono::steady_clock::time_point m_start;
+#endif
+    };
+
+}//end namespace ITUR_P452
+#endif /* ITUR_P452_STAGE_TIMING_H */
@@ -0,0 +1,41 @@
+#ifndef ITUR_P452_TASK_SCHEDULER_H
+#define ITUR_P452_TASK_SCHEDULER_H
+
+#include <cstddef>
+#include <functional>
+#include <span>
+
+namespace ITUR_P452{
+
+    /// @brief Settings of the parallel batch scheduler
+    struct SchedulerOptions{
+        unsigned int threadCount = 0;   //number of threads, including the calling thread (0 uses the hardware concurrency)
+        bool pinThreads = false;        //pin worker thread i to the i-th CPU of the process affinity mask (Linux only, ignored elsewhere).
+                                        //The calling thread is not pinned
+        std::size_t chunksPerThread = 8;//target number of chunks per thread, more chunks balance better but steal more often
+    };
+
+    /// @brief Number of threads used for a batch of items
+    /// @param threadCount  Requested number of threads (0 uses the hardware concurrency)
+    /// @param count        Number of items
+    /// @return Thread count between 1 and count
+    unsigned int resolveThreadCount(const unsigned int& threadCount, const std::size_t& count);
+
+    /// Job called for one item: job(itemInd, threadInd), threadInd is in [0, resolveThreadCount(...))
+    using ItemJob = std::function<void(const std::size_t& itemInd, const unsigned int& threadInd)>;
+
+    /// @brief Run a job for every item in [0, count) on a pool of threads with work stealing.
+    /// Items are grouped into contiguous chunks of about equal total cost and every thread starts with a contiguous
+    /// block of chunks, which it works through in order. A thread that runs out of work steals chunks from the end
+    /// of the other threads' blocks, so batches with very different item costs (e.g. 5 km and 1000 km profiles)
+    /// keep all threads busy. Jobs write their results by item index, so the output order is the input order.
+    /// The first exception thrown by a job stops the remaining chunks and is rethrown.
+    /// @param count    Number of items
+    /// @param costs    Relative cost of each item (e.g. number of profile points), empty if all items cost the same
+    /// @param job      Job run once per item
+    /// @param options  Thread count, CPU affinity and chunking
+    void runParallel(const std::size_t& count, std::span<const double> costs, const ItemJob& job,
+            const SchedulerOptions& options=SchedulerOptions());
+
+}//end namespace ITUR_P452
+#endif /* ITUR_P452_TASK_SCHEDULER_H */
@@ -3,6 +3,7 @@
 #include "MainModel/CalculationHelpers.h"
 #include <cmath>
 #include <iostream>
+#include <utility>
 
 ITUR_P452::AnomalousProp::AnomalousProp(const PathProfile::Path& path, const double& freq_GHz,
     const double& height_tx_asl_m, const double& height_rx_asl_m,
@@ -11,7 +12,19 @@ ITUR_P452::AnomalousProp::AnomalousProp(const PathProfile::Path& path, const dou
     const double& b0_percent, const double& eff_radius_med_km, 
     const ITUR_P452::HorizonAnglesAndDistances& horizonVals,
     const double& frac_over_sea): 
-    m_path{path}, m_freq_GHz{freq_GHz}, m_height_tx_asl_m{height_tx_asl_m}, m_height_rx_asl_m{height_rx_asl_m},
+    AnomalousProp(PathProfile::PathView(std::make_shared<const PathProfile::Path>(path)), freq_GHz, height_tx_asl_m, 
+        height_rx_asl_m, temp_K, dryPressure_hPa, dist_coast_tx_km, dist_coast_rx_km, p_percent, b0_percent, eff_radius_med_km, 
+        horizonVals, frac_over_sea){
+}
+
+ITUR_P452::AnomalousProp::AnomalousProp(PathProfile::PathView path, const double& freq_GHz,
+    const double& height_tx_asl_m, const double& height_rx_asl_m,
+    const double& temp_K, const double& dryPressure_hPa, const double& dist_coast_tx_km,
+    const double& dist_coast_rx_km, const double& p_percent,
+    const double& b0_percent, const double& eff_radius_med_km, 
+    const ITUR_P452::HorizonAnglesAndDistances& horizonVals,
+    const double& frac_over_sea): 
+    m_path{std::move(path)}, m_freq_GHz{freq_GHz}, m_height_tx_asl_m{height_tx_asl_m}, m_height_rx_asl_m{height_rx_asl_m},
     m_temp_K{temp_K}, m_dryPressure_hPa{dryPressure_hPa}, m_dist_coast_tx_km{dist_coast_tx_km}, m_dist_coast_rx_km{dist_coast_rx_km},
     m_p_percent{p_percent}, m_b0_percent{b0_percent}, m_eff_radius_med_km{eff_radius_med_km}, m_horizonVals{horizonVals},
     m_frac_over_sea{frac_over_sea} {
@@ -14,7 +14,7 @@ double ITUR_P452::Helpers::calcMedianEffectiveRadius_km(const double& delta_N){
 }
 
 //Least Squares linear approximation of the actual path
-ITUR_P452::TxRxPair ITUR_P452::Helpers::calcLeastSquaresSmoothEarthTxRxHeights_helper_amsl_m(const PathProfile::Path& path){
+ITUR_P452::TxRxPair ITUR_P452::Helpers::calcLeastSquaresSmoothEarthTxRxHeights_helper_amsl_m(const PathProfile::PathView& path){
 
     const double d_tot = path.back().d_km; //assume distances start at 0
     //Section 5.1.6.2
@@ -38,7 +38,7 @@ ITUR_P452::TxRxPair ITUR_P452::Helpers::calcLeastSquaresSmoothEarthTxRxHeights_h
     return ITUR_P452::TxRxPair{height_tx_amsl_m,height_rx_amsl_m};
 }
 
-ITUR_P452::HorizonAnglesAndDistances ITUR_P452::Helpers::calcHorizonAnglesAndDistances(const PathProfile::Path& path,
+ITUR_P452::HorizonAnglesAndDistances ITUR_P452::Helpers::calcHorizonAnglesAndDistances(const PathProfile::PathView& path,
             const double& height_tx_asl_m, const double& height_rx_asl_m, const double& eff_radius_med_km, const double& freq_GHz){
 
     const double d_tot = path.back().d_km;
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <ostream>
 #include <sstream>
+#include <utility>
 #include "Common/PhysicalConstants.h"
 #include "Common/MathHelpers.h"
 #include "MainModel/DiffractionLoss.h"
@@ -13,7 +14,14 @@
 ITUR_P452::DiffractionLoss::DiffractionLoss(const PathProfile::Path& path, const double& height_tx_asl_m, const double& height_rx_asl_m,
     const double& freq_GHz, const double& deltaN, const Enumerations::PolarizationType& pol, 
     const double& p_percent, const double&b0_percent, const double& frac_over_sea):
-    m_path{path}, m_height_tx_asl_m{height_tx_asl_m}, m_height_rx_asl_m{height_rx_asl_m},
+    DiffractionLoss(PathProfile::PathView(std::make_shared<const PathProfile::Path>(path)), height_tx_asl_m, height_rx_asl_m, 
+        freq_GHz, deltaN, pol, p_percent, b0_percent, frac_over_sea){
+}
+
+ITUR_P452::DiffractionLoss::DiffractionLoss(PathProfile::PathView path, const double& height_tx_asl_m, 
+    const double& height_rx_asl_m, const double& freq_GHz, const double& deltaN, const Enumerations::PolarizationType& pol, 
+    const double& p_percent, const double&b0_percent, const double& frac_over_sea):
+    m_path{std::move(path)}, m_height_tx_asl_m{height_tx_asl_m}, m_height_rx_asl_m{height_rx_asl_m},
     m_freq_GHz{freq_GHz}, m_deltaN{deltaN}, m_pol{pol},
     m_p_percent{p_percent}, m_b0_percent{b0_percent}, m_frac_over_sea{frac_over_sea} {
 
@@ -59,14 +67,8 @@ double ITUR_P452::DiffractionLoss::calcDeltaBullingtonLoss_dB(const double& eff_
     //Bullington Loss for the Actual Terrain
     const double Lbulla = calcBullingtonLoss_dB(m_path, m_height_tx_asl_m, m_height_rx_asl_m, eff_radius_p_km);
     
-    //modified heights and zero profile
-    PathProfile::Path zeroHeightpath;
-    for (auto point : m_path){
-        zeroHeightpath.push_back(PathProfile::ProfilePoint(point.d_km, 0.0));
-    }
-
-    //Bullington Loss for an equivalent Smooth Earth m_path
-    const double Lbulls = calcBullingtonLoss_dB(zeroHeightpath, m_eff_height_itx_m, m_eff_height_irx_m, eff_radius_p_km);
+    //Bullington Loss for an equivalent Smooth Earth m_path (modified heights and zero profile)
+    const double Lbulls = calcBullingtonLoss_dB(m_path, m_eff_height_itx_m, m_eff_height_irx_m, eff_radius_p_km, true);
 
     //Spherical Earth Diffraction Loss
     const double Ldsph = calcSphericalEarthDiffractionLoss_dB(eff_radius_p_km);
@@ -75,9 +77,13 @@ double ITUR_P452::DiffractionLoss::calcDeltaBullingtonLoss_dB(const double& eff_
     return Lbulla + std::max(Ldsph - Lbulls, 0.0);
 }
 
-double ITUR_P452::DiffractionLoss::calcBullingtonLoss_dB(const PathProfile::Path& path, const double& height_tx_asl_m,
-        const double& height_rx_asl_m, const double& eff_radius_p_km) const{
+double ITUR_P452::DiffractionLoss::calcBullingtonLoss_dB(const PathProfile::PathView& path, const double& height_tx_asl_m,
+        const double& height_rx_asl_m, const double& eff_radius_p_km, const bool& isZeroHeightProfile) const{
     
+    //the smooth earth profile uses the distances of the path with all heights at 0, without building a copy
+    auto terrainHeight_m = [&isZeroHeightProfile](const PathProfile::ProfilePoint& point){
+        return isZeroHeightProfile ? 0.0 : point.h_asl_m;
+    };
     const double Ce = 1.0/eff_radius_p_km; //effective Earth Curvature
     const double wavelength_m = CalculationHelpers::convert_freqGHz_to_wavelength_m(m_freq_GHz);
     double loss_knifeEdge_dB = 0;//knife edge loss
@@ -92,7 +98,7 @@ double ITUR_P452::DiffractionLoss::calcBullingtonLoss_dB(const PathProfile::Path
     PathProfile::ProfilePoint pt_tx;
     for(auto cit = path.cbegin()+1; cit<path.cend()-1;++cit){
         pt_tx = *cit;
-        slope_tx = (pt_tx.h_asl_m+500*Ce*pt_tx.d_km*(m_d_tot_km-pt_tx.d_km)-height_tx_asl_m)/pt_tx.d_km;
+        slope_tx = (terrainHeight_m(pt_tx)+500*Ce*pt_tx.d_km*(m_d_tot_km-pt_tx.d_km)-height_tx_asl_m)/pt_tx.d_km;
         max_slope_tx = std::max(max_slope_tx,slope_tx); 
     }
 
@@ -112,7 +118,7 @@ double ITUR_P452::DiffractionLoss::calcBullingtonLoss_dB(const PathProfile::Path
             pt = *cit;
             delta_d = m_d_tot_km-pt.d_km;
             //Note. There is no floor operation in this equation. The square brackets may not be rendered correctly. See Eq 155a
-            v1 = (pt.h_asl_m+500.0*Ce*pt.d_km*(delta_d)-(height_tx_asl_m*(delta_d)+height_rx_asl_m*pt.d_km)/m_d_tot_km);
+            v1 = (terrainHeight_m(pt)+500.0*Ce*pt.d_km*(delta_d)-(height_tx_asl_m*(delta_d)+height_rx_asl_m*pt.d_km)/m_d_tot_km);
             v2 = std::sqrt(0.002*m_d_tot_km/(wavelength_m*pt.d_km*delta_d));
             numax = std::max(numax,v1*v2); 
         }
@@ -132,7 +138,7 @@ double ITUR_P452::DiffractionLoss::calcBullingtonLoss_dB(const PathProfile::Path
         PathProfile::ProfilePoint pt_rx;
         for(auto cit = path.cbegin()+1; cit<path.cend()-1;++cit){
             pt_rx = *cit;
-            slope_rx = (pt_rx.h_asl_m+500*Ce*pt_rx.d_km*(m_d_tot_km-pt_rx.d_km)-height_rx_asl_m)/(m_d_tot_km-pt_rx.d_km); 
+            slope_rx = (terrainHeight_m(pt_rx)+500*Ce*pt_rx.d_km*(m_d_tot_km-pt_rx.d_km)-height_rx_asl_m)/(m_d_tot_km-pt_rx.d_km); 
             max_slope_rx = std::max(max_slope_rx,slope_rx); 
         }
 
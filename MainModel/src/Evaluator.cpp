@@ -0,0 +1,37 @@
+#include "MainModel/Evaluator.h"
+#include "MainModel/P452TotalAttenuation.h"
+
+PathProfile::Path& ITUR_P452::Evaluator::inputPath(){
+    return m_inputPath;
+}
+
+void ITUR_P452::Evaluator::reserve(const std::size_t& numPoints){
+    m_inputPath.reserve(numPoints);
+}
+
+double ITUR_P452::Evaluator::calcTotalClearAirAttenuation(const double& freq_GHz, const double& p_percent, 
+        const PathProfile::Path& path_TxToRx, const double& height_tx_m, const double& height_rx_m, 
+        const double& centerLatitude_deg, const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi, 
+        const Enumerations::PolarizationType& pol, const double& dist_coast_tx_km, const double& dist_coast_rx_km, 
+        const double& deltaN, const double& surfaceRefractivity, const double& temp_K, const double& dryPressure_hPa, 
+        const ClutterModel::ClutterType& tx_clutterType, const ClutterModel::ClutterType& rx_clutterType){
+
+    //the model views path_TxToRx without copying it, so it only lives in this scope
+    const auto model = TotalClearAirAttenuation(freq_GHz, p_percent, PathProfile::PathView(path_TxToRx), height_tx_m, height_rx_m, 
+            centerLatitude_deg, txHorizonGain_dBi, rxHorizonGain_dBi, pol, dist_coast_tx_km, dist_coast_rx_km, deltaN, 
+            surfaceRefractivity, temp_K, dryPressure_hPa, tx_clutterType, rx_clutterType);
+    return model.calcTotalClearAirAttenuation();
+}
+
+ITUR_P452::ClearAirIntermediates ITUR_P452::Evaluator::calcIntermediates(const double& freq_GHz, const double& p_percent, 
+        const PathProfile::Path& path_TxToRx, const double& height_tx_m, const double& height_rx_m, 
+        const double& centerLatitude_deg, const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi, 
+        const Enumerations::PolarizationType& pol, const double& dist_coast_tx_km, const double& dist_coast_rx_km, 
+        const double& deltaN, const double& surfaceRefractivity, const double& temp_K, const double& dryPressure_hPa, 
+        const ClutterModel::ClutterType& tx_clutterType, const ClutterModel::ClutterType& rx_clutterType){
+
+    const auto model = TotalClearAirAttenuation(freq_GHz, p_percent, PathProfile::PathView(path_TxToRx), height_tx_m, height_rx_m, 
+            centerLatitude_deg, txHorizonGain_dBi, rxHorizonGain_dBi, pol, dist_coast_tx_km, dist_coast_rx_km, deltaN, 
+            surfaceRefractivity, temp_K, dryPressure_hPa, tx_clutterType, rx_clutterType);
+    return model.calcIntermediates();
+}
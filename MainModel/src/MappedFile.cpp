@@ -0,0 +1,99 @@
+#include "MainModel/MappedFile.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ITUR_P452;
+
+MappedFile::MappedFile(const std::string& filePath): m_path{filePath}, m_data{nullptr}, m_size{0}, m_isMapped{false}{
+#ifndef _WIN32
+    const int fd = ::open(filePath.c_str(), O_RDONLY);
+    if(fd<0){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: MappedFile::MappedFile(): Failed to open file \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+    struct stat fileStats;
+    if(::fstat(fd,&fileStats)!=0){
+        ::close(fd);
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: MappedFile::MappedFile(): Failed to read the size of file \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+    m_size = static_cast<std::size_t>(fileStats.st_size);
+    //mmap does not accept a zero length mapping, an empty file has no data
+    if(m_size>0){
+        void* mapped = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapped==MAP_FAILED){
+            ::close(fd);
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: MappedFile::MappedFile(): Failed to memory map file \"" << filePath << "\"";
+            throw std::runtime_error(oStrStream.str());
+        }
+        //files are read front to back
+        ::madvise(mapped, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(mapped);
+        m_isMapped = true;
+    }
+    ::close(fd);
+#else
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if(!file.is_open()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: MappedFile::MappedFile(): Failed to open file \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+    m_buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(m_buffer.data(), m_buffer.size());
+    m_size = m_buffer.size();
+    m_data = m_size>0 ? m_buffer.data() : nullptr;
+#endif
+}
+
+MappedFile::~MappedFile(){
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept:
+        m_path{std::move(other.m_path)}, m_data{other.m_data}, m_size{other.m_size},
+        m_isMapped{other.m_isMapped}, m_buffer{std::move(other.m_buffer)}{
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_isMapped = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept{
+    if(this!=&other){
+        release();
+        m_path = std::move(other.m_path);
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_isMapped = other.m_isMapped;
+        m_buffer = std::move(other.m_buffer);
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_isMapped = false;
+    }
+    return *this;
+}
+
+void MappedFile::release(){
+#ifndef _WIN32
+    if(m_isMapped){
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_isMapped = false;
+}
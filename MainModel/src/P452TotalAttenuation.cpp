@@ -1,8 +1,22 @@
 #include "MainModel/P452TotalAttenuation.h"
 #include "MainModel/CalculationHelpers.h"
+#include "MainModel/StageTiming.h"
 #include <tuple>
+#include <utility>
 
-ITUR_P452::TotalClearAirAttenuation::TotalClearAirAttenuation(const double& freq_GHz, const double& p_percent, const PathProfile::Path path_TxToRx, 
+ITUR_P452::TotalClearAirAttenuation::TotalClearAirAttenuation(const double& freq_GHz, const double& p_percent, const PathProfile::Path& path_TxToRx, 
+            const double& height_tx_m, const double& height_rx_m, const double& centerLatitude_deg, const double& txHorizonGain_dBi, 
+            const double& rxHorizonGain_dBi, const Enumerations::PolarizationType& pol, const double& dist_coast_tx_km, 
+            const double& dist_coast_rx_km, const double& deltaN, const double& surfaceRefractivity,
+            const double& temp_K, const double& dryPressure_hPa, const ClutterModel::ClutterType& tx_clutterType, 
+            const ClutterModel::ClutterType& rx_clutterType):
+            TotalClearAirAttenuation(freq_GHz, p_percent, PathProfile::PathView(std::make_shared<const PathProfile::Path>(path_TxToRx)),
+                height_tx_m, height_rx_m, centerLatitude_deg, txHorizonGain_dBi, rxHorizonGain_dBi, pol, dist_coast_tx_km, 
+                dist_coast_rx_km, deltaN, surfaceRefractivity, temp_K, dryPressure_hPa, tx_clutterType, rx_clutterType){
+}
+
+ITUR_P452::TotalClearAirAttenuation::TotalClearAirAttenuation(const double& freq_GHz, const double& p_percent, 
+            const PathProfile::PathView& path_TxToRx, 
             const double& height_tx_m, const double& height_rx_m, const double& centerLatitude_deg, const double& txHorizonGain_dBi, 
             const double& rxHorizonGain_dBi, const Enumerations::PolarizationType& pol, const double& dist_coast_tx_km, 
             const double& dist_coast_rx_km, const double& deltaN, const double& surfaceRefractivity,
@@ -14,20 +28,24 @@ ITUR_P452::TotalClearAirAttenuation::TotalClearAirAttenuation(const double& freq
                     surfaceRefractivity,txHorizonGain_dBi,rxHorizonGain_dBi,pol);
 }
 
-void ITUR_P452::TotalClearAirAttenuation::pre_calcPathParameters(const PathProfile::Path& path_TxToRx, const double& deltaN, 
+void ITUR_P452::TotalClearAirAttenuation::pre_calcPathParameters(const PathProfile::PathView& path_TxToRx, const double& deltaN, 
         const double& centerLatitude_deg,const double& height_tx_m, const double& height_rx_m, 
         const ClutterModel::ClutterType& tx_clutterType, const ClutterModel::ClutterType& rx_clutterType){
 
     //Path Parameters calculated using actual path
+    ModelStageTimer stageTimer(ModelStage::EffectiveRadius);
     m_effEarthRadius_med_km = Helpers::calcMedianEffectiveRadius_km(deltaN);
+    stageTimer.next(ModelStage::PathStatistics);
     m_fracOverSea = path_TxToRx.calcFracOverSea();
     m_b0_percent = path_TxToRx.calcTimePercentBeta0(centerLatitude_deg);
 
     //Apply height gain model correction from clutter model
-    const auto ClutterResults = ClutterModel::calculateClutterModel(m_freq_GHz,path_TxToRx,height_tx_m,height_rx_m,
+    //The modified path is a view of the path without the clutter segments, sharing the ownership of path_TxToRx
+    stageTimer.next(ModelStage::ClutterModel);
+    auto ClutterResults = ClutterModel::calculateClutterModel(m_freq_GHz,path_TxToRx,height_tx_m,height_rx_m,
                                                                     tx_clutterType,rx_clutterType);
 
-    m_mod_path = ClutterResults.modifiedPath;
+    m_mod_path = std::move(ClutterResults.modifiedPath);
     const auto [hg_height_tx_m, hg_height_rx_m] = ClutterResults.modifiedHeights_m;
     std::tie(m_tx_clutterLoss_dB, m_rx_clutterLoss_dB) = ClutterResults.clutterLoss_dB;
 
@@ -36,6 +54,7 @@ void ITUR_P452::TotalClearAirAttenuation::pre_calcPathParameters(const PathProfi
     m_d_tot_km = m_mod_path.back().d_km;
 
     //Path geometry parameters of modified path
+    stageTimer.next(ModelStage::HorizonAnglesAndDistances);
     m_HorizonVals = Helpers::calcHorizonAnglesAndDistances(
         m_mod_path, m_height_tx_asl_m, m_height_rx_asl_m, m_effEarthRadius_med_km, m_freq_GHz
     );
@@ -49,6 +68,7 @@ void ITUR_P452::TotalClearAirAttenuation::calculateSubModels(const double& temp_
 
     const auto [HorizonAngles_mrad, HorizonDistances_km] = m_HorizonVals;
     
+    ModelStageTimer stageTimer(ModelStage::BasicPropagation);
     const auto BasicPropModel = BasicProp(m_d_tot_km, m_height_tx_asl_m, m_height_rx_asl_m, m_freq_GHz, temp_K, dryPressure_hPa, 
         m_fracOverSea, m_p_percent, m_b0_percent, HorizonDistances_km);
     //Equation 8 (Lbfsg) basic transmission loss with gas atten
@@ -57,39 +77,64 @@ void ITUR_P452::TotalClearAirAttenuation::calculateSubModels(const double& temp_
     BasicPropModel.calcTransmissionlosses_dB(m_freeSpaceWithGasLoss_dB, m_basicTransmissionLoss_p_percent_dB, 
                                             m_basicTransmissionLoss_b0_percent_dB);
 
+    stageTimer.next(ModelStage::Diffraction);
     const auto DiffractionModel = DiffractionLoss(m_mod_path, m_height_tx_asl_m, m_height_rx_asl_m, m_freq_GHz, 
         deltaN, pol, m_p_percent, m_b0_percent, m_fracOverSea);
     //Delta Bullington Diffraction Loss calculations
     DiffractionModel.calcDiffractionLoss_dB(m_diffractionLoss_median_dB,m_diffractionLoss_p_percent_dB);
 
     //Anomalous Propagation Calculations (Ducting and Layer Reflection)
+    stageTimer.next(ModelStage::AnomalousPropagation);
     const auto AnomalousPropModel = ITUR_P452::AnomalousProp(m_mod_path, m_freq_GHz, m_height_tx_asl_m, 
         m_height_rx_asl_m, temp_K, dryPressure_hPa, dist_coast_tx_km, dist_coast_rx_km, m_p_percent,
         m_b0_percent, m_effEarthRadius_med_km, m_HorizonVals, m_fracOverSea);
     m_anomalousPropagationLoss_dB = AnomalousPropModel.calcAnomalousPropLoss_dB();
     
     //Calculate Tropospheric Scatter
+    stageTimer.next(ModelStage::Troposcatter);
     m_tropoScatterLoss_dB = TropoScatter::calcTroposcatterLoss_dB(m_d_tot_km,m_freq_GHz,m_height_tx_asl_m,
         m_height_rx_asl_m, HorizonAngles_mrad, m_effEarthRadius_med_km, seaLevelSurfaceRefractivity, 
         txHorizonGain_dBi, rxHorizonGain_dBi, temp_K, dryPressure_hPa, m_p_percent);
 }
 
 double ITUR_P452::TotalClearAirAttenuation::calcTotalClearAirAttenuation() const{
+    return calcIntermediates().totalLoss_dB;
+}
+
+ITUR_P452::ClearAirIntermediates ITUR_P452::TotalClearAirAttenuation::calcIntermediates() const{
+    ClearAirIntermediates values;
+    values.d_tot_km = m_d_tot_km;
+    values.height_tx_asl_m = m_height_tx_asl_m;
+    values.height_rx_asl_m = m_height_rx_asl_m;
+    values.fracOverSea = m_fracOverSea;
+    values.b0_percent = m_b0_percent;
+    values.effEarthRadius_med_km = m_effEarthRadius_med_km;
+    std::tie(values.horizonAngle_tx_mrad, values.horizonAngle_rx_mrad) = m_HorizonVals.first;
+    std::tie(values.horizonDist_tx_km, values.horizonDist_rx_km) = m_HorizonVals.second;
+    values.freeSpaceWithGasLoss_dB = m_freeSpaceWithGasLoss_dB;
+    values.basicTransmissionLoss_p_percent_dB = m_basicTransmissionLoss_p_percent_dB;
+    values.basicTransmissionLoss_b0_percent_dB = m_basicTransmissionLoss_b0_percent_dB;
+    values.diffractionLoss_median_dB = m_diffractionLoss_median_dB;
+    values.diffractionLoss_p_percent_dB = m_diffractionLoss_p_percent_dB;
+    values.anomalousPropagationLoss_dB = m_anomalousPropagationLoss_dB;
+    values.tropoScatterLoss_dB = m_tropoScatterLoss_dB;
+    values.tx_clutterLoss_dB = m_tx_clutterLoss_dB;
+    values.rx_clutterLoss_dB = m_rx_clutterLoss_dB;
   
     //Equation 43 (Lbd50) basic loss with diffraction loss not exceeded for 50 percent of time
-    const double basicWithMedianDiffractionLoss_dB = m_freeSpaceWithGasLoss_dB + m_diffractionLoss_median_dB;
+    values.basicWithMedianDiffractionLoss_dB = m_freeSpaceWithGasLoss_dB + m_diffractionLoss_median_dB;
     //Equation 44 (Lbd) basic loss with diffraction loss not exceeded for p percent of time
-    const double basicWithDiffractionLoss_p_percent_dB = m_basicTransmissionLoss_p_percent_dB + m_diffractionLoss_p_percent_dB;
+    values.basicWithDiffractionLoss_p_percent_dB = m_basicTransmissionLoss_p_percent_dB + m_diffractionLoss_p_percent_dB;
 
     //Equation 60 Minimum basic transmission loss associated with LOS propagation and over-sea sub-path diffraction
-    double minLossWithOverSeaSubPathDiffraction_dB = m_basicTransmissionLoss_p_percent_dB + (1-m_fracOverSea)*m_diffractionLoss_p_percent_dB;
+    values.minLossWithOverSeaSubPathDiffraction_dB = m_basicTransmissionLoss_p_percent_dB + (1-m_fracOverSea)*m_diffractionLoss_p_percent_dB;
     if(m_p_percent>=m_b0_percent){
         //Diffraction Interpolation parameter
         const double diffractionInterpolationParameter = 
                     CalculationHelpers::inv_cum_norm(m_p_percent/100.0)/CalculationHelpers::inv_cum_norm(m_b0_percent/100.0);
                     
-        minLossWithOverSeaSubPathDiffraction_dB = MathHelpers::interpolate1D(
-                basicWithMedianDiffractionLoss_dB, 
+        values.minLossWithOverSeaSubPathDiffraction_dB = MathHelpers::interpolate1D(
+                values.basicWithMedianDiffractionLoss_dB, 
                 m_basicTransmissionLoss_b0_percent_dB + (1-m_fracOverSea)*m_diffractionLoss_p_percent_dB,
                 diffractionInterpolationParameter
         );
@@ -97,33 +142,34 @@ double ITUR_P452::TotalClearAirAttenuation::calcTotalClearAirAttenuation() const
 
     //Equation 61 (Lminbap)
     constexpr double eta = 2.5; //constant parameter
-    const double minLossWithAnomalousPropagation_dB = 
+    values.minLossWithAnomalousPropagation_dB = 
                 eta*std::log(std::exp(m_anomalousPropagationLoss_dB/eta)+std::exp(m_basicTransmissionLoss_p_percent_dB/eta));
 
     //Fk
-    const double pathBlendingInterpolationParameter = TotalClearAirAttenuation::calcPathBlendingInterpolationParameter(m_d_tot_km);
+    values.pathBlendingInterpolationParameter = TotalClearAirAttenuation::calcPathBlendingInterpolationParameter(m_d_tot_km);
     //Equation 62 (Lbda)
-    double diffractionAndAnomalousPropagationLoss_dB = basicWithDiffractionLoss_p_percent_dB;
-    if(minLossWithAnomalousPropagation_dB <= basicWithDiffractionLoss_p_percent_dB){
-        diffractionAndAnomalousPropagationLoss_dB = MathHelpers::interpolate1D(minLossWithAnomalousPropagation_dB,
-                                                    basicWithDiffractionLoss_p_percent_dB,pathBlendingInterpolationParameter);
+    values.diffractionAndAnomalousPropagationLoss_dB = values.basicWithDiffractionLoss_p_percent_dB;
+    if(values.minLossWithAnomalousPropagation_dB <= values.basicWithDiffractionLoss_p_percent_dB){
+        values.diffractionAndAnomalousPropagationLoss_dB = MathHelpers::interpolate1D(values.minLossWithAnomalousPropagation_dB,
+                                                    values.basicWithDiffractionLoss_p_percent_dB,values.pathBlendingInterpolationParameter);
     }
 
     //Fj
-    const double slopeInterpolationParameter = 
+    values.slopeInterpolationParameter = 
         TotalClearAirAttenuation::calcSlopeInterpolationParameter(m_mod_path,m_effEarthRadius_med_km,m_height_tx_asl_m,m_height_rx_asl_m);
     //Equation 63 (Lbam)
-    const double modifiedDiffractionAndAnomalousPropagationLoss_dB = 
-                                                    MathHelpers::interpolate1D(diffractionAndAnomalousPropagationLoss_dB, 
-                                                    minLossWithOverSeaSubPathDiffraction_dB,slopeInterpolationParameter);
+    values.modifiedDiffractionAndAnomalousPropagationLoss_dB = 
+                                                    MathHelpers::interpolate1D(values.diffractionAndAnomalousPropagationLoss_dB, 
+                                                    values.minLossWithOverSeaSubPathDiffraction_dB,values.slopeInterpolationParameter);
 
     //Equation 64 Total Loss predicted by model, combines losses using a geometric mean of the linear values
     const double val1 = std::pow(10.0, -0.2*m_tropoScatterLoss_dB);
-    const double val2 = std::pow(10.0, -0.2*modifiedDiffractionAndAnomalousPropagationLoss_dB);
-    return -5.0 * std::log10(val1+val2)+ m_tx_clutterLoss_dB + m_rx_clutterLoss_dB;
+    const double val2 = std::pow(10.0, -0.2*values.modifiedDiffractionAndAnomalousPropagationLoss_dB);
+    values.totalLoss_dB = -5.0 * std::log10(val1+val2)+ m_tx_clutterLoss_dB + m_rx_clutterLoss_dB;
+    return values;
 }
 
-double ITUR_P452::TotalClearAirAttenuation::calcSlopeInterpolationParameter(const PathProfile::Path& path, const double& effEarthRadius_med_km,
+double ITUR_P452::TotalClearAirAttenuation::calcSlopeInterpolationParameter(const PathProfile::PathView& path, const double& effEarthRadius_med_km,
         const double& height_tx_asl_m,const double& height_rx_asl_m){
 
     const double d_tot = path.back().d_km;
@@ -1,8 +1,10 @@
 #include "MainModel/PathProfile.h"
-#include <fstream>
-#include <sstream>
+#include "MainModel/ProfileCsvReader.h"
 #include <cmath>
 #include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
 
 //constructors
 PathProfile::ProfilePoint::ProfilePoint(){
@@ -19,46 +21,61 @@ PathProfile::Path::Path(){
 }
 
 //TODO we can add an assumption that height==0 implies over sea. otherwise land. 
-//TODO look for a more standard approach to interfacing with csvs
+//Reads the first profile of the file (column 1 distance, column 2 height, column 4 zone type)
 PathProfile::Path::Path(std::string csvPath){
-    std::ifstream file;
-    file.open(csvPath);
-    std::string line;
-    std::getline(file,line);//throw away first header line
-
-    std::stringstream ss(line);
-    std::string val;
-    uint16_t n = 0;
-    while(std::getline(ss,val,',')){
-        n+=1;
-    }
+    ProfileCsvReader reader(csvPath);
+    reader.readNext(*this);
+}
 
-    while(std::getline(file,line)){
-        std::stringstream ss(line);
-        std::string val;
-        PathProfile::ProfilePoint point;
+double PathProfile::Path::calcFracOverSea() const{
+    return PathView(*this).calcFracOverSea();
+}
 
-        for(uint16_t i=0; i<n; i++){
-            std::getline(ss,val,',');
-            //row 1 is the distance value
-            if(i==0){
-                point.d_km = std::stod(val);
-            }
-            //row 2 is the height value (m)
-            else if(i==1){
-                point.h_asl_m = std::stod(val);
-            }
-            //Row 3 is a label of the zone type, can be skipped
-            //Row 4 is an integer representing zone type
-            else if(i==3){
-                point.zone = static_cast<PathProfile::ZoneType>(std::stoi(val));
-            }
-        }
-        push_back(point);
+double PathProfile::Path::calcTimePercentBeta0(const double& centerLatitude_deg) const{
+    return PathView(*this).calcTimePercentBeta0(centerLatitude_deg);
+}
+
+double PathProfile::Path::calcLongestContiguousInlandDistance_km() const{
+    return PathView(*this).calcLongestContiguousInlandDistance_km();
+}
+
+PathProfile::PathView::PathView():
+    m_points{nullptr}, m_size{0}, m_offset_km{0.0}{
+}
+
+PathProfile::PathView::PathView(const Path& path):
+    m_points{path.data()}, m_size{path.size()}, m_offset_km{0.0}{
+}
+
+PathProfile::PathView::PathView(std::shared_ptr<const Path> path):
+    m_owner{std::move(path)}, m_points{m_owner->data()}, m_size{m_owner->size()}, m_offset_km{0.0}{
+}
+
+PathProfile::PathView PathProfile::PathView::subView(const std::size_t& firstInd, const std::size_t& endInd) const{
+    if(firstInd>endInd || endInd>m_size){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: PathView::subView(): Invalid point range [" << firstInd << ", " << endInd 
+                    << ") for a view of " << m_size << " points";
+        throw std::out_of_range(oStrStream.str());
     }
+    PathView view(*this);
+    view.m_points = m_points+firstInd;
+    view.m_size = endInd-firstInd;
+    //distances of the new view are measured from its first point
+    view.m_offset_km = firstInd<m_size ? m_points[firstInd].d_km : 0.0;
+    return view;
 }
 
-double PathProfile::Path::calcFracOverSea() const{
+PathProfile::ProfilePoint PathProfile::PathView::at(const std::size_t& pointInd) const{
+    if(pointInd>=m_size){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: PathView::at(): Point index " << pointInd << " out of range for a view of " << m_size << " points";
+        throw std::out_of_range(oStrStream.str());
+    }
+    return (*this)[pointInd];
+}
+
+double PathProfile::PathView::calcFracOverSea() const{
     double sea_dist = 0;
     PathProfile::ProfilePoint lastPoint = *cbegin();
     for(auto cit = cbegin()+1; cit<cend(); ++cit){
@@ -77,7 +94,7 @@ double PathProfile::Path::calcFracOverSea() const{
 }
 
 //WARNING this function only works if the zone types are populated correctly (not checked)
-double PathProfile::Path::calcTimePercentBeta0(const double& centerLatitude_deg) const{
+double PathProfile::PathView::calcTimePercentBeta0(const double& centerLatitude_deg) const{
     //get longest contiguous land and inland segments 
 
     double longestLand=0;
@@ -149,7 +166,7 @@ double PathProfile::Path::calcTimePercentBeta0(const double& centerLatitude_deg)
 
 //TODO refactor code. calc beta0 needs inland and non-sea
 // ducting model needs inland only
-double PathProfile::Path::calcLongestContiguousInlandDistance_km() const{
+double PathProfile::PathView::calcLongestContiguousInlandDistance_km() const{
     //get longest contiguous land and inland segments 
 
     double longestInland=0;
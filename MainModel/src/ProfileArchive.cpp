@@ -0,0 +1,253 @@
+#include "MainModel/ProfileArchive.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace{
+    //identifies the archive format (first 8 bytes of the file)
+    constexpr char ArchiveMagic[8] = {'P','4','5','2','P','R','F','1'};
+    constexpr uint32_t ArchiveVersion = 1;
+
+    struct ArchiveHeader{
+        char magic[8];
+        uint32_t version;
+        uint32_t heightEncoding;
+        uint64_t numProfiles;
+        uint64_t numPoints;
+        double heightScale_m;
+        double heightOffset_m;
+        //byte offsets of the sections from the start of the file
+        uint64_t indexOffset;
+        uint64_t distanceOffset;
+        uint64_t heightOffset;
+        uint64_t zoneOffset;
+    };
+
+    uint64_t alignTo8(const uint64_t& numBytes){
+        return (numBytes+7) & ~static_cast<uint64_t>(7);
+    }
+
+    //true if count elements of elementSize bytes starting at offset fit in the file, without overflowing on corrupt headers
+    bool fitsInFile(const uint64_t& offset, const uint64_t& count, const uint64_t& elementSize, const uint64_t& fileSize){
+        return offset<=fileSize && count<=(fileSize-offset)/elementSize;
+    }
+
+    [[noreturn]] void throwInvalidArchive(const std::string& archivePath, const std::string& message){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: ProfileArchive::ProfileArchive(): File \"" << archivePath << "\" " << message;
+        throw std::runtime_error(oStrStream.str());
+    }
+}
+
+////////////////////////////////
+// ProfileView
+
+PathProfile::ProfileView::ProfileView(std::span<const double> distances_km, std::span<const double> heights_m,
+        std::span<const int16_t> rawHeights, const double& heightScale_m, const double& heightOffset_m,
+        std::span<const uint8_t> zones):
+        m_distances_km{distances_km}, m_heights_m{heights_m}, m_rawHeights{rawHeights},
+        m_heightScale_m{heightScale_m}, m_heightOffset_m{heightOffset_m}, m_zones{zones}{
+}
+
+void PathProfile::ProfileView::copyTo(Path& out_path) const{
+    out_path.resize(size());
+    if(m_heights_m.empty()){
+        for(std::size_t pointInd = 0; pointInd<size(); pointInd++){
+            out_path[pointInd] = ProfilePoint(m_distances_km[pointInd], m_rawHeights[pointInd]*m_heightScale_m+m_heightOffset_m,
+                    static_cast<ZoneType>(m_zones[pointInd]));
+        }
+    }
+    else{
+        for(std::size_t pointInd = 0; pointInd<size(); pointInd++){
+            out_path[pointInd] = ProfilePoint(m_distances_km[pointInd], m_heights_m[pointInd],
+                    static_cast<ZoneType>(m_zones[pointInd]));
+        }
+    }
+}
+
+PathProfile::Path PathProfile::ProfileView::toPath() const{
+    Path path;
+    copyTo(path);
+    return path;
+}
+
+////////////////////////////////
+// ProfileArchive
+
+PathProfile::ProfileArchive::ProfileArchive(const std::string& archivePath): m_file{archivePath}{
+    ArchiveHeader header;
+    if(m_file.size()<sizeof(ArchiveHeader)){
+        throwInvalidArchive(archivePath, "is too small to be a profile archive");
+    }
+    std::memcpy(&header, m_file.data(), sizeof(ArchiveHeader));
+    if(std::memcmp(header.magic, ArchiveMagic, sizeof(ArchiveMagic))!=0){
+        throwInvalidArchive(archivePath, "is not a profile archive");
+    }
+    if(header.version!=ArchiveVersion){
+        throwInvalidArchive(archivePath, "has unsupported version " + std::to_string(header.version));
+    }
+    if(header.heightEncoding!=static_cast<uint32_t>(HeightEncoding::Float64)
+            && header.heightEncoding!=static_cast<uint32_t>(HeightEncoding::Int16)){
+        throwInvalidArchive(archivePath, "has unknown height encoding " + std::to_string(header.heightEncoding));
+    }
+
+    m_heightEncoding = static_cast<HeightEncoding>(header.heightEncoding);
+    m_numProfiles = header.numProfiles;
+    m_numPoints = header.numPoints;
+    m_heightScale_m = header.heightScale_m;
+    m_heightOffset_m = header.heightOffset_m;
+
+    //check that every section fits in the file (only the index is scanned)
+    const uint64_t heightSize = (m_heightEncoding==HeightEncoding::Float64) ? sizeof(double) : sizeof(int16_t);
+    const bool isValidLayout =
+        header.indexOffset%8==0 && header.distanceOffset%8==0 && header.heightOffset%8==0
+        && m_numProfiles<std::numeric_limits<uint64_t>::max()
+        && fitsInFile(header.indexOffset, m_numProfiles+1, sizeof(uint64_t), m_file.size())
+        && fitsInFile(header.distanceOffset, m_numPoints, sizeof(double), m_file.size())
+        && fitsInFile(header.heightOffset, m_numPoints, heightSize, m_file.size())
+        && fitsInFile(header.zoneOffset, m_numPoints, sizeof(uint8_t), m_file.size());
+    if(!isValidLayout){
+        throwInvalidArchive(archivePath, "is truncated or has an invalid layout");
+    }
+
+    const char* base = m_file.data();
+    m_pointOffsets = reinterpret_cast<const uint64_t*>(base+header.indexOffset);
+    m_distances_km = reinterpret_cast<const double*>(base+header.distanceOffset);
+    m_heights_m = (m_heightEncoding==HeightEncoding::Float64) ? reinterpret_cast<const double*>(base+header.heightOffset) : nullptr;
+    m_rawHeights = (m_heightEncoding==HeightEncoding::Int16) ? reinterpret_cast<const int16_t*>(base+header.heightOffset) : nullptr;
+    m_zones = reinterpret_cast<const uint8_t*>(base+header.zoneOffset);
+
+    //the offsets must start at 0, never decrease and end at the number of points, so operator[] needs no check
+    bool isValidIndex = m_pointOffsets[0]==0 && m_pointOffsets[m_numProfiles]==m_numPoints;
+    for(std::size_t profileInd = 0; profileInd<m_numProfiles && isValidIndex; profileInd++){
+        isValidIndex = m_pointOffsets[profileInd]<=m_pointOffsets[profileInd+1];
+    }
+    if(!isValidIndex){
+        throwInvalidArchive(archivePath, "has an invalid profile index");
+    }
+}
+
+PathProfile::ProfileView PathProfile::ProfileArchive::operator[](const std::size_t& profileInd) const{
+    const uint64_t first = m_pointOffsets[profileInd];
+    const std::size_t count = m_pointOffsets[profileInd+1]-first;
+    return ProfileView(
+        std::span<const double>(m_distances_km+first, count),
+        m_heights_m==nullptr ? std::span<const double>() : std::span<const double>(m_heights_m+first, count),
+        m_rawHeights==nullptr ? std::span<const int16_t>() : std::span<const int16_t>(m_rawHeights+first, count),
+        m_heightScale_m, m_heightOffset_m,
+        std::span<const uint8_t>(m_zones+first, count)
+    );
+}
+
+PathProfile::ProfileView PathProfile::ProfileArchive::at(const std::size_t& profileInd) const{
+    if(profileInd>=m_numProfiles){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: ProfileArchive::at(): Profile index " << profileInd << " is out of range, the archive \""
+                    << m_file.path() << "\" has " << m_numProfiles << " profiles";
+        throw std::out_of_range(oStrStream.str());
+    }
+    return (*this)[profileInd];
+}
+
+////////////////////////////////
+// ProfileArchiveWriter
+
+PathProfile::ProfileArchiveWriter::ProfileArchiveWriter(const std::string& archivePath, const HeightEncoding& heightEncoding,
+        const double& heightScale_m):
+        m_archivePath{archivePath}, m_heightEncoding{heightEncoding}, m_heightScale_m{heightScale_m}, m_pointOffsets{0}{
+    if(m_heightEncoding==HeightEncoding::Int16 && !(m_heightScale_m>0.0)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: ProfileArchiveWriter::ProfileArchiveWriter(): The height scale must be positive: " << m_heightScale_m;
+        throw std::domain_error(oStrStream.str());
+    }
+}
+
+void PathProfile::ProfileArchiveWriter::append(const Path& path){
+    for(const auto& point : path){
+        if(m_heightEncoding==HeightEncoding::Int16){
+            const double rawHeight = std::round(point.h_asl_m/m_heightScale_m);
+            if(rawHeight<std::numeric_limits<int16_t>::lowest() || rawHeight>std::numeric_limits<int16_t>::max()){
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ProfileArchiveWriter::append(): Height " << point.h_asl_m << " m of profile "
+                            << m_pointOffsets.size()-1 << " cannot be stored as int16 with a scale of " << m_heightScale_m << " m";
+                throw std::out_of_range(oStrStream.str());
+            }
+            m_rawHeights.push_back(static_cast<int16_t>(rawHeight));
+        }
+        else{
+            m_heights_m.push_back(point.h_asl_m);
+        }
+        m_distances_km.push_back(point.d_km);
+        m_zones.push_back(static_cast<uint8_t>(point.zone));
+    }
+    m_pointOffsets.push_back(m_distances_km.size());
+}
+
+void PathProfile::ProfileArchiveWriter::finish(){
+    ArchiveHeader header;
+    std::memcpy(header.magic, ArchiveMagic, sizeof(ArchiveMagic));
+    header.version = ArchiveVersion;
+    header.heightEncoding = static_cast<uint32_t>(m_heightEncoding);
+    header.numProfiles = m_pointOffsets.size()-1;
+    header.numPoints = m_distances_km.size();
+    header.heightScale_m = (m_heightEncoding==HeightEncoding::Int16) ? m_heightScale_m : 1.0;
+    header.heightOffset_m = 0.0;
+
+    const uint64_t heightBytes = (m_heightEncoding==HeightEncoding::Float64)
+            ? m_heights_m.size()*sizeof(double) : m_rawHeights.size()*sizeof(int16_t);
+    header.indexOffset = alignTo8(sizeof(ArchiveHeader));
+    header.distanceOffset = alignTo8(header.indexOffset+m_pointOffsets.size()*sizeof(uint64_t));
+    header.heightOffset = alignTo8(header.distanceOffset+m_distances_km.size()*sizeof(double));
+    header.zoneOffset = alignTo8(header.heightOffset+heightBytes);
+
+    std::ofstream file(m_archivePath, std::ios::binary | std::ios::trunc);
+    if(!file.is_open()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: ProfileArchiveWriter::finish(): Failed to open file \"" << m_archivePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+    //pad the file with zeros up to the start of the next section
+    auto padTo = [&file](const uint64_t& offset){
+        const char zeros[8] = {};
+        file.write(zeros, offset-static_cast<uint64_t>(file.tellp()));
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(ArchiveHeader));
+    padTo(header.indexOffset);
+    file.write(reinterpret_cast<const char*>(m_pointOffsets.data()), m_pointOffsets.size()*sizeof(uint64_t));
+    padTo(header.distanceOffset);
+    file.write(reinterpret_cast<const char*>(m_distances_km.data()), m_distances_km.size()*sizeof(double));
+    padTo(header.heightOffset);
+    if(m_heightEncoding==HeightEncoding::Float64){
+        file.write(reinterpret_cast<const char*>(m_heights_m.data()), heightBytes);
+    }
+    else{
+        file.write(reinterpret_cast<const char*>(m_rawHeights.data()), heightBytes);
+    }
+    padTo(header.zoneOffset);
+    file.write(reinterpret_cast<const char*>(m_zones.data()), m_zones.size());
+    if(!file){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: ProfileArchiveWriter::finish(): Failed writing file \"" << m_archivePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+}
+
+std::size_t PathProfile::convertCsvToProfileArchive(const std::vector<std::string>& csvPathList, const std::string& archivePath,
+        const HeightEncoding& heightEncoding, const double& heightScale_m, const CsvColumnMapping& mapping){
+    ProfileArchiveWriter writer(archivePath, heightEncoding, heightScale_m);
+    std::size_t numProfiles = 0;
+    Path profile;
+    for(const auto& csvPath : csvPathList){
+        ProfileCsvReader reader(csvPath, mapping);
+        while(reader.readNext(profile)){
+            writer.append(profile);
+            numProfiles++;
+        }
+    }
+    writer.finish();
+    return numProfiles;
+}
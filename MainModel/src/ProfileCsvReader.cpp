@@ -0,0 +1,198 @@
+#include "MainModel/ProfileCsvReader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace{
+    std::string_view trim(std::string_view text){
+        const auto first = text.find_first_not_of(" \t");
+        if(first==std::string_view::npos){
+            return std::string_view();
+        }
+        const auto last = text.find_last_not_of(" \t");
+        return text.substr(first, last-first+1);
+    }
+
+    //split the next comma separated field off the front of the line
+    std::string_view nextField(std::string_view& line){
+        const auto comma = line.find(',');
+        const std::string_view field = line.substr(0, comma);
+        line = (comma==std::string_view::npos) ? std::string_view() : line.substr(comma+1);
+        return trim(field);
+    }
+
+    template<typename T>
+    bool parseNumber(std::string_view field, T& out_value){
+        //from_chars does not accept a leading plus sign
+        if(!field.empty() && field.front()=='+'){
+            field.remove_prefix(1);
+        }
+        const char* fieldEnd = field.data()+field.size();
+        const auto [ptr, ec] = std::from_chars(field.data(), fieldEnd, out_value);
+        return ec==std::errc() && ptr==fieldEnd && !field.empty();
+    }
+
+    std::string_view firstField(std::string_view line){
+        return nextField(line);
+    }
+}
+
+PathProfile::ProfileCsvReader::ProfileCsvReader(const std::string& csvPath, const CsvColumnMapping& mapping):
+        m_file{csvPath}, m_mapping{mapping}, m_cursor{m_file.data()}, m_end{m_file.data()+m_file.size()}, m_lineNumber{0},
+        m_atProfileStart{true}, m_hasHeader{false}, m_numColumns{0}, m_distanceIndex{0}, m_heightIndex{1}, m_zoneIndex{3}, m_hasZone{false}{
+    //skip UTF-8 byte order mark
+    if(m_file.size()>=3 && std::memcmp(m_cursor,"\xEF\xBB\xBF",3)==0){
+        m_cursor+=3;
+    }
+}
+
+bool PathProfile::ProfileCsvReader::readNext(Path& out_path){
+    out_path.clear();
+    while(m_cursor<m_end){
+        const std::string_view line = nextLine();
+        if(trim(line).empty()){
+            //blank line ends the current profile, the next one may start with a header
+            m_atProfileStart = true;
+            if(!out_path.empty()){
+                return true;
+            }
+            continue;
+        }
+        const bool atProfileStart = m_atProfileStart;
+        m_atProfileStart = false;
+        double distance_km;
+        if(!parseNumber(firstField(line), distance_km)){
+            //a header is only accepted as the first line of a profile, anything else is a data line with a bad distance
+            if(!atProfileStart || !isHeaderLine(line)){
+                throwParseError("invalid distance value \"" + std::string(firstField(line))
+                        + "\" (a header line must be the first line of the file or follow a blank line, "
+                        + "have no numeric field and name the mapped columns)");
+            }
+            parseHeader(line);
+            continue;
+        }
+        if(!m_hasHeader){
+            //no header, use the default column positions
+            if(!m_mapping.distanceColumn.empty() || !m_mapping.heightColumn.empty() || !m_mapping.zoneColumn.empty()){
+                throwParseError("column names were given but the profile has no header line");
+            }
+            m_numColumns = std::count(line.begin(), line.end(), ',')+1;
+            m_hasZone = m_numColumns>3;
+            m_hasHeader = true;
+        }
+        out_path.push_back(parsePoint(line));
+    }
+    return !out_path.empty();
+}
+
+std::vector<PathProfile::Path> PathProfile::ProfileCsvReader::readAll(){
+    std::vector<Path> profileList;
+    Path profile;
+    while(readNext(profile)){
+        profileList.push_back(std::move(profile));
+        profile = Path();
+    }
+    return profileList;
+}
+
+std::string_view PathProfile::ProfileCsvReader::nextLine(){
+    const char* newline = static_cast<const char*>(std::memchr(m_cursor, '\n', m_end-m_cursor));
+    const char* lineEnd = (newline==nullptr) ? m_end : newline;
+    std::string_view line(m_cursor, lineEnd-m_cursor);
+    m_cursor = (newline==nullptr) ? m_end : newline+1;
+    m_lineNumber++;
+    //windows line endings
+    if(!line.empty() && line.back()=='\r'){
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+bool PathProfile::ProfileCsvReader::isHeaderLine(std::string_view line) const{
+    std::vector<std::string_view> columnNames;
+    while(!line.empty()){
+        const std::string_view field = nextField(line);
+        double value;
+        if(parseNumber(field, value)){
+            return false;
+        }
+        columnNames.push_back(field);
+    }
+    //a mapped column must be named, an unmapped one must exist at its default position
+    auto hasColumn = [&columnNames](const std::string& name, const std::size_t& defaultIndex){
+        return name.empty() ? defaultIndex<columnNames.size()
+                : std::find(columnNames.cbegin(), columnNames.cend(), std::string_view(name))!=columnNames.cend();
+    };
+    return hasColumn(m_mapping.distanceColumn, 0) && hasColumn(m_mapping.heightColumn, 1)
+            && (m_mapping.zoneColumn.empty() || hasColumn(m_mapping.zoneColumn, 3));
+}
+
+void PathProfile::ProfileCsvReader::parseHeader(std::string_view line){
+    std::vector<std::string_view> columnNames;
+    while(!line.empty()){
+        columnNames.push_back(nextField(line));
+    }
+    m_numColumns = columnNames.size();
+
+    auto findColumn = [this, &columnNames](const std::string& name){
+        const auto it = std::find(columnNames.cbegin(), columnNames.cend(), std::string_view(name));
+        if(it==columnNames.cend()){
+            throwParseError("column \"" + name + "\" was not found in the header");
+        }
+        return static_cast<std::size_t>(it-columnNames.cbegin());
+    };
+
+    //column 1 is the distance value
+    m_distanceIndex = m_mapping.distanceColumn.empty() ? 0 : findColumn(m_mapping.distanceColumn);
+    //column 2 is the height value (m)
+    m_heightIndex = m_mapping.heightColumn.empty() ? 1 : findColumn(m_mapping.heightColumn);
+    //column 3 is a label of the zone type, can be skipped
+    //column 4 is an integer representing zone type
+    if(m_mapping.zoneColumn.empty()){
+        m_zoneIndex = 3;
+        m_hasZone = m_numColumns>3;
+    }
+    else{
+        m_zoneIndex = findColumn(m_mapping.zoneColumn);
+        m_hasZone = true;
+    }
+    m_hasHeader = true;
+}
+
+PathProfile::ProfilePoint PathProfile::ProfileCsvReader::parsePoint(std::string_view line) const{
+    //zone type 0 means the zone was not specified
+    ProfilePoint point(0.0, 0.0, static_cast<ZoneType>(0));
+    const std::size_t lastIndex = std::max({m_distanceIndex, m_heightIndex, m_hasZone ? m_zoneIndex : 0});
+
+    std::size_t columnIndex = 0;
+    for(; columnIndex<=lastIndex && !line.empty(); columnIndex++){
+        const std::string_view field = nextField(line);
+        if(columnIndex==m_distanceIndex && !parseNumber(field, point.d_km)){
+            throwParseError("invalid distance value \"" + std::string(field) + "\"");
+        }
+        else if(columnIndex==m_heightIndex && !parseNumber(field, point.h_asl_m)){
+            throwParseError("invalid height value \"" + std::string(field) + "\"");
+        }
+        else if(m_hasZone && columnIndex==m_zoneIndex){
+            int zone;
+            if(!parseNumber(field, zone)){
+                throwParseError("invalid zone value \"" + std::string(field) + "\"");
+            }
+            point.zone = static_cast<ZoneType>(zone);
+        }
+    }
+    if(columnIndex<=lastIndex){
+        throwParseError("expected at least " + std::to_string(lastIndex+1) + " columns");
+    }
+    return point;
+}
+
+void PathProfile::ProfileCsvReader::throwParseError(const std::string& message) const{
+    std::ostringstream oStrStream;
+    oStrStream << "ERROR: ProfileCsvReader: " << m_file.path() << ":" << m_lineNumber << ": " << message;
+    throw std::runtime_error(oStrStream.str());
+}
@@ -0,0 +1,161 @@
+#include "MainModel/ProfileDecimation.h"
+#include "MainModel/CalculationHelpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace{
+    //mark the points with the highest elevation angles from both terminals and the highest Bullington diffraction parameter
+    //for one effective Earth radius (Annex 1 Attachment 2 Eq 151-157 and Eq 155a)
+    void keepHorizonPoints(const PathProfile::Path& path, const double& height_tx_asl_m, const double& height_rx_asl_m,
+            const double& wavelength_m, const double& eff_radius_km, std::vector<bool>& keepList){
+        const double d_tot = path.back().d_km;
+        const double Ce = 1.0/eff_radius_km;
+        double theta_tmax = std::numeric_limits<double>::lowest();
+        double theta_rmax = std::numeric_limits<double>::lowest();
+        double numax = std::numeric_limits<double>::lowest();
+        std::size_t tx_index = 0, rx_index = 0, nu_index = 0;
+        for(std::size_t pointInd = 1; pointInd+1<path.size(); pointInd++){
+            const double d_km = path[pointInd].d_km;
+            const double h_m = path[pointInd].h_asl_m;
+            const double delta_d = d_tot-d_km;
+            //the angles are compared without the arctangent, it does not change the order
+            const double theta_t = (h_m-height_tx_asl_m)/d_km-500.0*Ce*d_km;
+            const double theta_r = (h_m-height_rx_asl_m)/delta_d-500.0*Ce*delta_d;
+            const double nu = (h_m+500.0*Ce*d_km*delta_d-(height_tx_asl_m*delta_d+height_rx_asl_m*d_km)/d_tot)
+                    *std::sqrt(0.002*d_tot/(wavelength_m*d_km*delta_d));
+            //same tie breaking as calcHorizonAnglesAndDistances (tx and nu prefer points closer to tx, rx closer to rx)
+            if(theta_t>theta_tmax){
+                theta_tmax = theta_t;
+                tx_index = pointInd;
+            }
+            if(theta_r>=theta_rmax){
+                theta_rmax = theta_r;
+                rx_index = pointInd;
+            }
+            if(nu>numax){
+                numax = nu;
+                nu_index = pointInd;
+            }
+        }
+        keepList[tx_index] = true;
+        keepList[rx_index] = true;
+        keepList[nu_index] = true;
+    }
+}
+
+void PathProfile::findDecimatedPoints(const Path& path, const ProfileDecimationOptions& options, std::vector<bool>& out_keepList){
+    if(!(options.heightTolerance_m>=0.0)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: PathProfile::findDecimatedPoints(): The height tolerance must not be negative: " << options.heightTolerance_m;
+        throw std::domain_error(oStrStream.str());
+    }
+    out_keepList.assign(path.size(), false);
+    if(path.size()<=2){
+        out_keepList.assign(path.size(), true);
+        return;
+    }
+    const double d_tot = path.back().d_km;
+
+    //end points, points near the terminals and zone changes. The first point beyond the terminal distance is kept as well,
+    //the clutter model starts the path there on profiles without points within the terminal distance
+    for(std::size_t pointInd = 0; pointInd<path.size(); pointInd++){
+        if(path[pointInd].d_km<=options.terminalDistance_km || path[pointInd].d_km>=d_tot-options.terminalDistance_km){
+            out_keepList[pointInd] = true;
+        }
+        if(pointInd>0 && path[pointInd-1].d_km<=options.terminalDistance_km){
+            out_keepList[pointInd] = true;
+        }
+        if(pointInd+1<path.size() && path[pointInd+1].d_km>=d_tot-options.terminalDistance_km){
+            out_keepList[pointInd] = true;
+        }
+        if(pointInd>0 && path[pointInd].zone!=path[pointInd-1].zone){
+            out_keepList[pointInd-1] = true;
+            out_keepList[pointInd] = true;
+        }
+    }
+    out_keepList.front() = true;
+    out_keepList.back() = true;
+
+    //horizon and Bullington points
+    const double height_tx_asl_m = path.front().h_asl_m+options.txHeight_m;
+    const double height_rx_asl_m = path.back().h_asl_m+options.rxHeight_m;
+    const double wavelength_m = ITUR_P452::CalculationHelpers::convert_freqGHz_to_wavelength_m(options.freq_GHz);
+    double minEffRadius_km = std::numeric_limits<double>::infinity();
+    for(const double& eff_radius_km : options.effectiveRadiusList_km){
+        keepHorizonPoints(path, height_tx_asl_m, height_rx_asl_m, wavelength_m, eff_radius_km, out_keepList);
+        minEffRadius_km = std::min(minEffRadius_km, eff_radius_km);
+    }
+
+    //Longest gap between kept points for which the Earth bulge (500*Ce*d*(d_tot-d)) deviates from a straight line
+    //by less than the height tolerance. This bounds the error of the curvature corrected heights used by the
+    //horizon and Bullington calculations and of the smooth profile in the delta Bullington model.
+    const double maxGap_km = std::isfinite(minEffRadius_km)
+            ? 2.0*std::sqrt(options.heightTolerance_m*minEffRadius_km/500.0) : std::numeric_limits<double>::infinity();
+
+    //Douglas-Peucker refinement between consecutive kept points (explicit stack, the profiles can be long)
+    std::vector<std::pair<std::size_t,std::size_t>> segmentStack;
+    std::size_t prevKeptInd = 0;
+    for(std::size_t pointInd = 1; pointInd<path.size(); pointInd++){
+        if(out_keepList[pointInd]){
+            if(pointInd-prevKeptInd>1){
+                segmentStack.emplace_back(prevKeptInd, pointInd);
+            }
+            prevKeptInd = pointInd;
+        }
+    }
+    while(!segmentStack.empty()){
+        const auto [firstInd, lastInd] = segmentStack.back();
+        segmentStack.pop_back();
+
+        const ProfilePoint& first = path[firstInd];
+        const ProfilePoint& last = path[lastInd];
+        const double slope = (last.h_asl_m-first.h_asl_m)/(last.d_km-first.d_km);
+        double maxError_m = -1.0;
+        std::size_t splitInd = firstInd+1;
+        for(std::size_t pointInd = firstInd+1; pointInd<lastInd; pointInd++){
+            const double error_m = std::abs(path[pointInd].h_asl_m-(first.h_asl_m+slope*(path[pointInd].d_km-first.d_km)));
+            if(error_m>maxError_m){
+                maxError_m = error_m;
+                splitInd = pointInd;
+            }
+        }
+        if(maxError_m<=options.heightTolerance_m){
+            if(last.d_km-first.d_km<=maxGap_km){
+                continue;
+            }
+            //the heights are within tolerance but the gap is too long, split at the point closest to the middle
+            const double midDistance_km = 0.5*(first.d_km+last.d_km);
+            const auto it = std::lower_bound(path.cbegin()+firstInd+1, path.cbegin()+lastInd, midDistance_km,
+                    [](const ProfilePoint& point, const double& d_km){return point.d_km<d_km;});
+            splitInd = std::min<std::size_t>(it-path.cbegin(), lastInd-1);
+            if(splitInd>firstInd+1 && midDistance_km-path[splitInd-1].d_km<path[splitInd].d_km-midDistance_km){
+                splitInd--;
+            }
+        }
+        out_keepList[splitInd] = true;
+        if(splitInd-firstInd>1){
+            segmentStack.emplace_back(firstInd, splitInd);
+        }
+        if(lastInd-splitInd>1){
+            segmentStack.emplace_back(splitInd, lastInd);
+        }
+    }
+}
+
+PathProfile::Path PathProfile::decimateProfile(const Path& path, const ProfileDecimationOptions& options){
+    std::vector<bool> keepList;
+    findDecimatedPoints(path, options, keepList);
+    Path decimatedPath;
+    decimatedPath.reserve(std::count(keepList.cbegin(), keepList.cend(), true));
+    for(std::size_t pointInd = 0; pointInd<path.size(); pointInd++){
+        if(keepList[pointInd]){
+            decimatedPath.push_back(path[pointInd]);
+        }
+    }
+    return decimatedPath;
+}
@@ -0,0 +1,124 @@
+#include "MainModel/SharedMemory.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ITUR_P452;
+
+SharedMemorySegment::SharedMemorySegment(const std::string& name, char* data, const std::size_t& size, const bool& isWritable):
+        m_name{name}, m_data{data}, m_size{size}, m_isWritable{isWritable}, m_creatorProcessId{0}{
+}
+
+SharedMemorySegment SharedMemorySegment::create(const std::string& name, const std::size_t& size){
+#ifndef _WIN32
+    if(size==0){
+        throw std::invalid_argument("ERROR: SharedMemorySegment::create(): The segment size must be positive");
+    }
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fd<0){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: SharedMemorySegment::create(): Failed to create segment \"" << name << "\": " << std::strerror(errno);
+        throw std::runtime_error(oStrStream.str());
+    }
+    void* mapped = MAP_FAILED;
+    if(::ftruncate(fd, static_cast<off_t>(size))==0){
+        mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    const int error = errno;
+    ::close(fd);
+    if(mapped==MAP_FAILED){
+        ::shm_unlink(name.c_str());
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: SharedMemorySegment::create(): Failed to map " << size << " bytes of segment \"" << name << "\": "
+                    << std::strerror(error);
+        throw std::runtime_error(oStrStream.str());
+    }
+    SharedMemorySegment segment(name, static_cast<char*>(mapped), size, true);
+    segment.m_creatorProcessId = static_cast<long>(::getpid());
+    return segment;
+#else
+    (void)size;
+    std::ostringstream oStrStream;
+    oStrStream << "ERROR: SharedMemorySegment::create(): Shared memory segments are not supported on this platform (\"" << name << "\")";
+    throw std::runtime_error(oStrStream.str());
+#endif
+}
+
+SharedMemorySegment SharedMemorySegment::open(const std::string& name){
+#ifndef _WIN32
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if(fd<0){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: SharedMemorySegment::open(): Failed to open segment \"" << name << "\": " << std::strerror(errno);
+        throw std::runtime_error(oStrStream.str());
+    }
+    struct stat segmentStats;
+    void* mapped = MAP_FAILED;
+    if(::fstat(fd, &segmentStats)==0 && segmentStats.st_size>0){
+        mapped = ::mmap(nullptr, static_cast<std::size_t>(segmentStats.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if(mapped==MAP_FAILED){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: SharedMemorySegment::open(): Failed to map segment \"" << name << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+    return SharedMemorySegment(name, static_cast<char*>(mapped), static_cast<std::size_t>(segmentStats.st_size), false);
+#else
+    std::ostringstream oStrStream;
+    oStrStream << "ERROR: SharedMemorySegment::open(): Shared memory segments are not supported on this platform (\"" << name << "\")";
+    throw std::runtime_error(oStrStream.str());
+#endif
+}
+
+SharedMemorySegment::~SharedMemorySegment(){
+    release();
+}
+
+SharedMemorySegment::SharedMemorySegment(SharedMemorySegment&& other) noexcept:
+        m_name{std::move(other.m_name)}, m_data{other.m_data}, m_size{other.m_size},
+        m_isWritable{other.m_isWritable}, m_creatorProcessId{other.m_creatorProcessId}{
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_creatorProcessId = 0;
+}
+
+SharedMemorySegment& SharedMemorySegment::operator=(SharedMemorySegment&& other) noexcept{
+    if(this!=&other){
+        release();
+        m_name = std::move(other.m_name);
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_isWritable = other.m_isWritable;
+        m_creatorProcessId = other.m_creatorProcessId;
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_creatorProcessId = 0;
+    }
+    return *this;
+}
+
+void SharedMemorySegment::release(){
+#ifndef _WIN32
+    if(m_data!=nullptr){
+        ::munmap(m_data, m_size);
+    }
+    //forked workers inherit the segment object, only the creator removes the name
+    if(m_creatorProcessId!=0 && m_creatorProcessId==static_cast<long>(::getpid())){
+        ::shm_unlink(m_name.c_str());
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_creatorProcessId = 0;
+}
@@ -0,0 +1,122 @@
+#include "MainModel/StageTiming.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace{
+    constexpr std::array<const char*, ITUR_P452::NUM_MODEL_STAGES> STAGE_NAMES{
+        "effectiveRadius",
+        "pathStatistics",
+        "clutterModel",
+        "horizonAnglesAndDistances",
+        "basicPropagation",
+        "diffraction",
+        "anomalousPropagation",
+        "troposcatter",
+    };
+
+    //counters are only written by their thread, atomics let other threads sum them while the model runs
+    struct alignas(64) StageCounters{
+        std::array<std::atomic<std::uint64_t>, ITUR_P452::NUM_MODEL_STAGES> numCalls{};
+        std::array<std::atomic<std::uint64_t>, ITUR_P452::NUM_MODEL_STAGES> time_ns{};
+    };
+
+    //counters of the live threads, and the sum of the counters of the threads that have exited
+    struct CounterRegistry{
+        std::mutex mutex;
+        std::vector<StageCounters*> threadCounters;
+        StageCounters exitedThreads;
+    };
+
+    //never destroyed, threads may exit after the static destructors have run
+    CounterRegistry& registry(){
+        static CounterRegistry* counterRegistry = new CounterRegistry();
+        return *counterRegistry;
+    }
+
+    void addCounters(const StageCounters& from, ITUR_P452::ModelStageStats& stats){
+        for(std::size_t stageInd = 0; stageInd<ITUR_P452::NUM_MODEL_STAGES; stageInd++){
+            stats.stages[stageInd].numCalls += from.numCalls[stageInd].load(std::memory_order_relaxed);
+            stats.stages[stageInd].totalTime_s += from.time_ns[stageInd].load(std::memory_order_relaxed)*1e-9;
+        }
+    }
+
+    void resetCounters(StageCounters& counters){
+        for(std::size_t stageInd = 0; stageInd<ITUR_P452::NUM_MODEL_STAGES; stageInd++){
+            counters.numCalls[stageInd].store(0, std::memory_order_relaxed);
+            counters.time_ns[stageInd].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    //registered on the first recorded stage of a thread, folded into the exited thread counters when the thread exits
+    struct ThreadStageCounters{
+        StageCounters counters;
+
+        ThreadStageCounters(){
+            CounterRegistry& counterRegistry = registry();
+            const std::lock_guard lock(counterRegistry.mutex);
+            counterRegistry.threadCounters.push_back(&counters);
+        }
+
+        ~ThreadStageCounters(){
+            CounterRegistry& counterRegistry = registry();
+            const std::lock_guard lock(counterRegistry.mutex);
+            for(std::size_t stageInd = 0; stageInd<ITUR_P452::NUM_MODEL_STAGES; stageInd++){
+                counterRegistry.exitedThreads.numCalls[stageInd].fetch_add(
+                        counters.numCalls[stageInd].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                counterRegistry.exitedThreads.time_ns[stageInd].fetch_add(
+                        counters.time_ns[stageInd].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            std::erase(counterRegistry.threadCounters, &counters);
+        }
+    };
+}
+
+const char* ITUR_P452::modelStageName(const ModelStage& stage){
+    return STAGE_NAMES.at(static_cast<std::size_t>(stage));
+}
+
+std::string ITUR_P452::ModelStageStats::toJson() const{
+    std::ostringstream json;
+    json << std::setprecision(9);
+    json << "{\"enabled\":" << (isEnabled ? "true" : "false") << ",\"stages\":{";
+    for(std::size_t stageInd = 0; stageInd<NUM_MODEL_STAGES; stageInd++){
+        const StageTiming& timing = stages[stageInd];
+        json << (stageInd>0 ? "," : "") << "\"" << STAGE_NAMES[stageInd] << "\":{\"calls\":" << timing.numCalls
+                << ",\"total_s\":" << timing.totalTime_s << ",\"mean_s\":" << timing.meanTime_s() << "}";
+    }
+    json << "}}";
+    return json.str();
+}
+
+ITUR_P452::ModelStageStats ITUR_P452::collectModelStageStats(){
+    ModelStageStats stats;
+    stats.isEnabled = isStageTimingEnabled();
+    CounterRegistry& counterRegistry = registry();
+    const std::lock_guard lock(counterRegistry.mutex);
+    addCounters(counterRegistry.exitedThreads, stats);
+    for(const StageCounters* counters : counterRegistry.threadCounters){
+        addCounters(*counters, stats);
+    }
+    return stats;
+}
+
+void ITUR_P452::resetModelStageStats(){
+    CounterRegistry& counterRegistry = registry();
+    const std::lock_guard lock(counterRegistry.mutex);
+    resetCounters(counterRegistry.exitedThreads);
+    for(StageCounters* counters : counterRegistry.threadCounters){
+        resetCounters(*counters);
+    }
+}
+
+void ITUR_P452::recordModelStage(const ModelStage& stage, const std::uint64_t& time_ns){
+    thread_local ThreadStageCounters threadCounters;
+    const std::size_t stageInd = static_cast<std::size_t>(stage);
+    threadCounters.counters.numCalls[stageInd].fetch_add(1, std::memory_order_relaxed);
+    threadCounters.counters.time_ns[stageInd].fetch_add(time_ns, std::memory_order_relaxed);
+}
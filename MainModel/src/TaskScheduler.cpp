@@ -0,0 +1,177 @@
+#include "MainModel/TaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace{
+    //chunks [front, back) of one thread. The owner takes chunks from the front, thieves from the back
+    struct alignas(64) ChunkQueue{
+        std::mutex mutex;
+        std::size_t front = 0;
+        std::size_t back = 0;
+    };
+
+    //CPUs the process may run on (its affinity mask, e.g. set by taskset or a cgroup), empty if unknown
+    std::vector<unsigned int> allowedCpus(){
+        std::vector<unsigned int> cpuList;
+#if defined(__linux__)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        if(sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet)==0){
+            for(unsigned int cpuInd = 0; cpuInd<CPU_SETSIZE; cpuInd++){
+                if(CPU_ISSET(cpuInd, &cpuSet)){
+                    cpuList.push_back(cpuInd);
+                }
+            }
+        }
+#endif
+        return cpuList;
+    }
+
+    //best effort, the thread keeps running unpinned if the CPU is not available
+    void pinThreadToCpu(std::thread& thread, const unsigned int& cpuInd){
+#if defined(__linux__)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpuInd, &cpuSet);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#else
+        (void)thread;
+        (void)cpuInd;
+#endif
+    }
+
+    //split the items into contiguous chunks of about targetCost, returns the first item of every chunk plus count
+    std::vector<std::size_t> buildChunks(const std::size_t& count, std::span<const double> costs, const std::size_t& targetChunks){
+        std::vector<std::size_t> chunkStarts{0};
+        if(costs.empty()){
+            const std::size_t chunkSize = std::max<std::size_t>(1, (count+targetChunks-1)/targetChunks);
+            for(std::size_t itemInd = chunkSize; itemInd<count; itemInd+=chunkSize){
+                chunkStarts.push_back(itemInd);
+            }
+        }
+        else{
+            const double totalCost = std::accumulate(costs.begin(), costs.end(), 0.0);
+            const double targetCost = totalCost/targetChunks;
+            double chunkCost = 0.0;
+            for(std::size_t itemInd = 0; itemInd<count; itemInd++){
+                chunkCost += costs[itemInd];
+                if(chunkCost>=targetCost && itemInd+1<count){
+                    chunkStarts.push_back(itemInd+1);
+                    chunkCost = 0.0;
+                }
+            }
+        }
+        chunkStarts.push_back(count);
+        return chunkStarts;
+    }
+}
+
+unsigned int ITUR_P452::resolveThreadCount(const unsigned int& threadCount, const std::size_t& count){
+    const unsigned int requested = (threadCount==0) ? std::max(1u, std::thread::hardware_concurrency()) : threadCount;
+    return static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(requested, count)));
+}
+
+void ITUR_P452::runParallel(const std::size_t& count, std::span<const double> costs, const ItemJob& job,
+        const SchedulerOptions& options){
+    if(!costs.empty() && costs.size()!=count){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: runParallel(): Expected " << count << " item costs, got " << costs.size();
+        throw std::invalid_argument(oStrStream.str());
+    }
+    if(count==0){
+        return;
+    }
+    const unsigned int numThreads = resolveThreadCount(options.threadCount, count);
+    if(numThreads==1){
+        for(std::size_t itemInd = 0; itemInd<count; itemInd++){
+            job(itemInd, 0);
+        }
+        return;
+    }
+
+    const std::vector<std::size_t> chunkStarts = buildChunks(count, costs,
+            static_cast<std::size_t>(numThreads)*std::max<std::size_t>(1, options.chunksPerThread));
+    const std::size_t numChunks = chunkStarts.size()-1;
+
+    //every thread starts with a contiguous block of chunks
+    std::unique_ptr<ChunkQueue[]> queues(new ChunkQueue[numThreads]);
+    for(unsigned int threadInd = 0; threadInd<numThreads; threadInd++){
+        queues[threadInd].front = numChunks*threadInd/numThreads;
+        queues[threadInd].back = numChunks*(threadInd+1)/numThreads;
+    }
+
+    std::atomic<bool> isAborted{false};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto takeChunk = [&](const unsigned int& threadInd, std::size_t& out_chunkInd){
+        {
+            ChunkQueue& ownQueue = queues[threadInd];
+            std::lock_guard<std::mutex> lock(ownQueue.mutex);
+            if(ownQueue.front<ownQueue.back){
+                out_chunkInd = ownQueue.front++;
+                return true;
+            }
+        }
+        for(unsigned int offset = 1; offset<numThreads; offset++){
+            ChunkQueue& victimQueue = queues[(threadInd+offset)%numThreads];
+            std::lock_guard<std::mutex> lock(victimQueue.mutex);
+            if(victimQueue.front<victimQueue.back){
+                out_chunkInd = --victimQueue.back;
+                return true;
+            }
+        }
+        //no chunks are created while running, so an empty round means all work is taken
+        return false;
+    };
+
+    auto worker = [&](const unsigned int threadInd){
+        try{
+            std::size_t chunkInd;
+            while(!isAborted.load(std::memory_order_relaxed) && takeChunk(threadInd, chunkInd)){
+                for(std::size_t itemInd = chunkStarts[chunkInd]; itemInd<chunkStarts[chunkInd+1]; itemInd++){
+                    job(itemInd, threadInd);
+                }
+            }
+        }
+        catch(...){
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if(!firstError){
+                firstError = std::current_exception();
+            }
+            isAborted = true;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads-1);
+    //worker i is pinned to the i-th CPU of the affinity mask, not to CPU i which the process may not be allowed to use
+    const std::vector<unsigned int> cpuList = options.pinThreads ? allowedCpus() : std::vector<unsigned int>();
+    for(unsigned int threadInd = 1; threadInd<numThreads; threadInd++){
+        workers.emplace_back(worker, threadInd);
+        if(!cpuList.empty()){
+            pinThreadToCpu(workers.back(), cpuList[threadInd%cpuList.size()]);
+        }
+    }
+    worker(0);
+    for(auto& thread : workers){
+        thread.join();
+    }
+    if(firstError){
+        std::rethrow_exception(firstError);
+    }
+}
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "MainModel/BoundedQueue.h"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+TEST(BoundedQueueTests, singleThreadTest){
+	ITUR_P452::BoundedQueue<int> queue(3);
+	EXPECT_EQ(3u, queue.capacity());
+	int item = -1;
+	EXPECT_FALSE(queue.tryPop(item));
+	EXPECT_TRUE(queue.tryPush(1));
+	EXPECT_TRUE(queue.tryPush(2));
+	EXPECT_TRUE(queue.push(3));
+	EXPECT_FALSE(queue.tryPush(4));
+	EXPECT_EQ(3u, queue.size());
+
+	//wraps around the ring
+	EXPECT_TRUE(queue.tryPop(item));
+	EXPECT_EQ(1, item);
+	EXPECT_TRUE(queue.tryPush(4));
+	EXPECT_TRUE(queue.pop(item));
+	EXPECT_EQ(2, item);
+
+	//closed queues are drained, then empty
+	queue.close();
+	EXPECT_TRUE(queue.isClosed());
+	EXPECT_FALSE(queue.push(5));
+	EXPECT_TRUE(queue.pop(item));
+	EXPECT_EQ(3, item);
+	EXPECT_TRUE(queue.pop(item));
+	EXPECT_EQ(4, item);
+	EXPECT_FALSE(queue.pop(item));
+	EXPECT_EQ(0u, queue.size());
+
+	EXPECT_THROW(ITUR_P452::BoundedQueue<int>(0), std::invalid_argument);
+
+	//move-only items
+	ITUR_P452::BoundedQueue<std::unique_ptr<int>> pointerQueue(1);
+	EXPECT_TRUE(pointerQueue.push(std::make_unique<int>(7)));
+	std::unique_ptr<int> pointer;
+	EXPECT_TRUE(pointerQueue.pop(pointer));
+	EXPECT_EQ(7, *pointer);
+}
+
+//Every item must arrive once and in order when the producer and the consumer wait on each other
+TEST(BoundedQueueTests, producerConsumerTest){
+	const std::size_t NUM_ITEMS = 200000;
+	ITUR_P452::BoundedQueue<std::size_t> queue(4);
+	std::thread producer([&](){
+		for (std::size_t itemInd = 0; itemInd < NUM_ITEMS; itemInd++) {
+			queue.push(itemInd);
+		}
+		queue.close();
+	});
+
+	std::size_t numReceived = 0;
+	std::size_t numOutOfOrder = 0;
+	std::size_t item;
+	while (queue.pop(item)) {
+		numOutOfOrder += (item==numReceived) ? 0 : 1;
+		numReceived++;
+	}
+	producer.join();
+	EXPECT_EQ(NUM_ITEMS, numReceived);
+	EXPECT_EQ(0u, numOutOfOrder);
+}
+
+//Pushing a move-only item into a full queue must leave the item with the caller until it fits
+TEST(BoundedQueueTests, moveOnlyFullQueueTest){
+	ITUR_P452::BoundedQueue<std::unique_ptr<int>> queue(1);
+	EXPECT_TRUE(queue.tryPush(std::make_unique<int>(1)));
+	auto pointer = std::make_unique<int>(2);
+	EXPECT_FALSE(queue.tryPush(std::move(pointer)));
+	ASSERT_NE(nullptr, pointer);
+	EXPECT_EQ(2, *pointer);
+
+	//the blocking push retries while the consumer drains the queue
+	const int NUM_ITEMS = 20000;
+	std::thread producer([&](){
+		for (int itemInd = 2; itemInd <= NUM_ITEMS; itemInd++) {
+			queue.push(std::make_unique<int>(itemInd));
+		}
+		queue.close();
+	});
+	int numReceived = 0;
+	int numMissing = 0;
+	std::unique_ptr<int> item;
+	while (queue.pop(item)) {
+		numReceived++;
+		numMissing += (item!=nullptr && *item==numReceived) ? 0 : 1;
+	}
+	producer.join();
+	EXPECT_EQ(NUM_ITEMS, numReceived);
+	EXPECT_EQ(0, numMissing);
+}
+
+//close() must wake up a consumer waiting on an empty queue
+TEST(BoundedQueueTests, closeWakesConsumerTest){
+	ITUR_P452::BoundedQueue<int> queue(2);
+	bool hasItem = true;
+	std::thread consumer([&](){
+		int item;
+		hasItem = queue.pop(item);
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	queue.close();
+	consumer.join();
+	EXPECT_FALSE(hasItem);
+}
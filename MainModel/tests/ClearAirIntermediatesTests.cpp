@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "MainModel/Evaluator.h"
+#include "MainModel/P452TotalAttenuation.h"
+
+#include <filesystem>
+#include <set>
+#include <string>
+
+namespace{
+	const double FREQ_GHZ = 2.0;
+	const double P_PERCENT = 10.0;
+	const double HTG_M = 10.0;
+	const double HRG_M = 10.0;
+	const double INPUT_LAT = 40.25;
+	const double TX_GAIN = 10.0;
+	const double RX_GAIN = 22.0;
+	const auto POL = Enumerations::PolarizationType::HorizontalPolarized;
+	const double DIST_COAST = 500.0;
+	const double DN = 50.0;
+	const double N0 = 301.0;
+	const double TEMP_K = 288.15;
+	const double DRY_PRESSURE_HPA = 1013.0;
+	const auto TX_CLUTTER = ClutterModel::ClutterType::NoClutter;
+	const auto RX_CLUTTER = ClutterModel::ClutterType::DenseUrban;
+}
+
+//The intermediates match the separate submodel calls and the total loss of the same evaluation
+TEST(ClearAirIntermediatesTests, matchesSubModelCallsTest){
+	const std::filesystem::path clearAirPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+	const PathProfile::Path path((clearAirPathsFullPath / "test_profile_land_70km.csv").string());
+
+	const auto model = ITUR_P452::TotalClearAirAttenuation(FREQ_GHZ, P_PERCENT, path, HTG_M, HRG_M, INPUT_LAT, TX_GAIN, RX_GAIN,
+			POL, DIST_COAST, DIST_COAST, DN, N0, TEMP_K, DRY_PRESSURE_HPA, TX_CLUTTER, RX_CLUTTER);
+	const ITUR_P452::ClearAirIntermediates values = model.calcIntermediates();
+	EXPECT_DOUBLE_EQ(model.calcTotalClearAirAttenuation(), values.totalLoss_dB);
+
+	const auto clutter = ClutterModel::calculateClutterModel(FREQ_GHZ, path, HTG_M, HRG_M, TX_CLUTTER, RX_CLUTTER);
+	const PathProfile::PathView& modPath = clutter.modifiedPath;
+	const double htx_asl_m = clutter.modifiedHeights_m.first + modPath.front().h_asl_m;
+	const double hrx_asl_m = clutter.modifiedHeights_m.second + modPath.back().h_asl_m;
+	const double effRadius_km = ITUR_P452::Helpers::calcMedianEffectiveRadius_km(DN);
+	const double fracOverSea = path.calcFracOverSea();
+	const double b0_percent = path.calcTimePercentBeta0(INPUT_LAT);
+	const auto horizonVals = ITUR_P452::Helpers::calcHorizonAnglesAndDistances(modPath, htx_asl_m, hrx_asl_m, effRadius_km, FREQ_GHZ);
+	EXPECT_DOUBLE_EQ(modPath.back().d_km, values.d_tot_km);
+	EXPECT_DOUBLE_EQ(htx_asl_m, values.height_tx_asl_m);
+	EXPECT_DOUBLE_EQ(hrx_asl_m, values.height_rx_asl_m);
+	EXPECT_DOUBLE_EQ(fracOverSea, values.fracOverSea);
+	EXPECT_DOUBLE_EQ(b0_percent, values.b0_percent);
+	EXPECT_DOUBLE_EQ(effRadius_km, values.effEarthRadius_med_km);
+	EXPECT_DOUBLE_EQ(horizonVals.first.first, values.horizonAngle_tx_mrad);
+	EXPECT_DOUBLE_EQ(horizonVals.first.second, values.horizonAngle_rx_mrad);
+	EXPECT_DOUBLE_EQ(horizonVals.second.first, values.horizonDist_tx_km);
+	EXPECT_DOUBLE_EQ(horizonVals.second.second, values.horizonDist_rx_km);
+	EXPECT_DOUBLE_EQ(clutter.clutterLoss_dB.first, values.tx_clutterLoss_dB);
+	EXPECT_DOUBLE_EQ(clutter.clutterLoss_dB.second, values.rx_clutterLoss_dB);
+	EXPECT_GT(values.rx_clutterLoss_dB, 0.0);
+
+	double freeSpaceWithGasLoss_dB, basicLoss_p_dB, basicLoss_b0_dB;
+	ITUR_P452::BasicProp(values.d_tot_km, htx_asl_m, hrx_asl_m, FREQ_GHZ, TEMP_K, DRY_PRESSURE_HPA, fracOverSea, P_PERCENT,
+			b0_percent, horizonVals.second).calcTransmissionlosses_dB(freeSpaceWithGasLoss_dB, basicLoss_p_dB, basicLoss_b0_dB);
+	EXPECT_DOUBLE_EQ(freeSpaceWithGasLoss_dB, values.freeSpaceWithGasLoss_dB);
+	EXPECT_DOUBLE_EQ(basicLoss_p_dB, values.basicTransmissionLoss_p_percent_dB);
+	EXPECT_DOUBLE_EQ(basicLoss_b0_dB, values.basicTransmissionLoss_b0_percent_dB);
+
+	double diffLoss_median_dB, diffLoss_p_dB;
+	ITUR_P452::DiffractionLoss(modPath, htx_asl_m, hrx_asl_m, FREQ_GHZ, DN, POL, P_PERCENT, b0_percent, fracOverSea)
+			.calcDiffractionLoss_dB(diffLoss_median_dB, diffLoss_p_dB);
+	EXPECT_DOUBLE_EQ(diffLoss_median_dB, values.diffractionLoss_median_dB);
+	EXPECT_DOUBLE_EQ(diffLoss_p_dB, values.diffractionLoss_p_percent_dB);
+
+	EXPECT_DOUBLE_EQ(ITUR_P452::AnomalousProp(modPath, FREQ_GHZ, htx_asl_m, hrx_asl_m, TEMP_K, DRY_PRESSURE_HPA, DIST_COAST,
+			DIST_COAST, P_PERCENT, b0_percent, effRadius_km, horizonVals, fracOverSea).calcAnomalousPropLoss_dB(),
+			values.anomalousPropagationLoss_dB);
+	EXPECT_DOUBLE_EQ(ITUR_P452::TropoScatter::calcTroposcatterLoss_dB(values.d_tot_km, FREQ_GHZ, htx_asl_m, hrx_asl_m,
+			horizonVals.first, effRadius_km, N0, TX_GAIN, RX_GAIN, TEMP_K, DRY_PRESSURE_HPA, P_PERCENT), values.tropoScatterLoss_dB);
+
+	EXPECT_DOUBLE_EQ(freeSpaceWithGasLoss_dB+diffLoss_median_dB, values.basicWithMedianDiffractionLoss_dB);
+	EXPECT_DOUBLE_EQ(basicLoss_p_dB+diffLoss_p_dB, values.basicWithDiffractionLoss_p_percent_dB);
+	EXPECT_GE(values.pathBlendingInterpolationParameter, 0.0);
+	EXPECT_LE(values.pathBlendingInterpolationParameter, 1.0);
+	EXPECT_GE(values.slopeInterpolationParameter, 0.0);
+	EXPECT_LE(values.slopeInterpolationParameter, 1.0);
+
+	//the evaluator gives the same values without copying the path
+	ITUR_P452::Evaluator evaluator;
+	const ITUR_P452::ClearAirIntermediates evaluatorValues = evaluator.calcIntermediates(FREQ_GHZ, P_PERCENT, path, HTG_M, HRG_M,
+			INPUT_LAT, TX_GAIN, RX_GAIN, POL, DIST_COAST, DIST_COAST, DN, N0, TEMP_K, DRY_PRESSURE_HPA, TX_CLUTTER, RX_CLUTTER);
+	for (const ITUR_P452::ClearAirIntermediateField& field : ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS) {
+		EXPECT_DOUBLE_EQ(values.*field.value, evaluatorValues.*field.value) << field.name;
+	}
+}
+
+//Every field has its own member and a unique name
+TEST(ClearAirIntermediatesTests, fieldTableTest){
+	std::set<std::string> names;
+	ITUR_P452::ClearAirIntermediates values{};
+	double fieldValue = 1.0;
+	for (const ITUR_P452::ClearAirIntermediateField& field : ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS) {
+		EXPECT_TRUE(names.insert(field.name).second) << field.name;
+		values.*field.value = fieldValue++;
+	}
+	fieldValue = 1.0;
+	for (const ITUR_P452::ClearAirIntermediateField& field : ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS) {
+		EXPECT_EQ(fieldValue++, values.*field.value) << field.name;
+	}
+	EXPECT_EQ(28.0, values.totalLoss_dB);
+}
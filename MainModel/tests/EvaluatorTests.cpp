@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "MainModel/Evaluator.h"
+#include "MainModel/P452TotalAttenuation.h"
+#include "MainModel/PathProfile.h"
+#include "TestSupport/AllocationCounter.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+	const std::filesystem::path clearAirPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+
+	struct EvaluatorTestCase{
+		PathProfile::Path path;
+		double freq_GHz;
+		double p_percent;
+		ClutterModel::ClutterType clutterType;
+	};
+
+	//long and short profiles, with and without clutter trimming
+	std::vector<EvaluatorTestCase> buildTestCases(){
+		const std::vector<std::string> PROFILE_NAMES = {"test_profile_mixed_109km.csv", "test_profile_flat_land_5km.csv",
+				"test_profile_land_70km.csv", "test_profile_flat_land_1000km.csv"};
+		std::vector<EvaluatorTestCase> testCases;
+		for (const std::string& profileName : PROFILE_NAMES) {
+			const PathProfile::Path path((clearAirPathsFullPath/std::filesystem::path(profileName)).string());
+			testCases.push_back({path, 2.0, 10.0, ClutterModel::ClutterType::NoClutter});
+			testCases.push_back({path, 0.5, 50.0, ClutterModel::ClutterType::Urban});
+			testCases.push_back({path, 12.0, 1.0, ClutterModel::ClutterType::DeciduousTrees_IrregularlySpaced});
+		}
+		return testCases;
+	}
+
+	double calcModelLoss_dB(const EvaluatorTestCase& testCase){
+		return ITUR_P452::TotalClearAirAttenuation(testCase.freq_GHz, testCase.p_percent, testCase.path, 10, 10, 51, 20, 5,
+				Enumerations::PolarizationType::HorizontalPolarized, 500, 500, 53, 328, 288.15, 1013,
+				testCase.clutterType, testCase.clutterType).calcTotalClearAirAttenuation();
+	}
+
+	double calcEvaluatorLoss_dB(ITUR_P452::Evaluator& evaluator, const EvaluatorTestCase& testCase){
+		return evaluator.calcTotalClearAirAttenuation(testCase.freq_GHz, testCase.p_percent, testCase.path, 10, 10, 51, 20, 5,
+				Enumerations::PolarizationType::HorizontalPolarized, 500, 500, 53, 328, 288.15, 1013,
+				testCase.clutterType, testCase.clutterType);
+	}
+}
+
+TEST(EvaluatorTests, sameResultAsModelTest){
+	const auto TEST_CASES = buildTestCases();
+	ITUR_P452::Evaluator evaluator;
+	//twice, so no result depends on the links evaluated before it
+	for (int round = 0; round < 2; round++) {
+		for (const auto& testCase : TEST_CASES) {
+			EXPECT_EQ(calcModelLoss_dB(testCase), calcEvaluatorLoss_dB(evaluator, testCase));
+		}
+	}
+}
+
+//The model views the caller's path, so evaluations must not allocate, not even the first one
+TEST(EvaluatorTests, zeroSteadyStateAllocationsTest){
+	const auto TEST_CASES = buildTestCases();
+	ITUR_P452::Evaluator evaluator;
+	std::vector<double> lossList_dB(TEST_CASES.size());
+	TestSupport::AllocationCounter counter;
+	for (std::size_t caseInd = 0; caseInd < TEST_CASES.size(); caseInd++) {
+		lossList_dB[caseInd] = calcEvaluatorLoss_dB(evaluator, TEST_CASES[caseInd]);
+	}
+	EXPECT_EQ(0u, counter.stats().numAllocations);
+
+	//the counter sees allocations, the model object allocates its own copy of the path
+	counter.restart();
+	const double MODEL_LOSS_DB = calcModelLoss_dB(TEST_CASES.front());
+	EXPECT_GT(counter.stats().numAllocations, 0u);
+	EXPECT_EQ(MODEL_LOSS_DB, lossList_dB.front());
+}
+
+//Links copied into the scratch input path, as P452::calculateP452Loss_dB does, allocate until the path has room for
+//the longest profile, unless the room is reserved up front
+TEST(EvaluatorTests, inputPathReserveTest){
+	const auto TEST_CASES = buildTestCases();
+	std::size_t maxNumPoints = 0;
+	for (const auto& testCase : TEST_CASES) {
+		maxNumPoints = std::max(maxNumPoints, testCase.path.size());
+	}
+	TestSupport::AllocationCounter counter;
+	ITUR_P452::Evaluator evaluator;
+	evaluator.inputPath().assign(TEST_CASES.front().path.begin(), TEST_CASES.front().path.end());
+	EXPECT_GT(counter.stats().numAllocations, 0u);
+
+	ITUR_P452::Evaluator reservedEvaluator;
+	reservedEvaluator.reserve(maxNumPoints);
+	for (const auto& testCase : TEST_CASES) {
+		counter.restart();
+		reservedEvaluator.inputPath().assign(testCase.path.begin(), testCase.path.end());
+		const double LOSS_DB = reservedEvaluator.calcTotalClearAirAttenuation(testCase.freq_GHz, testCase.p_percent,
+				reservedEvaluator.inputPath(), 10, 10, 51, 20, 5, Enumerations::PolarizationType::HorizontalPolarized, 500, 500,
+				53, 328, 288.15, 1013, testCase.clutterType, testCase.clutterType);
+		EXPECT_EQ(0u, counter.stats().numAllocations);
+		EXPECT_EQ(calcModelLoss_dB(testCase), LOSS_DB);
+	}
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "MainModel/PathProfile.h"
+#include "MainModel/P452TotalAttenuation.h"
+#include "MainModel/TaskScheduler.h"
+
+#include <filesystem>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	const std::filesystem::path clearAirPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+
+	//all inputs are locals, so the returned model must not refer to them
+	ITUR_P452::TotalClearAirAttenuation buildModel(const std::string& profileName, double freq_GHz, double p_percent){
+		const PathProfile::Path path((clearAirPathsFullPath/std::filesystem::path(profileName)).string());
+		const double height_tx_m = 10, height_rx_m = 10;
+		return ITUR_P452::TotalClearAirAttenuation(freq_GHz, p_percent, path, height_tx_m, height_rx_m, (51.2+50.73)/2.0, 20, 5,
+				Enumerations::PolarizationType::HorizontalPolarized, 500, 500, 53, 328, 288.15, 1013,
+				ClutterModel::ClutterType::NoClutter, ClutterModel::ClutterType::NoClutter);
+	}
+}
+
+static_assert(std::is_copy_constructible_v<ITUR_P452::TotalClearAirAttenuation>);
+static_assert(std::is_copy_assignable_v<ITUR_P452::TotalClearAirAttenuation>);
+static_assert(std::is_nothrow_move_constructible_v<ITUR_P452::TotalClearAirAttenuation>);
+static_assert(std::is_copy_assignable_v<ITUR_P452::BasicProp>);
+static_assert(std::is_copy_assignable_v<ITUR_P452::DiffractionLoss>);
+static_assert(std::is_copy_assignable_v<ITUR_P452::AnomalousProp>);
+
+//Models must keep their results after the inputs are gone, and copies must give the same result
+TEST(ModelValueSemanticsTests, outliveInputsTest){
+	const std::vector<double> FREQ_GHZ_LIST = {0.1, 2.0, 12.97463379};
+	for (const double& freq_GHz : FREQ_GHZ_LIST) {
+		const auto MODEL = buildModel("test_profile_mixed_109km.csv", freq_GHz, 10.0);
+		const double EXPECTED_LOSS = MODEL.calcTotalClearAirAttenuation();
+
+		//overwrite the stack used by the inputs of the first model
+		const auto OTHER_MODEL = buildModel("test_profile_land_70km.csv", 2.0*freq_GHz, 40.0);
+		EXPECT_EQ(EXPECTED_LOSS, MODEL.calcTotalClearAirAttenuation());
+
+		auto copiedModel = MODEL;
+		EXPECT_EQ(EXPECTED_LOSS, copiedModel.calcTotalClearAirAttenuation());
+		copiedModel = OTHER_MODEL;
+		EXPECT_EQ(OTHER_MODEL.calcTotalClearAirAttenuation(), copiedModel.calcTotalClearAirAttenuation());
+		const auto MOVED_MODEL = std::move(copiedModel);
+		EXPECT_EQ(OTHER_MODEL.calcTotalClearAirAttenuation(), MOVED_MODEL.calcTotalClearAirAttenuation());
+	}
+}
+
+//Models built once and stored in a cache can be evaluated from many threads at the same time
+TEST(ModelValueSemanticsTests, concurrentEvaluationTest){
+	std::vector<ITUR_P452::TotalClearAirAttenuation> modelCache;
+	std::vector<double> expectedLossList_dB;
+	for (const double& p_percent : {1.0, 10.0, 49.0}) {
+		modelCache.push_back(buildModel("test_profile_mixed_109km.csv", 2.0, p_percent));
+		expectedLossList_dB.push_back(modelCache.back().calcTotalClearAirAttenuation());
+	}
+
+	const std::size_t NUM_EVALUATIONS = 3000;
+	std::vector<double> lossList_dB(NUM_EVALUATIONS);
+	ITUR_P452::runParallel(NUM_EVALUATIONS, {}, [&](const std::size_t& evalInd, const unsigned int&){
+		lossList_dB[evalInd] = modelCache[evalInd%modelCache.size()].calcTotalClearAirAttenuation();
+	}, ITUR_P452::SchedulerOptions{8});
+	for (std::size_t evalInd = 0; evalInd < NUM_EVALUATIONS; evalInd++) {
+		EXPECT_EQ(expectedLossList_dB[evalInd%modelCache.size()], lossList_dB[evalInd]);
+	}
+}
@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include "MainModel/PathProfile.h"
+#include "MainModel/ProfileArchive.h"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace {
+	const std::filesystem::path clearAirPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+	const std::vector<std::string> PROFILE_LIST = {
+		"dbull_path1.csv", "test_profile_flat_land_5km.csv", "test_profile_land_70km.csv", "test_profile_mixed_109km.csv"
+	};
+
+	std::vector<std::string> validationProfilePaths(){
+		std::vector<std::string> pathList;
+		for(const auto& profileName : PROFILE_LIST){
+			pathList.push_back((clearAirPathsFullPath/std::filesystem::path(profileName)).string());
+		}
+		return pathList;
+	}
+
+	std::string tempArchivePath(const std::string& fileName){
+		return (std::filesystem::temp_directory_path()/fileName).string();
+	}
+
+	//byte positions of header fields (see ArchiveHeader in ProfileArchive.cpp)
+	constexpr std::streamoff NUM_PROFILES_POSITION = 16;
+	constexpr std::streamoff INDEX_OFFSET_POSITION = 48;
+
+	uint64_t readWord(const std::string& filePath, const std::streamoff& position){
+		std::ifstream file(filePath, std::ios::binary);
+		uint64_t value = 0;
+		file.seekg(position);
+		file.read(reinterpret_cast<char*>(&value), sizeof(value));
+		return value;
+	}
+
+	void writeWord(const std::string& filePath, const std::streamoff& position, const uint64_t& value){
+		std::fstream file(filePath, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(position);
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+}
+
+//Float64 archives must reproduce the csv profiles exactly
+TEST(ProfileArchiveTests, float64RoundTripTest){
+	const std::string ARCHIVE_PATH = tempArchivePath("p452_float64_archive_test.bin");
+	const auto CSV_PATH_LIST = validationProfilePaths();
+	EXPECT_EQ(PROFILE_LIST.size(), PathProfile::convertCsvToProfileArchive(CSV_PATH_LIST, ARCHIVE_PATH));
+
+	const PathProfile::ProfileArchive ARCHIVE(ARCHIVE_PATH);
+	ASSERT_EQ(PROFILE_LIST.size(), ARCHIVE.size());
+	EXPECT_EQ(PathProfile::HeightEncoding::Float64, ARCHIVE.heightEncoding());
+
+	std::size_t totalPoints = 0;
+	PathProfile::Path decoded;
+	for (std::size_t profileInd = 0; profileInd < CSV_PATH_LIST.size(); profileInd++) {
+		const PathProfile::Path PROFILE(CSV_PATH_LIST[profileInd]);
+		const auto VIEW = ARCHIVE.at(profileInd);
+		ARCHIVE[profileInd].copyTo(decoded);
+		ASSERT_EQ(PROFILE.size(), VIEW.size());
+		ASSERT_EQ(PROFILE.size(), decoded.size());
+		for (std::size_t pointInd = 0; pointInd < PROFILE.size(); pointInd++) {
+			EXPECT_EQ(PROFILE[pointInd].d_km, VIEW.d_km(pointInd));
+			EXPECT_EQ(PROFILE[pointInd].h_asl_m, VIEW.h_asl_m(pointInd));
+			EXPECT_EQ(PROFILE[pointInd].zone, VIEW.zone(pointInd));
+			EXPECT_EQ(PROFILE[pointInd].h_asl_m, decoded[pointInd].h_asl_m);
+		}
+		totalPoints += PROFILE.size();
+	}
+	EXPECT_EQ(totalPoints, ARCHIVE.numPoints());
+	EXPECT_THROW(ARCHIVE.at(PROFILE_LIST.size()), std::out_of_range);
+	std::filesystem::remove(ARCHIVE_PATH);
+}
+
+//Int16 heights are quantized to the height scale
+TEST(ProfileArchiveTests, int16HeightsTest){
+	const std::string ARCHIVE_PATH = tempArchivePath("p452_int16_archive_test.bin");
+	const double HEIGHT_SCALE_M = 0.1;
+	const auto CSV_PATH_LIST = validationProfilePaths();
+	PathProfile::convertCsvToProfileArchive(CSV_PATH_LIST, ARCHIVE_PATH, PathProfile::HeightEncoding::Int16, HEIGHT_SCALE_M);
+
+	const PathProfile::ProfileArchive ARCHIVE(ARCHIVE_PATH);
+	ASSERT_EQ(PROFILE_LIST.size(), ARCHIVE.size());
+	EXPECT_EQ(PathProfile::HeightEncoding::Int16, ARCHIVE.heightEncoding());
+	for (std::size_t profileInd = 0; profileInd < CSV_PATH_LIST.size(); profileInd++) {
+		const PathProfile::Path PROFILE(CSV_PATH_LIST[profileInd]);
+		const PathProfile::Path DECODED = ARCHIVE[profileInd].toPath();
+		ASSERT_EQ(PROFILE.size(), DECODED.size());
+		for (std::size_t pointInd = 0; pointInd < PROFILE.size(); pointInd++) {
+			EXPECT_EQ(PROFILE[pointInd].d_km, DECODED[pointInd].d_km);
+			EXPECT_NEAR(PROFILE[pointInd].h_asl_m, DECODED[pointInd].h_asl_m, HEIGHT_SCALE_M/2.0+1.0e-9);
+			EXPECT_EQ(PROFILE[pointInd].zone, DECODED[pointInd].zone);
+		}
+	}
+	std::filesystem::remove(ARCHIVE_PATH);
+
+	//heights that do not fit in int16 at this scale are rejected
+	PathProfile::Path tallProfile;
+	tallProfile.push_back(PathProfile::ProfilePoint(0.0, 4000.0));
+	PathProfile::ProfileArchiveWriter writer(ARCHIVE_PATH, PathProfile::HeightEncoding::Int16, HEIGHT_SCALE_M);
+	EXPECT_THROW(writer.append(tallProfile), std::out_of_range);
+}
+
+TEST(ProfileArchiveTests, emptyProfileAndInvalidFileTest){
+	const std::string ARCHIVE_PATH = tempArchivePath("p452_empty_profile_archive_test.bin");
+	PathProfile::Path profile;
+	profile.push_back(PathProfile::ProfilePoint(0.0, 10.0, PathProfile::ZoneType::Sea));
+	profile.push_back(PathProfile::ProfilePoint(1.0, 11.0, PathProfile::ZoneType::Sea));
+
+	PathProfile::ProfileArchiveWriter writer(ARCHIVE_PATH);
+	writer.append(profile);
+	writer.append(PathProfile::Path());
+	writer.append(profile);
+	writer.finish();
+
+	const PathProfile::ProfileArchive ARCHIVE(ARCHIVE_PATH);
+	ASSERT_EQ(3u, ARCHIVE.size());
+	EXPECT_EQ(2u, ARCHIVE[0].size());
+	EXPECT_TRUE(ARCHIVE[1].empty());
+	EXPECT_EQ(PathProfile::ZoneType::Sea, ARCHIVE[2][1].zone);
+	EXPECT_DOUBLE_EQ(11.0, ARCHIVE[2][1].h_asl_m);
+
+	//truncated archive
+	std::filesystem::resize_file(ARCHIVE_PATH, std::filesystem::file_size(ARCHIVE_PATH)-8);
+	EXPECT_THROW(PathProfile::ProfileArchive{ARCHIVE_PATH}, std::runtime_error);
+	std::filesystem::remove(ARCHIVE_PATH);
+
+	//csv file is not an archive
+	EXPECT_THROW(PathProfile::ProfileArchive{validationProfilePaths().front()}, std::runtime_error);
+}
+
+//Corrupt headers and index entries must be rejected when the archive is opened
+TEST(ProfileArchiveTests, corruptIndexTest){
+	const std::string ARCHIVE_PATH = tempArchivePath("p452_corrupt_index_archive_test.bin");
+	const auto writeArchive = [&ARCHIVE_PATH](){
+		PathProfile::Path profile;
+		profile.push_back(PathProfile::ProfilePoint(0.0, 10.0, PathProfile::ZoneType::Inland));
+		profile.push_back(PathProfile::ProfilePoint(1.0, 11.0, PathProfile::ZoneType::Inland));
+		PathProfile::ProfileArchiveWriter writer(ARCHIVE_PATH);
+		writer.append(profile);
+		writer.append(profile);
+		writer.append(profile);
+		writer.finish();
+	};
+
+	//offset of the second profile beyond the number of points
+	writeArchive();
+	const uint64_t INDEX_OFFSET = readWord(ARCHIVE_PATH, INDEX_OFFSET_POSITION);
+	EXPECT_NO_THROW(PathProfile::ProfileArchive{ARCHIVE_PATH});
+	writeWord(ARCHIVE_PATH, INDEX_OFFSET+2*sizeof(uint64_t), 1000);
+	EXPECT_THROW(PathProfile::ProfileArchive{ARCHIVE_PATH}, std::runtime_error);
+
+	//decreasing offsets
+	writeArchive();
+	writeWord(ARCHIVE_PATH, INDEX_OFFSET+sizeof(uint64_t), 5);
+	EXPECT_THROW(PathProfile::ProfileArchive{ARCHIVE_PATH}, std::runtime_error);
+
+	//the index size (numProfiles+1)*8 overflows to 0
+	writeArchive();
+	writeWord(ARCHIVE_PATH, NUM_PROFILES_POSITION, (uint64_t(1)<<61)-1);
+	EXPECT_THROW(PathProfile::ProfileArchive{ARCHIVE_PATH}, std::runtime_error);
+	writeWord(ARCHIVE_PATH, NUM_PROFILES_POSITION, std::numeric_limits<uint64_t>::max());
+	EXPECT_THROW(PathProfile::ProfileArchive{ARCHIVE_PATH}, std::runtime_error);
+
+	std::filesystem::remove(ARCHIVE_PATH);
+}
@@ -0,0 +1,171 @@
+#include "gtest/gtest.h"
+#include "MainModel/PathProfile.h"
+#include "MainModel/ProfileCsvReader.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+	// Use when expected an exact match
+	double constexpr TOLERANCE = 1.0e-9;
+	const std::filesystem::path clearAirPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+
+	//write a temporary csv file and return its path
+	std::string writeTempCsv(const std::string& fileName, const std::string& contents){
+		const std::filesystem::path filePath = std::filesystem::temp_directory_path()/fileName;
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		file << contents;
+		return filePath.string();
+	}
+}
+
+//The reader should give the same profile as the Path constructor for every validation profile
+TEST(ProfileCsvReaderTests, readValidationProfilesTest){
+	const std::vector<std::string> PROFILE_LIST = {
+		"dbull_path1.csv", "test_profile_flat_land_5km.csv", "test_profile_land_70km.csv", "test_profile_mixed_109km.csv"
+	};
+	const std::vector<std::size_t> EXPECTED_LENGTH_LIST = {
+		1663, 501, 2002, 110
+	};
+	for (uint16_t profileInd = 0; profileInd < PROFILE_LIST.size(); profileInd++) {
+		const std::string FILE_PATH = (clearAirPathsFullPath/std::filesystem::path(PROFILE_LIST[profileInd])).string();
+		PathProfile::ProfileCsvReader reader(FILE_PATH);
+		const auto PROFILES = reader.readAll();
+		ASSERT_EQ(1u, PROFILES.size());
+		EXPECT_EQ(EXPECTED_LENGTH_LIST[profileInd], PROFILES.front().size());
+
+		const PathProfile::Path PROFILE(FILE_PATH);
+		ASSERT_EQ(PROFILE.size(), PROFILES.front().size());
+		for (std::size_t pointInd = 0; pointInd < PROFILE.size(); pointInd++) {
+			EXPECT_EQ(PROFILE[pointInd].d_km, PROFILES.front()[pointInd].d_km);
+			EXPECT_EQ(PROFILE[pointInd].h_asl_m, PROFILES.front()[pointInd].h_asl_m);
+			EXPECT_EQ(PROFILE[pointInd].zone, PROFILES.front()[pointInd].zone);
+		}
+	}
+}
+
+//Profiles are separated by blank lines, a new header may follow the blank line
+TEST(ProfileCsvReaderTests, readMultipleProfilesTest){
+	const std::string FILE_PATH = writeTempCsv("p452_multi_profile_test.csv",
+		"d (km),h(m),zone label,zone\r\n"
+		"0,10,A2,2\r\n"
+		"1,20,A2,2\r\n"
+		"\r\n"
+		"0,5,B,3\r\n"
+		"2,6,B,3\r\n"
+		"4,+7,A1,1\r\n"
+		"\n"
+		"Distance (km),DEM Height (m AMSL)\n"
+		"0,100\n"
+		"0.5,101.5\n");
+
+	PathProfile::ProfileCsvReader reader(FILE_PATH);
+	const auto PROFILES = reader.readAll();
+	std::filesystem::remove(FILE_PATH);
+
+	ASSERT_EQ(3u, PROFILES.size());
+	ASSERT_EQ(2u, PROFILES[0].size());
+	EXPECT_NEAR(20.0, PROFILES[0].back().h_asl_m, TOLERANCE);
+	EXPECT_EQ(PathProfile::ZoneType::Inland, PROFILES[0].back().zone);
+
+	ASSERT_EQ(3u, PROFILES[1].size());
+	EXPECT_NEAR(4.0, PROFILES[1].back().d_km, TOLERANCE);
+	EXPECT_NEAR(7.0, PROFILES[1].back().h_asl_m, TOLERANCE);
+	EXPECT_EQ(PathProfile::ZoneType::Sea, PROFILES[1].front().zone);
+	EXPECT_EQ(PathProfile::ZoneType::CoastalLand, PROFILES[1].back().zone);
+
+	//no zone column
+	ASSERT_EQ(2u, PROFILES[2].size());
+	EXPECT_NEAR(101.5, PROFILES[2].back().h_asl_m, TOLERANCE);
+	EXPECT_EQ(0, static_cast<int>(PROFILES[2].back().zone));
+}
+
+TEST(ProfileCsvReaderTests, headerColumnMappingTest){
+	const std::string FILE_PATH = writeTempCsv("p452_column_mapping_test.csv",
+		"zone,height,id,distance\n"
+		"3, 12.5 ,a,0\n"
+		"2,13.5,b,0.25\n");
+
+	PathProfile::ProfileCsvReader reader(FILE_PATH, PathProfile::CsvColumnMapping{"distance","height","zone"});
+	PathProfile::Path profile, emptyProfile;
+	ASSERT_TRUE(reader.readNext(profile));
+	EXPECT_FALSE(reader.readNext(emptyProfile));
+	std::filesystem::remove(FILE_PATH);
+
+	ASSERT_EQ(2u, profile.size());
+	EXPECT_NEAR(0.25, profile.back().d_km, TOLERANCE);
+	EXPECT_NEAR(12.5, profile.front().h_asl_m, TOLERANCE);
+	EXPECT_EQ(PathProfile::ZoneType::Sea, profile.front().zone);
+	EXPECT_EQ(PathProfile::ZoneType::Inland, profile.back().zone);
+}
+
+//Parse errors should report the file and line number
+TEST(ProfileCsvReaderTests, parseErrorTest){
+	const std::string FILE_PATH = writeTempCsv("p452_parse_error_test.csv",
+		"d (km),h(m)\n"
+		"0,10\n"
+		"1,1O\n");
+	PathProfile::ProfileCsvReader reader(FILE_PATH);
+	PathProfile::Path profile;
+	try{
+		reader.readNext(profile);
+		FAIL() << "expected a parse error";
+	}
+	catch(const std::runtime_error& err){
+		EXPECT_NE(std::string(err.what()).find("p452_parse_error_test.csv:3:"), std::string::npos) << err.what();
+	}
+
+	//a bad distance is not taken for a header in the middle of a profile
+	const std::string BAD_DISTANCE_FILE_PATH = writeTempCsv("p452_bad_distance_test.csv",
+		"d (km),h(m),zone label,zone\n"
+		"0,10,A2,2\n"
+		"1,11,A2,2\n"
+		"2x,12,A,2\n"
+		"3,13,A2,2\n");
+	PathProfile::ProfileCsvReader badDistanceReader(BAD_DISTANCE_FILE_PATH);
+	try{
+		badDistanceReader.readAll();
+		FAIL() << "expected a parse error";
+	}
+	catch(const std::runtime_error& err){
+		EXPECT_NE(std::string(err.what()).find("p452_bad_distance_test.csv:4: invalid distance value \"2x\""), std::string::npos)
+				<< err.what();
+	}
+	std::filesystem::remove(BAD_DISTANCE_FILE_PATH);
+
+	//nor at the start of a profile, where a header must have no numeric field and name the mapped columns
+	const std::string BAD_FIRST_DISTANCE_FILE_PATH = writeTempCsv("p452_bad_first_distance_test.csv",
+		"d (km),h(m),zone label,zone\n"
+		"0,10,A2,2\n"
+		"1,11,A2,2\n"
+		"\n"
+		"2x,12.5,A,2\n"
+		"3,13,A2,2\n");
+	PathProfile::ProfileCsvReader badFirstDistanceReader(BAD_FIRST_DISTANCE_FILE_PATH);
+	ASSERT_TRUE(badFirstDistanceReader.readNext(profile));
+	EXPECT_EQ(2u, profile.size());
+	try{
+		badFirstDistanceReader.readNext(profile);
+		FAIL() << "expected a parse error";
+	}
+	catch(const std::runtime_error& err){
+		EXPECT_NE(std::string(err.what()).find("p452_bad_first_distance_test.csv:5: invalid distance value \"2x\""), std::string::npos)
+				<< err.what();
+	}
+	PathProfile::ProfileCsvReader unmappedHeaderReader(BAD_FIRST_DISTANCE_FILE_PATH, PathProfile::CsvColumnMapping{"distance","",""});
+	try{
+		unmappedHeaderReader.readNext(profile);
+		FAIL() << "expected a parse error";
+	}
+	catch(const std::runtime_error& err){
+		EXPECT_NE(std::string(err.what()).find("p452_bad_first_distance_test.csv:1: invalid distance value \"d (km)\""), std::string::npos)
+				<< err.what();
+	}
+	std::filesystem::remove(BAD_FIRST_DISTANCE_FILE_PATH);
+
+	PathProfile::ProfileCsvReader missingColumnReader(FILE_PATH, PathProfile::CsvColumnMapping{"distance","h(m)",""});
+	EXPECT_THROW(missingColumnReader.readNext(profile), std::runtime_error);
+	std::filesystem::remove(FILE_PATH);
+
+	EXPECT_THROW(PathProfile::ProfileCsvReader("p452_file_that_does_not_exist.csv"), std::runtime_error);
+}
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+#include "MainModel/PathProfile.h"
+#include "MainModel/ProfileDecimation.h"
+#include "MainModel/Helpers.h"
+#include "MainModel/P452TotalAttenuation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+	// Use when expected an exact match
+	double constexpr TOLERANCE_STRICT = 1.0e-6;
+	const std::filesystem::path clearAirPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+
+	PathProfile::Path loadProfile(const std::string& profileName){
+		return PathProfile::Path((clearAirPathsFullPath/std::filesystem::path(profileName)).string());
+	}
+
+	//height of the decimated profile at a distance (linear interpolation)
+	double interpolateHeight_m(const PathProfile::Path& path, const double& d_km){
+		const auto it = std::lower_bound(path.cbegin(), path.cend(), d_km,
+				[](const PathProfile::ProfilePoint& point, const double& distance_km){return point.d_km<distance_km;});
+		if(it==path.cbegin()){
+			return it->h_asl_m;
+		}
+		const auto prev = it-1;
+		return prev->h_asl_m+(it->h_asl_m-prev->h_asl_m)*(d_km-prev->d_km)/(it->d_km-prev->d_km);
+	}
+
+	//validation path parameters (see the no_clutter_profile_tests test classes)
+	struct ValidationCase{
+		std::string profileName;
+		double centerLatitude_deg;
+		double txGain_dBi;
+		double rxGain_dBi;
+		double deltaN;
+		double surfaceRefractivity;
+		Enumerations::PolarizationType pol;
+	};
+	const std::vector<ValidationCase> VALIDATION_CASE_LIST = {
+		{"test_profile_flat_land_1000km.csv", (51.2+50.73)/2.0, 20, 5, 53, 328, Enumerations::PolarizationType::VerticalPolarized},
+		{"test_profile_mixed_109km.csv", (51.2+50.73)/2.0, 20, 5, 53, 328, Enumerations::PolarizationType::HorizontalPolarized},
+		{"test_profile_land_70km.csv", (40.5+40.0)/2.0, 10, 22, 50, 301, Enumerations::PolarizationType::HorizontalPolarized},
+	};
+
+	double calcLoss_dB(const ValidationCase& testCase, const PathProfile::Path& path, const double& freq_GHz, const double& p_percent){
+		const auto p452Model = ITUR_P452::TotalClearAirAttenuation(freq_GHz, p_percent, path, 10, 10, testCase.centerLatitude_deg,
+				testCase.txGain_dBi, testCase.rxGain_dBi, testCase.pol, 500, 500, testCase.deltaN, testCase.surfaceRefractivity,
+				288.15, 1013, ClutterModel::ClutterType::NoClutter, ClutterModel::ClutterType::NoClutter);
+		return p452Model.calcTotalClearAirAttenuation();
+	}
+}
+
+//Removed points must be within the height tolerance and the zone dependent parameters must not change
+TEST(ProfileDecimationTests, errorBoundTest){
+	const std::vector<std::string> PROFILE_LIST = {
+		"dbull_path1.csv", "dbull_path2.csv", "test_profile_land_70km.csv", "test_profile_mixed_109km.csv",
+		"test_profile_flat_land_1000km.csv"
+	};
+	const std::vector<double> HEIGHT_TOLERANCE_LIST_M = {0.0, 1.0, 5.0};
+	for (const auto& profileName : PROFILE_LIST) {
+		const PathProfile::Path PROFILE = loadProfile(profileName);
+		for (const double& heightTolerance_m : HEIGHT_TOLERANCE_LIST_M) {
+			PathProfile::ProfileDecimationOptions options;
+			options.heightTolerance_m = heightTolerance_m;
+			const PathProfile::Path DECIMATED = PathProfile::decimateProfile(PROFILE, options);
+			ASSERT_LE(DECIMATED.size(), PROFILE.size());
+			EXPECT_EQ(PROFILE.front().d_km, DECIMATED.front().d_km);
+			EXPECT_EQ(PROFILE.back().d_km, DECIMATED.back().d_km);
+			for (const auto& point : PROFILE) {
+				EXPECT_NEAR(point.h_asl_m, interpolateHeight_m(DECIMATED, point.d_km), heightTolerance_m+TOLERANCE_STRICT)
+						<< profileName << " at " << point.d_km << " km";
+			}
+			EXPECT_NEAR(PROFILE.calcFracOverSea(), DECIMATED.calcFracOverSea(), TOLERANCE_STRICT);
+			EXPECT_NEAR(PROFILE.calcTimePercentBeta0(45.0), DECIMATED.calcTimePercentBeta0(45.0), TOLERANCE_STRICT);
+			EXPECT_NEAR(PROFILE.calcLongestContiguousInlandDistance_km(), DECIMATED.calcLongestContiguousInlandDistance_km(),
+					TOLERANCE_STRICT);
+
+			//the horizons are exact for the effective Earth radii given in the options
+			const double TX_HEIGHT_ASL_M = PROFILE.front().h_asl_m+options.txHeight_m;
+			const double RX_HEIGHT_ASL_M = PROFILE.back().h_asl_m+options.rxHeight_m;
+			const auto EXPECTED_HORIZON = ITUR_P452::Helpers::calcHorizonAnglesAndDistances(PROFILE, TX_HEIGHT_ASL_M,
+					RX_HEIGHT_ASL_M, options.effectiveRadiusList_km.front(), options.freq_GHz);
+			const auto HORIZON = ITUR_P452::Helpers::calcHorizonAnglesAndDistances(DECIMATED, TX_HEIGHT_ASL_M,
+					RX_HEIGHT_ASL_M, options.effectiveRadiusList_km.front(), options.freq_GHz);
+			EXPECT_NEAR(EXPECTED_HORIZON.first.first, HORIZON.first.first, TOLERANCE_STRICT);
+			EXPECT_NEAR(EXPECTED_HORIZON.first.second, HORIZON.first.second, TOLERANCE_STRICT);
+			EXPECT_NEAR(EXPECTED_HORIZON.second.first, HORIZON.second.first, TOLERANCE_STRICT);
+			EXPECT_NEAR(EXPECTED_HORIZON.second.second, HORIZON.second.second, TOLERANCE_STRICT);
+		}
+	}
+
+	EXPECT_THROW(PathProfile::decimateProfile(loadProfile("dbull_path1.csv"), PathProfile::ProfileDecimationOptions{-1.0}),
+			std::domain_error);
+}
+
+//The clutter model moves a terminal to the first point beyond its clutter distance, that point must be kept on coarse profiles
+TEST(ProfileDecimationTests, clutterTerminalPointTest){
+	const PathProfile::Path PROFILE = loadProfile("test_profile_flat_land_1000km.csv");
+	PathProfile::ProfileDecimationOptions options;
+	options.heightTolerance_m = 5.0;
+	ASSERT_GT(PROFILE[1].d_km, options.terminalDistance_km);
+	const PathProfile::Path DECIMATED = PathProfile::decimateProfile(PROFILE, options);
+	ASSERT_GE(DECIMATED.size(), static_cast<std::size_t>(4));
+	EXPECT_EQ(PROFILE[1].d_km, DECIMATED[1].d_km);
+	EXPECT_EQ(PROFILE[PROFILE.size()-2].d_km, DECIMATED[DECIMATED.size()-2].d_km);
+
+	for (const auto clutterType : {ClutterModel::ClutterType::VillageCentre, ClutterModel::ClutterType::Urban}) {
+		const auto EXPECTED = ITUR_P452::TotalClearAirAttenuation(2.0, 10, PROFILE, 10, 10, 51, 20, 5,
+				Enumerations::PolarizationType::VerticalPolarized, 500, 500, 53, 328, 288.15, 1013, clutterType, clutterType);
+		const auto RESULT = ITUR_P452::TotalClearAirAttenuation(2.0, 10, DECIMATED, 10, 10, 51, 20, 5,
+				Enumerations::PolarizationType::VerticalPolarized, 500, 500, 53, 328, 288.15, 1013, clutterType, clutterType);
+		EXPECT_NEAR(EXPECTED.calcTotalClearAirAttenuation(), RESULT.calcTotalClearAirAttenuation(), 0.05) << clutterType;
+	}
+}
+
+//Report of the loss change caused by decimation on the validation paths
+TEST(ProfileDecimationTests, lossChangeTest){
+	const std::vector<double> FREQ_GHZ_LIST = {0.1, 0.5, 2, 8.649755859, 29.19292603};
+	const std::vector<double> P_LIST = {1, 10, 49};
+	//maximum loss change (dB) allowed for each validation case with a 1 m height tolerance
+	const std::vector<double> MAX_LOSS_CHANGE_DB = {0.05, 0.05, 0.05};
+
+	for (std::size_t caseInd = 0; caseInd < VALIDATION_CASE_LIST.size(); caseInd++) {
+		const auto& testCase = VALIDATION_CASE_LIST[caseInd];
+		const PathProfile::Path PROFILE = loadProfile(testCase.profileName);
+		PathProfile::ProfileDecimationOptions options;
+		options.heightTolerance_m = 1.0;
+		options.effectiveRadiusList_km.push_back(ITUR_P452::Helpers::calcMedianEffectiveRadius_km(testCase.deltaN));
+		const PathProfile::Path DECIMATED = PathProfile::decimateProfile(PROFILE, options);
+
+		double maxLossChange_dB = 0.0;
+		for (const double& freq_GHz : FREQ_GHZ_LIST) {
+			for (const double& p_percent : P_LIST) {
+				const double LOSS_CHANGE_DB = calcLoss_dB(testCase, DECIMATED, freq_GHz, p_percent)
+						-calcLoss_dB(testCase, PROFILE, freq_GHz, p_percent);
+				maxLossChange_dB = std::max(maxLossChange_dB, std::abs(LOSS_CHANGE_DB));
+			}
+		}
+		std::cout << testCase.profileName << ": " << PROFILE.size() << " -> " << DECIMATED.size()
+				<< " points, max loss change " << maxLossChange_dB << " dB" << std::endl;
+		EXPECT_LT(maxLossChange_dB, MAX_LOSS_CHANGE_DB[caseInd]) << testCase.profileName;
+	}
+}
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "MainModel/P452TotalAttenuation.h"
+#include "MainModel/StageTiming.h"
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace{
+	double calcLoss(const PathProfile::Path& path){
+		return ITUR_P452::TotalClearAirAttenuation(2.0, 10.0, path, 10.0, 10.0, 40.25, 10.0, 22.0,
+				Enumerations::PolarizationType::HorizontalPolarized, 500.0, 500.0, 50.0, 301.0, 288.15, 1013.0,
+				ClutterModel::ClutterType::NoClutter, ClutterModel::ClutterType::NoClutter).calcTotalClearAirAttenuation();
+	}
+}
+
+//Every stage is counted once per evaluation, on every thread, including threads that have exited
+TEST(StageTimingTests, countsEveryStageOnEveryThreadTest){
+	if (!ITUR_P452::isStageTimingEnabled()) {
+		GTEST_SKIP() << "built without P452_STAGE_TIMING";
+	}
+	const std::filesystem::path clearAirPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+	const PathProfile::Path path((clearAirPathsFullPath / "test_profile_land_70km.csv").string());
+	const std::size_t NUM_THREADS = 4;
+	const std::size_t LINKS_PER_THREAD = 3;
+
+	ITUR_P452::resetModelStageStats();
+	calcLoss(path);
+	std::vector<std::thread> threads;
+	for (std::size_t threadInd = 0; threadInd < NUM_THREADS; threadInd++) {
+		threads.emplace_back([&](){
+			for (std::size_t linkInd = 0; linkInd < LINKS_PER_THREAD; linkInd++) {
+				calcLoss(path);
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	const ITUR_P452::ModelStageStats stats = ITUR_P452::collectModelStageStats();
+	EXPECT_TRUE(stats.isEnabled);
+	double stageTimeSum_s = 0;
+	for (std::size_t stageInd = 0; stageInd < ITUR_P452::NUM_MODEL_STAGES; stageInd++) {
+		EXPECT_EQ(1+NUM_THREADS*LINKS_PER_THREAD, stats.stages[stageInd].numCalls) << stageInd;
+		EXPECT_GE(stats.stages[stageInd].totalTime_s, 0.0);
+		stageTimeSum_s += stats.stages[stageInd].totalTime_s;
+	}
+	//the profile dependent stages take some time on a 2000 point profile
+	EXPECT_GT(stats[ITUR_P452::ModelStage::Diffraction].totalTime_s, 0.0);
+	EXPECT_GT(stageTimeSum_s, 0.0);
+
+	const std::string json = stats.toJson();
+	EXPECT_NE(std::string::npos, json.find("\"enabled\":true"));
+	EXPECT_NE(std::string::npos, json.find("\"diffraction\":{\"calls\":13,"));
+	EXPECT_NE(std::string::npos, json.find("\"troposcatter\":{\"calls\":13,"));
+
+	ITUR_P452::resetModelStageStats();
+	calcLoss(path);
+	EXPECT_EQ(1u, ITUR_P452::collectModelStageStats()[ITUR_P452::ModelStage::ClutterModel].numCalls);
+}
+
+//Without P452_STAGE_TIMING nothing is recorded
+TEST(StageTimingTests, disabledRecordsNothingTest){
+	if (ITUR_P452::isStageTimingEnabled()) {
+		GTEST_SKIP() << "built with P452_STAGE_TIMING";
+	}
+	const std::filesystem::path clearAirPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+	calcLoss(PathProfile::Path((clearAirPathsFullPath / "test_profile_mixed_109km.csv").string()));
+
+	const ITUR_P452::ModelStageStats stats = ITUR_P452::collectModelStageStats();
+	EXPECT_FALSE(stats.isEnabled);
+	for (const ITUR_P452::StageTiming& timing : stats.stages) {
+		EXPECT_EQ(0u, timing.numCalls);
+		EXPECT_EQ(0.0, timing.totalTime_s);
+	}
+	EXPECT_EQ(0, stats.toJson().rfind("{\"enabled\":false,\"stages\":{\"effectiveRadius\":{\"calls\":0,", 0));
+}
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include "MainModel/TaskScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+//Every item must be run exactly once, with a valid thread index, for any thread count and cost distribution
+TEST(TaskSchedulerTests, runsEveryItemOnceTest){
+	const std::size_t COUNT = 1000;
+	std::vector<double> costs(COUNT);
+	for (std::size_t itemInd = 0; itemInd < COUNT; itemInd++) {
+		//5 km and 1000 km profiles mixed
+		costs[itemInd] = (itemInd%10==0) ? 10000.0 : 50.0;
+	}
+	const std::vector<unsigned int> THREAD_COUNT_LIST = {0, 1, 3, 8, 2000};
+	for (const unsigned int& threadCount : THREAD_COUNT_LIST) {
+		for (const bool& useCosts : {false, true}) {
+			std::vector<std::atomic<int>> runCounts(COUNT);
+			std::vector<double> results(COUNT, 0.0);
+			const unsigned int NUM_THREADS = ITUR_P452::resolveThreadCount(threadCount, COUNT);
+			ITUR_P452::runParallel(COUNT, useCosts ? std::span<const double>(costs) : std::span<const double>(),
+					[&](const std::size_t& itemInd, const unsigned int& threadInd){
+				EXPECT_LT(threadInd, NUM_THREADS);
+				runCounts[itemInd]++;
+				results[itemInd] = 2.0*itemInd;
+			}, ITUR_P452::SchedulerOptions{threadCount, threadCount==3});
+			for (std::size_t itemInd = 0; itemInd < COUNT; itemInd++) {
+				EXPECT_EQ(1, runCounts[itemInd].load()) << itemInd;
+				EXPECT_EQ(2.0*itemInd, results[itemInd]);
+			}
+		}
+	}
+	EXPECT_EQ(1u, ITUR_P452::resolveThreadCount(8, 1));
+	EXPECT_EQ(1u, ITUR_P452::resolveThreadCount(8, 0));
+	EXPECT_EQ(4u, ITUR_P452::resolveThreadCount(4, 100));
+}
+
+//Idle threads should steal the chunks at the end of another thread's block
+TEST(TaskSchedulerTests, workStealingTest){
+	const std::size_t COUNT = 64;
+	const unsigned int NUM_THREADS = 4;
+	//one item per chunk, every thread starts with a block of 16 items. The thread running item 0 waits until every other
+	//item is done, so the rest of thread 0's block can only be run by thieves (no timing involved)
+	std::vector<unsigned int> executingThread(COUNT);
+	std::mutex mutex;
+	std::condition_variable itemDone;
+	std::size_t numDone = 0;
+	bool isTimedOut = false;
+	ITUR_P452::runParallel(COUNT, {}, [&](const std::size_t& itemInd, const unsigned int& threadInd){
+		executingThread[itemInd] = threadInd;
+		std::unique_lock<std::mutex> lock(mutex);
+		if(itemInd==0){
+			//the timeout only keeps a broken scheduler from hanging the test
+			isTimedOut = !itemDone.wait_for(lock, std::chrono::seconds(60), [&](){return numDone==COUNT-1;});
+		}
+		else{
+			numDone++;
+			itemDone.notify_all();
+		}
+	}, ITUR_P452::SchedulerOptions{NUM_THREADS, false, COUNT/NUM_THREADS});
+	ASSERT_FALSE(isTimedOut);
+
+	//thread 0 takes its block from the front, so it either runs item 0 or (if it started late) none of its block
+	for (std::size_t itemInd = 1; itemInd < COUNT/NUM_THREADS; itemInd++) {
+		EXPECT_NE(0u, executingThread[itemInd]) << itemInd;
+	}
+}
+
+TEST(TaskSchedulerTests, errorTest){
+	std::atomic<std::size_t> numRun{0};
+	EXPECT_THROW(ITUR_P452::runParallel(10000, {}, [&](const std::size_t& itemInd, const unsigned int&){
+		numRun++;
+		if(itemInd==10){
+			throw std::runtime_error("job failure");
+		}
+	}, ITUR_P452::SchedulerOptions{4}), std::runtime_error);
+	//the remaining chunks are skipped
+	EXPECT_LT(numRun.load(), 10000u);
+
+	const std::vector<double> COSTS(3, 1.0);
+	EXPECT_THROW(ITUR_P452::runParallel(4, COSTS, [](const std::size_t&, const unsigned int&){}), std::invalid_argument);
+}
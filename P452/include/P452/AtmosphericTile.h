@@ -0,0 +1,97 @@
+#ifndef P452_ATMOSPHERIC_TILE_H
+#define P452_ATMOSPHERIC_TILE_H
+
+#include "Common/Enumerations.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace P452 {
+
+    /// @brief Atmospheric inputs of the clear air model that depend only on the path midpoint location
+    struct AtmosphericParameters{
+        double deltaN;              //Average radio-refractive index lapse-rate through the lowest 1km of the atmosphere (N-Units/km)
+        double surfaceRefractivity; //Sea Level Surface Refractivity (N0) (N-Units)
+        double temp_K;              //Temperature (K)
+        double dryPressure_hPa;     //Dry air pressure (hPa)
+    };
+
+    /// @brief Fetch deltaN and N0 from the DataLoader maps and temperature/dry pressure from the seasonal atmosphere
+    /// @param lat_deg      Latitude (deg)
+    /// @param lon_deg      Longitude (deg)
+    /// @param height_km    Height of the location above sea level (km)
+    /// @param season       Season used for the standard atmosphere
+    /// @return Atmospheric parameters at the location
+    AtmosphericParameters fetchAtmosphericParameters(const double& lat_deg, const double& lon_deg, const double& height_km=0.0,
+            const Enumerations::Season& season=Enumerations::Season::SummerTime);
+
+    /// @brief Regular lat/lon grid definition. Row r is at startLat_deg + r*latStep_deg,
+    ///        column c is at startLon_deg + c*lonStep_deg (steps may be negative)
+    struct AtmosphericGridDefinition{
+        double startLat_deg;
+        double startLon_deg;
+        double latStep_deg;
+        double lonStep_deg;
+        uint32_t numRows;
+        uint32_t numCols;
+    };
+
+    /// @brief Atmospheric parameters sampled once on a regular grid (e.g. the receiver grid of an area study)
+    /// so that per-pixel calculations can look them up by index instead of querying the data maps and the gas model.
+    /// Values are stored as 32 bit floats, row-major, and can be saved to / loaded from a compact binary tile file
+    class AtmosphericTile{
+    public:
+        AtmosphericTile();
+
+        /// @brief Sample all atmospheric parameters on the grid using multiple threads
+        /// @param grid             Grid definition (should match the study resolution)
+        /// @param samplingHeight_km Height used for every sample (km)
+        /// @param season           Season used for the standard atmosphere
+        /// @param threadCount      Number of threads (0 uses the hardware concurrency)
+        /// @return Generated tile
+        static AtmosphericTile generate(const AtmosphericGridDefinition& grid, const double& samplingHeight_km=0.0,
+                const Enumerations::Season& season=Enumerations::Season::SummerTime, const unsigned int& threadCount=0);
+
+        /// @brief Load a tile previously written with save()
+        /// @param filePath Path to the binary tile
+        /// @return Loaded tile
+        static AtmosphericTile load(const std::string& filePath);
+
+        /// @brief Write the tile to a binary file (native byte order)
+        /// @param filePath Path to the binary tile
+        void save(const std::string& filePath) const;
+
+        /// @brief Flat (row-major) index of the grid point nearest to the location, throws if outside the grid
+        /// @param lat_deg Latitude (deg)
+        /// @param lon_deg Longitude (deg)
+        /// @return index usable with at(index)
+        std::size_t indexOf(const double& lat_deg, const double& lon_deg) const;
+
+        /// @brief Parameters at a flat (row-major) grid index
+        AtmosphericParameters at(const std::size_t& index) const;
+
+        /// @brief Parameters at a row and column of the grid
+        AtmosphericParameters at(const uint32_t& rowInd, const uint32_t& colInd) const;
+
+        /// @brief Parameters at the grid point nearest to the location
+        AtmosphericParameters lookup(const double& lat_deg, const double& lon_deg) const;
+
+        const AtmosphericGridDefinition& grid() const {return m_grid;}
+        std::size_t size() const {return m_values.size();}
+
+    private:
+        //compact storage of a single grid point
+        struct PackedParameters{
+            float deltaN;
+            float surfaceRefractivity;
+            float temp_K;
+            float dryPressure_hPa;
+        };
+
+        AtmosphericGridDefinition m_grid;
+        std::vector<PackedParameters> m_values; //row-major grid values
+    };
+
+} // end namespace P452
+#endif /* P452_ATMOSPHERIC_TILE_H */
@@ -0,0 +1,164 @@
+#ifndef P452_BATCH_LOSS_H
+#define P452_BATCH_LOSS_H
+
+#include "ClutterModel/ClutterLoss.h"
+#include "MainModel/P452TotalAttenuation.h"
+#include "P452/AtmosphericTile.h"
+#include "TerrainModel/ProfileBatch.h"
+#include "TerrainModel/TerrainProfile.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace P452 {
+
+    class ProfileSource;
+
+    /// @brief Terminal parameters of one link of a batch
+    struct LinkParameters{
+        double txHeight_m;              //Tx Antenna Height above terrain (m)
+        double rxHeight_m;              //Rx Antenna Height above terrain (m)
+        double txHorizonGain_dBi = 0;   //Tx Antenna directional gain towards the horizon along the path (dB)
+        double rxHorizonGain_dBi = 0;   //Rx Antenna directional gain towards the horizon along the path (dB)
+        ClutterModel::ClutterType txClutterType = ClutterModel::ClutterType::NoClutter;
+        ClutterModel::ClutterType rxClutterType = ClutterModel::ClutterType::NoClutter;
+    };
+
+    /// @brief Calculate the clear air loss (ITU-R P.452-17, summer season) of every profile in a batch, 
+    ///        e.g. filled by TerrainModel::BatchProfileSampler, using multiple threads. 
+    ///        Links are scheduled with work stealing (ITUR_P452::runParallel) weighted by their number of profile points.
+    ///        Throws std::invalid_argument before any link is calculated if a profile has less than PathProfile::MIN_PROFILE_POINTS points
+    /// @param batch            Terrain profiles, step distances and midpoints of the links. If the batch holds zones
+    ///                         they are used with its distances to the coast, otherwise zones are derived as in createP452Path
+    /// @param links            Terminal parameters, either one entry shared by all links or one entry per link
+    /// @param freq_GHz         Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+    /// @param timePercent      Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    /// @param polariz          0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param atmospheres      Optional atmospheric parameters per link (e.g. from an AtmosphericTile), 
+    ///                         if empty they are fetched at each profile midpoint
+    /// @param threadCount      Number of threads (0 uses the hardware concurrency)
+    /// @param pinThreads       Pin the worker threads to CPUs (see ITUR_P452::SchedulerOptions)
+    /// @return Path loss of each link (dB), in batch order
+    std::vector<double> calculateP452LossBatch_dB(const TerrainModel::ProfileBatch& batch, std::span<const LinkParameters> links,
+            const double& freq_GHz, const double& timePercent, const int& polariz=0,
+            std::span<const AtmosphericParameters> atmospheres={}, const unsigned int& threadCount=0, const bool& pinThreads=false);
+
+    /// @brief Intermediate values of every link of a batch, one column per value of ITUR_P452::ClearAirIntermediates
+    struct IntermediateColumns{
+        //indexed like ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS, each column holds one value per link in batch order
+        std::array<std::vector<double>, ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS.size()> columns;
+
+        /// @brief Number of links
+        std::size_t size() const;
+
+        /// @brief Column of a value by its name (e.g. "diffractionLoss_p_percent_dB"), throws std::out_of_range if there is none
+        std::span<const double> column(const std::string& name) const;
+
+        /// @brief All values of one link, throws std::out_of_range if linkInd>=size()
+        ITUR_P452::ClearAirIntermediates link(const std::size_t& linkInd) const;
+    };
+
+    /// @brief Same as calculateP452LossBatch_dB, keeping every intermediate value of each link
+    ///        (path parameters, submodel losses and blending parameters) from the same evaluation as the loss
+    /// @return Intermediate values of each link, the totalLoss_dB column holds the losses of calculateP452LossBatch_dB
+    IntermediateColumns calculateP452IntermediatesBatch(const TerrainModel::ProfileBatch& batch, std::span<const LinkParameters> links,
+            const double& freq_GHz, const double& timePercent, const int& polariz=0,
+            std::span<const AtmosphericParameters> atmospheres={}, const unsigned int& threadCount=0, const bool& pinThreads=false);
+
+    /// @brief Write intermediate values as comma separated text: a "link,<value names>" header, then one line per link
+    /// @param output           Output stream
+    /// @param intermediates    Intermediate values of a batch
+    void writeIntermediatesCsv(std::ostream& output, const IntermediateColumns& intermediates);
+
+    /// @brief Links of a batch as columns of caller-owned arrays (e.g. NumPy arrays or arrays passed through a C interface),
+    ///        read in place without copies. The per link columns hold one value per link or a single value shared by all links,
+    ///        optional columns may also be empty
+    struct LinkColumns{
+        std::span<const double> heights_m;          //heights above sea level of all profiles, from tx to rx, one after the other (m)
+        std::span<const int64_t> offsets;           //start of each profile in heights_m, plus the total size (links+1 values),
+                                                    //profiles hold at least PathProfile::MIN_PROFILE_POINTS heights
+        std::span<const double> stepDistances_km;   //per link: distance between profile points (km)
+        std::span<const double> midpointLats_deg;   //per link: latitude of the great-circle midpoint (deg)
+        std::span<const double> midpointLons_deg;   //per link: longitude of the great-circle midpoint (deg)
+        std::span<const double> txHeights_m;        //per link: Tx Antenna Height above terrain (m)
+        std::span<const double> rxHeights_m;        //per link: Rx Antenna Height above terrain (m)
+        std::span<const double> freqs_GHz;          //per link: Frequency (GHz)
+        std::span<const double> timePercents;       //per link: time percentage for which the loss is not exceeded, 0<p<=50
+        std::span<const double> txHorizonGains_dBi; //optional per link: Tx directional gain towards the horizon (dB), 0 if empty
+        std::span<const double> rxHorizonGains_dBi; //optional per link: Rx directional gain towards the horizon (dB), 0 if empty
+        std::span<const int32_t> txClutterTypes;    //optional per link: ClutterModel::ClutterType values, NoClutter if empty
+        std::span<const int32_t> rxClutterTypes;    //optional per link: ClutterModel::ClutterType values, NoClutter if empty
+
+        /// @brief Number of links
+        std::size_t size() const {return offsets.empty() ? 0 : offsets.size()-1;}
+    };
+
+    /// @brief Calculate the clear air loss (ITU-R P.452-17, summer season) of links given as columns, using multiple threads.
+    ///        Same results as calculateP452Loss_dB(lat, lon) for each link; the atmospheric parameters are fetched at each midpoint.
+    ///        The columns are checked before any link is calculated, throws std::invalid_argument if they do not match
+    /// @param links        Link columns
+    /// @param lossList_dB  Receives the path loss of each link (dB), must hold links.size() values
+    /// @param polariz      0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param threadCount  Number of threads (0 uses the hardware concurrency)
+    /// @param pinThreads   Pin the worker threads to CPUs (see ITUR_P452::SchedulerOptions)
+    void calculateP452LossColumns_dB(const LinkColumns& links, std::span<double> lossList_dB, const int& polariz=0,
+            const unsigned int& threadCount=0, const bool& pinThreads=false);
+
+    /// @brief Link between two terminals whose terrain profile is sampled from DEM tiles
+    struct TerrainLink{
+        TerrainModel::GeoPoint tx;      //Tx location
+        TerrainModel::GeoPoint rx;      //Rx location
+        LinkParameters parameters;      //terminal heights, gains and clutter
+    };
+
+    /// @brief Calculate the clear air loss (ITU-R P.452-17, summer season) of links given by their terminal locations.
+    ///        The great-circle profiles are sampled from the tile cache in parallel, then calculated as one batch 
+    ///        (same results as calculateP452LossFromTerrain_dB for each link)
+    /// @param terrain              DEM tile cache (can be shared between threads)
+    /// @param links                Terminal locations and parameters of every link
+    /// @param freq_GHz             Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+    /// @param timePercent          Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    /// @param polariz              0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param threadCount          Number of threads (0 uses the hardware concurrency)
+    /// @param maxStepDistance_km   Maximum distance between terrain profile points (km)
+    /// @param zoneClassifier       Optional land/sea rasters for the zones and distances to the coast
+    /// @param atmosphericTile      Optional tile the atmospheric parameters are looked up in, 
+    ///                             if nullptr they are fetched at each profile midpoint
+    /// @return Path loss of each link (dB), in link order
+    std::vector<double> calculateP452LossFromTerrainBatch_dB(TerrainModel::RasterTileCache& terrain, std::span<const TerrainLink> links,
+            const double& freq_GHz, const double& timePercent, const int& polariz=0, const unsigned int& threadCount=0,
+            const double& maxStepDistance_km=TerrainModel::DEFAULT_PROFILE_STEP_KM,
+            TerrainModel::ZoneClassifier* zoneClassifier=nullptr, const AtmosphericTile* atmosphericTile=nullptr);
+
+    /// @brief Settings of calculateP452LossStream_dB
+    struct StreamOptions{
+        std::size_t chunkSize = 4096;   //number of links pulled from the source at a time
+        std::size_t prefetchChunks = 2; //number of chunks read ahead while a chunk is calculated
+        unsigned int threadCount = 0;   //number of calculation threads (0 uses the hardware concurrency)
+        bool pinThreads = false;        //pin the calculation threads to CPUs
+    };
+
+    /// Receives the losses (dB) of consecutive links, starting at link firstLinkInd of the stream
+    using LossSink = std::function<void(const std::size_t& firstLinkInd, std::span<const double> lossList_dB)>;
+
+    /// @brief Calculate the clear air loss of every link of a profile source chunk by chunk.
+    /// The source is read on a separate thread, at most options.prefetchChunks chunks ahead of the calculation, 
+    /// and the chunk buffers are reused, so the memory use does not depend on the number of links
+    /// @param source       Links to calculate
+    /// @param freq_GHz     Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+    /// @param timePercent  Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    /// @param sink         Called with the losses of each chunk, in stream order, from the calling thread
+    /// @param polariz      0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param options      Chunk size, prefetch depth and thread count
+    /// @return Number of links calculated
+    std::size_t calculateP452LossStream_dB(ProfileSource& source, const double& freq_GHz, const double& timePercent,
+            const LossSink& sink, const int& polariz=0, const StreamOptions& options=StreamOptions());
+
+} // end namespace P452
+#endif /* P452_BATCH_LOSS_H */
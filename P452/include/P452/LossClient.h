@@ -0,0 +1,39 @@
+#ifndef P452_LOSS_CLIENT_H
+#define P452_LOSS_CLIENT_H
+
+#include "P452/LossProtocol.h"
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace P452 {
+
+    /// @brief Connection to a LossServer (e.g. the P452LossDaemon executable) over its Unix domain socket.
+    /// A client sends one request at a time, use one client per thread
+    class LossClient{
+    public:
+        /// @brief Connect to the server, throws if no server listens on the socket
+        /// @param socketPath Path of the server socket
+        explicit LossClient(const std::string& socketPath);
+        ~LossClient();
+
+        LossClient(const LossClient&) = delete;
+        LossClient& operator=(const LossClient&) = delete;
+
+        /// @brief Calculate the clear air loss (ITU-R P.452-17, summer season) of links given by their terminal coordinates.
+        ///        Throws std::runtime_error with the server message if the server rejects the request
+        /// @param links        Terminal locations, heights, gains and clutter of each link
+        /// @param freq_GHz     Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+        /// @param timePercent  Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+        /// @param polariz      0 for Horizonatal Polarization, 1 for Vertical Polarization
+        /// @return Path loss of each link (dB), in request order
+        std::vector<double> calculate(std::span<const LossProtocol::LinkRecord> links, const double& freq_GHz,
+                const double& timePercent, const int& polariz=0);
+
+    private:
+        int m_socketFd;
+    };
+
+} // end namespace P452
+#endif /* P452_LOSS_CLIENT_H */
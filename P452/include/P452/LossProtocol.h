@@ -0,0 +1,70 @@
+#ifndef P452_LOSS_PROTOCOL_H
+#define P452_LOSS_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/// Binary protocol between LossClient and LossServer over a Unix domain socket.
+/// Both ends run on the same machine, so the records are sent as raw structs in native byte order.
+/// A request is a RequestHeader followed by numLinks LinkRecords. The reply is a ResponseHeader followed by
+/// numValues doubles (the loss of each link in dB, in request order) and messageSize characters of error message
+namespace P452::LossProtocol {
+
+    constexpr uint32_t MAGIC = 0x32353450;  //"P452"
+    constexpr uint16_t VERSION = 1;
+
+    enum MessageType : uint16_t {
+        CalculateLinks = 1  //clear air loss of links given by their terminal coordinates
+    };
+
+    enum Status : uint32_t {
+        Ok = 0,
+        InvalidRequest,     //bad magic, version, message type or link count, the connection is closed
+        CalculationError    //the model rejected a link of the batch holding the request
+    };
+
+    struct RequestHeader{
+        uint32_t magic = MAGIC;
+        uint16_t version = VERSION;
+        uint16_t type = MessageType::CalculateLinks;
+        uint32_t numLinks = 0;
+        int32_t polariz = 0;        //0 for Horizonatal Polarization, 1 for Vertical Polarization
+        double freq_GHz = 0;        //Frequency (GHz)
+        double timePercent = 0;     //Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    };
+
+    /// @brief One link of a CalculateLinks request
+    struct LinkRecord{
+        double txLat_deg;
+        double txLon_deg;
+        double rxLat_deg;
+        double rxLon_deg;
+        double txHeight_m;              //Tx Antenna Height above terrain (m)
+        double rxHeight_m;              //Rx Antenna Height above terrain (m)
+        double txHorizonGain_dBi = 0;   //Tx Antenna directional gain towards the horizon along the path (dB)
+        double rxHorizonGain_dBi = 0;   //Rx Antenna directional gain towards the horizon along the path (dB)
+        int32_t txClutterType = 0;      //ClutterModel::ClutterType at Tx
+        int32_t rxClutterType = 0;      //ClutterModel::ClutterType at Rx
+    };
+
+    struct ResponseHeader{
+        uint32_t magic = MAGIC;
+        uint32_t status = Status::Ok;
+        uint32_t numValues = 0;
+        uint32_t messageSize = 0;
+    };
+
+    static_assert(std::is_trivially_copyable_v<RequestHeader> && sizeof(RequestHeader)==32);
+    static_assert(std::is_trivially_copyable_v<LinkRecord> && sizeof(LinkRecord)==72);
+    static_assert(std::is_trivially_copyable_v<ResponseHeader> && sizeof(ResponseHeader)==16);
+
+    /// @brief Read exactly size bytes from a socket, retrying interrupted and partial reads
+    /// @return false if the peer closed the connection before the first byte, throws if it closes in the middle
+    bool readExact(const int& socketFd, void* data, const std::size_t& size);
+
+    /// @brief Write all bytes to a socket, retrying interrupted and partial writes. Throws if the peer is gone
+    void writeAll(const int& socketFd, const void* data, const std::size_t& size);
+
+} // end namespace P452::LossProtocol
+#endif /* P452_LOSS_PROTOCOL_H */
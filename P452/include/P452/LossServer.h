@@ -0,0 +1,110 @@
+#ifndef P452_LOSS_SERVER_H
+#define P452_LOSS_SERVER_H
+
+#include "P452/AtmosphericTile.h"
+#include "P452/LossProtocol.h"
+#include "TerrainModel/RasterTileCache.h"
+#include "TerrainModel/TerrainProfile.h"
+#include "TerrainModel/ZoneClassifier.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace P452 {
+
+    /// @brief Settings of a LossServer
+    struct LossServerOptions{
+        double maxStepDistance_km = TerrainModel::DEFAULT_PROFILE_STEP_KM;  //maximum distance between profile points (km)
+        std::size_t maxBatchLinks = 4096;       //a batch is calculated as soon as the waiting requests hold this many links
+        double coalescingWindow_ms = 2.0;       //time the first waiting request waits for more requests to join its batch (ms)
+        std::size_t maxRequestLinks = 1u<<20;   //larger requests are rejected
+        unsigned int threadCount = 0;           //number of calculation threads (0 uses the hardware concurrency)
+        const AtmosphericTile* atmosphericTile = nullptr;   //if set, atmospheric parameters are looked up in the tile
+        double shutdownTimeout_ms = 1000.0;     //time the clients get to read their last responses after stop() (ms)
+    };
+
+    /// @brief Activity of a LossServer since it started
+    struct LossServerStats{
+        std::size_t numConnections = 0;     //accepted connections
+        std::size_t numRequests = 0;        //valid requests received
+        std::size_t numLinks = 0;           //links calculated
+        std::size_t numBatches = 0;         //model batches run, requests received close together share a batch
+    };
+
+    /// @brief Long running loss server on a Unix domain socket (see LossProtocol), so the DEM tile cache,
+    /// the land/sea rasters, the atmospheric tile and the DataLoader grids stay loaded between queries.
+    /// Every connection is served on its own thread, joined by serve(). Requests arriving within the coalescing window
+    /// are grouped (by frequency, time percentage and polarization) into one batch for calculateP452LossBatch_dB. If a batch
+    /// fails, its requests are calculated one by one so an error only reaches the client whose links caused it
+    class LossServer{
+    public:
+        /// @brief Create and bind the socket, clients can connect as soon as the server is constructed
+        /// @param socketPath       Path of the socket, an existing socket file is replaced
+        /// @param terrain          DEM tile cache, must outlive the server
+        /// @param options          Batching, profile sampling and threading settings
+        /// @param zoneClassifier   Optional land/sea rasters used to classify the profile points, must outlive the server
+        LossServer(const std::string& socketPath, TerrainModel::RasterTileCache& terrain,
+                const LossServerOptions& options=LossServerOptions(), TerrainModel::ZoneClassifier* zoneClassifier=nullptr);
+        /// @brief Stop the server and remove the socket file
+        ~LossServer();
+
+        LossServer(const LossServer&) = delete;
+        LossServer& operator=(const LossServer&) = delete;
+
+        /// @brief Accept connections and answer requests until stop() is called. Returns once every connection is closed,
+        ///        connections whose client has not read its responses within the shutdown timeout are shut down
+        void serve();
+
+        /// @brief Make serve() return after the waiting requests are answered, and close the connections (any thread)
+        void stop();
+
+        LossServerStats stats() const;
+        const std::string& socketPath() const {return m_socketPath;}
+
+    private:
+        //a request waiting for its batch, owned by the connection thread
+        struct PendingRequest{
+            LossProtocol::RequestHeader header;
+            std::vector<LossProtocol::LinkRecord> links;
+            std::vector<double> lossList_dB;
+            std::string error;
+            bool isDone = false;
+        };
+
+        void serveConnection(const int& connectionFd, const std::size_t& connectionInd);
+        //join the threads of the connections that ended, called by serve()
+        void joinFinishedConnections(std::unordered_map<std::size_t, std::thread>& connectionThreads);
+        void runBatches();
+        //calculate one batch, if it fails every request is calculated on its own so only the failing ones get the error
+        void calculateBatch(const std::vector<PendingRequest*>& requests);
+        //calculate the links of the requests in one model batch, throws on failure
+        void calculateRequests(const std::vector<PendingRequest*>& requests);
+
+        std::string m_socketPath;
+        TerrainModel::RasterTileCache& m_terrain;
+        TerrainModel::ZoneClassifier* m_zoneClassifier;
+        LossServerOptions m_options;
+        int m_listenFd;
+        int m_wakeFds[2];           //pipe waking up the accept loop on stop()
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_requestCondition;     //new request or stop
+        std::condition_variable m_doneCondition;        //batch finished
+        std::deque<PendingRequest*> m_pendingRequests;
+        std::size_t m_numPendingLinks;
+        std::size_t m_numActiveConnections;
+        bool m_isStopping;
+        std::unordered_set<int> m_connectionFds;    //open connections
+        std::vector<std::size_t> m_finishedConnections; //connections whose thread has ended and can be joined
+        LossServerStats m_stats;
+    };
+
+} // end namespace P452
+#endif /* P452_LOSS_SERVER_H */
@@ -2,7 +2,11 @@
 #define P452_H
 
 #include "MainModel/PathProfile.h"
+#include "MainModel/P452TotalAttenuation.h"
 #include "ClutterModel/ClutterLoss.h"
+#include "P452/AtmosphericTile.h"
+#include "TerrainModel/TerrainProfile.h"
+#include <span>
 #include <vector>
 
 //WARNING ITU_R P452 is not recommended for frequencies below 100 MHz (VHF band)
@@ -34,6 +38,108 @@ namespace P452 {
             const ClutterModel::ClutterType& txClutterType=ClutterModel::ClutterType::NoClutter,
             const ClutterModel::ClutterType& rxClutterType=ClutterModel::ClutterType::NoClutter);
 
+    /// @brief Calculate total path loss for clear air conditions using ITU-R P.452-17 model with precomputed 
+    ///        atmospheric parameters (e.g. looked up from an AtmosphericTile) instead of fetching them per call
+    /// @param txHeight_m           Tx Antenna Height above terrain (m)
+    /// @param rxHeight_m           Rx Antenna Height above terrain (m)
+	/// @param elevationList_m      raw elevation list (meters above sea level) from tx to rx, total distance recommended <10,000 km
+    /// @param stepDistance_km      distance between points in elevation list (km)
+    /// @param midpoint_lat_deg     Latitude of midpoint in great circle path between tx and rx (deg)
+    /// @param atmosphere           deltaN, N0, temperature and dry pressure at the path midpoint
+    /// @param freq_GHz             Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+    /// @param timePercent          Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    /// @param polariz              0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param txHorizonGain_dBi    Tx Antenna directional gain towards the horizon along the path (dB)
+    /// @param rxHorizonGain_dBi    Rx Antenna directional gain towards the horizon along the path (dB)
+    /// @param txClutterType        Clutter Category Type at Tx 
+    /// @param rxClutterType        Clutter Category Type at Rx 
+	/// @return Path Loss (dB)
+    double calculateP452Loss_dB(const double& txHeight_m, const double& rxHeight_m, 
+            std::span<const double> elevationList_m, const double& stepDistance_km, 
+            const double& midpoint_lat_deg, const AtmosphericParameters& atmosphere,
+            const double& freq_GHz, const double& timePercent, const int& polariz=0,
+            const double& txHorizonGain_dBi=0, const double& rxHorizonGain_dBi=0,
+            const ClutterModel::ClutterType& txClutterType=ClutterModel::ClutterType::NoClutter,
+            const ClutterModel::ClutterType& rxClutterType=ClutterModel::ClutterType::NoClutter);
+
+    /// @brief Calculate total path loss for clear air conditions using ITU-R P.452-17 model with zone types and 
+    ///        distances to the coast from a land/sea classification (e.g. TerrainModel::ZoneClassifier)
+    /// @param txHeight_m           Tx Antenna Height above terrain (m)
+    /// @param rxHeight_m           Rx Antenna Height above terrain (m)
+	/// @param elevationList_m      raw elevation list (meters above sea level) from tx to rx, total distance recommended <10,000 km
+    /// @param zoneList             zone type of every point of the elevation list
+    /// @param dist_coast_tx_km     distance from tx to the coast (km), 0 if at sea
+    /// @param dist_coast_rx_km     distance from rx to the coast (km), 0 if at sea
+    /// @param stepDistance_km      distance between points in elevation list (km)
+    /// @param midpoint_lat_deg     Latitude of midpoint in great circle path between tx and rx (deg)
+    /// @param atmosphere           deltaN, N0, temperature and dry pressure at the path midpoint
+    /// @param freq_GHz             Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+    /// @param timePercent          Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    /// @param polariz              0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param txHorizonGain_dBi    Tx Antenna directional gain towards the horizon along the path (dB)
+    /// @param rxHorizonGain_dBi    Rx Antenna directional gain towards the horizon along the path (dB)
+    /// @param txClutterType        Clutter Category Type at Tx 
+    /// @param rxClutterType        Clutter Category Type at Rx 
+	/// @return Path Loss (dB)
+    double calculateP452Loss_dB(const double& txHeight_m, const double& rxHeight_m, 
+            std::span<const double> elevationList_m, std::span<const PathProfile::ZoneType> zoneList,
+            const double& dist_coast_tx_km, const double& dist_coast_rx_km, const double& stepDistance_km, 
+            const double& midpoint_lat_deg, const AtmosphericParameters& atmosphere,
+            const double& freq_GHz, const double& timePercent, const int& polariz=0,
+            const double& txHorizonGain_dBi=0, const double& rxHorizonGain_dBi=0,
+            const ClutterModel::ClutterType& txClutterType=ClutterModel::ClutterType::NoClutter,
+            const ClutterModel::ClutterType& rxClutterType=ClutterModel::ClutterType::NoClutter);
+
+    /// @brief Same as calculateP452Loss_dB with atmospheric parameters, returning every intermediate value of the evaluation
+    ///        (path parameters, submodel losses, blending parameters) along with the total loss, e.g. to diagnose outliers
+    /// @return Intermediate values, totalLoss_dB is the path loss (dB) returned by calculateP452Loss_dB
+    ITUR_P452::ClearAirIntermediates calculateP452Intermediates(const double& txHeight_m, const double& rxHeight_m, 
+            std::span<const double> elevationList_m, const double& stepDistance_km, 
+            const double& midpoint_lat_deg, const AtmosphericParameters& atmosphere,
+            const double& freq_GHz, const double& timePercent, const int& polariz=0,
+            const double& txHorizonGain_dBi=0, const double& rxHorizonGain_dBi=0,
+            const ClutterModel::ClutterType& txClutterType=ClutterModel::ClutterType::NoClutter,
+            const ClutterModel::ClutterType& rxClutterType=ClutterModel::ClutterType::NoClutter);
+
+    /// @brief Same as calculateP452Loss_dB with zone types, returning every intermediate value of the evaluation
+    /// @return Intermediate values, totalLoss_dB is the path loss (dB) returned by calculateP452Loss_dB
+    ITUR_P452::ClearAirIntermediates calculateP452Intermediates(const double& txHeight_m, const double& rxHeight_m, 
+            std::span<const double> elevationList_m, std::span<const PathProfile::ZoneType> zoneList,
+            const double& dist_coast_tx_km, const double& dist_coast_rx_km, const double& stepDistance_km, 
+            const double& midpoint_lat_deg, const AtmosphericParameters& atmosphere,
+            const double& freq_GHz, const double& timePercent, const int& polariz=0,
+            const double& txHorizonGain_dBi=0, const double& rxHorizonGain_dBi=0,
+            const ClutterModel::ClutterType& txClutterType=ClutterModel::ClutterType::NoClutter,
+            const ClutterModel::ClutterType& rxClutterType=ClutterModel::ClutterType::NoClutter);
+
+    /// @brief Calculate total path loss for clear air conditions using ITU-R P.452-17 model, assuming summer season, 
+    ///        with the terrain profile sampled from local DEM tiles along the great-circle path between tx and rx
+    /// @param terrain              DEM tile cache (can be shared between threads)
+    /// @param tx                   Tx location
+    /// @param rx                   Rx location
+    /// @param txHeight_m           Tx Antenna Height above terrain (m)
+    /// @param rxHeight_m           Rx Antenna Height above terrain (m)
+    /// @param freq_GHz             Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+    /// @param timePercent          Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    /// @param polariz              0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param txHorizonGain_dBi    Tx Antenna directional gain towards the horizon along the path (dB)
+    /// @param rxHorizonGain_dBi    Rx Antenna directional gain towards the horizon along the path (dB)
+    /// @param txClutterType        Clutter Category Type at Tx 
+    /// @param rxClutterType        Clutter Category Type at Rx 
+    /// @param maxStepDistance_km   Maximum distance between terrain profile points (km)
+    /// @param zoneClassifier       Optional land/sea rasters for the zones and distances to the coast, 
+    ///                             if nullptr they are derived from the elevations as in createP452Path
+	/// @return Path Loss (dB)
+    double calculateP452LossFromTerrain_dB(TerrainModel::RasterTileCache& terrain, 
+            const TerrainModel::GeoPoint& tx, const TerrainModel::GeoPoint& rx,
+            const double& txHeight_m, const double& rxHeight_m,
+            const double& freq_GHz, const double& timePercent, const int& polariz=0,
+            const double& txHorizonGain_dBi=0, const double& rxHorizonGain_dBi=0,
+            const ClutterModel::ClutterType& txClutterType=ClutterModel::ClutterType::NoClutter,
+            const ClutterModel::ClutterType& rxClutterType=ClutterModel::ClutterType::NoClutter,
+            const double& maxStepDistance_km=TerrainModel::DEFAULT_PROFILE_STEP_KM,
+            TerrainModel::ZoneClassifier* zoneClassifier=nullptr);
+
     /////////////////////////////
     // P452 Helper Functions
 
@@ -43,12 +149,16 @@ namespace P452 {
     /// @param out_path             return P452 path
 	/// @param out_dist_coast_tx_km return distance from tx to the coast (km), 0 if at sea
 	/// @param out_dist_coast_rx_km return distance from rx to the coast (km), 0 if at sea
-    void createP452Path(const std::vector<double>& elevationList_m, const double& stepDistance_km,
+    void createP452Path(std::span<const double> elevationList_m, const double& stepDistance_km,
         PathProfile::Path& out_path, double& out_dist_coast_tx_km, double& out_dist_coast_rx_km);
 
-    /// Potentially Useful Functions:
-    /// @brief create raw elevation list for ITU-R P.452-17 model using GdalRasterProcessor
-    /// @brief create path for ITU-R P.452-17 model using land border data to classify zones through GdalVectorProcessor
+    /// @brief create path for ITU-R P.452-17 model from elevations and already classified zones
+	/// @param elevationList_m      raw elevation list (meters above sea level)
+    /// @param zoneList             zone type of every point of the elevation list
+    /// @param stepDistance_km      distance between points in elevation list (km)
+    /// @param out_path             return P452 path
+    void createP452Path(std::span<const double> elevationList_m, std::span<const PathProfile::ZoneType> zoneList,
+        const double& stepDistance_km, PathProfile::Path& out_path);
 
 } // end namespace P452
 #endif /* P452_H */
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef P452_C_H
+#define P452_C_H
+
+/* C interface of the ITU-R P.452-17 clear air model for foreign function callers (Go, Rust, ...).
+ * Functions never throw, they return a p452_status and p452_last_error() describes the last failure of the calling thread.
+ * Arrays are plain pointer + length pairs read in place. Every structure starts with struct_size, which the caller sets to
+ * sizeof(structure) of the header it was built with, so the library knows which fields the caller's structure holds.
+ * Structures are only extended at the end, P452_C_ABI_VERSION is increased when they are, and sizes the library does not
+ * know are rejected with P452_ERROR_INVALID_ARGUMENT. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(p452c_EXPORTS)
+#define P452_C_API __declspec(dllexport)
+#else
+#define P452_C_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define P452_C_ABI_VERSION 2
+
+typedef enum p452_status {
+    P452_OK = 0,
+    P452_ERROR_INVALID_ARGUMENT = 1,    /* null pointer, array sizes that do not match, values out of range */
+    P452_ERROR_NO_TERRAIN = 2,          /* terrain calculation on a context without a DEM directory */
+    P452_ERROR_CALCULATION = 3,         /* the model failed, e.g. a missing DEM tile or data file */
+    P452_ERROR_OUT_OF_MEMORY = 4
+} p452_status;
+
+/* Context holding the DEM tile cache and settings, create one per process and reuse it for every batch.
+ * A context can be used by several threads at a time. */
+typedef struct p452_context p452_context;
+
+typedef struct p452_context_options {
+    size_t struct_size;                 /* sizeof(p452_context_options) */
+    const char* dem_directory;          /* directory of the DEM tiles, NULL if only profile batches are calculated */
+    const char* atmospheric_tile_path;  /* atmospheric tile for terrain batches, NULL fetches the parameters per link */
+    unsigned int thread_count;          /* threads per batch, 0 uses the hardware concurrency */
+    double max_step_distance_km;        /* distance between sampled profile points (km), 0 uses the default (0.1 km) */
+} p452_context_options;
+
+/* Links given by their terrain profiles. Profile i is heights_m[offsets[i]] to heights_m[offsets[i+1]-1] from tx to rx.
+ * The per link arrays hold num_links values or a single value shared by all links; the optional ones may also be empty */
+typedef struct p452_profile_columns {
+    size_t struct_size;                 /* sizeof(p452_profile_columns) */
+    const double* heights_m;            size_t num_heights;     /* heights above sea level (m) */
+    const int64_t* offsets;             size_t num_offsets;     /* number of links + 1 values, increasing from 0 to num_heights */
+    const double* step_distances_km;    size_t num_step_distances;
+    const double* midpoint_lats_deg;    size_t num_midpoint_lats;
+    const double* midpoint_lons_deg;    size_t num_midpoint_lons;
+    const double* tx_heights_m;         size_t num_tx_heights;  /* above terrain (m) */
+    const double* rx_heights_m;         size_t num_rx_heights;
+    const double* freqs_ghz;            size_t num_freqs;
+    const double* time_percents;        size_t num_time_percents;
+    const double* tx_horizon_gains_dbi; size_t num_tx_horizon_gains;    /* optional, 0 dB */
+    const double* rx_horizon_gains_dbi; size_t num_rx_horizon_gains;    /* optional, 0 dB */
+    const int32_t* tx_clutter_types;    size_t num_tx_clutter_types;    /* optional ClutterModel::ClutterType values, no clutter */
+    const int32_t* rx_clutter_types;    size_t num_rx_clutter_types;    /* optional ClutterModel::ClutterType values, no clutter */
+} p452_profile_columns;
+
+/* Links given by their terminal locations, the profiles are sampled from the context's DEM tiles.
+ * Every array holds num_links values, the optional ones may be NULL */
+typedef struct p452_terrain_columns {
+    size_t struct_size;                 /* sizeof(p452_terrain_columns) */
+    size_t num_links;
+    const double* tx_lats_deg;
+    const double* tx_lons_deg;
+    const double* rx_lats_deg;
+    const double* rx_lons_deg;
+    const double* tx_heights_m;         /* above terrain (m) */
+    const double* rx_heights_m;
+    const double* tx_horizon_gains_dbi; /* optional, 0 dB */
+    const double* rx_horizon_gains_dbi; /* optional, 0 dB */
+    const int32_t* tx_clutter_types;    /* optional ClutterModel::ClutterType values, no clutter */
+    const int32_t* rx_clutter_types;    /* optional ClutterModel::ClutterType values, no clutter */
+} p452_terrain_columns;
+
+/* Version of this interface the library was built with, compare with P452_C_ABI_VERSION */
+P452_C_API uint32_t p452_abi_version(void);
+
+/* Message of the last failed call on the calling thread ("" if none), valid until the next call on that thread */
+P452_C_API const char* p452_last_error(void);
+
+/* Create a context, options may be NULL for the defaults. *context is NULL if the creation fails */
+P452_C_API p452_status p452_context_create(const p452_context_options* options, p452_context** context);
+
+/* Destroy a context created by p452_context_create, NULL is ignored */
+P452_C_API void p452_context_destroy(p452_context* context);
+
+/* Clear air loss (dB, summer season) of profile links, written to losses_db which holds num_losses = number of links values.
+ * polariz is 0 for horizontal and 1 for vertical polarization */
+P452_C_API p452_status p452_calculate_profile_batch(p452_context* context, const p452_profile_columns* links, int polariz,
+        double* losses_db, size_t num_losses);
+
+/* Clear air loss (dB, summer season) of links between terminal locations, written to losses_db (num_losses = links->num_links).
+ * Same results as P452::calculateP452LossFromTerrain_dB for each link */
+P452_C_API p452_status p452_calculate_terrain_batch(p452_context* context, const p452_terrain_columns* links,
+        double freq_ghz, double time_percent, int polariz, double* losses_db, size_t num_losses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* P452_C_H */
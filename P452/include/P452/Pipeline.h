@@ -0,0 +1,71 @@
+#ifndef P452_PIPELINE_H
+#define P452_PIPELINE_H
+
+#include "P452/AtmosphericTile.h"
+#include "P452/BatchLoss.h"
+
+#include <array>
+#include <cstddef>
+
+namespace P452 {
+
+    class ProfileSource;
+
+    /// @brief Stages of calculateP452LossPipeline_dB, in pipeline order
+    enum PipelineStage{
+        ProfileExtraction = 0,  //ProfileSource::next (DEM reads, archive reads, ...)
+        AtmosphericLookup,      //atmospheric parameters at the profile midpoints, if the source does not provide them
+        ModelEvaluation,        //clear air model of every link of the chunk (multithreaded)
+        ResultWriting,          //loss sink
+        NumPipelineStages
+    };
+
+    /// @brief Activity of one pipeline stage
+    struct StageMetrics{
+        std::size_t numChunks = 0;      //number of chunks processed
+        std::size_t numLinks = 0;       //number of links processed
+        double busyTime_s = 0;          //time spent processing chunks (s)
+        double waitTime_s = 0;          //time spent waiting for a chunk from the previous stage (s)
+        double meanQueueDepth = 0;      //mean number of chunks waiting in the input queue when the stage takes a chunk
+        std::size_t maxQueueDepth = 0;  //largest number of chunks waiting in the input queue when the stage takes a chunk
+
+        /// @brief Links processed per second of busy time (0 if the stage was never busy)
+        double linksPerSecond() const {return busyTime_s>0 ? numLinks/busyTime_s : 0.0;}
+    };
+
+    /// @brief Activity of a whole pipeline run
+    struct PipelineMetrics{
+        std::array<StageMetrics, NumPipelineStages> stages; //indexed by PipelineStage
+        std::size_t numLinks = 0;                           //number of links calculated
+        double wallTime_s = 0;                              //total run time (s)
+
+        const StageMetrics& operator[](const PipelineStage& stage) const {return stages[stage];}
+    };
+
+    /// @brief Settings of calculateP452LossPipeline_dB
+    struct PipelineOptions{
+        std::size_t chunkSize = 1024;           //number of links pulled from the source at a time
+        std::size_t chunksInFlight = 4;         //number of chunk buffers cycling through the stages (bounds the queue depths)
+        unsigned int threadCount = 0;           //number of model evaluation threads (0 uses the hardware concurrency)
+        bool pinThreads = false;                //pin the model evaluation threads to CPUs
+        const AtmosphericTile* atmosphericTile = nullptr;   //if set, atmospheric parameters are looked up in the tile
+                                                            //instead of fetched from the data maps
+    };
+
+    /// @brief Calculate the clear air loss of every link of a profile source with the profile extraction,
+    /// the atmospheric lookup, the model evaluation and the result writing running concurrently on consecutive chunks,
+    /// so reading the terrain overlaps with the calculation. Every stage runs on its own thread (the result writing on
+    /// the calling thread) and passes the chunks to the next stage through bounded lock-free queues
+    /// (ITUR_P452::BoundedQueue). The chunk buffers are reused. The first error of any stage stops the pipeline and is rethrown
+    /// @param source       Links to calculate
+    /// @param freq_GHz     Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+    /// @param timePercent  Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    /// @param sink         Called with the losses of each chunk, in stream order, from the calling thread
+    /// @param polariz      0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param options      Chunk size, number of chunks in flight, thread count and atmospheric tile
+    /// @return Throughput and queue depth of every stage
+    PipelineMetrics calculateP452LossPipeline_dB(ProfileSource& source, const double& freq_GHz, const double& timePercent,
+            const LossSink& sink, const int& polariz=0, const PipelineOptions& options=PipelineOptions());
+
+} // end namespace P452
+#endif /* P452_PIPELINE_H */
@@ -0,0 +1,122 @@
+#ifndef P452_PROFILE_SOURCE_H
+#define P452_PROFILE_SOURCE_H
+
+#include "P452/AtmosphericTile.h"
+#include "P452/BatchLoss.h"
+#include "MainModel/ProfileArchive.h"
+#include "TerrainModel/BatchProfileSampler.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace P452 {
+
+    /// @brief A chunk of links pulled from a ProfileSource. The buffers are reused between chunks
+    struct LinkBatch{
+        TerrainModel::ProfileBatch profiles;            //terrain profile of each link
+        std::vector<LinkParameters> links;              //terminal parameters, one entry per profile
+        std::vector<AtmosphericParameters> atmospheres; //empty (fetched at each profile midpoint) or one entry per profile
+        std::size_t firstLinkInd = 0;                   //index of the first link of the chunk in the whole stream
+
+        /// @brief Number of links
+        std::size_t size() const {return profiles.size();}
+        bool empty() const {return profiles.empty();}
+
+        /// @brief Remove all links, keeping the allocated capacity
+        void clear(){
+            profiles.clear();
+            links.clear();
+            atmospheres.clear();
+        }
+    };
+
+    /// @brief Pull-based stream of link profiles, so studies larger than memory can be calculated chunk by chunk.
+    /// Sources are read from a single thread at a time
+    class ProfileSource{
+    public:
+        virtual ~ProfileSource() = default;
+
+        /// @brief Read the next links of the stream
+        /// @param out_batch    Cleared, then returns up to maxLinks links (firstLinkInd is set by the caller)
+        /// @param maxLinks     Maximum number of links to read
+        /// @return false if the stream is exhausted (out_batch is empty)
+        virtual bool next(LinkBatch& out_batch, const std::size_t& maxLinks) = 0;
+    };
+
+    /// @brief Profile source backed by a user callback that appends one link per call
+    class CallbackProfileSource : public ProfileSource{
+    public:
+        /// Appends one link (profile, link parameters and optionally atmosphere) to the batch, returns false at the end of the stream
+        using LinkGenerator = std::function<bool(LinkBatch& out_batch)>;
+
+        explicit CallbackProfileSource(LinkGenerator generator);
+
+        bool next(LinkBatch& out_batch, const std::size_t& maxLinks) override;
+
+    private:
+        LinkGenerator m_generator;
+        bool m_isExhausted;
+    };
+
+    /// @brief Profile source sampling the great-circle profiles from one site to many receivers from DEM tiles,
+    ///        one chunk of receivers at a time (see TerrainModel::BatchProfileSampler)
+    class DemProfileSource : public ProfileSource{
+    public:
+        /// @param terrain              DEM tile cache
+        /// @param origin               Tx location shared by all links
+        /// @param destinations         Rx location of each link, must stay alive while the source is read
+        /// @param links                Terminal parameters, either one entry shared by all links or one entry per destination
+        /// @param maxStepDistance_km   Maximum distance between profile points (km)
+        /// @param zoneClassifier       Optional land/sea rasters used to classify the profile points
+        DemProfileSource(TerrainModel::RasterTileCache& terrain, const TerrainModel::GeoPoint& origin,
+                std::span<const TerrainModel::GeoPoint> destinations, std::span<const LinkParameters> links,
+                const double& maxStepDistance_km=TerrainModel::DEFAULT_PROFILE_STEP_KM,
+                TerrainModel::ZoneClassifier* zoneClassifier=nullptr);
+
+        bool next(LinkBatch& out_batch, const std::size_t& maxLinks) override;
+
+    private:
+        TerrainModel::BatchProfileSampler m_sampler;
+        TerrainModel::GeoPoint m_origin;
+        std::span<const TerrainModel::GeoPoint> m_destinations;
+        std::vector<LinkParameters> m_links;
+        std::size_t m_nextLinkInd;
+    };
+
+    /// @brief Location and terminal parameters of a profile stored in a profile archive
+    struct ArchiveLinkInfo{
+        LinkParameters link;
+        TerrainModel::GeoPoint midpoint;        //great-circle midpoint of the link (for the atmospheric parameters)
+        double txDistanceToCoast_km = 500.0;    //only used for archives with zones
+        double rxDistanceToCoast_km = 500.0;    //only used for archives with zones
+    };
+
+    /// @brief Profile source reading the profiles of a memory-mapped PathProfile::ProfileArchive in order.
+    /// Profiles must be uniformly spaced. If the archive stores zones for every point they are used,
+    /// otherwise the zones are derived from the elevations as in createP452Path
+    class ArchiveProfileSource : public ProfileSource{
+    public:
+        /// Returns the location and terminal parameters of the profile at the given archive index
+        using LinkInfoCallback = std::function<ArchiveLinkInfo(const std::size_t& profileInd)>;
+
+        /// @param archivePath  Profile archive written by PathProfile::ProfileArchiveWriter
+        /// @param linkInfo     Location and terminal parameters of each profile
+        ArchiveProfileSource(const std::string& archivePath, LinkInfoCallback linkInfo);
+
+        bool next(LinkBatch& out_batch, const std::size_t& maxLinks) override;
+
+    private:
+        PathProfile::ProfileArchive m_archive;
+        LinkInfoCallback m_linkInfo;
+        bool m_hasZones;
+        std::size_t m_nextProfileInd;
+        std::vector<double> m_heights_m;
+        std::vector<PathProfile::ZoneType> m_zones;
+    };
+
+} // end namespace P452
+#endif /* P452_PROFILE_SOURCE_H */
@@ -0,0 +1,73 @@
+#ifndef P452_SHARDED_BATCH_H
+#define P452_SHARDED_BATCH_H
+
+#include "P452/BatchLoss.h"
+#include "TerrainModel/RasterTileCache.h"
+#include "TerrainModel/TerrainProfile.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace P452 {
+
+    /// @brief Read the links of a sharded run from a comma separated file, one link per line:
+    ///        txLat,txLon,rxLat,rxLon,txHeight_m,rxHeight_m[,txHorizonGain_dBi,rxHorizonGain_dBi[,txClutterType,rxClutterType]]
+    ///        Empty lines, lines starting with '#' and a header line are skipped.
+    ///        Clutter types are the integer values of ClutterModel::ClutterType
+    /// @param filePath Path of the link file
+    /// @return Links in file order, throws std::runtime_error if a line cannot be read
+    std::vector<TerrainLink> readLinkFile(const std::string& filePath);
+
+    /// @brief Settings of runShardedP452Batch
+    struct ShardedRunOptions{
+        std::size_t numShards = 0;                  //number of link ranges (0 uses one shard per process)
+        unsigned int numProcesses = 0;              //maximum number of worker processes at a time (0 uses the hardware concurrency)
+        unsigned int threadsPerProcess = 1;         //threads of each worker process
+        double maxStepDistance_km = TerrainModel::DEFAULT_PROFILE_STEP_KM;    //maximum distance between profile points (km)
+        TerrainModel::MissingTilePolicy missingTilePolicy = TerrainModel::MissingTilePolicy::SeaLevel;
+        bool shareTiles = true;                     //load the DEM tiles of the links once into shared memory for all workers
+        bool resume = true;                         //keep complete shard files of an earlier run with the same links and settings
+    };
+
+    /// @brief Outcome of runShardedP452Batch
+    struct ShardedRunResult{
+        std::size_t numLinks;
+        std::size_t numShards;
+        std::vector<std::size_t> calculatedShards;  //shards calculated by this run
+        std::vector<std::size_t> resumedShards;     //shards kept from an earlier run
+        std::vector<std::size_t> failedShards;      //shards whose worker failed, rerun to calculate them
+        std::vector<std::string> failureMessages;   //reason of each failed shard
+        std::size_t numSharedTiles;                 //DEM tiles placed in shared memory
+        std::size_t sharedTileBytes;                //size of the shared tile segment (bytes)
+
+        /// @brief True if every shard is done and the output file was written
+        bool isComplete() const {return failedShards.empty();}
+    };
+
+    /// @brief Calculate the clear air loss (ITU-R P.452-17, summer season) of a large link file with several worker processes.
+    ///        The links are split into contiguous shards, each calculated by a forked worker
+    ///        (calculateP452LossFromTerrainBatch_dB) that writes "shard_<index>.bin" to the work directory,
+    ///        or "shard_<index>.err" if it fails.
+    ///        The DEM tiles crossed by the links are loaded once by the calling process into a POSIX shared memory
+    ///        segment (TerrainModel::SharedTileSet) that every worker reads, the ITU digital maps are loaded before
+    ///        the workers are forked and shared with them copy-on-write.
+    ///        A shard file records a fingerprint of its links and settings, so rerunning after a failure only calculates
+    ///        the shards that are missing. Once every shard is done they are merged in link order into the output file
+    ///        ("link,loss_dB" lines), which is identical for any number of shards and processes.
+    ///        Only available on Unix (uses fork)
+    /// @param linkFilePath     Link file (see readLinkFile)
+    /// @param demDirectory     Directory holding the DEM tiles (see TerrainModel::RasterTileCache)
+    /// @param workDirectory    Directory for the shard files, created if needed
+    /// @param outputPath       Output file, only written when every shard is done
+    /// @param freq_GHz         Frequency (GHz) Recommended between 0.1 GHz and 50 GHz
+    /// @param timePercent      Required time percentage for which the calculated loss is not exceeded, 0<p<=50
+    /// @param polariz          0 for Horizonatal Polarization, 1 for Vertical Polarization
+    /// @param options          Sharding settings
+    /// @return Shards calculated, resumed and failed
+    ShardedRunResult runShardedP452Batch(const std::string& linkFilePath, const std::string& demDirectory,
+            const std::string& workDirectory, const std::string& outputPath, const double& freq_GHz, const double& timePercent,
+            const int& polariz=0, const ShardedRunOptions& options={});
+
+} // end namespace P452
+#endif /* P452_SHARDED_BATCH_H */
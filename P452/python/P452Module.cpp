@@ -0,0 +1,102 @@
+#include "P452/BatchLoss.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <cstdint>
+#include <span>
+#include <sstream>
+#include <string>
+
+namespace py = pybind11;
+
+namespace{
+    /// @brief Read-only view of a 1-d NumPy array argument, or of a Python number shared by all links.
+    /// Arrays must already have the column type and be C-contiguous, they are read in place and never copied
+    template<typename T>
+    class ColumnArgument{
+    public:
+        ColumnArgument(const py::object& argument, const char* name){
+            if(argument.is_none()){
+                return;
+            }
+            if(py::isinstance<py::array>(argument)){
+                if(!py::isinstance<py::array_t<T>>(argument)){
+                    throwTypeError(name, "has the wrong dtype");
+                }
+                m_array = py::reinterpret_borrow<py::array_t<T>>(argument);
+                if(m_array.ndim()!=1 || (m_array.flags() & py::array::c_style)==0){
+                    throwTypeError(name, "is not a C-contiguous 1-d array");
+                }
+                m_values = std::span<const T>(m_array.data(), static_cast<std::size_t>(m_array.size()));
+                return;
+            }
+            m_scalar = argument.cast<T>();
+            m_values = std::span<const T>(&m_scalar, 1);
+        }
+
+        ColumnArgument(const ColumnArgument&) = delete;
+        ColumnArgument& operator=(const ColumnArgument&) = delete;
+
+        std::span<const T> values() const {return m_values;}
+
+    private:
+        py::array_t<T> m_array;     //keeps the array alive while it is read
+        T m_scalar{};
+        std::span<const T> m_values;
+
+        [[noreturn]] static void throwTypeError(const char* name, const char* problem){
+            std::ostringstream oStrStream;
+            oStrStream << "Argument " << name << " " << problem << ", expected a C-contiguous 1-d array of " 
+                        << py::str(py::dtype::of<T>()).cast<std::string>();
+            throw py::type_error(oStrStream.str());
+        }
+    };
+
+    py::array_t<double> calculateLossBatch(const py::object& heights_m, const py::object& offsets, const py::object& stepDistances_km,
+            const py::object& midpointLats_deg, const py::object& midpointLons_deg, const py::object& txHeights_m,
+            const py::object& rxHeights_m, const py::object& freqs_GHz, const py::object& timePercents, const int& polariz,
+            const py::object& txHorizonGains_dBi, const py::object& rxHorizonGains_dBi, const py::object& txClutterTypes,
+            const py::object& rxClutterTypes, const unsigned int& threadCount){
+        const ColumnArgument<double> heightColumn(heights_m, "heights_m");
+        const ColumnArgument<int64_t> offsetColumn(offsets, "offsets");
+        const ColumnArgument<double> stepColumn(stepDistances_km, "step_distances_km");
+        const ColumnArgument<double> latColumn(midpointLats_deg, "midpoint_lats_deg");
+        const ColumnArgument<double> lonColumn(midpointLons_deg, "midpoint_lons_deg");
+        const ColumnArgument<double> txHeightColumn(txHeights_m, "tx_heights_m");
+        const ColumnArgument<double> rxHeightColumn(rxHeights_m, "rx_heights_m");
+        const ColumnArgument<double> freqColumn(freqs_GHz, "freqs_ghz");
+        const ColumnArgument<double> timePercentColumn(timePercents, "time_percents");
+        const ColumnArgument<double> txGainColumn(txHorizonGains_dBi, "tx_horizon_gains_dbi");
+        const ColumnArgument<double> rxGainColumn(rxHorizonGains_dBi, "rx_horizon_gains_dbi");
+        const ColumnArgument<int32_t> txClutterColumn(txClutterTypes, "tx_clutter_types");
+        const ColumnArgument<int32_t> rxClutterColumn(rxClutterTypes, "rx_clutter_types");
+
+        const P452::LinkColumns links{heightColumn.values(), offsetColumn.values(), stepColumn.values(), latColumn.values(),
+                lonColumn.values(), txHeightColumn.values(), rxHeightColumn.values(), freqColumn.values(), timePercentColumn.values(),
+                txGainColumn.values(), rxGainColumn.values(), txClutterColumn.values(), rxClutterColumn.values()};
+        py::array_t<double> lossList_dB(static_cast<py::ssize_t>(links.size()));
+        const std::span<double> lossValues_dB(lossList_dB.mutable_data(), links.size());
+        {
+            //the links are calculated by the worker threads while other Python threads run
+            py::gil_scoped_release release;
+            P452::calculateP452LossColumns_dB(links, lossValues_dB, polariz, threadCount);
+        }
+        return lossList_dB;
+    }
+}
+
+PYBIND11_MODULE(p452, module){
+    module.doc() = "ITU-R P.452-17 clear air path loss";
+
+    module.def("calculate_loss_batch", &calculateLossBatch,
+            "Clear air path loss (dB, summer season) of many links, calculated in parallel without holding the GIL.\n"
+            "Profile i is heights_m[offsets[i]:offsets[i+1]] (float64 and int64 arrays, offsets has one more value than links).\n"
+            "The other arguments hold one value per link or a single value (array or number) shared by all links.\n"
+            "Arrays must be C-contiguous with the expected dtype (float64, int32 for clutter types), they are read without copies.",
+            py::arg("heights_m"), py::arg("offsets"), py::arg("step_distances_km"), py::arg("midpoint_lats_deg"),
+            py::arg("midpoint_lons_deg"), py::arg("tx_heights_m"), py::arg("rx_heights_m"), py::arg("freqs_ghz"),
+            py::arg("time_percents"), py::arg("polariz")=0, py::arg("tx_horizon_gains_dbi")=py::none(),
+            py::arg("rx_horizon_gains_dbi")=py::none(), py::arg("tx_clutter_types")=py::none(),
+            py::arg("rx_clutter_types")=py::none(), py::arg("threads")=0u);
+}
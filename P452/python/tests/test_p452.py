@@ -0,0 +1,73 @@
+import threading
+import unittest
+
+import numpy as np
+
+import p452
+
+
+def build_links(num_links):
+    """Profiles of 40 to 120 points over a ridge, 0.1 km apart"""
+    profiles = [20.0 + 150.0 * np.exp(-((np.arange(40 + 8 * i) - 20.0 - 4 * i) / 6.0) ** 2) for i in range(num_links)]
+    offsets = np.concatenate(([0], np.cumsum([len(profile) for profile in profiles]))).astype(np.int64)
+    return np.concatenate(profiles), offsets
+
+
+class CalculateLossBatchTest(unittest.TestCase):
+    def calculate(self, heights_m, offsets, **kwargs):
+        arguments = dict(step_distances_km=0.1, midpoint_lats_deg=29.5, midpoint_lons_deg=47.5, tx_heights_m=20.0,
+                         rx_heights_m=10.0, freqs_ghz=2.0, time_percents=10.0)
+        arguments.update(kwargs)
+        return p452.calculate_loss_batch(heights_m, offsets, **arguments)
+
+    def test_shared_and_per_link_values(self):
+        heights_m, offsets = build_links(11)
+        num_links = len(offsets) - 1
+        shared = self.calculate(heights_m, offsets)
+        self.assertEqual((num_links,), shared.shape)
+        self.assertTrue(np.all(np.isfinite(shared)))
+        per_link = self.calculate(heights_m, offsets, freqs_ghz=np.full(num_links, 2.0), tx_heights_m=np.full(num_links, 20.0),
+                                  tx_clutter_types=np.zeros(num_links, dtype=np.int32), threads=1)
+        np.testing.assert_array_equal(shared, per_link)
+
+        freqs_ghz = np.linspace(0.5, 6.0, num_links)
+        varied = self.calculate(heights_m, offsets, freqs_ghz=freqs_ghz, threads=3)
+        for link_ind in range(num_links):
+            single = self.calculate(heights_m[offsets[link_ind]:offsets[link_ind + 1]].copy(), np.array([0, offsets[link_ind + 1] - offsets[link_ind]]),
+                                    freqs_ghz=freqs_ghz[link_ind])
+            self.assertEqual(single[0], varied[link_ind])
+
+    def test_invalid_arguments(self):
+        heights_m, offsets = build_links(3)
+        # arrays are never converted, so they are never copied
+        with self.assertRaises(TypeError):
+            self.calculate(heights_m.astype(np.float32), offsets)
+        with self.assertRaises(TypeError):
+            self.calculate(heights_m[::2], offsets)
+        with self.assertRaises(ValueError):
+            self.calculate(heights_m, offsets, freqs_ghz=np.array([2.0, 3.0]))
+        with self.assertRaises(ValueError):
+            self.calculate(heights_m, offsets[:-1])
+        with self.assertRaises(ValueError):
+            self.calculate(heights_m, offsets, rx_clutter_types=np.array([99], dtype=np.int32))
+        self.assertEqual((0,), self.calculate(np.zeros(0), np.zeros(1, dtype=np.int64)).shape)
+
+    def test_concurrent_python_threads(self):
+        heights_m, offsets = build_links(20)
+        expected = self.calculate(heights_m, offsets, threads=2)
+        results = [None] * 4
+
+        def run(thread_ind):
+            results[thread_ind] = self.calculate(heights_m, offsets, threads=2)
+
+        threads = [threading.Thread(target=run, args=(thread_ind,)) for thread_ind in range(len(results))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for result in results:
+            np.testing.assert_array_equal(expected, result)
+
+
+if __name__ == "__main__":
+    unittest.main()
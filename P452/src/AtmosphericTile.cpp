@@ -0,0 +1,167 @@
+#include "P452/AtmosphericTile.h"
+
+#include "MainModel/DataLoader.h"
+#include "MainModel/TaskScheduler.h"
+#include "GasModel/GasAttenuationHelpers.h"
+#include "Common/GeodeticCoord.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace{
+    //identifies the binary tile format (first 8 bytes of the file)
+    constexpr char TileMagic[8] = {'P','4','5','2','A','T','M','1'};
+
+    //round a fractional grid coordinate and check that it is inside the axis
+    bool toGridIndex(const double& fractionalIndex, const uint32_t& axisLength, uint32_t& out_index){
+        const double roundedIndex = std::round(fractionalIndex);
+        if(!(roundedIndex>=0.0 && roundedIndex<static_cast<double>(axisLength))){
+            return false;
+        }
+        out_index = static_cast<uint32_t>(roundedIndex);
+        return true;
+    }
+}
+
+P452::AtmosphericParameters P452::fetchAtmosphericParameters(const double& lat_deg, const double& lon_deg,
+        const double& height_km, const Enumerations::Season& season){
+
+    //convert coordinate to itumodels format
+    const GeodeticCoord coord = GeodeticCoord(lon_deg, lat_deg, height_km);
+
+    AtmosphericParameters result;
+    result.deltaN = ITUR_P452::DataLoader::fetchRadioRefractivityIndexLapseRate(coord);
+    result.surfaceRefractivity = ITUR_P452::DataLoader::fetchSeaLevelSurfaceRefractivity(coord);
+
+    //Get temp_K, dryPressure from standard atmosphere sources
+    double totalPressure_hPa, waterVapor_hPa;
+    GasAttenuationHelpers::setSeasonalAtmosphericTermsForUsLocation(coord,
+                result.temp_K, totalPressure_hPa, waterVapor_hPa, season);
+    result.dryPressure_hPa = totalPressure_hPa - waterVapor_hPa;
+    return result;
+}
+
+P452::AtmosphericTile::AtmosphericTile(): m_grid{0.0,0.0,0.0,0.0,0,0}{
+}
+
+P452::AtmosphericTile P452::AtmosphericTile::generate(const AtmosphericGridDefinition& grid, const double& samplingHeight_km,
+        const Enumerations::Season& season, const unsigned int& threadCount){
+
+    AtmosphericTile tile;
+    tile.m_grid = grid;
+    tile.m_values.resize(static_cast<std::size_t>(grid.numRows)*grid.numCols);
+
+    //every grid point is independent, rows are shared between the threads by the scheduler
+    ITUR_P452::runParallel(grid.numRows, {}, [&tile, &grid, &samplingHeight_km, &season](const std::size_t& rowInd, const unsigned int&){
+        const double lat_deg = grid.startLat_deg + rowInd*grid.latStep_deg;
+        for(uint32_t colInd = 0; colInd<grid.numCols; colInd++){
+            const double lon_deg = grid.startLon_deg + colInd*grid.lonStep_deg;
+            const AtmosphericParameters params = fetchAtmosphericParameters(lat_deg, lon_deg, samplingHeight_km, season);
+            tile.m_values[rowInd*grid.numCols+colInd] = PackedParameters{
+                static_cast<float>(params.deltaN), static_cast<float>(params.surfaceRefractivity),
+                static_cast<float>(params.temp_K), static_cast<float>(params.dryPressure_hPa)
+            };
+        }
+    }, ITUR_P452::SchedulerOptions{threadCount});
+    return tile;
+}
+
+P452::AtmosphericTile P452::AtmosphericTile::load(const std::string& filePath){
+    std::ifstream file(filePath, std::ios::binary);
+    if(!file.is_open()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: AtmosphericTile::load(): Failed to open file \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+
+    char magic[sizeof(TileMagic)];
+    AtmosphericTile tile;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&tile.m_grid.startLat_deg), sizeof(double));
+    file.read(reinterpret_cast<char*>(&tile.m_grid.startLon_deg), sizeof(double));
+    file.read(reinterpret_cast<char*>(&tile.m_grid.latStep_deg), sizeof(double));
+    file.read(reinterpret_cast<char*>(&tile.m_grid.lonStep_deg), sizeof(double));
+    file.read(reinterpret_cast<char*>(&tile.m_grid.numRows), sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(&tile.m_grid.numCols), sizeof(uint32_t));
+    if(!file || std::memcmp(magic, TileMagic, sizeof(TileMagic))!=0){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: AtmosphericTile::load(): File \"" << filePath << "\" is not an atmospheric tile";
+        throw std::runtime_error(oStrStream.str());
+    }
+
+    tile.m_values.resize(static_cast<std::size_t>(tile.m_grid.numRows)*tile.m_grid.numCols);
+    file.read(reinterpret_cast<char*>(tile.m_values.data()), tile.m_values.size()*sizeof(PackedParameters));
+    if(!file){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: AtmosphericTile::load(): File \"" << filePath << "\" is truncated, expected "
+                    << tile.m_values.size() << " grid points";
+        throw std::runtime_error(oStrStream.str());
+    }
+    return tile;
+}
+
+void P452::AtmosphericTile::save(const std::string& filePath) const{
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if(!file.is_open()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: AtmosphericTile::save(): Failed to open file \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+    file.write(TileMagic, sizeof(TileMagic));
+    file.write(reinterpret_cast<const char*>(&m_grid.startLat_deg), sizeof(double));
+    file.write(reinterpret_cast<const char*>(&m_grid.startLon_deg), sizeof(double));
+    file.write(reinterpret_cast<const char*>(&m_grid.latStep_deg), sizeof(double));
+    file.write(reinterpret_cast<const char*>(&m_grid.lonStep_deg), sizeof(double));
+    file.write(reinterpret_cast<const char*>(&m_grid.numRows), sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(&m_grid.numCols), sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(m_values.data()), m_values.size()*sizeof(PackedParameters));
+    if(!file){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: AtmosphericTile::save(): Failed writing file \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+}
+
+std::size_t P452::AtmosphericTile::indexOf(const double& lat_deg, const double& lon_deg) const{
+    uint32_t rowInd, colInd;
+    const bool isRowValid = m_grid.latStep_deg!=0.0
+            && toGridIndex((lat_deg-m_grid.startLat_deg)/m_grid.latStep_deg, m_grid.numRows, rowInd);
+    //allow the longitude to be given in either the [-180,180) or the [0,360) convention
+    bool isColValid = false;
+    for(const double lonShift_deg : {0.0, 360.0, -360.0}){
+        if(m_grid.lonStep_deg!=0.0
+                && toGridIndex((lon_deg+lonShift_deg-m_grid.startLon_deg)/m_grid.lonStep_deg, m_grid.numCols, colInd)){
+            isColValid = true;
+            break;
+        }
+    }
+    if(!isRowValid || !isColValid){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: AtmosphericTile::indexOf(): Location (lat " << lat_deg << " deg, lon " << lon_deg
+                    << " deg) is outside of the tile";
+        throw std::out_of_range(oStrStream.str());
+    }
+    return static_cast<std::size_t>(rowInd)*m_grid.numCols+colInd;
+}
+
+P452::AtmosphericParameters P452::AtmosphericTile::at(const std::size_t& index) const{
+    const PackedParameters& packed = m_values.at(index);
+    return AtmosphericParameters{packed.deltaN, packed.surfaceRefractivity, packed.temp_K, packed.dryPressure_hPa};
+}
+
+P452::AtmosphericParameters P452::AtmosphericTile::at(const uint32_t& rowInd, const uint32_t& colInd) const{
+    if(rowInd>=m_grid.numRows || colInd>=m_grid.numCols){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: AtmosphericTile::at(): Grid point (" << rowInd << ", " << colInd << ") is outside of the tile";
+        throw std::out_of_range(oStrStream.str());
+    }
+    return at(static_cast<std::size_t>(rowInd)*m_grid.numCols+colInd);
+}
+
+P452::AtmosphericParameters P452::AtmosphericTile::lookup(const double& lat_deg, const double& lon_deg) const{
+    return at(indexOf(lat_deg, lon_deg));
+}
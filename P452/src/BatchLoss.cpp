@@ -0,0 +1,377 @@
+#include "P452/BatchLoss.h"
+#include "P452/P452.h"
+#include "P452/ProfileSource.h"
+#include "MainModel/TaskScheduler.h"
+
+#include "Common/Enumerations.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace{
+    //calculate the intermediates of every link of a batch, passed to store(linkInd, intermediates) from the worker threads
+    template<typename Store>
+    void calculateBatch(const char* functionName, const TerrainModel::ProfileBatch& batch, 
+            std::span<const P452::LinkParameters> links, const double& freq_GHz, const double& timePercent, const int& polariz,
+            std::span<const P452::AtmosphericParameters> atmospheres, const unsigned int& threadCount, const bool& pinThreads,
+            const Store& store){
+
+        if(links.size()!=1 && links.size()!=batch.size()){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: " << functionName << "(): Expected 1 or " << batch.size() << " link parameters, got " << links.size();
+            throw std::invalid_argument(oStrStream.str());
+        }
+        if(!atmospheres.empty() && atmospheres.size()!=batch.size()){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: " << functionName << "(): Expected " << batch.size() << " atmospheric parameters, got " 
+                        << atmospheres.size();
+            throw std::invalid_argument(oStrStream.str());
+        }
+        //the batch members are public, so profiles not added by ProfileBatch::append are checked here
+        if(batch.offsets.size()!=batch.size()+1 || batch.offsets.back()!=batch.heights_m.size()){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: " << functionName << "(): The profile offsets do not match the " << batch.size() << " profiles";
+            throw std::invalid_argument(oStrStream.str());
+        }
+
+        //link cost grows with the profile length, the scheduler balances the links by number of points
+        std::vector<double> costs(batch.size());
+        for(std::size_t linkInd = 0; linkInd<batch.size(); linkInd++){
+            if(batch.offsets[linkInd+1]<batch.offsets[linkInd]+PathProfile::MIN_PROFILE_POINTS){
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: " << functionName << "(): Profile " << linkInd << " has less than " 
+                            << PathProfile::MIN_PROFILE_POINTS << " points";
+                throw std::invalid_argument(oStrStream.str());
+            }
+            costs[linkInd] = static_cast<double>(batch.offsets[linkInd+1]-batch.offsets[linkInd]);
+        }
+        ITUR_P452::runParallel(batch.size(), costs, [&](const std::size_t& linkInd, const unsigned int&){
+            const auto heights_m = batch.heights(linkInd);
+            const P452::LinkParameters& link = links.size()==1 ? links.front() : links[linkInd];
+            //same midpoint height approximation as calculateP452Loss_dB
+            const P452::AtmosphericParameters atmosphere = atmospheres.empty() 
+                    ? P452::fetchAtmosphericParameters(batch.midpoints[linkInd].lat_deg, batch.midpoints[linkInd].lon_deg, 
+                            heights_m[heights_m.size()/2]/1000.0, Enumerations::Season::SummerTime)
+                    : atmospheres[linkInd];
+            if(batch.hasZones()){
+                store(linkInd, P452::calculateP452Intermediates(link.txHeight_m, link.rxHeight_m, heights_m, batch.profileZones(linkInd),
+                        batch.txDistancesToCoast_km[linkInd], batch.rxDistancesToCoast_km[linkInd], batch.stepDistances_km[linkInd],
+                        batch.midpoints[linkInd].lat_deg, atmosphere, freq_GHz, timePercent, polariz, 
+                        link.txHorizonGain_dBi, link.rxHorizonGain_dBi, link.txClutterType, link.rxClutterType));
+            }
+            else{
+                store(linkInd, P452::calculateP452Intermediates(link.txHeight_m, link.rxHeight_m, heights_m, 
+                        batch.stepDistances_km[linkInd], batch.midpoints[linkInd].lat_deg, atmosphere, freq_GHz, timePercent, polariz, 
+                        link.txHorizonGain_dBi, link.rxHorizonGain_dBi, link.txClutterType, link.rxClutterType));
+            }
+        }, ITUR_P452::SchedulerOptions{threadCount, pinThreads});
+    }
+}
+
+std::vector<double> P452::calculateP452LossBatch_dB(const TerrainModel::ProfileBatch& batch, std::span<const LinkParameters> links,
+        const double& freq_GHz, const double& timePercent, const int& polariz,
+        std::span<const AtmosphericParameters> atmospheres, const unsigned int& threadCount, const bool& pinThreads){
+
+    std::vector<double> lossList_dB(batch.size());
+    calculateBatch("calculateP452LossBatch_dB", batch, links, freq_GHz, timePercent, polariz, atmospheres, threadCount, pinThreads,
+            [&](const std::size_t& linkInd, const ITUR_P452::ClearAirIntermediates& values){
+        lossList_dB[linkInd] = values.totalLoss_dB;
+    });
+    return lossList_dB;
+}
+
+std::size_t P452::IntermediateColumns::size() const{
+    return columns.front().size();
+}
+
+std::span<const double> P452::IntermediateColumns::column(const std::string& name) const{
+    for(std::size_t fieldInd = 0; fieldInd<ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS.size(); fieldInd++){
+        if(name==ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS[fieldInd].name){
+            return columns[fieldInd];
+        }
+    }
+    std::ostringstream oStrStream;
+    oStrStream << "ERROR: IntermediateColumns::column(): No intermediate value named " << name;
+    throw std::out_of_range(oStrStream.str());
+}
+
+ITUR_P452::ClearAirIntermediates P452::IntermediateColumns::link(const std::size_t& linkInd) const{
+    if(linkInd>=size()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: IntermediateColumns::link(): Link " << linkInd << " out of range for " << size() << " links";
+        throw std::out_of_range(oStrStream.str());
+    }
+    ITUR_P452::ClearAirIntermediates values;
+    for(std::size_t fieldInd = 0; fieldInd<ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS.size(); fieldInd++){
+        values.*ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS[fieldInd].value = columns[fieldInd][linkInd];
+    }
+    return values;
+}
+
+P452::IntermediateColumns P452::calculateP452IntermediatesBatch(const TerrainModel::ProfileBatch& batch, 
+        std::span<const LinkParameters> links, const double& freq_GHz, const double& timePercent, const int& polariz,
+        std::span<const AtmosphericParameters> atmospheres, const unsigned int& threadCount, const bool& pinThreads){
+
+    IntermediateColumns intermediates;
+    for(std::vector<double>& column : intermediates.columns){
+        column.resize(batch.size());
+    }
+    calculateBatch("calculateP452IntermediatesBatch", batch, links, freq_GHz, timePercent, polariz, atmospheres, threadCount, 
+            pinThreads, [&](const std::size_t& linkInd, const ITUR_P452::ClearAirIntermediates& values){
+        for(std::size_t fieldInd = 0; fieldInd<ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS.size(); fieldInd++){
+            intermediates.columns[fieldInd][linkInd] = values.*ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS[fieldInd].value;
+        }
+    });
+    return intermediates;
+}
+
+void P452::writeIntermediatesCsv(std::ostream& output, const IntermediateColumns& intermediates){
+    output << "link";
+    for(const ITUR_P452::ClearAirIntermediateField& field : ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS){
+        output << "," << field.name;
+    }
+    output << "\n";
+    const auto oldPrecision = output.precision(17);
+    for(std::size_t linkInd = 0; linkInd<intermediates.size(); linkInd++){
+        output << linkInd;
+        for(const std::vector<double>& column : intermediates.columns){
+            output << "," << column[linkInd];
+        }
+        output << "\n";
+    }
+    output.precision(oldPrecision);
+}
+
+namespace{
+    //one value per link, or one value shared by all links
+    template<typename T>
+    const T& columnValue(std::span<const T> column, const std::size_t& linkInd){
+        return column.size()==1 ? column.front() : column[linkInd];
+    }
+
+    template<typename T>
+    void checkColumn(std::span<const T> column, const std::size_t& numLinks, const char* columnName, const bool& isOptional){
+        if((column.empty() && isOptional) || column.size()==1 || column.size()==numLinks){
+            return;
+        }
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: calculateP452LossColumns_dB(): Expected " << (isOptional ? "0, " : "") << "1 or " << numLinks 
+                    << " values in column " << columnName << ", got " << column.size();
+        throw std::invalid_argument(oStrStream.str());
+    }
+
+    void checkClutterColumn(std::span<const int32_t> column, const char* columnName){
+        for(const int32_t& clutterType : column){
+            if(clutterType<ClutterModel::ClutterType::NoClutter || clutterType>ClutterModel::ClutterType::IndustrialZone){
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: calculateP452LossColumns_dB(): Invalid clutter type " << clutterType << " in column " << columnName;
+                throw std::invalid_argument(oStrStream.str());
+            }
+        }
+    }
+}
+
+void P452::calculateP452LossColumns_dB(const LinkColumns& links, std::span<double> lossList_dB, const int& polariz,
+        const unsigned int& threadCount, const bool& pinThreads){
+    const std::size_t numLinks = links.size();
+    if(lossList_dB.size()!=numLinks){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: calculateP452LossColumns_dB(): Expected room for " << numLinks << " losses, got " << lossList_dB.size();
+        throw std::invalid_argument(oStrStream.str());
+    }
+    if(numLinks==0){
+        return;
+    }
+    if(links.offsets.front()!=0 || links.offsets.back()!=static_cast<int64_t>(links.heights_m.size())
+            || std::adjacent_find(links.offsets.begin(), links.offsets.end(), std::greater<int64_t>())!=links.offsets.end()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: calculateP452LossColumns_dB(): The profile offsets must increase from 0 to the number of heights ("
+                    << links.heights_m.size() << ")";
+        throw std::invalid_argument(oStrStream.str());
+    }
+    for(std::size_t linkInd = 0; linkInd<numLinks; linkInd++){
+        if(links.offsets[linkInd+1]-links.offsets[linkInd]<static_cast<int64_t>(PathProfile::MIN_PROFILE_POINTS)){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: calculateP452LossColumns_dB(): Profile " << linkInd << " has " 
+                        << links.offsets[linkInd+1]-links.offsets[linkInd] << " points, at least " 
+                        << PathProfile::MIN_PROFILE_POINTS << " are needed";
+            throw std::invalid_argument(oStrStream.str());
+        }
+    }
+    checkColumn(links.stepDistances_km, numLinks, "stepDistances_km", false);
+    checkColumn(links.midpointLats_deg, numLinks, "midpointLats_deg", false);
+    checkColumn(links.midpointLons_deg, numLinks, "midpointLons_deg", false);
+    checkColumn(links.txHeights_m, numLinks, "txHeights_m", false);
+    checkColumn(links.rxHeights_m, numLinks, "rxHeights_m", false);
+    checkColumn(links.freqs_GHz, numLinks, "freqs_GHz", false);
+    checkColumn(links.timePercents, numLinks, "timePercents", false);
+    checkColumn(links.txHorizonGains_dBi, numLinks, "txHorizonGains_dBi", true);
+    checkColumn(links.rxHorizonGains_dBi, numLinks, "rxHorizonGains_dBi", true);
+    checkColumn(links.txClutterTypes, numLinks, "txClutterTypes", true);
+    checkColumn(links.rxClutterTypes, numLinks, "rxClutterTypes", true);
+    checkClutterColumn(links.txClutterTypes, "txClutterTypes");
+    checkClutterColumn(links.rxClutterTypes, "rxClutterTypes");
+
+    std::vector<double> costs(numLinks);
+    for(std::size_t linkInd = 0; linkInd<numLinks; linkInd++){
+        costs[linkInd] = static_cast<double>(links.offsets[linkInd+1]-links.offsets[linkInd]);
+    }
+    ITUR_P452::runParallel(numLinks, costs, [&](const std::size_t& linkInd, const unsigned int&){
+        const auto heights_m = links.heights_m.subspan(links.offsets[linkInd], links.offsets[linkInd+1]-links.offsets[linkInd]);
+        const double& midpointLat_deg = columnValue(links.midpointLats_deg, linkInd);
+        //same midpoint height approximation as calculateP452Loss_dB
+        const AtmosphericParameters atmosphere = fetchAtmosphericParameters(midpointLat_deg, columnValue(links.midpointLons_deg, linkInd),
+                heights_m[heights_m.size()/2]/1000.0, Enumerations::Season::SummerTime);
+        lossList_dB[linkInd] = calculateP452Loss_dB(columnValue(links.txHeights_m, linkInd), columnValue(links.rxHeights_m, linkInd),
+                heights_m, columnValue(links.stepDistances_km, linkInd), midpointLat_deg, atmosphere, 
+                columnValue(links.freqs_GHz, linkInd), columnValue(links.timePercents, linkInd), polariz,
+                links.txHorizonGains_dBi.empty() ? 0.0 : columnValue(links.txHorizonGains_dBi, linkInd),
+                links.rxHorizonGains_dBi.empty() ? 0.0 : columnValue(links.rxHorizonGains_dBi, linkInd),
+                links.txClutterTypes.empty() ? ClutterModel::ClutterType::NoClutter 
+                        : static_cast<ClutterModel::ClutterType>(columnValue(links.txClutterTypes, linkInd)),
+                links.rxClutterTypes.empty() ? ClutterModel::ClutterType::NoClutter 
+                        : static_cast<ClutterModel::ClutterType>(columnValue(links.rxClutterTypes, linkInd)));
+    }, ITUR_P452::SchedulerOptions{threadCount, pinThreads});
+}
+
+std::vector<double> P452::calculateP452LossFromTerrainBatch_dB(TerrainModel::RasterTileCache& terrain, std::span<const TerrainLink> links,
+        const double& freq_GHz, const double& timePercent, const int& polariz, const unsigned int& threadCount,
+        const double& maxStepDistance_km, TerrainModel::ZoneClassifier* zoneClassifier, const AtmosphericTile* atmosphericTile){
+
+    //the profiles are sampled in parallel from the shared tile cache, then packed into one batch
+    std::vector<TerrainModel::TerrainProfile> profiles(links.size());
+    ITUR_P452::runParallel(links.size(), {}, [&](const std::size_t& linkInd, const unsigned int&){
+        profiles[linkInd] = TerrainModel::sampleGreatCircleProfile(terrain, links[linkInd].tx, links[linkInd].rx, 
+                maxStepDistance_km, zoneClassifier);
+    }, ITUR_P452::SchedulerOptions{threadCount});
+
+    TerrainModel::ProfileBatch batch;
+    std::vector<LinkParameters> linkParameters;
+    std::vector<AtmosphericParameters> atmospheres;
+    linkParameters.reserve(links.size());
+    for(std::size_t linkInd = 0; linkInd<links.size(); linkInd++){
+        const TerrainModel::TerrainProfile& profile = profiles[linkInd];
+        if(zoneClassifier!=nullptr){
+            batch.append(profile.elevationList_m, profile.zoneList, profile.stepDistance_km, profile.distance_km, profile.midpoint,
+                    profile.txDistanceToCoast_km, profile.rxDistanceToCoast_km);
+        }
+        else{
+            batch.append(profile.elevationList_m, profile.stepDistance_km, profile.distance_km, profile.midpoint);
+        }
+        linkParameters.push_back(links[linkInd].parameters);
+        if(atmosphericTile!=nullptr){
+            atmospheres.push_back(atmosphericTile->lookup(profile.midpoint.lat_deg, profile.midpoint.lon_deg));
+        }
+    }
+    if(links.empty()){
+        return {};
+    }
+    return calculateP452LossBatch_dB(batch, linkParameters, freq_GHz, timePercent, polariz, atmospheres, threadCount);
+}
+
+std::size_t P452::calculateP452LossStream_dB(ProfileSource& source, const double& freq_GHz, const double& timePercent,
+        const LossSink& sink, const int& polariz, const StreamOptions& options){
+    if(options.chunkSize==0){
+        throw std::invalid_argument("ERROR: calculateP452LossStream_dB(): The chunk size must be positive");
+    }
+
+    //fixed pool of chunk buffers, cycled between the reader (free -> ready) and the calculation (ready -> free)
+    std::vector<LinkBatch> chunkPool(options.prefetchChunks+1);
+    std::deque<LinkBatch*> freeChunks, readyChunks;
+    for(auto& chunk : chunkPool){
+        freeChunks.push_back(&chunk);
+    }
+    std::mutex mutex;
+    std::condition_variable chunkCondition;
+    bool isSourceDone = false;
+    bool isStopped = false;
+    std::exception_ptr readError;
+
+    auto readChunks = [&](){
+        std::size_t nextLinkInd = 0;
+        try{
+            while(true){
+                LinkBatch* chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    chunkCondition.wait(lock, [&](){return isStopped || !freeChunks.empty();});
+                    if(isStopped){
+                        break;
+                    }
+                    chunk = freeChunks.front();
+                    freeChunks.pop_front();
+                }
+                const bool hasLinks = source.next(*chunk, options.chunkSize);
+                chunk->firstLinkInd = nextLinkInd;
+                nextLinkInd += chunk->size();
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!hasLinks){
+                    freeChunks.push_back(chunk);
+                    break;
+                }
+                readyChunks.push_back(chunk);
+                chunkCondition.notify_all();
+            }
+        }
+        catch(...){
+            std::lock_guard<std::mutex> lock(mutex);
+            readError = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        isSourceDone = true;
+        chunkCondition.notify_all();
+    };
+    std::thread reader(readChunks);
+
+    //stop and join the reader on every exit path
+    auto stopReader = [&](){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopped = true;
+        }
+        chunkCondition.notify_all();
+        reader.join();
+    };
+
+    std::size_t numLinks = 0;
+    try{
+        while(true){
+            LinkBatch* chunk;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                chunkCondition.wait(lock, [&](){return !readyChunks.empty() || isSourceDone;});
+                if(readyChunks.empty()){
+                    break;
+                }
+                chunk = readyChunks.front();
+                readyChunks.pop_front();
+            }
+            const auto lossList_dB = calculateP452LossBatch_dB(chunk->profiles, chunk->links, freq_GHz, timePercent, polariz,
+                    chunk->atmospheres, options.threadCount, options.pinThreads);
+            sink(chunk->firstLinkInd, lossList_dB);
+            numLinks += chunk->size();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                freeChunks.push_back(chunk);
+            }
+            chunkCondition.notify_all();
+        }
+    }
+    catch(...){
+        stopReader();
+        throw;
+    }
+    stopReader();
+    if(readError){
+        std::rethrow_exception(readError);
+    }
+    return numLinks;
+}
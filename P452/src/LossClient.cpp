@@ -0,0 +1,69 @@
+#include "P452/LossClient.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+P452::LossClient::LossClient(const std::string& socketPath): m_socketFd{-1}{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(socketPath.size()>=sizeof(address.sun_path)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: LossClient::LossClient(): Socket path is too long: " << socketPath;
+        throw std::invalid_argument(oStrStream.str());
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size()+1);
+
+    m_socketFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(m_socketFd<0 || ::connect(m_socketFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address))!=0){
+        const int error = errno;
+        if(m_socketFd>=0){
+            ::close(m_socketFd);
+        }
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: LossClient::LossClient(): Cannot connect to " << socketPath << ": " << std::strerror(error);
+        throw std::runtime_error(oStrStream.str());
+    }
+}
+
+P452::LossClient::~LossClient(){
+    ::close(m_socketFd);
+}
+
+std::vector<double> P452::LossClient::calculate(std::span<const LossProtocol::LinkRecord> links, const double& freq_GHz,
+        const double& timePercent, const int& polariz){
+    LossProtocol::RequestHeader request;
+    request.numLinks = static_cast<uint32_t>(links.size());
+    request.polariz = polariz;
+    request.freq_GHz = freq_GHz;
+    request.timePercent = timePercent;
+    LossProtocol::writeAll(m_socketFd, &request, sizeof(request));
+    LossProtocol::writeAll(m_socketFd, links.data(), links.size_bytes());
+
+    LossProtocol::ResponseHeader response;
+    if(!LossProtocol::readExact(m_socketFd, &response, sizeof(response)) || response.magic!=LossProtocol::MAGIC){
+        throw std::runtime_error("ERROR: LossClient::calculate(): No valid response from the server");
+    }
+    std::vector<double> lossList_dB(response.numValues);
+    std::string message(response.messageSize, '\0');
+    if((!lossList_dB.empty() && !LossProtocol::readExact(m_socketFd, lossList_dB.data(), lossList_dB.size()*sizeof(double)))
+            || (!message.empty() && !LossProtocol::readExact(m_socketFd, message.data(), message.size()))){
+        throw std::runtime_error("ERROR: LossClient::calculate(): Incomplete response from the server");
+    }
+    if(response.status!=LossProtocol::Status::Ok){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: LossClient::calculate(): The server rejected the request: " << message;
+        throw std::runtime_error(oStrStream.str());
+    }
+    if(lossList_dB.size()!=links.size()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: LossClient::calculate(): Expected " << links.size() << " losses, got " << lossList_dB.size();
+        throw std::runtime_error(oStrStream.str());
+    }
+    return lossList_dB;
+}
@@ -0,0 +1,53 @@
+#include "P452/LossProtocol.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+bool P452::LossProtocol::readExact(const int& socketFd, void* data, const std::size_t& size){
+    char* bytes = static_cast<char*>(data);
+    std::size_t numRead = 0;
+    while(numRead<size){
+        const ssize_t result = ::recv(socketFd, bytes+numRead, size-numRead, 0);
+        if(result<0 && errno==EINTR){
+            continue;
+        }
+        if(result<0){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: LossProtocol::readExact(): Socket read failed: " << std::strerror(errno);
+            throw std::runtime_error(oStrStream.str());
+        }
+        if(result==0){
+            if(numRead==0){
+                return false;
+            }
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: LossProtocol::readExact(): Connection closed after " << numRead << " of " << size << " bytes";
+            throw std::runtime_error(oStrStream.str());
+        }
+        numRead += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+void P452::LossProtocol::writeAll(const int& socketFd, const void* data, const std::size_t& size){
+    const char* bytes = static_cast<const char*>(data);
+    std::size_t numWritten = 0;
+    while(numWritten<size){
+        //no SIGPIPE if the peer is gone, the error is reported instead
+        const ssize_t result = ::send(socketFd, bytes+numWritten, size-numWritten, MSG_NOSIGNAL);
+        if(result<0 && errno==EINTR){
+            continue;
+        }
+        if(result<0){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: LossProtocol::writeAll(): Socket write failed: " << std::strerror(errno);
+            throw std::runtime_error(oStrStream.str());
+        }
+        numWritten += static_cast<std::size_t>(result);
+    }
+}
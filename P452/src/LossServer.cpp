@@ -0,0 +1,346 @@
+#include "P452/LossServer.h"
+#include "P452/BatchLoss.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace{
+    //wait before accepting again when the process is out of file descriptors (ms)
+    constexpr int ACCEPT_RETRY_DELAY_MS = 100;
+
+    void sendResponse(const int& connectionFd, const P452::LossProtocol::Status& status, const std::vector<double>& lossList_dB,
+            const std::string& message){
+        P452::LossProtocol::ResponseHeader response;
+        response.status = status;
+        response.numValues = static_cast<uint32_t>(lossList_dB.size());
+        response.messageSize = static_cast<uint32_t>(message.size());
+        P452::LossProtocol::writeAll(connectionFd, &response, sizeof(response));
+        P452::LossProtocol::writeAll(connectionFd, lossList_dB.data(), lossList_dB.size()*sizeof(double));
+        P452::LossProtocol::writeAll(connectionFd, message.data(), message.size());
+    }
+
+    bool isValidClutterType(const int32_t& clutterType){
+        return clutterType>=ClutterModel::ClutterType::NoClutter && clutterType<=ClutterModel::ClutterType::IndustrialZone;
+    }
+
+    //model settings within the ranges of the model, a NaN would also never match itself when the requests are grouped
+    bool isValidSettings(const P452::LossProtocol::RequestHeader& header){
+        return std::isfinite(header.freq_GHz) && header.freq_GHz>0.0
+                && header.timePercent>=0.001 && header.timePercent<=50.0
+                && (header.polariz==0 || header.polariz==1);
+    }
+
+    //requests with the same model settings can be calculated in one batch
+    bool haveSameSettings(const P452::LossProtocol::RequestHeader& first, const P452::LossProtocol::RequestHeader& second){
+        return first.freq_GHz==second.freq_GHz && first.timePercent==second.timePercent && first.polariz==second.polariz;
+    }
+}
+
+P452::LossServer::LossServer(const std::string& socketPath, TerrainModel::RasterTileCache& terrain,
+        const LossServerOptions& options, TerrainModel::ZoneClassifier* zoneClassifier):
+        m_socketPath{socketPath}, m_terrain{terrain}, m_zoneClassifier{zoneClassifier}, m_options{options},
+        m_listenFd{-1}, m_wakeFds{-1, -1}, m_numPendingLinks{0}, m_numActiveConnections{0}, m_isStopping{false}{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(socketPath.size()>=sizeof(address.sun_path)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: LossServer::LossServer(): Socket path is too long: " << socketPath;
+        throw std::invalid_argument(oStrStream.str());
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size()+1);
+
+    //replace the socket left by a previous server, but never a regular file
+    struct stat fileStatus;
+    if(::stat(socketPath.c_str(), &fileStatus)==0 && S_ISSOCK(fileStatus.st_mode)){
+        ::unlink(socketPath.c_str());
+    }
+
+    m_listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(m_listenFd<0 || ::bind(m_listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address))!=0
+            || ::listen(m_listenFd, SOMAXCONN)!=0 || ::pipe(m_wakeFds)!=0){
+        const int error = errno;
+        for(const int& fd : {m_listenFd, m_wakeFds[0], m_wakeFds[1]}){
+            if(fd>=0){
+                ::close(fd);
+            }
+        }
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: LossServer::LossServer(): Cannot listen on " << socketPath << ": " << std::strerror(error);
+        throw std::runtime_error(oStrStream.str());
+    }
+}
+
+P452::LossServer::~LossServer(){
+    stop();
+    ::close(m_listenFd);
+    ::close(m_wakeFds[0]);
+    ::close(m_wakeFds[1]);
+    ::unlink(m_socketPath.c_str());
+}
+
+void P452::LossServer::serve(){
+    std::thread batchThread(&LossServer::runBatches, this);
+    std::unordered_map<std::size_t, std::thread> connectionThreads;
+    while(true){
+        pollfd pollFds[2] = {{m_listenFd, POLLIN, 0}, {m_wakeFds[0], POLLIN, 0}};
+        const int result = ::poll(pollFds, 2, -1);
+        if(result<0 && errno==EINTR){
+            continue;
+        }
+        if(result<0 || pollFds[1].revents!=0){
+            break;
+        }
+        if((pollFds[0].revents & POLLIN)==0){
+            continue;
+        }
+        const int connectionFd = ::accept(m_listenFd, nullptr, nullptr);
+        if(connectionFd<0){
+            //without a free file descriptor the connection stays in the backlog and poll reports it again at once,
+            //so wait for connections to close instead of spinning (stop() still ends the wait)
+            if(errno==EMFILE || errno==ENFILE || errno==ENOBUFS || errno==ENOMEM){
+                pollfd wakeFd = {m_wakeFds[0], POLLIN, 0};
+                ::poll(&wakeFd, 1, ACCEPT_RETRY_DELAY_MS);
+            }
+            continue;
+        }
+        joinFinishedConnections(connectionThreads);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_isStopping){
+            ::close(connectionFd);
+            break;
+        }
+        m_connectionFds.insert(connectionFd);
+        m_numActiveConnections++;
+        const std::size_t connectionInd = m_stats.numConnections++;
+        connectionThreads.emplace(connectionInd, std::thread(&LossServer::serveConnection, this, connectionFd, connectionInd));
+    }
+
+    //the batch thread answers the waiting requests before it ends, then the connections close
+    stop();
+    batchThread.join();
+    {
+        //a client that never reads its responses blocks its connection thread in send(), shutting the socket down ends the send
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const auto shutdownTimeout = std::chrono::duration<double, std::milli>(m_options.shutdownTimeout_ms);
+        if(!m_doneCondition.wait_for(lock, shutdownTimeout, [&](){return m_numActiveConnections==0;})){
+            for(const int& connectionFd : m_connectionFds){
+                ::shutdown(connectionFd, SHUT_RDWR);
+            }
+        }
+    }
+    for(auto& [connectionInd, thread] : connectionThreads){
+        thread.join();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finishedConnections.clear();
+}
+
+void P452::LossServer::joinFinishedConnections(std::unordered_map<std::size_t, std::thread>& connectionThreads){
+    std::vector<std::size_t> finishedConnections;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        finishedConnections.swap(m_finishedConnections);
+    }
+    for(const std::size_t& connectionInd : finishedConnections){
+        const auto thread = connectionThreads.find(connectionInd);
+        thread->second.join();
+        connectionThreads.erase(thread);
+    }
+}
+
+void P452::LossServer::stop(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_isStopping){
+            return;
+        }
+        m_isStopping = true;
+        //idle connections see the end of the stream, the responses of waiting requests can still be sent
+        for(const int& connectionFd : m_connectionFds){
+            ::shutdown(connectionFd, SHUT_RD);
+        }
+    }
+    m_requestCondition.notify_all();
+    const char wakeByte = 0;
+    while(::write(m_wakeFds[1], &wakeByte, 1)<0 && errno==EINTR){
+    }
+}
+
+P452::LossServerStats P452::LossServer::stats() const{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void P452::LossServer::serveConnection(const int& connectionFd, const std::size_t& connectionInd){
+    try{
+        LossProtocol::RequestHeader header;
+        while(LossProtocol::readExact(connectionFd, &header, sizeof(header))){
+            std::ostringstream errorStream;
+            if(header.magic!=LossProtocol::MAGIC || header.version!=LossProtocol::VERSION){
+                errorStream << "Unknown protocol (magic " << header.magic << ", version " << header.version << ")";
+            }
+            else if(header.type!=LossProtocol::MessageType::CalculateLinks){
+                errorStream << "Unknown message type " << header.type;
+            }
+            else if(header.numLinks>m_options.maxRequestLinks){
+                errorStream << "Too many links: " << header.numLinks << " (at most " << m_options.maxRequestLinks << ")";
+            }
+            else if(!isValidSettings(header)){
+                errorStream << "Invalid settings (frequency " << header.freq_GHz << " GHz, time percentage " << header.timePercent
+                        << " %, polarization " << header.polariz << ")";
+            }
+            PendingRequest request;
+            request.header = header;
+            request.links.resize(errorStream.tellp()>0 ? 0 : header.numLinks);
+            if(!request.links.empty() && !LossProtocol::readExact(connectionFd, request.links.data(),
+                    request.links.size()*sizeof(LossProtocol::LinkRecord))){
+                break;
+            }
+            for(std::size_t linkInd = 0; linkInd<request.links.size() && errorStream.tellp()==0; linkInd++){
+                const LossProtocol::LinkRecord& link = request.links[linkInd];
+                if(!isValidClutterType(link.txClutterType) || !isValidClutterType(link.rxClutterType)){
+                    errorStream << "Invalid clutter type for link " << linkInd;
+                }
+            }
+            //the rest of the stream cannot be trusted after an invalid request
+            if(errorStream.tellp()>0){
+                sendResponse(connectionFd, LossProtocol::Status::InvalidRequest, {}, errorStream.str());
+                break;
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if(m_isStopping){
+                    break;
+                }
+                m_stats.numRequests++;
+                if(!request.links.empty()){
+                    m_pendingRequests.push_back(&request);
+                    m_numPendingLinks += request.links.size();
+                    m_requestCondition.notify_all();
+                    m_doneCondition.wait(lock, [&](){return request.isDone;});
+                }
+            }
+            if(request.error.empty()){
+                sendResponse(connectionFd, LossProtocol::Status::Ok, request.lossList_dB, "");
+            }
+            else{
+                sendResponse(connectionFd, LossProtocol::Status::CalculationError, {}, request.error);
+            }
+        }
+    }
+    catch(const std::exception&){
+        //a broken connection only ends this connection
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_connectionFds.erase(connectionFd);
+    ::close(connectionFd);
+    m_finishedConnections.push_back(connectionInd);
+    m_numActiveConnections--;
+    m_doneCondition.notify_all();
+}
+
+void P452::LossServer::runBatches(){
+    const auto coalescingWindow = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(m_options.coalescingWindow_ms));
+    while(true){
+        std::vector<PendingRequest*> requests;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_requestCondition.wait(lock, [&](){return m_isStopping || !m_pendingRequests.empty();});
+            if(m_pendingRequests.empty()){
+                return;
+            }
+            //give the other clients the window to join the batch
+            m_requestCondition.wait_until(lock, std::chrono::steady_clock::now()+coalescingWindow,
+                    [&](){return m_isStopping || m_numPendingLinks>=m_options.maxBatchLinks;});
+            requests.assign(m_pendingRequests.begin(), m_pendingRequests.end());
+            m_pendingRequests.clear();
+            m_numPendingLinks = 0;
+        }
+
+        //one batch per group of requests with the same settings, in arrival order
+        std::vector<bool> isCalculated(requests.size(), false);
+        for(std::size_t requestInd = 0; requestInd<requests.size(); requestInd++){
+            if(isCalculated[requestInd]){
+                continue;
+            }
+            std::vector<PendingRequest*> group{requests[requestInd]};
+            isCalculated[requestInd] = true;
+            for(std::size_t otherInd = requestInd+1; otherInd<requests.size(); otherInd++){
+                if(!isCalculated[otherInd] && haveSameSettings(requests[requestInd]->header, requests[otherInd]->header)){
+                    group.push_back(requests[otherInd]);
+                    isCalculated[otherInd] = true;
+                }
+            }
+            calculateBatch(group);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(PendingRequest* request : requests){
+                request->isDone = true;
+            }
+        }
+        m_doneCondition.notify_all();
+    }
+}
+
+void P452::LossServer::calculateBatch(const std::vector<PendingRequest*>& requests){
+    try{
+        calculateRequests(requests);
+    }
+    catch(const std::exception& err){
+        if(requests.size()==1){
+            requests.front()->error = err.what();
+        }
+        else{
+            //a bad link of one client must not fail the other requests of the batch
+            for(PendingRequest* request : requests){
+                try{
+                    calculateRequests({request});
+                }
+                catch(const std::exception& requestErr){
+                    request->error = requestErr.what();
+                }
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.numBatches++;
+}
+
+void P452::LossServer::calculateRequests(const std::vector<PendingRequest*>& requests){
+    std::vector<TerrainLink> links;
+    for(const PendingRequest* request : requests){
+        for(const auto& record : request->links){
+            links.push_back(TerrainLink{TerrainModel::GeoPoint{record.txLat_deg, record.txLon_deg},
+                    TerrainModel::GeoPoint{record.rxLat_deg, record.rxLon_deg},
+                    LinkParameters{record.txHeight_m, record.rxHeight_m, record.txHorizonGain_dBi, record.rxHorizonGain_dBi,
+                    static_cast<ClutterModel::ClutterType>(record.txClutterType),
+                    static_cast<ClutterModel::ClutterType>(record.rxClutterType)}});
+        }
+    }
+    const LossProtocol::RequestHeader& header = requests.front()->header;
+    const std::vector<double> lossList_dB = calculateP452LossFromTerrainBatch_dB(m_terrain, links, header.freq_GHz, 
+            header.timePercent, header.polariz, m_options.threadCount, m_options.maxStepDistance_km, m_zoneClassifier,
+            m_options.atmosphericTile);
+    auto lossIt = lossList_dB.begin();
+    for(PendingRequest* request : requests){
+        request->lossList_dB.assign(lossIt, lossIt+request->links.size());
+        lossIt += request->links.size();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.numLinks += links.size();
+}
@@ -1,13 +1,43 @@
 #include "P452/P452.h"
 
-#include <utility>
-#include "MainModel/Dataloader.h"
+#include <sstream>
+#include <stdexcept>
+#include "MainModel/Evaluator.h"
 #include "MainModel/P452TotalAttenuation.h"
-#include "GasModel/GasAttenuationHelpers.h"
 #include "Common/Enumerations.h"
-#include "Common/GeodeticCoord.h"
 
 
+namespace{
+    //scratch paths of the calling thread, reused by every link calculated on it
+    ITUR_P452::Evaluator& threadEvaluator(){
+        thread_local ITUR_P452::Evaluator evaluator;
+        return evaluator;
+    }
+
+    //run the clear air model on a path whose zones are already set
+    ITUR_P452::ClearAirIntermediates calculateIntermediatesFromPath(const double& txHeight_m, const double& rxHeight_m, const PathProfile::Path& p452Path,
+            const double& dist_coast_tx_km, const double& dist_coast_rx_km, const double& midpoint_lat_deg, 
+            const P452::AtmosphericParameters& atmosphere, const double& freq_GHz, const double& timePercent, const int& polariz,
+            const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi,
+            const ClutterModel::ClutterType& txClutterType, const ClutterModel::ClutterType& rxClutterType){
+
+        //convert polarization convention
+        Enumerations::PolarizationType pol;
+        if(polariz==0){//itm polarization 0 for horizontal
+            pol = Enumerations::PolarizationType::HorizontalPolarized;
+        } 
+        else{//itm polarization 1 for vertical
+            pol = Enumerations::PolarizationType::VerticalPolarized;
+        }
+
+        //use ITU-R P.452-17
+        return threadEvaluator().calcIntermediates(freq_GHz, timePercent, p452Path, 
+                txHeight_m, rxHeight_m, midpoint_lat_deg, txHorizonGain_dBi, 
+                rxHorizonGain_dBi, pol, dist_coast_tx_km, dist_coast_rx_km, atmosphere.deltaN, atmosphere.surfaceRefractivity,
+                atmosphere.temp_K, atmosphere.dryPressure_hPa, txClutterType, rxClutterType);
+    }
+}
+
 double P452::calculateP452Loss_dB(const double& txHeight_m, const double& rxHeight_m, 
             const std::vector<double>& elevationList_m, const double& stepDistance_km, 
             const double& midpoint_lat_deg, const double& midpoint_lon_deg,
@@ -15,54 +45,106 @@ double P452::calculateP452Loss_dB(const double& txHeight_m, const double& rxHeig
             const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi,
             const ClutterModel::ClutterType& txClutterType, const ClutterModel::ClutterType& rxClutterType){
 
-    //path creation
-    PathProfile::Path p452Path;
-    double dist_coast_tx_km,dist_coast_rx_km;
-    createP452Path(elevationList_m, stepDistance_km, p452Path, dist_coast_tx_km, dist_coast_rx_km);
-
     //approximate midpoint height (might not be exactly the midpoint if there are an even number of points)
     //we could check if its even and do an average of the two middle points but I don't think that's worth it
     const double midpointHeight_km = elevationList_m[elevationList_m.size()/2]/1000.0;
 
     //get deltaN, N0 (surfaceRefractivity) from data map
-    //convert coordinate to itumodels format
-    const GeodeticCoord midpointCoord = GeodeticCoord(midpoint_lon_deg, midpoint_lat_deg, midpointHeight_km);
-    const double deltaN = ITUR_P452::DataLoader::fetchRadioRefractivityIndexLapseRate(midpointCoord);
-    const double surfaceRefractivity = ITUR_P452::DataLoader::fetchSeaLevelSurfaceRefractivity(midpointCoord);
-
     //Get temp_K, dryPressure from standard atmosphere sources
     //assuming summer, mid latitude for Kuwait
-    double temp_K, totalPressure_hPa, waterVapor_hPa;
+    const AtmosphericParameters atmosphere = fetchAtmosphericParameters(midpoint_lat_deg, midpoint_lon_deg, 
+            midpointHeight_km, Enumerations::Season::SummerTime);
 
-    GasAttenuationHelpers::setSeasonalAtmosphericTermsForUsLocation(midpointCoord, 
-                temp_K, totalPressure_hPa, waterVapor_hPa, Enumerations::Season::SummerTime);
+    return calculateP452Loss_dB(txHeight_m, rxHeight_m, elevationList_m, stepDistance_km, midpoint_lat_deg, atmosphere,
+            freq_GHz, timePercent, polariz, txHorizonGain_dBi, rxHorizonGain_dBi, txClutterType, rxClutterType);
+}
 
-    const double dryPressure_hPa = totalPressure_hPa - waterVapor_hPa;
+double P452::calculateP452Loss_dB(const double& txHeight_m, const double& rxHeight_m, 
+            std::span<const double> elevationList_m, const double& stepDistance_km, 
+            const double& midpoint_lat_deg, const AtmosphericParameters& atmosphere,
+            const double& freq_GHz, const double& timePercent, const int& polariz,
+            const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi,
+            const ClutterModel::ClutterType& txClutterType, const ClutterModel::ClutterType& rxClutterType){
 
-    //convert polarization convention
-    Enumerations::PolarizationType pol;
-    if(polariz==0){//itm polarization 0 for horizontal
-        pol = Enumerations::PolarizationType::HorizontalPolarized;
-    } 
-    else{//itm polarization 1 for vertical
-        pol = Enumerations::PolarizationType::VerticalPolarized;
-    }
+    return calculateP452Intermediates(txHeight_m, rxHeight_m, elevationList_m, stepDistance_km, midpoint_lat_deg, atmosphere,
+            freq_GHz, timePercent, polariz, txHorizonGain_dBi, rxHorizonGain_dBi, txClutterType, rxClutterType).totalLoss_dB;
+}
 
-    //use ITU-R P.452-17
-    const auto p452Model = ITUR_P452::TotalClearAirAttenuation(freq_GHz, timePercent, p452Path, 
-            txHeight_m, rxHeight_m, midpoint_lat_deg, txHorizonGain_dBi, 
-            rxHorizonGain_dBi, pol, dist_coast_tx_km, dist_coast_rx_km, deltaN, surfaceRefractivity,
-            temp_K, dryPressure_hPa, txClutterType, rxClutterType);
+double P452::calculateP452Loss_dB(const double& txHeight_m, const double& rxHeight_m, 
+            std::span<const double> elevationList_m, std::span<const PathProfile::ZoneType> zoneList,
+            const double& dist_coast_tx_km, const double& dist_coast_rx_km, const double& stepDistance_km, 
+            const double& midpoint_lat_deg, const AtmosphericParameters& atmosphere,
+            const double& freq_GHz, const double& timePercent, const int& polariz,
+            const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi,
+            const ClutterModel::ClutterType& txClutterType, const ClutterModel::ClutterType& rxClutterType){
 
-    return p452Model.calcTotalClearAirAttenuation();
+    return calculateP452Intermediates(txHeight_m, rxHeight_m, elevationList_m, zoneList, dist_coast_tx_km, dist_coast_rx_km, 
+            stepDistance_km, midpoint_lat_deg, atmosphere, freq_GHz, timePercent, polariz, txHorizonGain_dBi, rxHorizonGain_dBi, 
+            txClutterType, rxClutterType).totalLoss_dB;
 }
 
-void P452::createP452Path(const std::vector<double>& elevationList_m, const double& stepDistance_km,
+ITUR_P452::ClearAirIntermediates P452::calculateP452Intermediates(const double& txHeight_m, const double& rxHeight_m, 
+            std::span<const double> elevationList_m, const double& stepDistance_km, 
+            const double& midpoint_lat_deg, const AtmosphericParameters& atmosphere,
+            const double& freq_GHz, const double& timePercent, const int& polariz,
+            const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi,
+            const ClutterModel::ClutterType& txClutterType, const ClutterModel::ClutterType& rxClutterType){
+
+    //path creation
+    PathProfile::Path& p452Path = threadEvaluator().inputPath();
+    double dist_coast_tx_km,dist_coast_rx_km;
+    createP452Path(elevationList_m, stepDistance_km, p452Path, dist_coast_tx_km, dist_coast_rx_km);
+
+    return calculateIntermediatesFromPath(txHeight_m, rxHeight_m, p452Path, dist_coast_tx_km, dist_coast_rx_km, midpoint_lat_deg, 
+            atmosphere, freq_GHz, timePercent, polariz, txHorizonGain_dBi, rxHorizonGain_dBi, txClutterType, rxClutterType);
+}
+
+ITUR_P452::ClearAirIntermediates P452::calculateP452Intermediates(const double& txHeight_m, const double& rxHeight_m, 
+            std::span<const double> elevationList_m, std::span<const PathProfile::ZoneType> zoneList,
+            const double& dist_coast_tx_km, const double& dist_coast_rx_km, const double& stepDistance_km, 
+            const double& midpoint_lat_deg, const AtmosphericParameters& atmosphere,
+            const double& freq_GHz, const double& timePercent, const int& polariz,
+            const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi,
+            const ClutterModel::ClutterType& txClutterType, const ClutterModel::ClutterType& rxClutterType){
+
+    PathProfile::Path& p452Path = threadEvaluator().inputPath();
+    createP452Path(elevationList_m, zoneList, stepDistance_km, p452Path);
+
+    return calculateIntermediatesFromPath(txHeight_m, rxHeight_m, p452Path, dist_coast_tx_km, dist_coast_rx_km, midpoint_lat_deg, 
+            atmosphere, freq_GHz, timePercent, polariz, txHorizonGain_dBi, rxHorizonGain_dBi, txClutterType, rxClutterType);
+}
+
+double P452::calculateP452LossFromTerrain_dB(TerrainModel::RasterTileCache& terrain, 
+            const TerrainModel::GeoPoint& tx, const TerrainModel::GeoPoint& rx,
+            const double& txHeight_m, const double& rxHeight_m,
+            const double& freq_GHz, const double& timePercent, const int& polariz,
+            const double& txHorizonGain_dBi, const double& rxHorizonGain_dBi,
+            const ClutterModel::ClutterType& txClutterType, const ClutterModel::ClutterType& rxClutterType,
+            const double& maxStepDistance_km, TerrainModel::ZoneClassifier* zoneClassifier){
+
+    const auto profile = TerrainModel::sampleGreatCircleProfile(terrain, tx, rx, maxStepDistance_km, zoneClassifier);
+
+    if(zoneClassifier!=nullptr){
+        const double midpointHeight_km = profile.elevationList_m[profile.elevationList_m.size()/2]/1000.0;
+        const AtmosphericParameters atmosphere = fetchAtmosphericParameters(profile.midpoint.lat_deg, profile.midpoint.lon_deg, 
+                midpointHeight_km, Enumerations::Season::SummerTime);
+        return calculateP452Loss_dB(txHeight_m, rxHeight_m, profile.elevationList_m, profile.zoneList, 
+                profile.txDistanceToCoast_km, profile.rxDistanceToCoast_km, profile.stepDistance_km, profile.midpoint.lat_deg, 
+                atmosphere, freq_GHz, timePercent, polariz, txHorizonGain_dBi, rxHorizonGain_dBi, txClutterType, rxClutterType);
+    }
+    return calculateP452Loss_dB(txHeight_m, rxHeight_m, profile.elevationList_m, profile.stepDistance_km, 
+            profile.midpoint.lat_deg, profile.midpoint.lon_deg, freq_GHz, timePercent, polariz, 
+            txHorizonGain_dBi, rxHorizonGain_dBi, txClutterType, rxClutterType);
+}
+
+void P452::createP452Path(std::span<const double> elevationList_m, const double& stepDistance_km,
         PathProfile::Path& out_path, double& out_dist_coast_tx_km, double& out_dist_coast_rx_km){
    
     //Step 1 convert elevation to path
-    //create a new path
-    PathProfile::Path newPath;
+    //fill the output path, reusing its memory
+    PathProfile::Path& newPath = out_path;
+    newPath.clear();
+    newPath.reserve(elevationList_m.size());
 
     //assume starting zone is inland or sea
     double distance_km = 0;
@@ -144,6 +226,18 @@ void P452::createP452Path(const std::vector<double>& elevationList_m, const doub
         }
         //if the end of the loop is reached, keep default large value of 500km
     }
+}
 
-    out_path = std::move(newPath);
+void P452::createP452Path(std::span<const double> elevationList_m, std::span<const PathProfile::ZoneType> zoneList,
+        const double& stepDistance_km, PathProfile::Path& out_path){
+    if(zoneList.size()!=elevationList_m.size()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: P452::createP452Path(): Expected " << elevationList_m.size() << " zone types, got " << zoneList.size();
+        throw std::invalid_argument(oStrStream.str());
+    }
+    out_path.clear();
+    out_path.reserve(elevationList_m.size());
+    for(std::size_t pointInd = 0; pointInd<elevationList_m.size(); pointInd++){
+        out_path.push_back(PathProfile::ProfilePoint(pointInd*stepDistance_km, elevationList_m[pointInd], zoneList[pointInd]));
+    }
 }
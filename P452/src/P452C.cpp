@@ -0,0 +1,194 @@
+#include "P452/P452C.h"
+#include "P452/AtmosphericTile.h"
+#include "P452/BatchLoss.h"
+#include "TerrainModel/RasterTileCache.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct p452_context{
+    std::unique_ptr<TerrainModel::RasterTileCache> terrain;    //nullptr without a DEM directory
+    std::optional<P452::AtmosphericTile> atmosphericTile;
+    unsigned int threadCount;
+    double maxStepDistance_km;
+};
+
+namespace{
+    thread_local std::string lastError;
+
+    p452_status fail(const p452_status& status, const std::string& message){
+        lastError = message;
+        return status;
+    }
+
+    //runs a call of the C interface, exceptions are turned into status codes
+    template<typename Call>
+    p452_status runCall(const Call& call){
+        lastError.clear();
+        try{
+            return call();
+        }
+        catch(const std::bad_alloc&){
+            return fail(P452_ERROR_OUT_OF_MEMORY, "ERROR: Out of memory");
+        }
+        catch(const std::invalid_argument& err){
+            return fail(P452_ERROR_INVALID_ARGUMENT, err.what());
+        }
+        catch(const std::domain_error& err){
+            return fail(P452_ERROR_INVALID_ARGUMENT, err.what());
+        }
+        catch(const std::exception& err){
+            return fail(P452_ERROR_CALCULATION, err.what());
+        }
+        catch(...){
+            return fail(P452_ERROR_CALCULATION, "ERROR: Unknown error");
+        }
+    }
+
+    //the caller's struct_size must be a layout of the structure this library knows. There is only one layout of every
+    //structure so far, when a field is added the older sizes are accepted and the new field is only read if struct_size covers it
+    template<typename Struct>
+    void checkStructSize(const Struct& value, const char* functionName, const char* structName){
+        if(value.struct_size!=sizeof(Struct)){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: " << functionName << "(): " << structName << ".struct_size is " << value.struct_size
+                        << ", this library (ABI version " << P452_C_ABI_VERSION << ") expects " << sizeof(Struct);
+            throw std::invalid_argument(oStrStream.str());
+        }
+    }
+
+    template<typename T>
+    std::span<const T> column(const T* values, const size_t& numValues, const char* columnName){
+        if(values==nullptr && numValues!=0){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: p452_calculate_profile_batch(): Column " << columnName << " is NULL but holds " << numValues << " values";
+            throw std::invalid_argument(oStrStream.str());
+        }
+        return std::span<const T>(values, numValues);
+    }
+}
+
+uint32_t p452_abi_version(void){
+    return P452_C_ABI_VERSION;
+}
+
+const char* p452_last_error(void){
+    return lastError.c_str();
+}
+
+p452_status p452_context_create(const p452_context_options* options, p452_context** context){
+    if(context==nullptr){
+        return fail(P452_ERROR_INVALID_ARGUMENT, "ERROR: p452_context_create(): context is NULL");
+    }
+    *context = nullptr;
+    return runCall([&](){
+        if(options!=nullptr){
+            checkStructSize(*options, "p452_context_create", "p452_context_options");
+        }
+        auto newContext = std::make_unique<p452_context>();
+        newContext->threadCount = (options!=nullptr) ? options->thread_count : 0;
+        newContext->maxStepDistance_km = (options!=nullptr && options->max_step_distance_km>0.0)
+                ? options->max_step_distance_km : TerrainModel::DEFAULT_PROFILE_STEP_KM;
+        if(options!=nullptr && options->dem_directory!=nullptr){
+            newContext->terrain = std::make_unique<TerrainModel::RasterTileCache>(options->dem_directory);
+        }
+        if(options!=nullptr && options->atmospheric_tile_path!=nullptr){
+            newContext->atmosphericTile = P452::AtmosphericTile::load(options->atmospheric_tile_path);
+        }
+        *context = newContext.release();
+        return P452_OK;
+    });
+}
+
+void p452_context_destroy(p452_context* context){
+    delete context;
+}
+
+p452_status p452_calculate_profile_batch(p452_context* context, const p452_profile_columns* links, int polariz,
+        double* losses_db, size_t num_losses){
+    return runCall([&](){
+        if(context==nullptr || links==nullptr || (losses_db==nullptr && num_losses!=0)){
+            return fail(P452_ERROR_INVALID_ARGUMENT, "ERROR: p452_calculate_profile_batch(): context, links or losses_db is NULL");
+        }
+        checkStructSize(*links, "p452_calculate_profile_batch", "p452_profile_columns");
+        const P452::LinkColumns columns{column(links->heights_m, links->num_heights, "heights_m"),
+                column(links->offsets, links->num_offsets, "offsets"),
+                column(links->step_distances_km, links->num_step_distances, "step_distances_km"),
+                column(links->midpoint_lats_deg, links->num_midpoint_lats, "midpoint_lats_deg"),
+                column(links->midpoint_lons_deg, links->num_midpoint_lons, "midpoint_lons_deg"),
+                column(links->tx_heights_m, links->num_tx_heights, "tx_heights_m"),
+                column(links->rx_heights_m, links->num_rx_heights, "rx_heights_m"),
+                column(links->freqs_ghz, links->num_freqs, "freqs_ghz"),
+                column(links->time_percents, links->num_time_percents, "time_percents"),
+                column(links->tx_horizon_gains_dbi, links->num_tx_horizon_gains, "tx_horizon_gains_dbi"),
+                column(links->rx_horizon_gains_dbi, links->num_rx_horizon_gains, "rx_horizon_gains_dbi"),
+                column(links->tx_clutter_types, links->num_tx_clutter_types, "tx_clutter_types"),
+                column(links->rx_clutter_types, links->num_rx_clutter_types, "rx_clutter_types")};
+        P452::calculateP452LossColumns_dB(columns, std::span<double>(losses_db, num_losses), polariz, context->threadCount);
+        return P452_OK;
+    });
+}
+
+p452_status p452_calculate_terrain_batch(p452_context* context, const p452_terrain_columns* links,
+        double freq_ghz, double time_percent, int polariz, double* losses_db, size_t num_losses){
+    return runCall([&](){
+        if(context==nullptr || links==nullptr){
+            return fail(P452_ERROR_INVALID_ARGUMENT, "ERROR: p452_calculate_terrain_batch(): context or links is NULL");
+        }
+        checkStructSize(*links, "p452_calculate_terrain_batch", "p452_terrain_columns");
+        if(context->terrain==nullptr){
+            return fail(P452_ERROR_NO_TERRAIN, "ERROR: p452_calculate_terrain_batch(): The context was created without a DEM directory");
+        }
+        if(num_losses!=links->num_links){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: p452_calculate_terrain_batch(): Expected room for " << links->num_links << " losses, got " << num_losses;
+            return fail(P452_ERROR_INVALID_ARGUMENT, oStrStream.str());
+        }
+        if(links->num_links==0){
+            return P452_OK;
+        }
+        if(losses_db==nullptr || links->tx_lats_deg==nullptr || links->tx_lons_deg==nullptr || links->rx_lats_deg==nullptr
+                || links->rx_lons_deg==nullptr || links->tx_heights_m==nullptr || links->rx_heights_m==nullptr){
+            return fail(P452_ERROR_INVALID_ARGUMENT, "ERROR: p452_calculate_terrain_batch(): A required array is NULL");
+        }
+
+        std::vector<P452::TerrainLink> terrainLinks(links->num_links);
+        for(size_t linkInd = 0; linkInd<links->num_links; linkInd++){
+            P452::TerrainLink& link = terrainLinks[linkInd];
+            link.tx = TerrainModel::GeoPoint{links->tx_lats_deg[linkInd], links->tx_lons_deg[linkInd]};
+            link.rx = TerrainModel::GeoPoint{links->rx_lats_deg[linkInd], links->rx_lons_deg[linkInd]};
+            link.parameters.txHeight_m = links->tx_heights_m[linkInd];
+            link.parameters.rxHeight_m = links->rx_heights_m[linkInd];
+            link.parameters.txHorizonGain_dBi = (links->tx_horizon_gains_dbi!=nullptr) ? links->tx_horizon_gains_dbi[linkInd] : 0.0;
+            link.parameters.rxHorizonGain_dBi = (links->rx_horizon_gains_dbi!=nullptr) ? links->rx_horizon_gains_dbi[linkInd] : 0.0;
+            for(const auto& [clutterTypes, linkClutterType] : {std::pair{links->tx_clutter_types, &link.parameters.txClutterType},
+                    std::pair{links->rx_clutter_types, &link.parameters.rxClutterType}}){
+                if(clutterTypes==nullptr){
+                    continue;
+                }
+                if(clutterTypes[linkInd]<ClutterModel::ClutterType::NoClutter || clutterTypes[linkInd]>ClutterModel::ClutterType::IndustrialZone){
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: p452_calculate_terrain_batch(): Invalid clutter type " << clutterTypes[linkInd]
+                                << " for link " << linkInd;
+                    return fail(P452_ERROR_INVALID_ARGUMENT, oStrStream.str());
+                }
+                *linkClutterType = static_cast<ClutterModel::ClutterType>(clutterTypes[linkInd]);
+            }
+        }
+
+        const std::vector<double> lossList_dB = P452::calculateP452LossFromTerrainBatch_dB(*context->terrain, terrainLinks, freq_ghz,
+                time_percent, polariz, context->threadCount, context->maxStepDistance_km, nullptr,
+                context->atmosphericTile ? &*context->atmosphericTile : nullptr);
+        std::copy(lossList_dB.begin(), lossList_dB.end(), losses_db);
+        return P452_OK;
+    });
+}
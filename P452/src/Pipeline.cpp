@@ -0,0 +1,179 @@
+#include "P452/Pipeline.h"
+#include "P452/ProfileSource.h"
+#include "MainModel/BoundedQueue.h"
+
+#include "Common/Enumerations.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace{
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(const Clock::time_point& start){
+        return std::chrono::duration<double>(Clock::now()-start).count();
+    }
+
+    //buffers of one chunk, cycled through all stages and back to the profile extraction
+    struct PipelineChunk{
+        P452::LinkBatch batch;
+        std::vector<double> lossList_dB;
+    };
+    using ChunkQueue = ITUR_P452::BoundedQueue<PipelineChunk*>;
+
+    //Takes chunks from the input queue until it is closed and empty (or the pipeline is aborted), processes them and
+    //passes them to the output queue, which is closed at the end. The stage also stops if work returns false
+    template<typename StageWork>
+    void runStage(ChunkQueue& input, ChunkQueue& output, P452::StageMetrics& metrics, const std::atomic<bool>& isAborted,
+            StageWork work){
+        std::size_t queueDepthSum = 0;
+        PipelineChunk* chunk;
+        while(true){
+            const auto waitStart = Clock::now();
+            const std::size_t queueDepth = input.size();
+            if(!input.pop(chunk) || isAborted.load(std::memory_order_relaxed)){
+                break;
+            }
+            metrics.waitTime_s += secondsSince(waitStart);
+            queueDepthSum += queueDepth;
+            metrics.maxQueueDepth = std::max(metrics.maxQueueDepth, queueDepth);
+
+            const auto busyStart = Clock::now();
+            const bool hasLinks = work(*chunk);
+            metrics.busyTime_s += secondsSince(busyStart);
+            if(!hasLinks){
+                break;
+            }
+            metrics.numChunks++;
+            metrics.numLinks += chunk->batch.size();
+            metrics.meanQueueDepth = static_cast<double>(queueDepthSum)/metrics.numChunks;
+            output.push(chunk);
+        }
+        output.close();
+    }
+}
+
+P452::PipelineMetrics P452::calculateP452LossPipeline_dB(ProfileSource& source, const double& freq_GHz, const double& timePercent,
+        const LossSink& sink, const int& polariz, const PipelineOptions& options){
+    if(options.chunkSize==0 || options.chunksInFlight==0){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: calculateP452LossPipeline_dB(): The chunk size and the number of chunks in flight must be positive, got "
+                    << options.chunkSize << " and " << options.chunksInFlight;
+        throw std::invalid_argument(oStrStream.str());
+    }
+    const auto pipelineStart = Clock::now();
+    PipelineMetrics metrics;
+
+    //freeChunks -> extraction -> extractedChunks -> lookup -> atmosphereChunks -> evaluation -> calculatedChunks -> writing -> freeChunks
+    std::vector<PipelineChunk> chunkPool(options.chunksInFlight);
+    ChunkQueue freeChunks(options.chunksInFlight);
+    ChunkQueue extractedChunks(options.chunksInFlight);
+    ChunkQueue atmosphereChunks(options.chunksInFlight);
+    ChunkQueue calculatedChunks(options.chunksInFlight);
+    for(auto& chunk : chunkPool){
+        freeChunks.tryPush(&chunk);
+    }
+
+    std::atomic<bool> isAborted{false};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+    //the first failing stage stops every stage, the chunks left in the queues are dropped
+    auto abort = [&](){
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if(!firstError){
+                firstError = std::current_exception();
+            }
+        }
+        isAborted = true;
+        for(ChunkQueue* queue : {&freeChunks, &extractedChunks, &atmosphereChunks, &calculatedChunks}){
+            queue->close();
+        }
+    };
+
+    std::size_t nextLinkInd = 0;
+    auto extractProfiles = [&](PipelineChunk& chunk){
+        if(!source.next(chunk.batch, options.chunkSize)){
+            return false;
+        }
+        chunk.batch.firstLinkInd = nextLinkInd;
+        nextLinkInd += chunk.batch.size();
+        return true;
+    };
+
+    auto lookupAtmospheres = [&](PipelineChunk& chunk){
+        LinkBatch& batch = chunk.batch;
+        if(!batch.atmospheres.empty()){
+            return true;
+        }
+        batch.atmospheres.resize(batch.size());
+        for(std::size_t linkInd = 0; linkInd<batch.size(); linkInd++){
+            const TerrainModel::GeoPoint& midpoint = batch.profiles.midpoints[linkInd];
+            if(options.atmosphericTile!=nullptr){
+                batch.atmospheres[linkInd] = options.atmosphericTile->lookup(midpoint.lat_deg, midpoint.lon_deg);
+            }
+            else{
+                //same midpoint height approximation as calculateP452LossBatch_dB, which also refuses these profiles
+                const auto heights_m = batch.profiles.heights(linkInd);
+                if(heights_m.size()<PathProfile::MIN_PROFILE_POINTS){
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: calculateP452LossPipeline_dB(): Profile " << batch.firstLinkInd+linkInd << " has less than "
+                                << PathProfile::MIN_PROFILE_POINTS << " points";
+                    throw std::invalid_argument(oStrStream.str());
+                }
+                batch.atmospheres[linkInd] = fetchAtmosphericParameters(midpoint.lat_deg, midpoint.lon_deg,
+                        heights_m[heights_m.size()/2]/1000.0, Enumerations::Season::SummerTime);
+            }
+        }
+        return true;
+    };
+
+    auto evaluateModel = [&](PipelineChunk& chunk){
+        chunk.lossList_dB = calculateP452LossBatch_dB(chunk.batch.profiles, chunk.batch.links, freq_GHz, timePercent, polariz,
+                chunk.batch.atmospheres, options.threadCount, options.pinThreads);
+        return true;
+    };
+
+    auto writeResults = [&](PipelineChunk& chunk){
+        sink(chunk.batch.firstLinkInd, chunk.lossList_dB);
+        return true;
+    };
+
+    auto runStageThread = [&](ChunkQueue& input, ChunkQueue& output, const PipelineStage& stage, auto work){
+        return std::thread([&, stage, work](){
+            try{
+                runStage(input, output, metrics.stages[stage], isAborted, work);
+            }
+            catch(...){
+                abort();
+            }
+        });
+    };
+    std::vector<std::thread> stageThreads;
+    stageThreads.push_back(runStageThread(freeChunks, extractedChunks, PipelineStage::ProfileExtraction, extractProfiles));
+    stageThreads.push_back(runStageThread(extractedChunks, atmosphereChunks, PipelineStage::AtmosphericLookup, lookupAtmospheres));
+    stageThreads.push_back(runStageThread(atmosphereChunks, calculatedChunks, PipelineStage::ModelEvaluation, evaluateModel));
+    try{
+        runStage(calculatedChunks, freeChunks, metrics.stages[PipelineStage::ResultWriting], isAborted, writeResults);
+    }
+    catch(...){
+        abort();
+    }
+    for(auto& thread : stageThreads){
+        thread.join();
+    }
+    if(firstError){
+        std::rethrow_exception(firstError);
+    }
+
+    metrics.numLinks = metrics.stages[PipelineStage::ResultWriting].numLinks;
+    metrics.wallTime_s = secondsSince(pipelineStart);
+    return metrics;
+}
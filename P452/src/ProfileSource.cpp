@@ -0,0 +1,115 @@
+#include "P452/ProfileSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+////////////////////////////////
+// CallbackProfileSource
+
+P452::CallbackProfileSource::CallbackProfileSource(LinkGenerator generator):
+        m_generator{std::move(generator)}, m_isExhausted{false}{
+}
+
+bool P452::CallbackProfileSource::next(LinkBatch& out_batch, const std::size_t& maxLinks){
+    out_batch.clear();
+    while(!m_isExhausted && out_batch.size()<maxLinks){
+        const std::size_t prevSize = out_batch.size();
+        m_isExhausted = !m_generator(out_batch);
+        if(!m_isExhausted && (out_batch.size()!=prevSize+1 || out_batch.links.size()!=out_batch.size()
+                || (!out_batch.atmospheres.empty() && out_batch.atmospheres.size()!=out_batch.size()))){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: CallbackProfileSource::next(): The generator must append exactly one profile and one link parameter "
+                        << "entry (and one atmosphere entry if atmospheres are given) per call";
+            throw std::logic_error(oStrStream.str());
+        }
+    }
+    return !out_batch.empty();
+}
+
+////////////////////////////////
+// DemProfileSource
+
+P452::DemProfileSource::DemProfileSource(TerrainModel::RasterTileCache& terrain, const TerrainModel::GeoPoint& origin,
+        std::span<const TerrainModel::GeoPoint> destinations, std::span<const LinkParameters> links,
+        const double& maxStepDistance_km, TerrainModel::ZoneClassifier* zoneClassifier):
+        m_sampler{terrain, maxStepDistance_km, zoneClassifier}, m_origin{origin}, m_destinations{destinations},
+        m_links(links.begin(), links.end()), m_nextLinkInd{0}{
+    if(m_links.size()!=1 && m_links.size()!=m_destinations.size()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: DemProfileSource::DemProfileSource(): Expected 1 or " << m_destinations.size()
+                    << " link parameters, got " << m_links.size();
+        throw std::invalid_argument(oStrStream.str());
+    }
+}
+
+bool P452::DemProfileSource::next(LinkBatch& out_batch, const std::size_t& maxLinks){
+    out_batch.clear();
+    const std::size_t numLinks = std::min(maxLinks, m_destinations.size()-m_nextLinkInd);
+    if(numLinks==0){
+        return false;
+    }
+    m_sampler.sample(m_origin, m_destinations.subspan(m_nextLinkInd, numLinks), out_batch.profiles);
+    if(m_links.size()==1){
+        out_batch.links.assign(numLinks, m_links.front());
+    }
+    else{
+        out_batch.links.assign(m_links.begin()+m_nextLinkInd, m_links.begin()+m_nextLinkInd+numLinks);
+    }
+    m_nextLinkInd += numLinks;
+    return true;
+}
+
+////////////////////////////////
+// ArchiveProfileSource
+
+P452::ArchiveProfileSource::ArchiveProfileSource(const std::string& archivePath, LinkInfoCallback linkInfo):
+        m_archive{archivePath}, m_linkInfo{std::move(linkInfo)}, m_hasZones{m_archive.numPoints()>0}, m_nextProfileInd{0}{
+    //zones are only used if every point has one, so all chunks are consistent
+    for(std::size_t profileInd = 0; profileInd<m_archive.size() && m_hasZones; profileInd++){
+        const auto zones = m_archive[profileInd].zones();
+        m_hasZones = std::find(zones.begin(), zones.end(), 0)==zones.end();
+    }
+}
+
+bool P452::ArchiveProfileSource::next(LinkBatch& out_batch, const std::size_t& maxLinks){
+    out_batch.clear();
+    for(; m_nextProfileInd<m_archive.size() && out_batch.size()<maxLinks; m_nextProfileInd++){
+        const PathProfile::ProfileView profile = m_archive.at(m_nextProfileInd);
+        if(profile.size()<2){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ArchiveProfileSource::next(): Profile " << m_nextProfileInd << " has less than 2 points";
+            throw std::runtime_error(oStrStream.str());
+        }
+        //the clear air model interface expects a constant step distance
+        const double distance_km = profile.d_km(profile.size()-1)-profile.d_km(0);
+        const double stepDistance_km = distance_km/(profile.size()-1);
+        m_heights_m.resize(profile.size());
+        for(std::size_t pointInd = 0; pointInd<profile.size(); pointInd++){
+            if(std::abs(profile.d_km(pointInd)-profile.d_km(0)-pointInd*stepDistance_km)>1e-3*stepDistance_km){
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ArchiveProfileSource::next(): Profile " << m_nextProfileInd
+                            << " is not uniformly spaced at point " << pointInd;
+                throw std::runtime_error(oStrStream.str());
+            }
+            m_heights_m[pointInd] = profile.h_asl_m(pointInd);
+        }
+
+        const ArchiveLinkInfo info = m_linkInfo(m_nextProfileInd);
+        if(m_hasZones){
+            m_zones.resize(profile.size());
+            for(std::size_t pointInd = 0; pointInd<profile.size(); pointInd++){
+                m_zones[pointInd] = profile.zone(pointInd);
+            }
+            out_batch.profiles.append(m_heights_m, m_zones, stepDistance_km, distance_km, info.midpoint,
+                    info.txDistanceToCoast_km, info.rxDistanceToCoast_km);
+        }
+        else{
+            out_batch.profiles.append(m_heights_m, stepDistance_km, distance_km, info.midpoint);
+        }
+        out_batch.links.push_back(info.link);
+    }
+    return !out_batch.empty();
+}
@@ -0,0 +1,395 @@
+#include "P452/ShardedBatch.h"
+#include "TerrainModel/GreatCircle.h"
+#include "TerrainModel/SharedTileSet.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace{
+    constexpr char ShardMagic[8] = {'P','4','5','2','S','H','D','1'};
+
+    struct ShardHeader{
+        char magic[8];
+        uint64_t shardInd;
+        uint64_t firstLink;
+        uint64_t numLinks;
+        uint64_t fingerprint;   //of the links and settings the shard was calculated with
+    };
+
+    //distance between the path points used to find the DEM tiles crossed by a link (km)
+    constexpr double TileSearchStep_km = 10.0;
+
+    /// @brief 64 bit FNV-1a hash
+    class Fingerprint{
+    public:
+        template<typename T>
+        void add(const T& value){
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            for(const unsigned char& byte : bytes){
+                m_hash = (m_hash^byte)*1099511628211ull;
+            }
+        }
+        void add(const std::string& text){
+            add(text.size());
+            for(const char& character : text){
+                add(character);
+            }
+        }
+        uint64_t value() const {return m_hash;}
+
+    private:
+        uint64_t m_hash = 14695981039346656037ull;
+    };
+
+    struct ShardSettings{
+        std::string demDirectory;
+        double freq_GHz;
+        double timePercent;
+        int polariz;
+        double maxStepDistance_km;
+        TerrainModel::MissingTilePolicy missingTilePolicy;
+    };
+
+    uint64_t shardFingerprint(std::span<const P452::TerrainLink> links, const ShardSettings& settings){
+        Fingerprint fingerprint;
+        fingerprint.add(settings.demDirectory);
+        fingerprint.add(settings.freq_GHz);
+        fingerprint.add(settings.timePercent);
+        fingerprint.add(settings.polariz);
+        fingerprint.add(settings.maxStepDistance_km);
+        fingerprint.add(static_cast<int>(settings.missingTilePolicy));
+        for(const P452::TerrainLink& link : links){
+            fingerprint.add(link.tx.lat_deg);
+            fingerprint.add(link.tx.lon_deg);
+            fingerprint.add(link.rx.lat_deg);
+            fingerprint.add(link.rx.lon_deg);
+            fingerprint.add(link.parameters.txHeight_m);
+            fingerprint.add(link.parameters.rxHeight_m);
+            fingerprint.add(link.parameters.txHorizonGain_dBi);
+            fingerprint.add(link.parameters.rxHorizonGain_dBi);
+            fingerprint.add(static_cast<int>(link.parameters.txClutterType));
+            fingerprint.add(static_cast<int>(link.parameters.rxClutterType));
+        }
+        return fingerprint.value();
+    }
+
+    std::filesystem::path shardPath(const std::filesystem::path& workDirectory, const std::size_t& shardInd, const std::string& extension){
+        return workDirectory/("shard_"+std::to_string(shardInd)+extension);
+    }
+
+    /// @brief Read the losses of a complete shard file
+    /// @return False if the file is missing, truncated or was calculated for other links or settings
+    bool readShardFile(const std::filesystem::path& filePath, const ShardHeader& expected, std::vector<double>& lossList_dB){
+        std::ifstream file(filePath, std::ios::binary);
+        ShardHeader header;
+        if(!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                || std::memcmp(header.magic, ShardMagic, sizeof(ShardMagic))!=0 || header.shardInd!=expected.shardInd
+                || header.firstLink!=expected.firstLink || header.numLinks!=expected.numLinks
+                || header.fingerprint!=expected.fingerprint){
+            return false;
+        }
+        lossList_dB.resize(header.numLinks);
+        if(!file.read(reinterpret_cast<char*>(lossList_dB.data()), static_cast<std::streamsize>(lossList_dB.size()*sizeof(double)))
+                || file.peek()!=std::ifstream::traits_type::eof()){
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Write a file under a temporary name, then rename it, so readers never see a partial file
+    template<typename WriteContent>
+    void writeAtomically(const std::filesystem::path& filePath, const std::ios::openmode& mode, const WriteContent& writeContent){
+        const std::filesystem::path tempPath = filePath.string()+".tmp";
+        {
+            std::ofstream file(tempPath, mode | std::ios::trunc);
+            writeContent(file);
+            file.flush();
+            if(!file){
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: runShardedP452Batch(): Failed to write \"" << tempPath.string() << "\"";
+                throw std::runtime_error(oStrStream.str());
+            }
+        }
+        std::filesystem::rename(tempPath, filePath);
+    }
+
+    /// @brief Body of a worker process: calculate one shard and write its file, never returns
+    [[noreturn]] void runShardWorker(std::span<const P452::TerrainLink> links, const ShardHeader& header, const ShardSettings& settings,
+            const std::filesystem::path& workDirectory, const unsigned int& threadCount,
+            const std::shared_ptr<const TerrainModel::SharedTileSet>& sharedTiles){
+        int exitCode = EXIT_SUCCESS;
+        try{
+            //tiles outside the shared set are loaded by the worker itself
+            TerrainModel::RasterTileCache terrain(settings.demDirectory, TerrainModel::DEFAULT_TILE_CACHE_BYTES,
+                    settings.missingTilePolicy, sharedTiles);
+            const std::vector<double> lossList_dB = P452::calculateP452LossFromTerrainBatch_dB(terrain, links, settings.freq_GHz,
+                    settings.timePercent, settings.polariz, threadCount, settings.maxStepDistance_km);
+            writeAtomically(shardPath(workDirectory, header.shardInd, ".bin"), std::ios::binary, [&](std::ofstream& file){
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                file.write(reinterpret_cast<const char*>(lossList_dB.data()),
+                        static_cast<std::streamsize>(lossList_dB.size()*sizeof(double)));
+            });
+        }
+        catch(const std::exception& err){
+            std::ofstream(shardPath(workDirectory, header.shardInd, ".err")) << err.what() << std::endl;
+            exitCode = EXIT_FAILURE;
+        }
+        catch(...){
+            std::ofstream(shardPath(workDirectory, header.shardInd, ".err")) << "Unknown error" << std::endl;
+            exitCode = EXIT_FAILURE;
+        }
+        //skip the destructors and exit handlers of the state copied from the parent
+        ::_exit(exitCode);
+    }
+
+    std::string readFailureMessage(const std::filesystem::path& workDirectory, const std::size_t& shardInd, const int& status){
+        std::ifstream file(shardPath(workDirectory, shardInd, ".err"));
+        std::string message;
+        if(file && std::getline(file, message) && !message.empty()){
+            return message;
+        }
+        std::ostringstream oStrStream;
+        if(WIFSIGNALED(status)){
+            oStrStream << "Worker killed by signal " << WTERMSIG(status);
+        }
+        else if(WIFEXITED(status) && WEXITSTATUS(status)!=EXIT_SUCCESS){
+            oStrStream << "Worker exited with status " << WEXITSTATUS(status);
+        }
+        else{
+            oStrStream << "Worker did not write a complete shard file";
+        }
+        return oStrStream.str();
+    }
+
+    /// @brief Copy the DEM tiles crossed by the links into a new shared memory segment
+    std::shared_ptr<const TerrainModel::SharedTileSet> shareTiles(const std::string& demDirectory, std::span<const P452::TerrainLink> links){
+        //one location per tile is enough, the set is keyed by tile
+        std::set<std::pair<int, int>> tileCorners;
+        const auto addLocation = [&tileCorners](const TerrainModel::GeoPoint& location){
+            tileCorners.emplace(static_cast<int>(std::floor(location.lat_deg)),
+                    static_cast<int>(std::floor(TerrainModel::normalizeLongitude_deg(location.lon_deg))));
+        };
+        for(const P452::TerrainLink& link : links){
+            const int numSteps = static_cast<int>(std::ceil(TerrainModel::greatCircleDistance_km(link.tx, link.rx)/TileSearchStep_km));
+            addLocation(link.tx);
+            for(int stepInd = 1; stepInd<numSteps; stepInd++){
+                addLocation(TerrainModel::greatCircleIntermediatePoint(link.tx, link.rx, static_cast<double>(stepInd)/numSteps));
+            }
+            addLocation(link.rx);
+        }
+        std::vector<TerrainModel::GeoPoint> locations;
+        for(const auto& [lat_deg, lon_deg] : tileCorners){
+            locations.push_back(TerrainModel::GeoPoint{lat_deg+0.5, lon_deg+0.5});
+        }
+
+        //the parent only reads the tiles to copy them, missing tiles are left to the workers' policy
+        static std::atomic<unsigned int> segmentCount{0};
+        const std::string segmentName = "/p452_tiles_"+std::to_string(::getpid())+"_"+std::to_string(segmentCount++);
+        TerrainModel::RasterTileCache terrain(demDirectory);
+        return TerrainModel::SharedTileSet::create(segmentName, terrain, locations);
+    }
+}
+
+std::vector<P452::TerrainLink> P452::readLinkFile(const std::string& filePath){
+    std::ifstream file(filePath);
+    if(!file){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: readLinkFile(): Failed to open \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+    std::vector<TerrainLink> links;
+    std::string line;
+    std::size_t lineNumber = 0;
+    bool isFirstRecord = true;
+    while(std::getline(file, line)){
+        lineNumber++;
+        if(!line.empty() && line.back()=='\r'){
+            line.pop_back();
+        }
+        if(line.empty() || line.front()=='#'){
+            continue;
+        }
+        std::vector<double> values;
+        std::istringstream lineStream(line);
+        std::string field;
+        bool isNumeric = true;
+        while(std::getline(lineStream, field, ',')){
+            std::istringstream fieldStream(field);
+            double value;
+            if(!(fieldStream >> value) || !(fieldStream >> std::ws).eof()){
+                isNumeric = false;
+                break;
+            }
+            values.push_back(value);
+        }
+        //the first line may name the columns
+        if(!isNumeric && isFirstRecord){
+            isFirstRecord = false;
+            continue;
+        }
+        isFirstRecord = false;
+        if(!isNumeric || (values.size()!=6 && values.size()!=8 && values.size()!=10)){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: readLinkFile(): Line " << lineNumber << " of \"" << filePath
+                        << "\" is not a link (expected 6, 8 or 10 numbers): " << line;
+            throw std::runtime_error(oStrStream.str());
+        }
+
+        TerrainLink link{TerrainModel::GeoPoint{values[0], values[1]}, TerrainModel::GeoPoint{values[2], values[3]},
+                LinkParameters{values[4], values[5]}};
+        if(values.size()>=8){
+            link.parameters.txHorizonGain_dBi = values[6];
+            link.parameters.rxHorizonGain_dBi = values[7];
+        }
+        if(values.size()==10){
+            for(const double& clutterValue : {values[8], values[9]}){
+                if(clutterValue!=std::floor(clutterValue) || clutterValue<static_cast<int>(ClutterModel::ClutterType::NoClutter)
+                        || clutterValue>static_cast<int>(ClutterModel::ClutterType::IndustrialZone)){
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: readLinkFile(): Invalid clutter type " << clutterValue << " on line " << lineNumber
+                                << " of \"" << filePath << "\"";
+                    throw std::runtime_error(oStrStream.str());
+                }
+            }
+            link.parameters.txClutterType = static_cast<ClutterModel::ClutterType>(static_cast<int>(values[8]));
+            link.parameters.rxClutterType = static_cast<ClutterModel::ClutterType>(static_cast<int>(values[9]));
+        }
+        links.push_back(link);
+    }
+    return links;
+}
+
+P452::ShardedRunResult P452::runShardedP452Batch(const std::string& linkFilePath, const std::string& demDirectory,
+        const std::string& workDirectory, const std::string& outputPath, const double& freq_GHz, const double& timePercent,
+        const int& polariz, const ShardedRunOptions& options){
+
+    const std::vector<TerrainLink> links = readLinkFile(linkFilePath);
+    const unsigned int numProcesses = (options.numProcesses==0) ? std::max(1u, std::thread::hardware_concurrency()) : options.numProcesses;
+    std::size_t numShards = (options.numShards==0) ? numProcesses : options.numShards;
+    numShards = std::max<std::size_t>(1, std::min(numShards, links.size()));
+    const std::filesystem::path workPath(workDirectory);
+    std::filesystem::create_directories(workPath);
+
+    const ShardSettings settings{demDirectory, freq_GHz, timePercent, polariz, options.maxStepDistance_km, options.missingTilePolicy};
+    std::vector<ShardHeader> headers(numShards);
+    for(std::size_t shardInd = 0; shardInd<numShards; shardInd++){
+        ShardHeader& header = headers[shardInd];
+        std::memcpy(header.magic, ShardMagic, sizeof(ShardMagic));
+        header.shardInd = shardInd;
+        header.firstLink = shardInd*links.size()/numShards;
+        header.numLinks = (shardInd+1)*links.size()/numShards-header.firstLink;
+        header.fingerprint = shardFingerprint(std::span(links).subspan(header.firstLink, header.numLinks), settings);
+    }
+
+    ShardedRunResult result{links.size(), numShards, {}, {}, {}, {}, 0, 0};
+    std::vector<std::size_t> pendingShards;
+    std::vector<double> lossList_dB;
+    for(std::size_t shardInd = 0; shardInd<numShards; shardInd++){
+        if(options.resume && readShardFile(shardPath(workPath, shardInd, ".bin"), headers[shardInd], lossList_dB)){
+            result.resumedShards.push_back(shardInd);
+        }
+        else{
+            std::filesystem::remove(shardPath(workPath, shardInd, ".err"));
+            pendingShards.push_back(shardInd);
+        }
+    }
+
+    std::shared_ptr<const TerrainModel::SharedTileSet> sharedTiles;
+    if(options.shareTiles && !pendingShards.empty()){
+        sharedTiles = shareTiles(demDirectory, links);
+        result.numSharedTiles = sharedTiles->size();
+        result.sharedTileBytes = sharedTiles->byteSize();
+    }
+
+    //at most numProcesses workers at a time, each forked when a previous one exits
+    std::map<pid_t, std::size_t> runningShards;
+    std::map<std::size_t, std::string> failures;
+    std::size_t nextPendingInd = 0;
+    while(nextPendingInd<pendingShards.size() || !runningShards.empty()){
+        while(nextPendingInd<pendingShards.size() && runningShards.size()<numProcesses){
+            const std::size_t shardInd = pendingShards[nextPendingInd];
+            const pid_t processId = ::fork();
+            if(processId<0){
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: runShardedP452Batch(): Failed to start the worker of shard " << shardInd << ": "
+                            << std::strerror(errno);
+                throw std::runtime_error(oStrStream.str());
+            }
+            if(processId==0){
+                const ShardHeader& header = headers[shardInd];
+                runShardWorker(std::span(links).subspan(header.firstLink, header.numLinks), header, settings, workPath,
+                        options.threadsPerProcess, sharedTiles);
+            }
+            runningShards.emplace(processId, shardInd);
+            nextPendingInd++;
+        }
+
+        //only the workers started here are waited for, other children of the caller are left alone
+        bool hasExited = false;
+        for(auto it = runningShards.begin(); it!=runningShards.end();){
+            int status = 0;
+            if(::waitpid(it->first, &status, WNOHANG)!=it->first){
+                ++it;
+                continue;
+            }
+            hasExited = true;
+            const std::size_t shardInd = it->second;
+            if(WIFEXITED(status) && WEXITSTATUS(status)==EXIT_SUCCESS
+                    && readShardFile(shardPath(workPath, shardInd, ".bin"), headers[shardInd], lossList_dB)){
+                result.calculatedShards.push_back(shardInd);
+            }
+            else{
+                failures.emplace(shardInd, readFailureMessage(workPath, shardInd, status));
+            }
+            it = runningShards.erase(it);
+        }
+        if(!hasExited && !runningShards.empty()){
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    std::sort(result.calculatedShards.begin(), result.calculatedShards.end());
+    for(const auto& [shardInd, message] : failures){
+        result.failedShards.push_back(shardInd);
+        result.failureMessages.push_back(message);
+    }
+    if(!result.isComplete()){
+        return result;
+    }
+
+    //the losses are merged in link order, whatever order the workers finished in
+    writeAtomically(outputPath, std::ios::out, [&](std::ofstream& file){
+        file << "link,loss_dB\n" << std::setprecision(std::numeric_limits<double>::max_digits10);
+        for(std::size_t shardInd = 0; shardInd<numShards; shardInd++){
+            if(!readShardFile(shardPath(workPath, shardInd, ".bin"), headers[shardInd], lossList_dB)){
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: runShardedP452Batch(): Shard file " << shardInd << " changed during the run";
+                throw std::runtime_error(oStrStream.str());
+            }
+            for(std::size_t linkInd = 0; linkInd<lossList_dB.size(); linkInd++){
+                file << headers[shardInd].firstLink+linkInd << ',' << lossList_dB[linkInd] << '\n';
+            }
+        }
+    });
+    return result;
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "AccuracyHarness.h"
+
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace {
+	const std::filesystem::path seedProfilesFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+
+	const std::vector<PathProfile::Path>& seedProfiles(){
+		static const std::vector<PathProfile::Path> PROFILES = P452::loadAccuracySeedProfiles(seedProfilesFullPath.string());
+		return PROFILES;
+	}
+
+	P452::AccuracyCorpusOptions smallCorpusOptions(){
+		P452::AccuracyCorpusOptions options;
+		options.numCases = 200;
+		return options;
+	}
+}
+
+//The same seed gives the same corpus, every input within its range and every clutter type drawn
+TEST(AccuracyHarnessTests, generateCorpusTest){
+	const auto OPTIONS = smallCorpusOptions();
+	const auto CORPUS = P452::generateAccuracyCorpus(seedProfiles(), OPTIONS);
+	const auto SAME_SEED_CORPUS = P452::generateAccuracyCorpus(seedProfiles(), OPTIONS);
+	ASSERT_EQ(CORPUS.size(), OPTIONS.numCases);
+	ASSERT_EQ(SAME_SEED_CORPUS.size(), OPTIONS.numCases);
+
+	std::set<int> clutterTypes;
+	for (std::size_t caseInd = 0; caseInd < CORPUS.size(); caseInd++) {
+		const auto& testCase = CORPUS[caseInd];
+		const auto& sameSeedCase = SAME_SEED_CORPUS[caseInd];
+		EXPECT_EQ(testCase.freq_GHz, sameSeedCase.freq_GHz);
+		EXPECT_EQ(testCase.p_percent, sameSeedCase.p_percent);
+		ASSERT_EQ(testCase.path.size(), sameSeedCase.path.size());
+		EXPECT_EQ(testCase.path.back().h_asl_m, sameSeedCase.path.back().h_asl_m);
+
+		EXPECT_LT(testCase.seedProfileInd, seedProfiles().size());
+		EXPECT_GE(testCase.path.size(), OPTIONS.minNumPoints);
+		EXPECT_DOUBLE_EQ(testCase.path.front().d_km, 0.0);
+		EXPECT_GE(testCase.freq_GHz, OPTIONS.minFreq_GHz);
+		EXPECT_LE(testCase.freq_GHz, OPTIONS.maxFreq_GHz);
+		EXPECT_GE(testCase.p_percent, OPTIONS.minTimePercent);
+		EXPECT_LE(testCase.p_percent, OPTIONS.maxTimePercent);
+		for (const auto& point : testCase.path) {
+			EXPECT_GE(point.h_asl_m, 0.0);
+		}
+		clutterTypes.insert(testCase.txClutterType);
+		clutterTypes.insert(testCase.rxClutterType);
+	}
+	EXPECT_EQ(clutterTypes.size(), static_cast<std::size_t>(ClutterModel::IndustrialZone-ClutterModel::NoClutter+1));
+
+	auto otherSeedOptions = OPTIONS;
+	otherSeedOptions.seed++;
+	EXPECT_NE(P452::generateAccuracyCorpus(seedProfiles(), otherSeedOptions).front().freq_GHz, CORPUS.front().freq_GHz);
+
+	EXPECT_THROW(P452::generateAccuracyCorpus({}, OPTIONS), std::invalid_argument);
+	EXPECT_THROW(P452::loadAccuracySeedProfiles((seedProfilesFullPath/"missing").string()), std::runtime_error);
+}
+
+//A mode repeating the reference has no error, decimation stays within the accepted errors of P452AccuracyHarness
+TEST(AccuracyHarnessTests, runHarnessTest){
+	const auto CORPUS = P452::generateAccuracyCorpus(seedProfiles(), smallCorpusOptions());
+
+	P452::AccuracyMode referenceMode;
+	referenceMode.name = "reference";
+	referenceMode.calcLoss_dB = [](const std::size_t&, const P452::AccuracyCase& testCase){
+		return P452::calcReferenceLoss_dB(testCase);
+	};
+	const std::vector<P452::AccuracyMode> MODES = {
+		referenceMode,
+		P452::makeProfileDecimationMode(1.0, 0.25),
+		P452::makeProfileDecimationMode(5.0, 0.5),
+	};
+	const auto REPORTS = P452::runAccuracyHarness(CORPUS, MODES, 1);
+	P452::writeAccuracyReport(std::cout, REPORTS);
+	ASSERT_EQ(REPORTS.size(), MODES.size());
+
+	EXPECT_EQ(REPORTS[0].maxAbsError_dB, 0.0);
+	EXPECT_EQ(REPORTS[0].meanError_dB, 0.0);
+	for (const auto& report : REPORTS) {
+		EXPECT_EQ(report.numCases, CORPUS.size());
+		EXPECT_TRUE(report.isWithinTolerance()) << report.modeName;
+		EXPECT_LE(report.p50AbsError_dB, report.p95AbsError_dB);
+		EXPECT_LE(report.p95AbsError_dB, report.p99AbsError_dB);
+		EXPECT_LE(report.p99AbsError_dB, report.maxAbsError_dB);
+		EXPECT_LT(report.maxErrorCaseInd, CORPUS.size());
+		EXPECT_GT(report.referenceTime_s, 0.0);
+		EXPECT_GT(report.modeTime_s, 0.0);
+	}
+	EXPECT_EQ(REPORTS[1].modeName, "decimation_1m");
+
+	EXPECT_THROW(P452::runAccuracyHarness({}, MODES), std::invalid_argument);
+	EXPECT_THROW(P452::runAccuracyHarness(CORPUS, MODES, 0), std::invalid_argument);
+}
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+
+#include "P452/P452.h"
+#include "TestSupport/AllocationCounter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+namespace {
+	const double STEP_KM = 0.1;
+	const std::size_t NUM_LINKS = 12;
+
+	//hilly land with a sea segment in the middle, of 200+40*profileInd points
+	std::vector<double> syntheticProfile(const std::size_t& profileInd){
+		const std::size_t NUM_POINTS = 200+40*profileInd;
+		std::vector<double> heights_m;
+		for(std::size_t pointInd = 0; pointInd<NUM_POINTS; pointInd++){
+			const bool isSea = pointInd>NUM_POINTS*2/5 && pointInd<NUM_POINTS*3/5;
+			heights_m.push_back(isSea ? 0.0 : 40.0+30.0*std::sin(0.05*pointInd+profileInd));
+		}
+		return heights_m;
+	}
+
+	ClutterModel::ClutterType clutterType(const std::size_t& linkInd){
+		return (linkInd%2==0) ? ClutterModel::ClutterType::Urban : ClutterModel::ClutterType::NoClutter;
+	}
+
+	struct TestLink{
+		std::vector<double> heights_m;
+		PathProfile::Path path;
+		double dist_coast_tx_km;
+		double dist_coast_rx_km;
+	};
+
+	//the longest profile comes first, so the warm up link sizes the reused buffers
+	std::vector<TestLink> buildTestLinks(){
+		std::vector<TestLink> links(NUM_LINKS);
+		for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+			TestLink& link = links[linkInd];
+			link.heights_m = syntheticProfile(NUM_LINKS-1-linkInd);
+			P452::createP452Path(link.heights_m, STEP_KM, link.path, link.dist_coast_tx_km, link.dist_coast_rx_km);
+		}
+		return links;
+	}
+
+	//reads the counter before the entry name allocates
+	void addReportEntry(std::vector<TestSupport::EntryPointAllocations>& report, const char* entryPoint,
+			const TestSupport::AllocationCounter& counter){
+		const TestSupport::AllocationStats STATS = counter.stats();
+		report.push_back({entryPoint, NUM_LINKS, STATS});
+	}
+
+	std::string formatReport(const std::vector<TestSupport::EntryPointAllocations>& report){
+		std::ostringstream output;
+		TestSupport::writeAllocationReport(output, report);
+		return output.str();
+	}
+}
+
+//Allocations per link of the public entry points after warm up. The thresholds are the current state, lower them when
+//an allocation is removed and do not raise them without a reason
+TEST(AllocationTests, allocationsPerLinkTest){
+	const std::vector<TestLink> LINKS = buildTestLinks();
+	const P452::AtmosphericParameters ATMOSPHERE = P452::fetchAtmosphericParameters(29.5, 47.5, 0.05,
+			Enumerations::Season::SummerTime);
+	std::vector<TestSupport::EntryPointAllocations> report;
+	report.reserve(4);
+	std::vector<double> lossList_dB(NUM_LINKS);
+
+	//the thread evaluator keeps its buffers between calls
+	P452::calculateP452Loss_dB(10.0, 10.0, LINKS.front().heights_m, STEP_KM, 29.5, ATMOSPHERE, 2.0, 10.0);
+	TestSupport::AllocationCounter counter;
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		lossList_dB[linkInd] = P452::calculateP452Loss_dB(10.0, 10.0, LINKS[linkInd].heights_m, STEP_KM, 29.5, ATMOSPHERE,
+				2.0, 10.0, 0, 0.0, 0.0, clutterType(linkInd), clutterType(linkInd+1));
+	}
+	addReportEntry(report, "P452::calculateP452Loss_dB", counter);
+
+	//the model object shares one copy of the profile with its submodels (control block and profile points)
+	std::size_t maxProfileBytes = 0;
+	counter.restart();
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		const TestLink& link = LINKS[linkInd];
+		maxProfileBytes = std::max(maxProfileBytes, link.path.size()*sizeof(PathProfile::ProfilePoint));
+		lossList_dB[linkInd] -= ITUR_P452::TotalClearAirAttenuation(2.0, 10.0, link.path, 10.0, 10.0, 29.5, 0.0, 0.0,
+				Enumerations::PolarizationType::HorizontalPolarized, link.dist_coast_tx_km, link.dist_coast_rx_km,
+				ATMOSPHERE.deltaN, ATMOSPHERE.surfaceRefractivity, ATMOSPHERE.temp_K, ATMOSPHERE.dryPressure_hPa, clutterType(linkInd),
+				clutterType(linkInd+1)).calcTotalClearAirAttenuation();
+	}
+	addReportEntry(report, "ITUR_P452::TotalClearAirAttenuation", counter);
+
+	counter.restart();
+	double clutterLossSum_dB = 0;
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		const ClutterModel::ClutterResults clutter = ClutterModel::calculateClutterModel(2.0, LINKS[linkInd].path, 10.0, 10.0,
+				clutterType(linkInd), clutterType(linkInd+1));
+		clutterLossSum_dB += clutter.clutterLoss_dB.first+clutter.clutterLoss_dB.second;
+	}
+	addReportEntry(report, "ClutterModel::calculateClutterModel", counter);
+
+	//the output path is reused, its capacity covers the first (longest) profile
+	PathProfile::Path path;
+	double dist_coast_tx_km, dist_coast_rx_km;
+	P452::createP452Path(LINKS.front().heights_m, STEP_KM, path, dist_coast_tx_km, dist_coast_rx_km);
+	counter.restart();
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		P452::createP452Path(LINKS[linkInd].heights_m, STEP_KM, path, dist_coast_tx_km, dist_coast_rx_km);
+	}
+	addReportEntry(report, "P452::createP452Path", counter);
+
+	const std::string REPORT = formatReport(report);
+	EXPECT_EQ(0.0, report[0].allocationsPerLink()) << REPORT;
+	EXPECT_LE(report[1].allocationsPerLink(), 2.0) << REPORT;
+	EXPECT_LE(report[1].stats.numBytes, NUM_LINKS*(maxProfileBytes+256)) << REPORT;
+	EXPECT_EQ(0.0, report[2].allocationsPerLink()) << REPORT;
+	EXPECT_EQ(0.0, report[3].allocationsPerLink()) << REPORT;
+
+	//the entry points evaluated the same links
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		EXPECT_DOUBLE_EQ(0.0, lossList_dB[linkInd]) << linkInd;
+	}
+	EXPECT_GT(clutterLossSum_dB, 0.0);
+	EXPECT_EQ(LINKS.back().path.size(), path.size());
+}
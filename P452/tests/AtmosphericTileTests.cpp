@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include "P452/P452.h"
+#include "P452/AtmosphericTile.h"
+
+#include <filesystem>
+
+namespace {
+	// Tiles store single precision values
+	double constexpr TOLERANCE = 1.0e-3;
+
+	const P452::AtmosphericGridDefinition TEST_GRID = {
+		29.5, 47.5, -0.25, 0.25, 5, 7
+	};
+}
+
+//Every grid point should match the direct data map and seasonal atmosphere values
+TEST(AtmosphericTileTests, generateTileTest){
+	const auto TILE = P452::AtmosphericTile::generate(TEST_GRID, 0.0, Enumerations::Season::SummerTime, 3);
+	ASSERT_EQ(TILE.size(), static_cast<std::size_t>(TEST_GRID.numRows*TEST_GRID.numCols));
+
+	for (uint32_t rowInd = 0; rowInd < TEST_GRID.numRows; rowInd++) {
+		for (uint32_t colInd = 0; colInd < TEST_GRID.numCols; colInd++) {
+			const double LAT = TEST_GRID.startLat_deg + rowInd*TEST_GRID.latStep_deg;
+			const double LON = TEST_GRID.startLon_deg + colInd*TEST_GRID.lonStep_deg;
+			const auto EXPECTED = P452::fetchAtmosphericParameters(LAT, LON);
+			const auto RESULT = TILE.at(rowInd, colInd);
+
+			EXPECT_NEAR(EXPECTED.deltaN, RESULT.deltaN, TOLERANCE);
+			EXPECT_NEAR(EXPECTED.surfaceRefractivity, RESULT.surfaceRefractivity, TOLERANCE);
+			EXPECT_NEAR(EXPECTED.temp_K, RESULT.temp_K, TOLERANCE);
+			EXPECT_NEAR(EXPECTED.dryPressure_hPa, RESULT.dryPressure_hPa, TOLERANCE);
+			EXPECT_EQ(static_cast<std::size_t>(rowInd*TEST_GRID.numCols+colInd), TILE.indexOf(LAT, LON));
+		}
+	}
+	EXPECT_THROW(TILE.indexOf(40.0, 47.5), std::out_of_range);
+	EXPECT_THROW(TILE.at(TEST_GRID.numRows, 0), std::out_of_range);
+}
+
+TEST(AtmosphericTileTests, saveLoadTileTest){
+	const auto TILE = P452::AtmosphericTile::generate(TEST_GRID);
+	const std::string FILE_PATH = (std::filesystem::temp_directory_path()/"p452_atmospheric_tile_test.bin").string();
+	TILE.save(FILE_PATH);
+	const auto LOADED = P452::AtmosphericTile::load(FILE_PATH);
+	std::filesystem::remove(FILE_PATH);
+
+	ASSERT_EQ(TILE.size(), LOADED.size());
+	EXPECT_EQ(TILE.grid().numRows, LOADED.grid().numRows);
+	EXPECT_EQ(TILE.grid().numCols, LOADED.grid().numCols);
+	for (std::size_t index = 0; index < TILE.size(); index++) {
+		EXPECT_EQ(TILE.at(index).deltaN, LOADED.at(index).deltaN);
+		EXPECT_EQ(TILE.at(index).surfaceRefractivity, LOADED.at(index).surfaceRefractivity);
+		EXPECT_EQ(TILE.at(index).temp_K, LOADED.at(index).temp_K);
+		EXPECT_EQ(TILE.at(index).dryPressure_hPa, LOADED.at(index).dryPressure_hPa);
+	}
+	EXPECT_THROW(P452::AtmosphericTile::load(FILE_PATH), std::runtime_error);
+}
+
+//Loss calculated with tile values should match the loss calculated with per-call lookups
+TEST(AtmosphericTileTests, lossFromTileTest){
+	const std::vector<double> ELEVATION_LIST_M = {
+		62.0, 62.0, 60.0, 66.0, 73.0, 88.0, 96.0, 108.0, 105.0, 84.0,
+        78.0, 63.0, 34.0, 38.0, 27.0, 19.0, 1.0, 0.0, 0.0, 0.0,
+        0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+        0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+        0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0
+	};
+    const double stepDistance_km = 0.994291;
+    const double midpoint_lat_deg = 29.0;
+    const double midpoint_lon_deg = 48.25;
+
+	const auto TILE = P452::AtmosphericTile::generate(TEST_GRID);
+	const auto ATMOSPHERE = TILE.lookup(midpoint_lat_deg, midpoint_lon_deg);
+
+    const double EXPECTED_LOSS = P452::calculateP452Loss_dB(10.0, 10.0, ELEVATION_LIST_M, stepDistance_km,
+            midpoint_lat_deg, midpoint_lon_deg, 0.3, 50.0);
+    const double RES_LOSS = P452::calculateP452Loss_dB(10.0, 10.0, ELEVATION_LIST_M, stepDistance_km,
+            midpoint_lat_deg, ATMOSPHERE, 0.3, 50.0);
+
+    EXPECT_NEAR(EXPECTED_LOSS, RES_LOSS, TOLERANCE);
+}
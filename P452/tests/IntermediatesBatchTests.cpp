@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include "P452/BatchLoss.h"
+#include "P452/P452.h"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	const double STEP_KM = 0.1;
+
+	//ridge profile of 40+8*profileInd points
+	std::vector<double> syntheticProfile(const std::size_t& profileInd){
+		std::vector<double> heights_m;
+		for(std::size_t pointInd = 0; pointInd<40+8*profileInd; pointInd++){
+			const double x = (pointInd-20.0-4.0*profileInd)/6.0;
+			heights_m.push_back(20.0+150.0*std::exp(-x*x));
+		}
+		return heights_m;
+	}
+}
+
+//The intermediate columns hold the values of the single link interface and the losses of the loss batch
+TEST(IntermediatesBatchTests, sameResultAsLossBatchTest){
+	const std::size_t NUM_LINKS = 6;
+	TerrainModel::ProfileBatch batch;
+	std::vector<P452::LinkParameters> links;
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		const auto PROFILE = syntheticProfile(linkInd);
+		batch.append(PROFILE, STEP_KM, STEP_KM*(PROFILE.size()-1), TerrainModel::GeoPoint{29.5, 47.5});
+		P452::LinkParameters link{15.0+linkInd, 10.0};
+		link.rxClutterType = (linkInd%2==0) ? ClutterModel::ClutterType::Urban : ClutterModel::ClutterType::NoClutter;
+		links.push_back(link);
+	}
+	const P452::AtmosphericParameters ATMOSPHERE = P452::fetchAtmosphericParameters(29.5, 47.5, 0.05,
+			Enumerations::Season::SummerTime);
+	const std::vector<P452::AtmosphericParameters> ATMOSPHERES(NUM_LINKS, ATMOSPHERE);
+
+	const P452::IntermediateColumns intermediates = P452::calculateP452IntermediatesBatch(batch, links, 2.0, 10.0, 1, ATMOSPHERES, 3);
+	const std::vector<double> lossList_dB = P452::calculateP452LossBatch_dB(batch, links, 2.0, 10.0, 1, ATMOSPHERES, 2);
+	ASSERT_EQ(NUM_LINKS, intermediates.size());
+	const auto totalLosses_dB = intermediates.column("totalLoss_dB");
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		EXPECT_DOUBLE_EQ(lossList_dB[linkInd], totalLosses_dB[linkInd]) << linkInd;
+		const ITUR_P452::ClearAirIntermediates EXPECTED = P452::calculateP452Intermediates(links[linkInd].txHeight_m,
+				links[linkInd].rxHeight_m, syntheticProfile(linkInd), STEP_KM, 29.5, ATMOSPHERE, 2.0, 10.0, 1, 0.0, 0.0,
+				links[linkInd].txClutterType, links[linkInd].rxClutterType);
+		const ITUR_P452::ClearAirIntermediates values = intermediates.link(linkInd);
+		for(const ITUR_P452::ClearAirIntermediateField& field : ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS){
+			EXPECT_DOUBLE_EQ(EXPECTED.*field.value, values.*field.value) << linkInd << " " << field.name;
+		}
+	}
+	EXPECT_GT(intermediates.column("rx_clutterLoss_dB")[0], 0.0);
+	EXPECT_EQ(0.0, intermediates.column("rx_clutterLoss_dB")[1]);
+	EXPECT_THROW(intermediates.column("noSuchValue"), std::out_of_range);
+	EXPECT_THROW(intermediates.link(NUM_LINKS), std::out_of_range);
+	EXPECT_THROW(P452::calculateP452IntermediatesBatch(batch, std::vector<P452::LinkParameters>(2, links[0]), 2.0, 10.0),
+			std::invalid_argument);
+
+	//profiles too short for the model are refused when added, and when the members are filled directly
+	EXPECT_THROW(batch.append(std::vector<double>{10.0}, STEP_KM, 0.0, {29.5, 47.5}), std::invalid_argument);
+	EXPECT_EQ(NUM_LINKS, batch.size());
+	TerrainModel::ProfileBatch shortBatch = batch;
+	shortBatch.offsets[1] = shortBatch.offsets[0]+1;
+	EXPECT_THROW(P452::calculateP452LossBatch_dB(shortBatch, links, 2.0, 10.0), std::invalid_argument);
+
+	//one header line and one line per link, with every value
+	std::ostringstream csv;
+	P452::writeIntermediatesCsv(csv, intermediates);
+	std::istringstream lines(csv.str());
+	std::string line;
+	ASSERT_TRUE(std::getline(lines, line));
+	EXPECT_EQ(0u, line.find("link,d_tot_km,height_tx_asl_m,"));
+	EXPECT_EQ(line.size()-std::string("totalLoss_dB").size(), line.rfind("totalLoss_dB"));
+	std::size_t numLines = 0;
+	while(std::getline(lines, line)){
+		std::istringstream values(line);
+		std::string value;
+		std::vector<double> row;
+		std::getline(values, value, ',');
+		EXPECT_EQ(std::to_string(numLines), value);
+		while(std::getline(values, value, ',')){
+			row.push_back(std::stod(value));
+		}
+		ASSERT_EQ(ITUR_P452::CLEAR_AIR_INTERMEDIATE_FIELDS.size(), row.size());
+		EXPECT_DOUBLE_EQ(lossList_dB[numLines], row.back());
+		numLines++;
+	}
+	EXPECT_EQ(NUM_LINKS, numLines);
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+
+#include "P452/BatchLoss.h"
+#include "P452/P452.h"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	//ridge profile of 40+8*profileInd points
+	std::vector<double> syntheticProfile(const std::size_t& profileInd){
+		std::vector<double> heights_m;
+		for(std::size_t pointInd = 0; pointInd<40+8*profileInd; pointInd++){
+			const double x = (pointInd-20.0-4.0*profileInd)/6.0;
+			heights_m.push_back(20.0+150.0*std::exp(-x*x));
+		}
+		return heights_m;
+	}
+}
+
+//Columns with per link and shared values give the same losses as the single link interface
+TEST(LinkColumnsTests, sameResultAsSingleLinkTest){
+	const std::size_t NUM_LINKS = 7;
+	const double STEP_KM = 0.1;
+	std::vector<double> heights_m;
+	std::vector<int64_t> offsets{0};
+	std::vector<double> freqs_GHz, timePercents, txHeights_m;
+	std::vector<int32_t> rxClutterTypes;
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		const auto PROFILE = syntheticProfile(linkInd);
+		heights_m.insert(heights_m.end(), PROFILE.begin(), PROFILE.end());
+		offsets.push_back(static_cast<int64_t>(heights_m.size()));
+		freqs_GHz.push_back(0.5+linkInd);
+		timePercents.push_back(1.0+5.0*linkInd);
+		txHeights_m.push_back(15.0+linkInd);
+		rxClutterTypes.push_back(linkInd%2==0 ? ClutterModel::ClutterType::Urban : ClutterModel::ClutterType::NoClutter);
+	}
+	const std::vector<double> SHARED_STEP{STEP_KM}, SHARED_LAT{29.5}, SHARED_LON{47.5}, SHARED_RX_HEIGHT{10.0};
+
+	P452::LinkColumns links;
+	links.heights_m = heights_m;
+	links.offsets = offsets;
+	links.stepDistances_km = SHARED_STEP;
+	links.midpointLats_deg = SHARED_LAT;
+	links.midpointLons_deg = SHARED_LON;
+	links.txHeights_m = txHeights_m;
+	links.rxHeights_m = SHARED_RX_HEIGHT;
+	links.freqs_GHz = freqs_GHz;
+	links.timePercents = timePercents;
+	links.rxClutterTypes = rxClutterTypes;
+	ASSERT_EQ(NUM_LINKS, links.size());
+
+	std::vector<double> lossList_dB(NUM_LINKS);
+	P452::calculateP452LossColumns_dB(links, lossList_dB, 1, 3);
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		const double EXPECTED_LOSS = P452::calculateP452Loss_dB(txHeights_m[linkInd], 10.0, syntheticProfile(linkInd), STEP_KM, 
+				29.5, 47.5, freqs_GHz[linkInd], timePercents[linkInd], 1, 0.0, 0.0, ClutterModel::ClutterType::NoClutter,
+				static_cast<ClutterModel::ClutterType>(rxClutterTypes[linkInd]));
+		EXPECT_DOUBLE_EQ(EXPECTED_LOSS, lossList_dB[linkInd]);
+	}
+
+	//no links
+	P452::LinkColumns emptyLinks;
+	EXPECT_NO_THROW(P452::calculateP452LossColumns_dB(emptyLinks, {}));
+}
+
+//Columns that do not match the profiles are rejected before any link is calculated
+TEST(LinkColumnsTests, invalidColumnsTest){
+	const std::vector<double> HEIGHTS_M(100, 10.0);
+	const std::vector<int64_t> OFFSETS{0, 50, 100};
+	const std::vector<double> SHARED{2.0}, PAIR{20.0, 30.0}, TRIPLE{1.0, 2.0, 3.0};
+	P452::LinkColumns links{HEIGHTS_M, OFFSETS, SHARED, SHARED, SHARED, PAIR, SHARED, SHARED, SHARED};
+	std::vector<double> lossList_dB(2, -1.0);
+	EXPECT_NO_THROW(P452::calculateP452LossColumns_dB(links, lossList_dB));
+
+	std::vector<double> shortLossList_dB(1);
+	EXPECT_THROW(P452::calculateP452LossColumns_dB(links, shortLossList_dB), std::invalid_argument);
+
+	auto badLinks = links;
+	badLinks.freqs_GHz = TRIPLE;
+	EXPECT_THROW(P452::calculateP452LossColumns_dB(badLinks, lossList_dB), std::invalid_argument);
+	badLinks = links;
+	badLinks.stepDistances_km = {};
+	EXPECT_THROW(P452::calculateP452LossColumns_dB(badLinks, lossList_dB), std::invalid_argument);
+
+	const std::vector<int64_t> DECREASING_OFFSETS{0, 60, 50, 100}, SHORT_OFFSETS{0, 50, 90};
+	badLinks = links;
+	badLinks.offsets = SHORT_OFFSETS;
+	EXPECT_THROW(P452::calculateP452LossColumns_dB(badLinks, lossList_dB), std::invalid_argument);
+	badLinks.offsets = DECREASING_OFFSETS;
+	std::vector<double> tripleLossList_dB(3);
+	EXPECT_THROW(P452::calculateP452LossColumns_dB(badLinks, tripleLossList_dB), std::invalid_argument);
+	//empty and single point profiles cannot be evaluated
+	const std::vector<int64_t> EMPTY_PROFILE_OFFSETS{0, 0, 100}, SINGLE_POINT_OFFSETS{0, 99, 100};
+	for(const std::vector<int64_t>& offsets : {EMPTY_PROFILE_OFFSETS, SINGLE_POINT_OFFSETS}){
+		badLinks.offsets = offsets;
+		lossList_dB.assign(2, -1.0);
+		EXPECT_THROW(P452::calculateP452LossColumns_dB(badLinks, lossList_dB), std::invalid_argument);
+		EXPECT_EQ(-1.0, lossList_dB.back());
+	}
+
+	const std::vector<int32_t> BAD_CLUTTER{99};
+	badLinks = links;
+	badLinks.txClutterTypes = BAD_CLUTTER;
+	lossList_dB.assign(2, -1.0);
+	EXPECT_THROW(P452::calculateP452LossColumns_dB(badLinks, lossList_dB), std::invalid_argument);
+	EXPECT_EQ(-1.0, lossList_dB.front());
+}
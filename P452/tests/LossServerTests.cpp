@@ -0,0 +1,276 @@
+#include "gtest/gtest.h"
+
+#include "P452/LossClient.h"
+#include "P452/LossServer.h"
+#include "P452/P452.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+	//one raw float DEM tile covering N29E047
+	void writeTestTile(const std::filesystem::path& directory){
+		std::filesystem::create_directories(directory);
+		const uint32_t GRID_SIZE = 121;
+		std::vector<float> values;
+		for(uint32_t row = 0; row<GRID_SIZE; row++){
+			for(uint32_t col = 0; col<GRID_SIZE; col++){
+				values.push_back(row>110 ? 0.0f : static_cast<float>(15.0+3.0*col+std::max(0.0, 150.0-4.0*std::abs(row-60.0))));
+			}
+		}
+		const double STEP_DEG = 1.0/(GRID_SIZE-1);
+		TerrainModel::RasterTile(TerrainModel::TileGeometry{30.0, 47.0, STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, values)
+				.saveRawFloat((directory/"N29E047.f32").string());
+	}
+
+	P452::LossProtocol::LinkRecord buildLink(const std::size_t& linkInd){
+		P452::LossProtocol::LinkRecord link;
+		link.txLat_deg = 29.8;
+		link.txLon_deg = 47.2+0.01*(linkInd%7);
+		link.rxLat_deg = 29.1+0.05*(linkInd%11);
+		link.rxLon_deg = 47.9-0.03*(linkInd%13);
+		link.txHeight_m = 20.0+linkInd%4;
+		link.rxHeight_m = 10.0;
+		link.txClutterType = (linkInd%3==0) ? ClutterModel::ClutterType::Urban : ClutterModel::ClutterType::NoClutter;
+		return link;
+	}
+
+	double calcExpectedLoss_dB(TerrainModel::RasterTileCache& terrain, const P452::LossProtocol::LinkRecord& link,
+			const double& freq_GHz, const double& timePercent){
+		return P452::calculateP452LossFromTerrain_dB(terrain, TerrainModel::GeoPoint{link.txLat_deg, link.txLon_deg},
+				TerrainModel::GeoPoint{link.rxLat_deg, link.rxLon_deg}, link.txHeight_m, link.rxHeight_m, freq_GHz, timePercent, 0,
+				link.txHorizonGain_dBi, link.rxHorizonGain_dBi, static_cast<ClutterModel::ClutterType>(link.txClutterType),
+				static_cast<ClutterModel::ClutterType>(link.rxClutterType));
+	}
+}
+
+//Concurrent clients get the same losses as the single link interface, and their requests share batches
+TEST(LossServerTests, concurrentClientsTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_loss_server_test";
+	const std::string SOCKET_PATH = (std::filesystem::temp_directory_path()/"p452_loss_server_test.sock").string();
+	writeTestTile(DIRECTORY);
+	TerrainModel::RasterTileCache terrain(DIRECTORY.string());
+
+	P452::LossServerOptions options;
+	options.coalescingWindow_ms = 300.0;
+	options.threadCount = 2;
+	P452::LossServer server(SOCKET_PATH, terrain, options);
+	std::thread serverThread(&P452::LossServer::serve, &server);
+
+	const std::size_t NUM_CLIENTS = 6;
+	const std::size_t NUM_LINKS_PER_REQUEST = 3;
+	std::vector<std::vector<double>> lossLists_dB(NUM_CLIENTS);
+	std::vector<std::vector<double>> secondLossLists_dB(NUM_CLIENTS);
+	std::latch startLatch(NUM_CLIENTS);
+	std::vector<std::thread> clientThreads;
+	for(std::size_t clientInd = 0; clientInd<NUM_CLIENTS; clientInd++){
+		clientThreads.emplace_back([&, clientInd](){
+			P452::LossClient client(SOCKET_PATH);
+			std::vector<P452::LossProtocol::LinkRecord> links;
+			for(std::size_t linkInd = 0; linkInd<NUM_LINKS_PER_REQUEST; linkInd++){
+				links.push_back(buildLink(NUM_LINKS_PER_REQUEST*clientInd+linkInd));
+			}
+			startLatch.arrive_and_wait();
+			lossLists_dB[clientInd] = client.calculate(links, 2.0, 10.0);
+			//the connection is reused, with other settings
+			secondLossLists_dB[clientInd] = client.calculate(links, 0.7, 40.0);
+		});
+	}
+	for(auto& thread : clientThreads){
+		thread.join();
+	}
+
+	for(std::size_t clientInd = 0; clientInd<NUM_CLIENTS; clientInd++){
+		ASSERT_EQ(NUM_LINKS_PER_REQUEST, lossLists_dB[clientInd].size());
+		ASSERT_EQ(NUM_LINKS_PER_REQUEST, secondLossLists_dB[clientInd].size());
+		for(std::size_t linkInd = 0; linkInd<NUM_LINKS_PER_REQUEST; linkInd++){
+			const auto LINK = buildLink(NUM_LINKS_PER_REQUEST*clientInd+linkInd);
+			EXPECT_DOUBLE_EQ(calcExpectedLoss_dB(terrain, LINK, 2.0, 10.0), lossLists_dB[clientInd][linkInd]);
+			EXPECT_DOUBLE_EQ(calcExpectedLoss_dB(terrain, LINK, 0.7, 40.0), secondLossLists_dB[clientInd][linkInd]);
+		}
+	}
+
+	const P452::LossServerStats STATS = server.stats();
+	EXPECT_EQ(NUM_CLIENTS, STATS.numConnections);
+	EXPECT_EQ(2*NUM_CLIENTS, STATS.numRequests);
+	EXPECT_EQ(2*NUM_CLIENTS*NUM_LINKS_PER_REQUEST, STATS.numLinks);
+	//the first requests of all clients arrive within the coalescing window
+	EXPECT_LT(STATS.numBatches, STATS.numRequests);
+
+	server.stop();
+	serverThread.join();
+	std::filesystem::remove_all(DIRECTORY);
+}
+
+//Invalid requests are rejected without stopping the server
+TEST(LossServerTests, invalidRequestTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_loss_server_invalid_test";
+	const std::string SOCKET_PATH = (std::filesystem::temp_directory_path()/"p452_loss_server_invalid_test.sock").string();
+	writeTestTile(DIRECTORY);
+	TerrainModel::RasterTileCache terrain(DIRECTORY.string());
+
+	P452::LossServerOptions options;
+	options.maxRequestLinks = 4;
+	options.coalescingWindow_ms = 0.0;
+	{
+		P452::LossServer server(SOCKET_PATH, terrain, options);
+		std::thread serverThread(&P452::LossServer::serve, &server);
+		{
+			P452::LossClient client(SOCKET_PATH);
+			EXPECT_TRUE(client.calculate({}, 2.0, 10.0).empty());
+			std::vector<P452::LossProtocol::LinkRecord> links(5, buildLink(0));
+			EXPECT_THROW(client.calculate(links, 2.0, 10.0), std::runtime_error);
+		}
+		{
+			P452::LossClient client(SOCKET_PATH);
+			std::vector<P452::LossProtocol::LinkRecord> links(1, buildLink(1));
+			links.front().rxClutterType = 99;
+			EXPECT_THROW(client.calculate(links, 2.0, 10.0), std::runtime_error);
+		}
+		//a NaN frequency would not match itself when the requests are grouped
+		const std::vector<P452::LossProtocol::LinkRecord> VALID_LINKS(1, buildLink(1));
+		for (const auto& [freq_GHz, timePercent, polariz] : {std::tuple{std::nan(""), 10.0, 0}, std::tuple{2.0, 0.0, 0},
+				std::tuple{2.0, 60.0, 0}, std::tuple{2.0, std::nan(""), 0}, std::tuple{2.0, 10.0, 2}}) {
+			P452::LossClient client(SOCKET_PATH);
+			EXPECT_THROW(client.calculate(VALID_LINKS, freq_GHz, timePercent, polariz), std::runtime_error)
+					<< freq_GHz << " " << timePercent << " " << polariz;
+		}
+		P452::LossClient client(SOCKET_PATH);
+		const std::vector<P452::LossProtocol::LinkRecord> LINKS(1, buildLink(2));
+		const auto LOSS_LIST = client.calculate(LINKS, 2.0, 10.0);
+		ASSERT_EQ(1u, LOSS_LIST.size());
+		EXPECT_DOUBLE_EQ(calcExpectedLoss_dB(terrain, LINKS.front(), 2.0, 10.0), LOSS_LIST.front());
+
+		//a connected client sees the server go away
+		server.stop();
+		serverThread.join();
+		EXPECT_THROW(client.calculate(LINKS, 2.0, 10.0), std::runtime_error);
+	}
+	//the socket file is removed with the server
+	EXPECT_FALSE(std::filesystem::exists(SOCKET_PATH));
+	EXPECT_THROW(P452::LossClient client(SOCKET_PATH), std::runtime_error);
+	std::filesystem::remove_all(DIRECTORY);
+}
+
+//A link that fails in a shared batch only fails the request it belongs to
+TEST(LossServerTests, failingLinkIsolationTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_loss_server_isolation_test";
+	const std::string SOCKET_PATH = (std::filesystem::temp_directory_path()/"p452_loss_server_isolation_test.sock").string();
+	writeTestTile(DIRECTORY);
+	//links leaving the N29E047 tile throw
+	TerrainModel::RasterTileCache terrain(DIRECTORY.string(), TerrainModel::DEFAULT_TILE_CACHE_BYTES,
+			TerrainModel::MissingTilePolicy::Throw);
+
+	P452::LossServerOptions options;
+	options.coalescingWindow_ms = 300.0;
+	P452::LossServer server(SOCKET_PATH, terrain, options);
+	std::thread serverThread(&P452::LossServer::serve, &server);
+
+	const std::size_t NUM_CLIENTS = 3;
+	const std::size_t FAILING_CLIENT = 1;
+	std::vector<std::vector<double>> lossLists_dB(NUM_CLIENTS);
+	std::vector<std::string> errors(NUM_CLIENTS);
+	std::latch startLatch(NUM_CLIENTS);
+	std::vector<std::thread> clientThreads;
+	for(std::size_t clientInd = 0; clientInd<NUM_CLIENTS; clientInd++){
+		clientThreads.emplace_back([&, clientInd](){
+			P452::LossClient client(SOCKET_PATH);
+			std::vector<P452::LossProtocol::LinkRecord> links = {buildLink(2*clientInd), buildLink(2*clientInd+1)};
+			if(clientInd==FAILING_CLIENT){
+				links.back().rxLat_deg = 35.0;
+			}
+			startLatch.arrive_and_wait();
+			try{
+				lossLists_dB[clientInd] = client.calculate(links, 2.0, 10.0);
+			}
+			catch(const std::runtime_error& err){
+				errors[clientInd] = err.what();
+			}
+		});
+	}
+	for(auto& thread : clientThreads){
+		thread.join();
+	}
+
+	for(std::size_t clientInd = 0; clientInd<NUM_CLIENTS; clientInd++){
+		if(clientInd==FAILING_CLIENT){
+			EXPECT_FALSE(errors[clientInd].empty());
+			continue;
+		}
+		EXPECT_TRUE(errors[clientInd].empty()) << errors[clientInd];
+		ASSERT_EQ(2u, lossLists_dB[clientInd].size());
+		for(std::size_t linkInd = 0; linkInd<2; linkInd++){
+			EXPECT_DOUBLE_EQ(calcExpectedLoss_dB(terrain, buildLink(2*clientInd+linkInd), 2.0, 10.0),
+					lossLists_dB[clientInd][linkInd]);
+		}
+	}
+	EXPECT_EQ(2*(NUM_CLIENTS-1), server.stats().numLinks);
+
+	server.stop();
+	serverThread.join();
+	std::filesystem::remove_all(DIRECTORY);
+}
+
+//A client that sends requests but never reads the responses cannot keep the server from stopping
+TEST(LossServerTests, unreadResponsesTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_loss_server_unread_test";
+	const std::string SOCKET_PATH = (std::filesystem::temp_directory_path()/"p452_loss_server_unread_test.sock").string();
+	writeTestTile(DIRECTORY);
+	TerrainModel::RasterTileCache terrain(DIRECTORY.string());
+
+	P452::LossServerOptions options;
+	options.shutdownTimeout_ms = 100.0;
+	P452::LossServer server(SOCKET_PATH, terrain, options);
+	std::promise<void> servePromise;
+	std::future<void> serveFuture = servePromise.get_future();
+	std::thread serverThread([&](){
+		server.serve();
+		servePromise.set_value();
+	});
+
+	const int clientFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	ASSERT_GE(clientFd, 0);
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	std::strncpy(address.sun_path, SOCKET_PATH.c_str(), sizeof(address.sun_path)-1);
+	ASSERT_EQ(0, ::connect(clientFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)));
+	P452::LossProtocol::RequestHeader emptyRequest;
+	emptyRequest.freq_GHz = 2.0;
+	emptyRequest.timePercent = 10.0;
+	//the first response shows the connection is being served
+	P452::LossProtocol::writeAll(clientFd, &emptyRequest, sizeof(emptyRequest));
+	P452::LossProtocol::ResponseHeader response;
+	ASSERT_TRUE(P452::LossProtocol::readExact(clientFd, &response, sizeof(response)));
+	EXPECT_EQ(P452::LossProtocol::Status::Ok, response.status);
+
+	//send until the socket buffers stay full: the server stopped reading, it is blocked sending responses nobody reads
+	const std::vector<P452::LossProtocol::RequestHeader> REQUESTS(1000, emptyRequest);
+	pollfd clientPollFd{clientFd, POLLOUT, 0};
+	do{
+		while(::send(clientFd, REQUESTS.data(), REQUESTS.size()*sizeof(emptyRequest), MSG_DONTWAIT | MSG_NOSIGNAL)>0){
+		}
+		ASSERT_TRUE(errno==EAGAIN || errno==EWOULDBLOCK) << std::strerror(errno);
+	}while(::poll(&clientPollFd, 1, 200)>0);
+
+	server.stop();
+	EXPECT_EQ(std::future_status::ready, serveFuture.wait_for(std::chrono::seconds(30)));
+	//closing the client also ends a connection the server failed to shut down, so the test cannot hang
+	::close(clientFd);
+	serverThread.join();
+	std::filesystem::remove_all(DIRECTORY);
+}
@@ -0,0 +1,167 @@
+#include "gtest/gtest.h"
+
+#include "P452/P452.h"
+#include "P452/P452C.h"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+	//raw float DEM tile covering N29E047
+	void writeTestTile(const std::filesystem::path& directory){
+		std::filesystem::create_directories(directory);
+		const uint32_t GRID_SIZE = 121;
+		std::vector<float> values;
+		for(uint32_t row = 0; row<GRID_SIZE; row++){
+			for(uint32_t col = 0; col<GRID_SIZE; col++){
+				values.push_back(row>110 ? 0.0f : static_cast<float>(15.0+3.0*col+std::max(0.0, 150.0-4.0*std::abs(row-60.0))));
+			}
+		}
+		const double STEP_DEG = 1.0/(GRID_SIZE-1);
+		TerrainModel::RasterTile(TerrainModel::TileGeometry{30.0, 47.0, STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, values)
+				.saveRawFloat((directory/"N29E047.f32").string());
+	}
+}
+
+//Profile batches through the C interface match the C++ single link interface
+TEST(P452CTests, profileBatchTest){
+	EXPECT_EQ(static_cast<uint32_t>(P452_C_ABI_VERSION), p452_abi_version());
+	p452_context* context = nullptr;
+	ASSERT_EQ(P452_OK, p452_context_create(nullptr, &context));
+	ASSERT_NE(nullptr, context);
+
+	std::vector<double> heights_m;
+	std::vector<int64_t> offsets{0};
+	for(int linkInd = 0; linkInd<3; linkInd++){
+		for(int pointInd = 0; pointInd<50+10*linkInd; pointInd++){
+			heights_m.push_back(30.0+100.0*std::exp(-std::pow((pointInd-25.0)/5.0, 2)));
+		}
+		offsets.push_back(static_cast<int64_t>(heights_m.size()));
+	}
+	const double STEP_KM = 0.1, LAT_DEG = 29.5, LON_DEG = 47.5, RX_HEIGHT_M = 10.0, TIME_PERCENT = 10.0;
+	const std::vector<double> TX_HEIGHTS_M{15.0, 20.0, 25.0}, FREQS_GHZ{0.9, 2.0, 6.0};
+	const std::vector<int32_t> TX_CLUTTER_TYPES{ClutterModel::ClutterType::Urban};
+
+	p452_profile_columns links;
+	std::memset(&links, 0, sizeof(links));
+	links.struct_size = sizeof(links);
+	links.heights_m = heights_m.data();
+	links.num_heights = heights_m.size();
+	links.offsets = offsets.data();
+	links.num_offsets = offsets.size();
+	links.step_distances_km = &STEP_KM;
+	links.num_step_distances = 1;
+	links.midpoint_lats_deg = &LAT_DEG;
+	links.num_midpoint_lats = 1;
+	links.midpoint_lons_deg = &LON_DEG;
+	links.num_midpoint_lons = 1;
+	links.tx_heights_m = TX_HEIGHTS_M.data();
+	links.num_tx_heights = TX_HEIGHTS_M.size();
+	links.rx_heights_m = &RX_HEIGHT_M;
+	links.num_rx_heights = 1;
+	links.freqs_ghz = FREQS_GHZ.data();
+	links.num_freqs = FREQS_GHZ.size();
+	links.time_percents = &TIME_PERCENT;
+	links.num_time_percents = 1;
+	links.tx_clutter_types = TX_CLUTTER_TYPES.data();
+	links.num_tx_clutter_types = TX_CLUTTER_TYPES.size();
+
+	std::vector<double> lossList_dB(3);
+	ASSERT_EQ(P452_OK, p452_calculate_profile_batch(context, &links, 0, lossList_dB.data(), lossList_dB.size()));
+	EXPECT_STREQ("", p452_last_error());
+	for(std::size_t linkInd = 0; linkInd<3; linkInd++){
+		const std::vector<double> PROFILE(heights_m.begin()+offsets[linkInd], heights_m.begin()+offsets[linkInd+1]);
+		EXPECT_DOUBLE_EQ(P452::calculateP452Loss_dB(TX_HEIGHTS_M[linkInd], RX_HEIGHT_M, PROFILE, STEP_KM, LAT_DEG, LON_DEG,
+				FREQS_GHZ[linkInd], TIME_PERCENT, 0, 0.0, 0.0, ClutterModel::ClutterType::Urban), lossList_dB[linkInd]);
+	}
+
+	//errors are returned as status codes with a message
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_profile_batch(context, &links, 0, lossList_dB.data(), 2));
+	EXPECT_NE(std::string::npos, std::string(p452_last_error()).find("losses"));
+	links.num_freqs = 2;
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_profile_batch(context, &links, 0, lossList_dB.data(), 3));
+	EXPECT_NE(std::string::npos, std::string(p452_last_error()).find("freqs_GHz"));
+	links.num_freqs = 3;
+	links.rx_horizon_gains_dbi = nullptr;
+	links.num_rx_horizon_gains = 3;
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_profile_batch(context, &links, 0, lossList_dB.data(), 3));
+	links.num_rx_horizon_gains = 0;
+	//an empty profile is refused instead of being evaluated
+	const std::vector<int64_t> EMPTY_PROFILE_OFFSETS{0, 0, offsets[2], offsets[3]};
+	links.offsets = EMPTY_PROFILE_OFFSETS.data();
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_profile_batch(context, &links, 0, lossList_dB.data(), 3));
+	EXPECT_NE(std::string::npos, std::string(p452_last_error()).find("Profile 0")) << p452_last_error();
+	links.offsets = offsets.data();
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_profile_batch(nullptr, &links, 0, lossList_dB.data(), 3));
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_context_create(nullptr, nullptr));
+	EXPECT_EQ(P452_OK, p452_calculate_profile_batch(context, &links, 0, lossList_dB.data(), 3));
+
+	//structures of another layout are rejected instead of read past their end
+	for(const std::size_t& structSize : {std::size_t(0), sizeof(links)-sizeof(size_t), sizeof(links)+sizeof(size_t)}){
+		links.struct_size = structSize;
+		EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_profile_batch(context, &links, 0, lossList_dB.data(), 3));
+		EXPECT_NE(std::string::npos, std::string(p452_last_error()).find("struct_size")) << p452_last_error();
+	}
+	links.struct_size = sizeof(links);
+
+	//terrain needs a DEM directory
+	p452_terrain_columns terrainLinks;
+	std::memset(&terrainLinks, 0, sizeof(terrainLinks));
+	terrainLinks.struct_size = sizeof(terrainLinks);
+	EXPECT_EQ(P452_ERROR_NO_TERRAIN, p452_calculate_terrain_batch(context, &terrainLinks, 2.0, 10.0, 0, nullptr, 0));
+	p452_context_destroy(context);
+	p452_context_destroy(nullptr);
+}
+
+//Terrain batches through the C interface match the C++ single link interface
+TEST(P452CTests, terrainBatchTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_c_interface_test";
+	writeTestTile(DIRECTORY);
+	const std::string DEM_DIRECTORY = DIRECTORY.string();
+	p452_context_options options{sizeof(p452_context_options), DEM_DIRECTORY.c_str(), nullptr, 2, 0.0};
+	p452_context* context = nullptr;
+	ASSERT_EQ(P452_OK, p452_context_create(&options, &context));
+
+	const std::vector<double> TX_LATS{29.8, 29.7}, TX_LONS{47.2, 47.3}, RX_LATS{29.1, 29.4}, RX_LONS{47.9, 47.8};
+	const std::vector<double> TX_HEIGHTS{20.0, 30.0}, RX_HEIGHTS{10.0, 12.0};
+	const std::vector<int32_t> RX_CLUTTER_TYPES{ClutterModel::ClutterType::NoClutter, ClutterModel::ClutterType::Suburban};
+	p452_terrain_columns links{sizeof(p452_terrain_columns), 2, TX_LATS.data(), TX_LONS.data(), RX_LATS.data(), RX_LONS.data(), TX_HEIGHTS.data(), RX_HEIGHTS.data(),
+			nullptr, nullptr, nullptr, RX_CLUTTER_TYPES.data()};
+	std::vector<double> lossList_dB(2);
+	ASSERT_EQ(P452_OK, p452_calculate_terrain_batch(context, &links, 2.0, 10.0, 1, lossList_dB.data(), lossList_dB.size()));
+
+	TerrainModel::RasterTileCache terrain(DEM_DIRECTORY);
+	for(std::size_t linkInd = 0; linkInd<2; linkInd++){
+		EXPECT_DOUBLE_EQ(P452::calculateP452LossFromTerrain_dB(terrain, {TX_LATS[linkInd], TX_LONS[linkInd]}, 
+				{RX_LATS[linkInd], RX_LONS[linkInd]}, TX_HEIGHTS[linkInd], RX_HEIGHTS[linkInd], 2.0, 10.0, 1, 0.0, 0.0,
+				ClutterModel::ClutterType::NoClutter, static_cast<ClutterModel::ClutterType>(RX_CLUTTER_TYPES[linkInd])),
+				lossList_dB[linkInd]);
+	}
+
+	const std::vector<int32_t> BAD_CLUTTER_TYPES{0, 42};
+	links.rx_clutter_types = BAD_CLUTTER_TYPES.data();
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_terrain_batch(context, &links, 2.0, 10.0, 0, lossList_dB.data(), 2));
+	links.rx_clutter_types = nullptr;
+	links.rx_lons_deg = nullptr;
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_terrain_batch(context, &links, 2.0, 10.0, 0, lossList_dB.data(), 2));
+	links.rx_lons_deg = RX_LONS.data();
+	//the model rejects the time percentage
+	EXPECT_NE(P452_OK, p452_calculate_terrain_batch(context, &links, 2.0, 80.0, 0, lossList_dB.data(), 2));
+	EXPECT_STRNE("", p452_last_error());
+	links.struct_size = sizeof(size_t);
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_calculate_terrain_batch(context, &links, 2.0, 10.0, 0, lossList_dB.data(), 2));
+	EXPECT_NE(std::string::npos, std::string(p452_last_error()).find("struct_size")) << p452_last_error();
+	p452_context_destroy(context);
+
+	options.struct_size = sizeof(p452_context_options)+sizeof(size_t);
+	EXPECT_EQ(P452_ERROR_INVALID_ARGUMENT, p452_context_create(&options, &context));
+	EXPECT_EQ(nullptr, context);
+	options.struct_size = sizeof(p452_context_options);
+	options.atmospheric_tile_path = "/nonexistent/atmosphere.bin";
+	EXPECT_NE(P452_OK, p452_context_create(&options, &context));
+	EXPECT_EQ(nullptr, context);
+	std::filesystem::remove_all(DIRECTORY);
+}
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+
+#include "P452/BatchLoss.h"
+#include "P452/Pipeline.h"
+#include "P452/ProfileSource.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	const double STEP_KM = 0.5;
+
+	std::vector<double> syntheticProfile(const std::size_t& linkInd){
+		std::vector<double> heights_m;
+		for(std::size_t pointInd = 0; pointInd<30+7*(linkInd%9); pointInd++){
+			heights_m.push_back(pointInd<4 ? 0.0 : 40.0+25.0*std::sin(0.13*pointInd*(linkInd%5+1)));
+		}
+		return heights_m;
+	}
+
+	TerrainModel::GeoPoint syntheticMidpoint(const std::size_t& linkInd){
+		return TerrainModel::GeoPoint{29.1+0.03*(linkInd%20), 47.1+0.02*(linkInd%30)};
+	}
+
+	//all links of the source in a single batch
+	TerrainModel::ProfileBatch buildBatch(const std::size_t& numLinks){
+		TerrainModel::ProfileBatch batch;
+		for(std::size_t linkInd = 0; linkInd<numLinks; linkInd++){
+			const auto heights_m = syntheticProfile(linkInd);
+			batch.append(heights_m, STEP_KM, STEP_KM*(heights_m.size()-1), syntheticMidpoint(linkInd));
+		}
+		return batch;
+	}
+
+	//source of numLinks synthetic links, without atmospheres
+	P452::CallbackProfileSource buildSource(const std::size_t& numLinks, std::size_t& nextLinkInd){
+		return P452::CallbackProfileSource([&nextLinkInd, numLinks](P452::LinkBatch& out_batch){
+			if(nextLinkInd==numLinks){
+				return false;
+			}
+			const auto heights_m = syntheticProfile(nextLinkInd);
+			out_batch.profiles.append(heights_m, STEP_KM, STEP_KM*(heights_m.size()-1), syntheticMidpoint(nextLinkInd));
+			out_batch.links.push_back(P452::LinkParameters{20.0, 10.0});
+			nextLinkInd++;
+			return true;
+		});
+	}
+}
+
+//The pipeline must give the losses of the batch calculation, in order, and account for every link in every stage
+TEST(PipelineTests, sameResultAsBatchTest){
+	const std::size_t NUM_LINKS = 103;
+	const std::vector<P452::LinkParameters> LINKS = {{20.0, 10.0}};
+	const auto EXPECTED_LOSS_LIST = P452::calculateP452LossBatch_dB(buildBatch(NUM_LINKS), LINKS, 2.0, 10.0);
+
+	const std::vector<std::size_t> CHUNKS_IN_FLIGHT_LIST = {1, 2, 5};
+	for(const std::size_t& chunksInFlight : CHUNKS_IN_FLIGHT_LIST){
+		std::size_t nextLinkInd = 0;
+		auto source = buildSource(NUM_LINKS, nextLinkInd);
+		std::vector<double> lossList_dB;
+		const auto METRICS = P452::calculateP452LossPipeline_dB(source, 2.0, 10.0,
+				[&](const std::size_t& firstLinkInd, std::span<const double> chunkLossList_dB){
+			EXPECT_EQ(lossList_dB.size(), firstLinkInd);
+			lossList_dB.insert(lossList_dB.end(), chunkLossList_dB.begin(), chunkLossList_dB.end());
+		}, 0, P452::PipelineOptions{10, chunksInFlight, 2});
+
+		ASSERT_EQ(EXPECTED_LOSS_LIST.size(), lossList_dB.size());
+		for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+			EXPECT_DOUBLE_EQ(EXPECTED_LOSS_LIST[linkInd], lossList_dB[linkInd]);
+		}
+		EXPECT_EQ(NUM_LINKS, METRICS.numLinks);
+		EXPECT_GT(METRICS.wallTime_s, 0.0);
+		for(const auto& stageMetrics : METRICS.stages){
+			EXPECT_EQ(NUM_LINKS, stageMetrics.numLinks);
+			EXPECT_EQ(11u, stageMetrics.numChunks);
+			EXPECT_LE(stageMetrics.maxQueueDepth, chunksInFlight);
+			EXPECT_LE(stageMetrics.meanQueueDepth, static_cast<double>(stageMetrics.maxQueueDepth));
+		}
+		EXPECT_GT(METRICS[P452::PipelineStage::ModelEvaluation].busyTime_s, 0.0);
+		EXPECT_GT(METRICS[P452::PipelineStage::ModelEvaluation].linksPerSecond(), 0.0);
+	}
+}
+
+//With an atmospheric tile the midpoints are looked up in the tile
+TEST(PipelineTests, atmosphericTileTest){
+	const std::size_t NUM_LINKS = 25;
+	const auto TILE = P452::AtmosphericTile::generate(P452::AtmosphericGridDefinition{29.0, 47.0, 0.1, 0.1, 11, 11});
+	const auto BATCH = buildBatch(NUM_LINKS);
+	std::vector<P452::AtmosphericParameters> atmospheres;
+	for(const auto& midpoint : BATCH.midpoints){
+		atmospheres.push_back(TILE.lookup(midpoint.lat_deg, midpoint.lon_deg));
+	}
+	const auto EXPECTED_LOSS_LIST = P452::calculateP452LossBatch_dB(BATCH, std::vector<P452::LinkParameters>{{20.0, 10.0}},
+			0.8, 40.0, 1, atmospheres);
+
+	std::size_t nextLinkInd = 0;
+	auto source = buildSource(NUM_LINKS, nextLinkInd);
+	std::vector<double> lossList_dB;
+	P452::PipelineOptions options;
+	options.chunkSize = 4;
+	options.threadCount = 3;
+	options.atmosphericTile = &TILE;
+	P452::calculateP452LossPipeline_dB(source, 0.8, 40.0, [&](const std::size_t&, std::span<const double> chunkLossList_dB){
+		lossList_dB.insert(lossList_dB.end(), chunkLossList_dB.begin(), chunkLossList_dB.end());
+	}, 1, options);
+	ASSERT_EQ(NUM_LINKS, lossList_dB.size());
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		EXPECT_DOUBLE_EQ(EXPECTED_LOSS_LIST[linkInd], lossList_dB[linkInd]);
+	}
+}
+
+//An error in any stage stops the pipeline and reaches the caller
+TEST(PipelineTests, errorTest){
+	const auto NO_SINK = [](const std::size_t&, std::span<const double>){};
+	std::size_t numCalls = 0;
+	P452::CallbackProfileSource failingSource([&](P452::LinkBatch& out_batch){
+		if(++numCalls>20){
+			throw std::runtime_error("generator failure");
+		}
+		out_batch.profiles.append(syntheticProfile(0), STEP_KM, STEP_KM*29, syntheticMidpoint(0));
+		out_batch.links.push_back(P452::LinkParameters{20.0, 5.0});
+		return true;
+	});
+	EXPECT_THROW(P452::calculateP452LossPipeline_dB(failingSource, 2.0, 10.0, NO_SINK, 0, P452::PipelineOptions{3, 2, 1}),
+			std::runtime_error);
+
+	std::size_t nextLinkInd = 0;
+	auto source = buildSource(1000, nextLinkInd);
+	std::size_t numChunksWritten = 0;
+	EXPECT_THROW(P452::calculateP452LossPipeline_dB(source, 2.0, 10.0, [&](const std::size_t&, std::span<const double>){
+		if(++numChunksWritten==2){
+			throw std::logic_error("sink failure");
+		}
+	}, 0, P452::PipelineOptions{5, 3, 1}), std::logic_error);
+	//the remaining links are not read
+	EXPECT_LT(nextLinkInd, 1000u);
+
+	EXPECT_THROW(P452::calculateP452LossPipeline_dB(source, 2.0, 10.0, NO_SINK, 0, P452::PipelineOptions{0}), std::invalid_argument);
+	EXPECT_THROW(P452::calculateP452LossPipeline_dB(source, 2.0, 10.0, NO_SINK, 0, P452::PipelineOptions{5, 0}),
+			std::invalid_argument);
+}
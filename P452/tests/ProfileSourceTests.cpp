@@ -0,0 +1,182 @@
+#include "gtest/gtest.h"
+
+#include "P452/P452.h"
+#include "P452/BatchLoss.h"
+#include "P452/ProfileSource.h"
+#include "MainModel/ProfileArchive.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+	//collects the streamed losses and checks that the chunks arrive in order
+	struct LossCollector{
+		std::vector<double> lossList_dB;
+		std::size_t numChunks = 0;
+		void operator()(const std::size_t& firstLinkInd, std::span<const double> chunkLossList_dB){
+			EXPECT_EQ(lossList_dB.size(), firstLinkInd);
+			lossList_dB.insert(lossList_dB.end(), chunkLossList_dB.begin(), chunkLossList_dB.end());
+			numChunks++;
+		}
+	};
+
+	std::vector<double> syntheticProfile(const std::size_t& linkInd){
+		std::vector<double> heights_m;
+		for(std::size_t pointInd = 0; pointInd<40+10*linkInd; pointInd++){
+			heights_m.push_back(pointInd<5 ? 0.0 : 30.0+20.0*std::sin(0.1*pointInd*(linkInd+1)));
+		}
+		return heights_m;
+	}
+}
+
+//Streaming a DEM source in small chunks should give the losses of the whole batch, in order
+TEST(ProfileSourceTests, demStreamTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_dem_stream_test";
+	std::filesystem::create_directories(DIRECTORY);
+	const uint32_t GRID_SIZE = 121;
+	std::vector<float> values;
+	for(uint32_t row = 0; row<GRID_SIZE; row++){
+		for(uint32_t col = 0; col<GRID_SIZE; col++){
+			values.push_back(row>110 ? 0.0f : static_cast<float>(20.0+2.0*col+std::max(0.0, 200.0-5.0*std::abs(row-40.0))));
+		}
+	}
+	const double STEP_DEG = 1.0/(GRID_SIZE-1);
+	TerrainModel::RasterTile(TerrainModel::TileGeometry{30.0, 47.0, STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, values)
+			.saveRawFloat((DIRECTORY/"N29E047.f32").string());
+	TerrainModel::RasterTileCache terrain(DIRECTORY.string());
+
+	const TerrainModel::GeoPoint TX{29.8, 47.5};
+	std::vector<TerrainModel::GeoPoint> RX_LIST;
+	for(std::size_t linkInd = 0; linkInd<11; linkInd++){
+		RX_LIST.push_back(TerrainModel::GeoPoint{29.05+0.08*linkInd, 47.05+0.07*linkInd});
+	}
+	const std::vector<P452::LinkParameters> LINKS = {{25.0, 10.0}};
+
+	TerrainModel::ProfileBatch batch;
+	TerrainModel::BatchProfileSampler(terrain).sample(TX, RX_LIST, batch);
+	const auto EXPECTED_LOSS_LIST = P452::calculateP452LossBatch_dB(batch, LINKS, 1.5, 1.0);
+
+	P452::DemProfileSource source(terrain, TX, RX_LIST, LINKS);
+	LossCollector collector;
+	const std::size_t NUM_LINKS = P452::calculateP452LossStream_dB(source, 1.5, 1.0, std::ref(collector), 0,
+			P452::StreamOptions{3, 1, 2});
+	std::filesystem::remove_all(DIRECTORY);
+
+	EXPECT_EQ(RX_LIST.size(), NUM_LINKS);
+	EXPECT_EQ(4u, collector.numChunks);
+	ASSERT_EQ(EXPECTED_LOSS_LIST.size(), collector.lossList_dB.size());
+	for(std::size_t linkInd = 0; linkInd<EXPECTED_LOSS_LIST.size(); linkInd++){
+		EXPECT_DOUBLE_EQ(EXPECTED_LOSS_LIST[linkInd], collector.lossList_dB[linkInd]);
+	}
+
+	EXPECT_THROW(P452::DemProfileSource(terrain, TX, RX_LIST, std::vector<P452::LinkParameters>(2, LINKS.front())),
+			std::invalid_argument);
+}
+
+//Archive profiles with zones should give the same loss as the single link zone interface
+TEST(ProfileSourceTests, archiveStreamTest){
+	const std::string ARCHIVE_PATH = (std::filesystem::temp_directory_path()/"p452_archive_stream_test.bin").string();
+	const double STEP_KM = 0.25;
+	const std::size_t NUM_PROFILES = 5;
+	const P452::AtmosphericParameters ATMOSPHERE{45.0, 330.0, 290.0, 1000.0};
+	{
+		PathProfile::ProfileArchiveWriter writer(ARCHIVE_PATH);
+		for(std::size_t profileInd = 0; profileInd<NUM_PROFILES; profileInd++){
+			const auto heights_m = syntheticProfile(profileInd);
+			PathProfile::Path path;
+			for(std::size_t pointInd = 0; pointInd<heights_m.size(); pointInd++){
+				path.push_back(PathProfile::ProfilePoint(pointInd*STEP_KM, heights_m[pointInd],
+						heights_m[pointInd]==0.0 ? PathProfile::ZoneType::Sea : PathProfile::ZoneType::CoastalLand));
+			}
+			writer.append(path);
+		}
+		writer.finish();
+	}
+
+	auto linkInfo = [](const std::size_t& profileInd){
+		return P452::ArchiveLinkInfo{P452::LinkParameters{15.0+profileInd, 10.0}, TerrainModel::GeoPoint{29.5, 47.5}, 0.0, 3.0};
+	};
+	P452::ArchiveProfileSource source(ARCHIVE_PATH, linkInfo);
+	P452::LinkBatch chunk;
+	std::vector<double> expectedLossList_dB;
+	for(std::size_t chunkInd = 0; source.next(chunk, 2); chunkInd++){
+		EXPECT_LE(chunk.size(), 2u);
+		ASSERT_TRUE(chunk.profiles.hasZones());
+		const auto lossList_dB = P452::calculateP452LossBatch_dB(chunk.profiles, chunk.links, 2.0, 10.0, 0,
+				std::vector<P452::AtmosphericParameters>(chunk.size(), ATMOSPHERE));
+		for(std::size_t linkInd = 0; linkInd<chunk.size(); linkInd++){
+			const std::size_t profileInd = 2*chunkInd+linkInd;
+			const auto heights_m = syntheticProfile(profileInd);
+			EXPECT_NEAR(STEP_KM, chunk.profiles.stepDistances_km[linkInd], 1.0e-12);
+			std::vector<PathProfile::ZoneType> zones;
+			for(const double& height_m : heights_m){
+				zones.push_back(height_m==0.0 ? PathProfile::ZoneType::Sea : PathProfile::ZoneType::CoastalLand);
+			}
+			const double EXPECTED_LOSS = P452::calculateP452Loss_dB(15.0+profileInd, 10.0, heights_m, zones, 0.0, 3.0, STEP_KM, 29.5,
+					ATMOSPHERE, 2.0, 10.0);
+			EXPECT_DOUBLE_EQ(EXPECTED_LOSS, lossList_dB[linkInd]);
+			expectedLossList_dB.push_back(EXPECTED_LOSS);
+		}
+	}
+	EXPECT_EQ(NUM_PROFILES, expectedLossList_dB.size());
+	EXPECT_FALSE(source.next(chunk, 2));
+	EXPECT_TRUE(chunk.empty());
+
+	//non uniform profiles are rejected
+	{
+		PathProfile::ProfileArchiveWriter writer(ARCHIVE_PATH);
+		PathProfile::Path path;
+		path.push_back(PathProfile::ProfilePoint(0.0, 10.0));
+		path.push_back(PathProfile::ProfilePoint(0.1, 10.0));
+		path.push_back(PathProfile::ProfilePoint(0.3, 10.0));
+		writer.append(path);
+		writer.finish();
+	}
+	P452::ArchiveProfileSource nonUniformSource(ARCHIVE_PATH, linkInfo);
+	EXPECT_THROW(nonUniformSource.next(chunk, 2), std::runtime_error);
+	std::filesystem::remove(ARCHIVE_PATH);
+}
+
+//Callback sources pass the atmospheres through, and errors of the generator reach the caller
+TEST(ProfileSourceTests, callbackStreamTest){
+	const std::size_t NUM_LINKS = 7;
+	const double STEP_KM = 0.5;
+	const P452::AtmosphericParameters ATMOSPHERE{40.0, 320.0, 288.0, 1013.0};
+	std::size_t nextLinkInd = 0;
+	P452::CallbackProfileSource source([&](P452::LinkBatch& out_batch){
+		if(nextLinkInd==NUM_LINKS){
+			return false;
+		}
+		const auto heights_m = syntheticProfile(nextLinkInd);
+		out_batch.profiles.append(heights_m, STEP_KM, STEP_KM*(heights_m.size()-1), TerrainModel::GeoPoint{29.5, 47.5});
+		out_batch.links.push_back(P452::LinkParameters{20.0, 5.0+nextLinkInd});
+		out_batch.atmospheres.push_back(ATMOSPHERE);
+		nextLinkInd++;
+		return true;
+	});
+	LossCollector collector;
+	EXPECT_EQ(NUM_LINKS, P452::calculateP452LossStream_dB(source, 0.9, 20.0, std::ref(collector), 1, P452::StreamOptions{2, 3, 1}));
+	EXPECT_EQ(4u, collector.numChunks);
+	ASSERT_EQ(NUM_LINKS, collector.lossList_dB.size());
+	for(std::size_t linkInd = 0; linkInd<NUM_LINKS; linkInd++){
+		const double EXPECTED_LOSS = P452::calculateP452Loss_dB(20.0, 5.0+linkInd, syntheticProfile(linkInd), STEP_KM, 29.5,
+				ATMOSPHERE, 0.9, 20.0, 1);
+		EXPECT_DOUBLE_EQ(EXPECTED_LOSS, collector.lossList_dB[linkInd]);
+	}
+
+	std::size_t numCalls = 0;
+	P452::CallbackProfileSource failingSource([&](P452::LinkBatch& out_batch){
+		if(++numCalls>3){
+			throw std::runtime_error("generator failure");
+		}
+		out_batch.profiles.append(syntheticProfile(0), STEP_KM, STEP_KM*39, TerrainModel::GeoPoint{29.5, 47.5});
+		out_batch.links.push_back(P452::LinkParameters{20.0, 5.0});
+		out_batch.atmospheres.push_back(ATMOSPHERE);
+		return true;
+	});
+	LossCollector failingCollector;
+	EXPECT_THROW(P452::calculateP452LossStream_dB(failingSource, 0.9, 20.0, std::ref(failingCollector), 1,
+			P452::StreamOptions{1, 1, 1}), std::runtime_error);
+}
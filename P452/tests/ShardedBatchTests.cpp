@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+
+#include "P452/P452.h"
+#include "P452/ShardedBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	//raw float DEM tile with a ridge across the middle
+	void writeTestTile(const std::filesystem::path& directory, const int& westLon){
+		std::filesystem::create_directories(directory);
+		const uint32_t GRID_SIZE = 121;
+		std::vector<float> values;
+		for(uint32_t row = 0; row<GRID_SIZE; row++){
+			for(uint32_t col = 0; col<GRID_SIZE; col++){
+				values.push_back(row>110 ? 0.0f : static_cast<float>(15.0+3.0*col+std::max(0.0, 150.0-4.0*std::abs(row-60.0))));
+			}
+		}
+		const double STEP_DEG = 1.0/(GRID_SIZE-1);
+		TerrainModel::RasterTile(TerrainModel::TileGeometry{30.0, static_cast<double>(westLon), STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, 
+				values).saveRawFloat((directory/(TerrainModel::tileNameFor(29.5, westLon+0.5)+".f32")).string());
+	}
+
+	//links inside N29E047, except link 7 which ends in N29E048
+	std::vector<P452::TerrainLink> buildLinks(const std::size_t& numLinks){
+		std::vector<P452::TerrainLink> links;
+		for(std::size_t linkInd = 0; linkInd<numLinks; linkInd++){
+			P452::TerrainLink link{{29.8, 47.2+0.01*(linkInd%7)}, {29.1+0.05*(linkInd%11), 47.9-0.03*(linkInd%13)}, 
+					P452::LinkParameters{20.0+linkInd%4, 10.0}};
+			if(linkInd%3==0){
+				link.parameters.txClutterType = ClutterModel::ClutterType::Urban;
+			}
+			if(linkInd==7){
+				link.rx.lon_deg = 48.2;
+			}
+			links.push_back(link);
+		}
+		return links;
+	}
+
+	void writeLinkFile(const std::string& filePath, const std::vector<P452::TerrainLink>& links){
+		std::ofstream file(filePath, std::ios::trunc);
+		file.precision(17);
+		file << "# test links\ntxLat,txLon,rxLat,rxLon,txHeight_m,rxHeight_m,txGain_dBi,rxGain_dBi,txClutter,rxClutter\n";
+		for(const auto& link : links){
+			file << link.tx.lat_deg << ',' << link.tx.lon_deg << ',' << link.rx.lat_deg << ',' << link.rx.lon_deg << ','
+					<< link.parameters.txHeight_m << ',' << link.parameters.rxHeight_m << ",0,0," 
+					<< link.parameters.txClutterType << ',' << link.parameters.rxClutterType << '\n';
+		}
+	}
+
+	std::string readFile(const std::string& filePath){
+		std::ifstream file(filePath);
+		std::ostringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+}
+
+//A failed shard is reported without an output file, and the rerun only calculates that shard
+TEST(ShardedBatchTests, resumeFailedShardTest){
+	const std::filesystem::path ROOT = std::filesystem::temp_directory_path()/"p452_sharded_batch_test";
+	std::filesystem::remove_all(ROOT);
+	const std::filesystem::path DEM_DIRECTORY = ROOT/"dem";
+	const std::string LINK_FILE = (ROOT/"links.csv").string();
+	const std::string WORK_DIRECTORY = (ROOT/"work").string();
+	const std::string OUTPUT_FILE = (ROOT/"losses.csv").string();
+	writeTestTile(DEM_DIRECTORY, 47);
+	const auto LINKS = buildLinks(12);
+	writeLinkFile(LINK_FILE, LINKS);
+
+	P452::ShardedRunOptions options;
+	options.numShards = 4;
+	options.numProcesses = 2;
+	options.threadsPerProcess = 2;
+	options.missingTilePolicy = TerrainModel::MissingTilePolicy::Throw;
+
+	//link 7 of shard 2 needs the missing tile N29E048
+	auto result = P452::runShardedP452Batch(LINK_FILE, DEM_DIRECTORY.string(), WORK_DIRECTORY, OUTPUT_FILE, 2.0, 10.0, 0, options);
+	EXPECT_EQ(12u, result.numLinks);
+	EXPECT_EQ(4u, result.numShards);
+	EXPECT_FALSE(result.isComplete());
+	EXPECT_EQ((std::vector<std::size_t>{0, 1, 3}), result.calculatedShards);
+	EXPECT_TRUE(result.resumedShards.empty());
+	ASSERT_EQ((std::vector<std::size_t>{2}), result.failedShards);
+	EXPECT_NE(std::string::npos, result.failureMessages.front().find("N29E048"));
+	EXPECT_EQ(1u, result.numSharedTiles);
+	EXPECT_FALSE(std::filesystem::exists(OUTPUT_FILE));
+
+	writeTestTile(DEM_DIRECTORY, 48);
+	result = P452::runShardedP452Batch(LINK_FILE, DEM_DIRECTORY.string(), WORK_DIRECTORY, OUTPUT_FILE, 2.0, 10.0, 0, options);
+	EXPECT_TRUE(result.isComplete());
+	EXPECT_EQ((std::vector<std::size_t>{2}), result.calculatedShards);
+	EXPECT_EQ((std::vector<std::size_t>{0, 1, 3}), result.resumedShards);
+	EXPECT_EQ(2u, result.numSharedTiles);
+
+	//the merged output matches the single link interface, in link order
+	TerrainModel::RasterTileCache terrain(DEM_DIRECTORY.string());
+	std::ifstream output(OUTPUT_FILE);
+	std::string line;
+	ASSERT_TRUE(std::getline(output, line));
+	EXPECT_EQ("link,loss_dB", line);
+	for(std::size_t linkInd = 0; linkInd<LINKS.size(); linkInd++){
+		ASSERT_TRUE(std::getline(output, line));
+		const std::size_t COMMA = line.find(',');
+		EXPECT_EQ(std::to_string(linkInd), line.substr(0, COMMA));
+		const auto& LINK = LINKS[linkInd];
+		EXPECT_DOUBLE_EQ(P452::calculateP452LossFromTerrain_dB(terrain, LINK.tx, LINK.rx, LINK.parameters.txHeight_m,
+				LINK.parameters.rxHeight_m, 2.0, 10.0, 0, 0, 0, LINK.parameters.txClutterType, LINK.parameters.rxClutterType),
+				std::stod(line.substr(COMMA+1)));
+	}
+	EXPECT_FALSE(std::getline(output, line));
+
+	//other shard and process counts without resuming give the same file
+	const std::string FIRST_OUTPUT = readFile(OUTPUT_FILE);
+	options.numShards = 5;
+	options.numProcesses = 3;
+	options.threadsPerProcess = 1;
+	options.shareTiles = false;
+	options.resume = false;
+	result = P452::runShardedP452Batch(LINK_FILE, DEM_DIRECTORY.string(), WORK_DIRECTORY, OUTPUT_FILE, 2.0, 10.0, 0, options);
+	EXPECT_TRUE(result.isComplete());
+	EXPECT_EQ(5u, result.calculatedShards.size());
+	EXPECT_EQ(0u, result.numSharedTiles);
+	EXPECT_EQ(FIRST_OUTPUT, readFile(OUTPUT_FILE));
+
+	//shard files of other settings are not resumed
+	options.resume = true;
+	result = P452::runShardedP452Batch(LINK_FILE, DEM_DIRECTORY.string(), WORK_DIRECTORY, OUTPUT_FILE, 0.7, 10.0, 0, options);
+	EXPECT_EQ(5u, result.calculatedShards.size());
+	EXPECT_TRUE(result.resumedShards.empty());
+	std::filesystem::remove_all(ROOT);
+}
+
+TEST(ShardedBatchTests, readLinkFileTest){
+	const std::string FILE_PATH = (std::filesystem::temp_directory_path()/"p452_link_file_test.csv").string();
+	{
+		std::ofstream file(FILE_PATH, std::ios::trunc);
+		file << "txLat,txLon,rxLat,rxLon,txHeight,rxHeight\n\n# comment\n29.8,47.2,29.1,47.9,20,10\r\n"
+				<< "29.8,47.2,29.1,47.9,20,10,3.5,-1,1,0\n";
+	}
+	const auto LINKS = P452::readLinkFile(FILE_PATH);
+	ASSERT_EQ(2u, LINKS.size());
+	EXPECT_DOUBLE_EQ(47.9, LINKS[0].rx.lon_deg);
+	EXPECT_DOUBLE_EQ(0.0, LINKS[0].parameters.txHorizonGain_dBi);
+	EXPECT_EQ(ClutterModel::ClutterType::NoClutter, LINKS[0].parameters.txClutterType);
+	EXPECT_DOUBLE_EQ(3.5, LINKS[1].parameters.txHorizonGain_dBi);
+	EXPECT_EQ(static_cast<ClutterModel::ClutterType>(1), LINKS[1].parameters.txClutterType);
+
+	for(const std::string BAD_LINE : {"29.8,47.2,29.1,47.9,20", "29.8,47.2,29.1,47.9,20,ten", "29.8,47.2,29.1,47.9,20,10,0,0,99,0"}){
+		std::ofstream(FILE_PATH, std::ios::trunc) << "29.8,47.2,29.1,47.9,20,10\n" << BAD_LINE << '\n';
+		EXPECT_THROW(P452::readLinkFile(FILE_PATH), std::runtime_error) << BAD_LINE;
+	}
+	EXPECT_THROW(P452::readLinkFile(FILE_PATH+".missing"), std::runtime_error);
+	std::filesystem::remove(FILE_PATH);
+}
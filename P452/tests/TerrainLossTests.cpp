@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+
+#include "P452/P452.h"
+#include "P452/BatchLoss.h"
+#include "TerrainModel/BatchProfileSampler.h"
+#include "TerrainModel/GreatCircle.h"
+#include "TerrainModel/TerrainProfile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+
+//Loss from coordinates should match the elevation list interface fed with a profile built by hand from the known terrain
+TEST(P452TerrainTests, lossFromTerrainTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_terrain_loss_test";
+	std::filesystem::create_directories(DIRECTORY);
+	const uint32_t GRID_SIZE = 121;
+	const double STEP_DEG = 1.0/(GRID_SIZE-1);
+	//east-west ridge along row 60, the heights are piecewise linear between the grid rows so bilinear interpolation is exact
+	auto ridgeHeight_m = [](const double& row){return 50.0+std::max(0.0, 300.0-10.0*std::abs(row-60.0));};
+	std::vector<float> values;
+	for(uint32_t row = 0; row<GRID_SIZE; row++){
+		for(uint32_t col = 0; col<GRID_SIZE; col++){
+			values.push_back(static_cast<float>(ridgeHeight_m(row)));
+		}
+	}
+	TerrainModel::RasterTile(TerrainModel::TileGeometry{30.0, 47.0, STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, values)
+			.saveRawFloat((DIRECTORY/"N29E047.f32").string());
+	TerrainModel::RasterTileCache terrain(DIRECTORY.string());
+
+	//north-south link, the great circle is the meridian so the latitude is linear along the path
+	const TerrainModel::GeoPoint TX{29.9, 47.5}, RX{29.15, 47.5};
+	const double freq_GHz = 2.0;
+	const double timePercent = 10.0;
+	const double RES_LOSS = P452::calculateP452LossFromTerrain_dB(terrain, TX, RX, 20.0, 10.0, freq_GHz, timePercent);
+	std::filesystem::remove_all(DIRECTORY);
+
+	//points no more than TerrainModel::DEFAULT_PROFILE_STEP_KM apart
+	const double PI = 3.14159265358979323846;
+	const double DISTANCE_KM = TerrainModel::EARTH_RADIUS_KM*(TX.lat_deg-RX.lat_deg)*PI/180.0;
+	const std::size_t NUM_POINTS = static_cast<std::size_t>(std::ceil(DISTANCE_KM/TerrainModel::DEFAULT_PROFILE_STEP_KM))+1;
+	std::vector<double> elevationList_m;
+	for(std::size_t pointInd = 0; pointInd<NUM_POINTS; pointInd++){
+		const double LAT_DEG = TX.lat_deg+(RX.lat_deg-TX.lat_deg)*pointInd/(NUM_POINTS-1);
+		elevationList_m.push_back(ridgeHeight_m((30.0-LAT_DEG)/STEP_DEG));
+	}
+	ASSERT_GT(*std::max_element(elevationList_m.begin(), elevationList_m.end()), 349.0);
+	const double EXPECTED_LOSS = P452::calculateP452Loss_dB(20.0, 10.0, elevationList_m, DISTANCE_KM/(NUM_POINTS-1),
+			(TX.lat_deg+RX.lat_deg)/2.0, TX.lon_deg, freq_GHz, timePercent);
+
+	EXPECT_NEAR(EXPECTED_LOSS, RES_LOSS, 1.0e-6);
+	EXPECT_GT(RES_LOSS, 0.0);
+}
+
+//The batch API should give the same loss as the single link interface
+TEST(P452TerrainTests, batchLossTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_batch_loss_test";
+	std::filesystem::create_directories(DIRECTORY);
+	const uint32_t GRID_SIZE = 121;
+	std::vector<float> values;
+	for(uint32_t row = 0; row<GRID_SIZE; row++){
+		for(uint32_t col = 0; col<GRID_SIZE; col++){
+			values.push_back(row>110 ? 0.0f : static_cast<float>(20.0+2.0*col+std::max(0.0, 200.0-5.0*std::abs(row-40.0))));
+		}
+	}
+	const double STEP_DEG = 1.0/(GRID_SIZE-1);
+	TerrainModel::RasterTile(TerrainModel::TileGeometry{30.0, 47.0, STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, values)
+			.saveRawFloat((DIRECTORY/"N29E047.f32").string());
+	TerrainModel::RasterTileCache terrain(DIRECTORY.string());
+
+	const TerrainModel::GeoPoint TX{29.8, 47.5};
+	const std::vector<TerrainModel::GeoPoint> RX_LIST = {{29.05, 47.2}, {29.3, 47.9}, {29.95, 47.05}, {29.6, 47.6}};
+	TerrainModel::ProfileBatch batch;
+	TerrainModel::BatchProfileSampler(terrain).sample(TX, RX_LIST, batch);
+
+	const std::vector<P452::LinkParameters> LINKS = {{25.0, 10.0, 0.0, 0.0, ClutterModel::ClutterType::NoClutter, 
+			ClutterModel::ClutterType::Urban}};
+	const auto RES_LOSS_LIST = P452::calculateP452LossBatch_dB(batch, LINKS, 1.5, 1.0, 1, {}, 3);
+	ASSERT_EQ(RX_LIST.size(), RES_LOSS_LIST.size());
+	for(std::size_t linkInd = 0; linkInd<RX_LIST.size(); linkInd++){
+		const double EXPECTED_LOSS = P452::calculateP452LossFromTerrain_dB(terrain, TX, RX_LIST[linkInd], 25.0, 10.0, 1.5, 1.0, 1,
+				0.0, 0.0, ClutterModel::ClutterType::NoClutter, ClutterModel::ClutterType::Urban);
+		EXPECT_NEAR(EXPECTED_LOSS, RES_LOSS_LIST[linkInd], 1.0e-6);
+	}
+	std::filesystem::remove_all(DIRECTORY);
+
+	EXPECT_THROW(P452::calculateP452LossBatch_dB(batch, std::vector<P452::LinkParameters>(2, LINKS.front()), 1.5, 1.0), 
+			std::invalid_argument);
+}
+
+//Zones from land/sea rasters should be used by both the single link and the batch interface
+TEST(P452TerrainTests, rasterZoneLossTest){
+	const std::filesystem::path ROOT = std::filesystem::temp_directory_path()/"p452_raster_zone_loss_test";
+	const uint32_t GRID_SIZE = 121;
+	const double STEP_DEG = 1.0/(GRID_SIZE-1);
+	auto writeTile = [&](const std::string& name, auto valueFunc){
+		std::filesystem::create_directories(ROOT/name);
+		std::vector<float> values;
+		for(uint32_t row = 0; row<GRID_SIZE; row++){
+			for(uint32_t col = 0; col<GRID_SIZE; col++){
+				values.push_back(static_cast<float>(valueFunc(47.0+col*STEP_DEG)));
+			}
+		}
+		TerrainModel::RasterTile(TerrainModel::TileGeometry{30.0, 47.0, STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, values)
+				.saveRawFloat((ROOT/name/"N29E047.f32").string());
+	};
+	writeTile("dem", [](double lon){return lon<47.3 ? 0.0 : 10.0+300.0*(lon-47.3);});
+	writeTile("mask", [](double lon){return lon<47.3 ? 0.0 : 1.0;});
+	writeTile("coast", [](double lon){return std::max(0.0, (lon-47.3)*97.0);});
+	TerrainModel::RasterTileCache terrain((ROOT/"dem").string());
+	TerrainModel::RasterTileCache mask((ROOT/"mask").string());
+	TerrainModel::RasterTileCache coast((ROOT/"coast").string());
+	TerrainModel::ZoneClassifier classifier(mask, coast);
+
+	const TerrainModel::GeoPoint TX{29.5, 47.1};
+	const std::vector<TerrainModel::GeoPoint> RX_LIST = {{29.4, 47.8}, {29.7, 47.35}};
+	TerrainModel::ProfileBatch batch;
+	TerrainModel::BatchProfileSampler(terrain, TerrainModel::DEFAULT_PROFILE_STEP_KM, &classifier).sample(TX, RX_LIST, batch);
+	const std::vector<P452::LinkParameters> LINKS = {{30.0, 10.0}};
+	const auto RES_LOSS_LIST = P452::calculateP452LossBatch_dB(batch, LINKS, 0.9, 5.0);
+	for(std::size_t linkInd = 0; linkInd<RX_LIST.size(); linkInd++){
+		const double EXPECTED_LOSS = P452::calculateP452LossFromTerrain_dB(terrain, TX, RX_LIST[linkInd], 30.0, 10.0, 0.9, 5.0, 0,
+				0.0, 0.0, ClutterModel::ClutterType::NoClutter, ClutterModel::ClutterType::NoClutter, 
+				TerrainModel::DEFAULT_PROFILE_STEP_KM, &classifier);
+		EXPECT_NEAR(EXPECTED_LOSS, RES_LOSS_LIST[linkInd], 1.0e-6);
+	}
+	std::filesystem::remove_all(ROOT);
+
+	EXPECT_THROW(P452::calculateP452Loss_dB(10.0, 10.0, std::vector<double>(5, 0.0), std::vector<PathProfile::ZoneType>(4),
+			500.0, 500.0, 0.1, 29.5, P452::AtmosphericParameters{45.0, 330.0, 290.0, 1000.0}, 1.0, 10.0), std::invalid_argument);
+}
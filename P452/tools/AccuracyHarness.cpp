@@ -0,0 +1,338 @@
+#include "AccuracyHarness.h"
+#include "MainModel/Evaluator.h"
+#include "MainModel/Helpers.h"
+#include "MainModel/P452TotalAttenuation.h"
+#include "MainModel/ProfileDecimation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace{
+    //distance over land from the terminal to the coast when a path has no sea (km)
+    constexpr double INLAND_DIST_COAST_MIN_KM = 50.0;
+    constexpr double INLAND_DIST_COAST_MAX_KM = 500.0;
+
+    /// @brief Random numbers of the corpus. The standard distributions differ between standard libraries,
+    ///        so the values are derived from the 64 bit engine output directly and a seed gives the same corpus everywhere
+    class CorpusRandom{
+    public:
+        explicit CorpusRandom(const std::uint64_t& seed) : m_engine{seed} {}
+
+        //uniform in [0,1)
+        double uniform(){
+            return static_cast<double>(m_engine() >> 11)*0x1.0p-53;
+        }
+
+        double uniform(const double& low, const double& high){
+            return low+(high-low)*uniform();
+        }
+
+        //log-uniform in [low,high), low>0
+        double logUniform(const double& low, const double& high){
+            return std::exp(uniform(std::log(low), std::log(high)));
+        }
+
+        //uniform integer in [low,high]
+        std::size_t index(const std::size_t& low, const std::size_t& high){
+            return low+static_cast<std::size_t>(uniform()*(high-low+1));
+        }
+
+    private:
+        std::mt19937_64 m_engine;
+    };
+
+    /// @brief Midpoint displacement noise of numPoints values starting and ending at 0, the displacement amplitude
+    ///        halves at each subdivision
+    std::vector<double> midpointDisplacement(CorpusRandom& random, const std::size_t& numPoints, const double& amplitude_m){
+        std::size_t numIntervals = 1;
+        while(numIntervals<numPoints-1){
+            numIntervals *= 2;
+        }
+        std::vector<double> noise(numIntervals+1, 0.0);
+        double stepAmplitude_m = amplitude_m;
+        for(std::size_t step = numIntervals; step>1; step /= 2){
+            for(std::size_t pointInd = step/2; pointInd<numIntervals; pointInd += step){
+                noise[pointInd] = 0.5*(noise[pointInd-step/2]+noise[pointInd+step/2]) + stepAmplitude_m*(2.0*random.uniform()-1.0);
+            }
+            stepAmplitude_m *= 0.5;
+        }
+        noise.resize(numPoints);
+        return noise;
+    }
+
+    /// @brief Distance over land from the first point of the path to the first sea point (km), 0 if the terminal is at sea
+    double calcDistToCoast_km(const PathProfile::Path& path, const bool& fromRx, CorpusRandom& random){
+        for(std::size_t offset = 0; offset<path.size(); offset++){
+            const PathProfile::ProfilePoint& point = fromRx ? path[path.size()-1-offset] : path[offset];
+            if(point.zone==PathProfile::Sea){
+                return std::abs(point.d_km-(fromRx ? path.back().d_km : 0.0));
+            }
+        }
+        return random.uniform(INLAND_DIST_COAST_MIN_KM, INLAND_DIST_COAST_MAX_KM);
+    }
+
+    PathProfile::Path generateTerrain(CorpusRandom& random, const PathProfile::Path& seedProfile,
+            const P452::AccuracyCorpusOptions& options){
+        //random section of at least minNumPoints points, spanning at least 1 km where the profile is long enough
+        std::size_t numPoints = seedProfile.size();
+        std::size_t startInd = 0;
+        if(seedProfile.size()>options.minNumPoints){
+            numPoints = random.index(options.minNumPoints, seedProfile.size());
+            startInd = random.index(0, seedProfile.size()-numPoints);
+            while(numPoints<seedProfile.size() && seedProfile[startInd+numPoints-1].d_km-seedProfile[startInd].d_km<1.0){
+                if(startInd+numPoints<seedProfile.size()){
+                    numPoints++;
+                }
+                else{
+                    startInd--;
+                    numPoints++;
+                }
+            }
+        }
+        const bool isReversed = random.uniform()<0.5;
+
+        double landHeightSum_m = 0;
+        std::size_t numLandPoints = 0;
+        for(std::size_t pointInd = startInd; pointInd<startInd+numPoints; pointInd++){
+            if(seedProfile[pointInd].zone!=PathProfile::Sea){
+                landHeightSum_m += seedProfile[pointInd].h_asl_m;
+                numLandPoints++;
+            }
+        }
+        const double meanLandHeight_m = numLandPoints>0 ? landHeightSum_m/numLandPoints : 0.0;
+        const double heightScale = random.uniform(0.5, 2.0);
+        const std::vector<double> noise_m = midpointDisplacement(random, numPoints, random.uniform(0.0, 50.0));
+
+        PathProfile::Path path;
+        path.reserve(numPoints);
+        const double firstDist_km = seedProfile[startInd].d_km;
+        const double lastDist_km = seedProfile[startInd+numPoints-1].d_km;
+        for(std::size_t offset = 0; offset<numPoints; offset++){
+            const PathProfile::ProfilePoint& seedPoint = seedProfile[isReversed ? startInd+numPoints-1-offset : startInd+offset];
+            const double d_km = isReversed ? lastDist_km-seedPoint.d_km : seedPoint.d_km-firstDist_km;
+            const double h_asl_m = (seedPoint.zone==PathProfile::Sea) ? seedPoint.h_asl_m
+                    : std::max(0.0, meanLandHeight_m+heightScale*(seedPoint.h_asl_m-meanLandHeight_m)+noise_m[offset]);
+            path.push_back(PathProfile::ProfilePoint(d_km, h_asl_m, seedPoint.zone));
+        }
+        return path;
+    }
+
+    double calcLoss_dB(ITUR_P452::Evaluator& evaluator, const P452::AccuracyCase& testCase, const PathProfile::Path& path){
+        return evaluator.calcTotalClearAirAttenuation(testCase.freq_GHz, testCase.p_percent, path, testCase.txHeight_m,
+                testCase.rxHeight_m, testCase.centerLatitude_deg, testCase.txHorizonGain_dBi, testCase.rxHorizonGain_dBi,
+                testCase.pol, testCase.dist_coast_tx_km, testCase.dist_coast_rx_km, testCase.atmosphere.deltaN,
+                testCase.atmosphere.surfaceRefractivity, testCase.atmosphere.temp_K, testCase.atmosphere.dryPressure_hPa,
+                testCase.txClutterType, testCase.rxClutterType);
+    }
+
+    /// @brief Losses of the corpus with the fastest time of timingRounds passes (s)
+    template<typename LossFunction>
+    double timeCorpus(const char* modeName, std::span<const P452::AccuracyCase> corpus, const std::size_t& timingRounds,
+            LossFunction calcCaseLoss_dB, std::vector<double>& out_lossList_dB){
+        out_lossList_dB.resize(corpus.size());
+        double bestTime_s = std::numeric_limits<double>::infinity();
+        for(std::size_t roundInd = 0; roundInd<timingRounds; roundInd++){
+            const auto start = std::chrono::steady_clock::now();
+            for(std::size_t caseInd = 0; caseInd<corpus.size(); caseInd++){
+                try{
+                    out_lossList_dB[caseInd] = calcCaseLoss_dB(caseInd, corpus[caseInd]);
+                }
+                catch(const std::exception& err){
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: P452::runAccuracyHarness(): " << modeName << " failed on case " << caseInd << ": "
+                            << err.what();
+                    throw std::runtime_error(oStrStream.str());
+                }
+            }
+            bestTime_s = std::min(bestTime_s, std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count());
+        }
+        return bestTime_s;
+    }
+
+    //nearest rank percentile of sorted values
+    double percentile(const std::vector<double>& sortedValues, const double& fraction){
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(fraction*sortedValues.size()));
+        return sortedValues[std::max<std::size_t>(rank, 1)-1];
+    }
+}
+
+std::vector<PathProfile::Path> P452::loadAccuracySeedProfiles(const std::string& directory){
+    std::vector<std::filesystem::path> filePaths;
+    if(std::filesystem::is_directory(directory)){
+        for(const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory)){
+            if(entry.is_regular_file() && entry.path().extension()==".csv"){
+                filePaths.push_back(entry.path());
+            }
+        }
+    }
+    if(filePaths.empty()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: P452::loadAccuracySeedProfiles(): no profile csv file in " << directory;
+        throw std::runtime_error(oStrStream.str());
+    }
+    std::sort(filePaths.begin(), filePaths.end());
+
+    std::vector<PathProfile::Path> profiles;
+    for(const std::filesystem::path& filePath : filePaths){
+        profiles.push_back(PathProfile::Path(filePath.string()));
+    }
+    return profiles;
+}
+
+std::vector<P452::AccuracyCase> P452::generateAccuracyCorpus(std::span<const PathProfile::Path> seedProfiles,
+        const AccuracyCorpusOptions& options){
+    if(seedProfiles.empty()){
+        throw std::invalid_argument("ERROR: P452::generateAccuracyCorpus(): no seed profiles");
+    }
+    if(!(options.minFreq_GHz>0 && options.minFreq_GHz<=options.maxFreq_GHz
+            && options.minTimePercent>0 && options.minTimePercent<=options.maxTimePercent && options.minNumPoints>=3)){
+        throw std::invalid_argument("ERROR: P452::generateAccuracyCorpus(): invalid frequency, time percentage or point range");
+    }
+
+    CorpusRandom random(options.seed);
+    std::vector<AccuracyCase> corpus(options.numCases);
+    for(AccuracyCase& testCase : corpus){
+        testCase.seedProfileInd = random.index(0, seedProfiles.size()-1);
+        testCase.path = generateTerrain(random, seedProfiles[testCase.seedProfileInd], options);
+        testCase.freq_GHz = random.logUniform(options.minFreq_GHz, options.maxFreq_GHz);
+        testCase.p_percent = random.logUniform(options.minTimePercent, options.maxTimePercent);
+        testCase.txHeight_m = random.uniform(5.0, 100.0);
+        testCase.rxHeight_m = random.uniform(5.0, 100.0);
+        testCase.centerLatitude_deg = random.uniform(-70.0, 70.0);
+        testCase.txHorizonGain_dBi = random.uniform(0.0, 20.0);
+        testCase.rxHorizonGain_dBi = random.uniform(0.0, 20.0);
+        testCase.pol = random.uniform()<0.5 ? Enumerations::PolarizationType::HorizontalPolarized
+                : Enumerations::PolarizationType::VerticalPolarized;
+        testCase.dist_coast_tx_km = calcDistToCoast_km(testCase.path, false, random);
+        testCase.dist_coast_rx_km = calcDistToCoast_km(testCase.path, true, random);
+        testCase.atmosphere = AtmosphericParameters{random.uniform(30.0, 70.0), random.uniform(300.0, 370.0),
+                random.uniform(260.0, 305.0), random.uniform(980.0, 1030.0)};
+        testCase.txClutterType = static_cast<ClutterModel::ClutterType>(
+                random.index(ClutterModel::NoClutter, ClutterModel::IndustrialZone));
+        testCase.rxClutterType = static_cast<ClutterModel::ClutterType>(
+                random.index(ClutterModel::NoClutter, ClutterModel::IndustrialZone));
+    }
+    return corpus;
+}
+
+P452::AccuracyMode P452::makeProfileDecimationMode(const double& heightTolerance_m, const double& maxP99Error_dB){
+    std::ostringstream name;
+    name << "decimation_" << heightTolerance_m << "m";
+    //shared by the copies of the mode functions
+    const auto decimatedPaths = std::make_shared<std::vector<PathProfile::Path>>();
+    const auto evaluator = std::make_shared<ITUR_P452::Evaluator>();
+
+    AccuracyMode mode;
+    mode.name = name.str();
+    mode.maxP99Error_dB = maxP99Error_dB;
+    mode.prepare = [decimatedPaths, heightTolerance_m](std::span<const AccuracyCase> corpus){
+        decimatedPaths->clear();
+        decimatedPaths->reserve(corpus.size());
+        for(const AccuracyCase& testCase : corpus){
+            PathProfile::ProfileDecimationOptions options;
+            options.heightTolerance_m = heightTolerance_m;
+            options.txHeight_m = testCase.txHeight_m;
+            options.rxHeight_m = testCase.rxHeight_m;
+            options.freq_GHz = testCase.freq_GHz;
+            options.effectiveRadiusList_km.push_back(ITUR_P452::Helpers::calcMedianEffectiveRadius_km(testCase.atmosphere.deltaN));
+            decimatedPaths->push_back(PathProfile::decimateProfile(testCase.path, options));
+        }
+    };
+    mode.calcLoss_dB = [decimatedPaths, evaluator](const std::size_t& caseInd, const AccuracyCase& testCase){
+        return calcLoss_dB(*evaluator, testCase, decimatedPaths->at(caseInd));
+    };
+    return mode;
+}
+
+double P452::calcReferenceLoss_dB(const AccuracyCase& testCase){
+    return ITUR_P452::TotalClearAirAttenuation(testCase.freq_GHz, testCase.p_percent, testCase.path, testCase.txHeight_m,
+            testCase.rxHeight_m, testCase.centerLatitude_deg, testCase.txHorizonGain_dBi, testCase.rxHorizonGain_dBi,
+            testCase.pol, testCase.dist_coast_tx_km, testCase.dist_coast_rx_km, testCase.atmosphere.deltaN,
+            testCase.atmosphere.surfaceRefractivity, testCase.atmosphere.temp_K, testCase.atmosphere.dryPressure_hPa,
+            testCase.txClutterType, testCase.rxClutterType).calcTotalClearAirAttenuation();
+}
+
+std::vector<P452::AccuracyReport> P452::runAccuracyHarness(std::span<const AccuracyCase> corpus,
+        std::span<const AccuracyMode> modes, const std::size_t& timingRounds){
+    if(corpus.empty() || timingRounds==0){
+        throw std::invalid_argument("ERROR: P452::runAccuracyHarness(): empty corpus or no timing round");
+    }
+
+    //the reference evaluator reuses its scratch path like the modes, so the speedup compares the models only
+    ITUR_P452::Evaluator referenceEvaluator;
+    std::vector<double> referenceLossList_dB;
+    const double referenceTime_s = timeCorpus("reference", corpus, timingRounds,
+            [&referenceEvaluator](const std::size_t&, const AccuracyCase& testCase){
+                return calcLoss_dB(referenceEvaluator, testCase, testCase.path);
+            }, referenceLossList_dB);
+
+    std::vector<AccuracyReport> reports;
+    std::vector<double> modeLossList_dB;
+    std::vector<double> absErrorList_dB(corpus.size());
+    for(const AccuracyMode& mode : modes){
+        if(mode.prepare){
+            mode.prepare(corpus);
+        }
+        AccuracyReport report;
+        report.modeName = mode.name;
+        report.numCases = corpus.size();
+        report.referenceTime_s = referenceTime_s;
+        report.maxP99Error_dB = mode.maxP99Error_dB;
+        report.modeTime_s = timeCorpus(mode.name.c_str(), corpus, timingRounds, mode.calcLoss_dB, modeLossList_dB);
+
+        double errorSum_dB = 0;
+        report.maxAbsError_dB = -1.0;
+        for(std::size_t caseInd = 0; caseInd<corpus.size(); caseInd++){
+            const double error_dB = modeLossList_dB[caseInd]-referenceLossList_dB[caseInd];
+            errorSum_dB += error_dB;
+            //a NaN loss counts as an infinite error
+            absErrorList_dB[caseInd] = std::isnan(error_dB) ? std::numeric_limits<double>::infinity() : std::abs(error_dB);
+            if(absErrorList_dB[caseInd]>report.maxAbsError_dB){
+                report.maxAbsError_dB = absErrorList_dB[caseInd];
+                report.maxErrorCaseInd = caseInd;
+            }
+        }
+        report.meanError_dB = errorSum_dB/corpus.size();
+        std::sort(absErrorList_dB.begin(), absErrorList_dB.end());
+        report.p50AbsError_dB = percentile(absErrorList_dB, 0.50);
+        report.p95AbsError_dB = percentile(absErrorList_dB, 0.95);
+        report.p99AbsError_dB = percentile(absErrorList_dB, 0.99);
+        reports.push_back(report);
+    }
+    return reports;
+}
+
+void P452::writeAccuracyReport(std::ostream& output, std::span<const AccuracyReport> reports){
+    const auto oldFlags = output.flags();
+    const auto oldPrecision = output.precision(4);
+    output << std::left << std::setw(20) << "mode" << std::right << std::setw(8) << "cases" << std::setw(11) << "max_dB"
+            << std::setw(8) << "(case)" << std::setw(11) << "p50_dB" << std::setw(11) << "p95_dB" << std::setw(11) << "p99_dB"
+            << std::setw(11) << "bias_dB" << std::setw(12) << "ref_us" << std::setw(12) << "mode_us" << std::setw(9) << "speedup"
+            << "  status\n" << std::fixed;
+    for(const AccuracyReport& report : reports){
+        output << std::left << std::setw(20) << report.modeName << std::right << std::setw(8) << report.numCases
+                << std::setw(11) << report.maxAbsError_dB << std::setw(8) << report.maxErrorCaseInd
+                << std::setw(11) << report.p50AbsError_dB << std::setw(11) << report.p95AbsError_dB
+                << std::setw(11) << report.p99AbsError_dB << std::setw(11) << report.meanError_dB
+                << std::setw(12) << 1e6*report.referenceTime_s/report.numCases << std::setw(12) << 1e6*report.modeTime_s/report.numCases
+                << std::setw(9) << std::setprecision(2) << report.speedup() << std::setprecision(4)
+                << "  ";
+        if(report.isWithinTolerance()){
+            output << "ok\n";
+        }
+        else{
+            output << "p99 above " << report.maxP99Error_dB << " dB\n";
+        }
+    }
+    output.flags(oldFlags);
+    output.precision(oldPrecision);
+}
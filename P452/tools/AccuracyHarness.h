@@ -0,0 +1,124 @@
+#ifndef P452_ACCURACY_HARNESS_H
+#define P452_ACCURACY_HARNESS_H
+
+#include "P452/AtmosphericTile.h"
+#include "MainModel/PathProfile.h"
+#include "ClutterModel/ClutterLoss.h"
+#include "Common/Enumerations.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace P452 {
+
+    /// @brief One link of the accuracy corpus, with every input of the clear air model
+    struct AccuracyCase{
+        PathProfile::Path path;
+        std::size_t seedProfileInd;         //index of the validation profile the terrain was derived from
+        double freq_GHz;
+        double p_percent;
+        double txHeight_m;
+        double rxHeight_m;
+        double centerLatitude_deg;
+        double txHorizonGain_dBi;
+        double rxHorizonGain_dBi;
+        Enumerations::PolarizationType pol;
+        double dist_coast_tx_km;
+        double dist_coast_rx_km;
+        AtmosphericParameters atmosphere;
+        ClutterModel::ClutterType txClutterType;
+        ClutterModel::ClutterType rxClutterType;
+    };
+
+    /// @brief Settings of generateAccuracyCorpus
+    struct AccuracyCorpusOptions{
+        std::size_t numCases = 2000;
+        std::uint64_t seed = 452;           //same seed and seed profiles give the same corpus
+        double minFreq_GHz = 0.1;           //frequencies are log-uniform between the limits
+        double maxFreq_GHz = 50.0;
+        double minTimePercent = 0.001;      //time percentages are log-uniform between the limits
+        double maxTimePercent = 50.0;
+        std::size_t minNumPoints = 30;      //shortest terrain section taken from a seed profile
+    };
+
+    /// @brief Read the seed profiles of a corpus, every csv file of a directory in file name order
+    /// @param directory    Directory of profile csv files (e.g. MainModel/tests/test_paths)
+    /// @return Profiles, throws std::runtime_error if the directory has no csv file
+    std::vector<PathProfile::Path> loadAccuracySeedProfiles(const std::string& directory);
+
+    /// @brief Generate random links for accuracy comparisons. The terrain of each link is a random section of a seed
+    ///        profile (possibly reversed) whose land heights are scaled about their mean and perturbed by random
+    ///        midpoint displacement, sea points and zone types are kept. Frequency, time percentage, antenna heights,
+    ///        gains, polarization, atmosphere and the clutter type at each end (all types, NoClutter included) are drawn
+    ///        independently
+    /// @param seedProfiles Validation profiles the terrain is derived from
+    /// @param options      Corpus settings
+    /// @return Corpus of options.numCases links
+    std::vector<AccuracyCase> generateAccuracyCorpus(std::span<const PathProfile::Path> seedProfiles,
+            const AccuracyCorpusOptions& options={});
+
+    /// @brief A fast (approximate) way of calculating the clear air loss of the corpus links, compared against the
+    ///        reference model by runAccuracyHarness
+    struct AccuracyMode{
+        std::string name;
+        /// Untimed preparation on the whole corpus (e.g. precomputed profiles), may be empty
+        std::function<void(std::span<const AccuracyCase> corpus)> prepare;
+        /// Loss (dB) of the corpus link caseInd
+        std::function<double(const std::size_t& caseInd, const AccuracyCase& testCase)> calcLoss_dB;
+        /// Largest loss error (dB) on the 99th percentile accepted for the mode
+        double maxP99Error_dB = 0.1;
+    };
+
+    /// @brief Fast mode evaluating the model on profiles decimated with PathProfile::decimateProfile (the decimation
+    ///        keeps the horizon and Bullington points for the antenna heights, frequency and median effective radius
+    ///        of each link and runs in the untimed preparation, as for profiles decimated once and stored)
+    /// @param heightTolerance_m    Height tolerance of the decimation (m)
+    /// @param maxP99Error_dB       Accepted 99th percentile loss error (dB)
+    /// @return Mode named "decimation_<tolerance>m"
+    AccuracyMode makeProfileDecimationMode(const double& heightTolerance_m, const double& maxP99Error_dB);
+
+    /// @brief Comparison of a fast mode with the reference model on a corpus
+    struct AccuracyReport{
+        std::string modeName;
+        std::size_t numCases;
+        double maxAbsError_dB;          //largest |mode loss - reference loss|
+        std::size_t maxErrorCaseInd;    //corpus index of the largest error
+        double meanError_dB;            //mean signed error (bias)
+        double p50AbsError_dB;          //percentiles of the absolute error
+        double p95AbsError_dB;
+        double p99AbsError_dB;
+        double referenceTime_s;         //time of the reference model over the corpus
+        double modeTime_s;              //time of the mode over the corpus
+        double maxP99Error_dB;          //accepted 99th percentile error of the mode
+
+        /// @brief Reference time divided by mode time
+        double speedup() const {return referenceTime_s/modeTime_s;}
+
+        /// @brief True if the 99th percentile error is within the accepted error of the mode
+        bool isWithinTolerance() const {return p99AbsError_dB<=maxP99Error_dB;}
+    };
+
+    /// @brief Loss of a corpus link with the reference model (ITUR_P452::TotalClearAirAttenuation on the full profile)
+    double calcReferenceLoss_dB(const AccuracyCase& testCase);
+
+    /// @brief Run the reference model and every fast mode over the corpus on the calling thread.
+    ///        The corpus is timed timingRounds times for each model and the fastest round is kept
+    /// @param corpus           Links (see generateAccuracyCorpus)
+    /// @param modes            Fast modes to compare with the reference
+    /// @param timingRounds     Number of timed passes over the corpus (at least 1)
+    /// @return One report per mode, in the order of modes
+    std::vector<AccuracyReport> runAccuracyHarness(std::span<const AccuracyCase> corpus, std::span<const AccuracyMode> modes,
+            const std::size_t& timingRounds=3);
+
+    /// @brief Write one line per mode: error statistics, times per link, speedup and tolerance check
+    /// @param output   Output stream
+    /// @param reports  Reports of runAccuracyHarness
+    void writeAccuracyReport(std::ostream& output, std::span<const AccuracyReport> reports);
+
+} // end namespace P452
+#endif /* P452_ACCURACY_HARNESS_H */
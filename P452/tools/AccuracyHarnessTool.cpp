@@ -0,0 +1,63 @@
+#include "AccuracyHarness.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//Compare the fast modes with the reference clear air model on a generated corpus (see P452::runAccuracyHarness),
+//fails if a mode is outside of its accepted error
+//usage: P452AccuracyHarness [cases] [seed] [seed profile directory]
+int main(int argc, char* argv[]){
+    if(argc>4){
+        std::cerr << "usage: " << argv[0] << " [cases] [seed] [seed profile directory]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try{
+        P452::AccuracyCorpusOptions options;
+        if(argc>=2){
+            options.numCases = std::stoul(argv[1]);
+        }
+        if(argc>=3){
+            options.seed = std::stoull(argv[2]);
+        }
+        const std::string seedDirectory = (argc==4) ? std::string(argv[3])
+                : (CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths")).string();
+
+        const std::vector<PathProfile::Path> seedProfiles = P452::loadAccuracySeedProfiles(seedDirectory);
+        const std::vector<P452::AccuracyCase> corpus = P452::generateAccuracyCorpus(seedProfiles, options);
+        std::size_t numPoints = 0;
+        for(const P452::AccuracyCase& testCase : corpus){
+            numPoints += testCase.path.size();
+        }
+        std::cout << corpus.size() << " links (seed " << options.seed << ") from " << seedProfiles.size() << " profiles in "
+                << seedDirectory << ", " << numPoints/std::max<std::size_t>(corpus.size(), 1) << " points per link" << std::endl;
+
+        //accepted 99th percentile errors of the decimation tolerances, the largest errors are links with clutter on
+        //coarse profiles: the clutter model moves the terminal inwards and its horizon is then a point the decimation
+        //(done for the unmoved terminal) may have removed
+        const std::vector<P452::AccuracyMode> modes = {
+            P452::makeProfileDecimationMode(0.5, 0.1),
+            P452::makeProfileDecimationMode(1.0, 0.25),
+            P452::makeProfileDecimationMode(2.0, 0.25),
+            P452::makeProfileDecimationMode(5.0, 0.5),
+        };
+        const std::vector<P452::AccuracyReport> reports = P452::runAccuracyHarness(corpus, modes);
+        P452::writeAccuracyReport(std::cout, reports);
+
+        for(const P452::AccuracyReport& report : reports){
+            if(!report.isWithinTolerance()){
+                return EXIT_FAILURE;
+            }
+        }
+        return EXIT_SUCCESS;
+    }
+    catch(const std::exception& err){
+        std::cerr << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,56 @@
+#include "P452/AtmosphericTile.h"
+#include "P452/LossServer.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+
+//Serve clear air loss requests (see P452::LossClient) on a Unix domain socket until SIGINT or SIGTERM
+//usage: P452LossDaemon <socket path> <DEM directory> [atmospheric tile] [thread count]
+int main(int argc, char* argv[]){
+    if(argc<3 || argc>5){
+        std::cerr << "usage: " << argv[0] << " <socket path> <DEM directory> [atmospheric tile] [thread count]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    //the signals are received by sigwait below, not by the server threads
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    try{
+        TerrainModel::RasterTileCache terrain(argv[2]);
+        std::unique_ptr<P452::AtmosphericTile> atmosphericTile;
+        P452::LossServerOptions options;
+        if(argc>=4){
+            atmosphericTile = std::make_unique<P452::AtmosphericTile>(P452::AtmosphericTile::load(argv[3]));
+            options.atmosphericTile = atmosphericTile.get();
+        }
+        options.threadCount = (argc==5) ? static_cast<unsigned int>(std::stoul(argv[4])) : 0;
+
+        P452::LossServer server(argv[1], terrain, options);
+        std::thread serverThread(&P452::LossServer::serve, &server);
+        std::cout << "Listening on " << server.socketPath() << std::endl;
+        int signal;
+        sigwait(&stopSignals, &signal);
+        server.stop();
+        serverThread.join();
+
+        const P452::LossServerStats stats = server.stats();
+        std::cout << "Served " << stats.numLinks << " links in " << stats.numRequests << " requests (" << stats.numBatches
+                << " batches, " << stats.numConnections << " connections)" << std::endl;
+    }
+    catch(const std::exception& err){
+        std::cerr << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,41 @@
+#include "P452/ShardedBatch.h"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+//Calculate the losses of a link file with several worker processes (see P452::runShardedP452Batch).
+//Rerunning the same command after a failure only calculates the shards that did not finish
+//usage: P452ShardedBatch <link file> <DEM directory> <work directory> <output file> <freq GHz> <time percent> [processes] [shards]
+int main(int argc, char* argv[]){
+    if(argc<7 || argc>9){
+        std::cerr << "usage: " << argv[0] << " <link file> <DEM directory> <work directory> <output file> <freq GHz> <time percent>"
+                << " [processes] [shards]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try{
+        P452::ShardedRunOptions options;
+        if(argc>=8){
+            options.numProcesses = static_cast<unsigned int>(std::stoul(argv[7]));
+        }
+        if(argc==9){
+            options.numShards = std::stoul(argv[8]);
+        }
+        const P452::ShardedRunResult result = P452::runShardedP452Batch(argv[1], argv[2], argv[3], argv[4],
+                std::stod(argv[5]), std::stod(argv[6]), 0, options);
+
+        std::cout << result.numLinks << " links in " << result.numShards << " shards: " << result.calculatedShards.size()
+                << " calculated, " << result.resumedShards.size() << " resumed, " << result.failedShards.size() << " failed ("
+                << result.numSharedTiles << " shared tiles, " << result.sharedTileBytes << " bytes)" << std::endl;
+        for(std::size_t failureInd = 0; failureInd<result.failedShards.size(); failureInd++){
+            std::cerr << "shard " << result.failedShards[failureInd] << ": " << result.failureMessages[failureInd] << std::endl;
+        }
+        return result.isComplete() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch(const std::exception& err){
+        std::cerr << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
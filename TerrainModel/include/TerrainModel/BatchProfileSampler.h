@@ -0,0 +1,52 @@
+#ifndef TERRAIN_BATCH_PROFILE_SAMPLER_H
+#define TERRAIN_BATCH_PROFILE_SAMPLER_H
+
+#include "TerrainModel/GreatCircle.h"
+#include "TerrainModel/ProfileBatch.h"
+#include "TerrainModel/RasterTileCache.h"
+#include "TerrainModel/TerrainProfile.h"
+#include "TerrainModel/ZoneClassifier.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace TerrainModel {
+
+    /// @brief Samples the great-circle profiles from one origin to many destinations (point-to-area, point-to-multipoint).
+    /// All sample coordinates are computed first in flat arrays, then the samples are grouped by tile so every tile
+    /// is fetched from the cache once per batch and read with good locality. Heights (and zones, if a ZoneClassifier
+    /// is given) are written directly into the flat buffers of a ProfileBatch. 
+    /// The sampler keeps its scratch buffers between calls, use one sampler per thread
+    class BatchProfileSampler{
+    public:
+        /// @param terrain              DEM tile cache (can be shared with other samplers)
+        /// @param maxStepDistance_km   Maximum distance between profile points (km), as in sampleGreatCircleProfile
+        /// @param zoneClassifier       Optional land/sea rasters used to classify every sample in the same pass
+        explicit BatchProfileSampler(RasterTileCache& terrain, const double& maxStepDistance_km=DEFAULT_PROFILE_STEP_KM,
+                ZoneClassifier* zoneClassifier=nullptr);
+
+        /// @brief Sample the profiles from the origin to every destination
+        /// @param origin       Tx location shared by all links
+        /// @param destinations Rx location of each link
+        /// @param out_batch    Returns one profile per destination, in order. Existing capacity is reused
+        void sample(const GeoPoint& origin, std::span<const GeoPoint> destinations, ProfileBatch& out_batch);
+
+    private:
+        RasterTileCache& m_terrain;
+        double m_maxStepDistance_km;
+        ZoneClassifier* m_zoneClassifier;
+
+        //per sample scratch buffers, indexed like ProfileBatch::heights_m
+        std::vector<double> m_lat_deg;
+        std::vector<double> m_lon_deg;
+        std::vector<uint32_t> m_tileGroup;      //dense index of the tile holding each sample
+        std::vector<std::size_t> m_order;       //sample indices grouped by tile
+        std::vector<double> m_distanceToCoast_km;
+        //per tile scratch buffers
+        std::vector<int32_t> m_tileKeys;
+        std::vector<std::size_t> m_groupStart;
+    };
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_BATCH_PROFILE_SAMPLER_H */
@@ -0,0 +1,32 @@
+#ifndef TERRAIN_DISTANCE_TO_COAST_H
+#define TERRAIN_DISTANCE_TO_COAST_H
+
+#include "TerrainModel/RasterTile.h"
+
+#include <cstddef>
+#include <string>
+
+namespace TerrainModel {
+
+    /// @brief Distance from every grid point of a land/sea mask to the nearest sea grid point (km), 0 at sea.
+    /// Uses the linear-time Euclidean distance transform of Felzenszwalb and Huttenlocher: a pass along the
+    /// columns (parallelised over columns) followed by a pass along the rows (parallelised over rows).
+    /// The grid is treated as locally flat: rows are spaced by the latitude step and, within each row, columns 
+    /// by the longitude step scaled with the cosine of the row latitude. Points with no sea in the mask get FAR_FROM_COAST_KM
+    /// @param landSeaMask  Mask with values >= 0.5 on land and < 0.5 (or void) at sea, as used by ZoneClassifier
+    /// @param threadCount  Number of threads (0 uses the hardware concurrency)
+    /// @return Distance raster with the geometry of the mask (km)
+    RasterTile computeDistanceToCoast(const RasterTile& landSeaMask, const unsigned int& threadCount=0);
+
+    /// @brief Build the distance-to-coast tiles for every land/sea mask tile (SRTM named .hgt or .f32 files) in a directory.
+    /// Each tile is processed together with its 8 neighbours so coasts in adjacent tiles are found, missing neighbours
+    /// are treated as sea (as ZoneClassifier does). The results are written as raw float tiles named "<tile>.f32"
+    /// @param maskDirectory    Directory holding the mask tiles, all tiles must share the same grid size
+    /// @param outputDirectory  Directory for the distance tiles (created if needed)
+    /// @param threadCount      Number of threads used per tile (0 uses the hardware concurrency)
+    /// @return Number of tiles written
+    std::size_t buildDistanceToCoastTiles(const std::string& maskDirectory, const std::string& outputDirectory,
+            const unsigned int& threadCount=0);
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_DISTANCE_TO_COAST_H */
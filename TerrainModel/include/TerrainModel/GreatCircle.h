@@ -0,0 +1,32 @@
+#ifndef TERRAIN_GREAT_CIRCLE_H
+#define TERRAIN_GREAT_CIRCLE_H
+
+namespace TerrainModel {
+
+    /// Mean Earth radius used for great-circle distances (km)
+    constexpr double EARTH_RADIUS_KM = 6371.0;
+
+    /// @brief Geographic location on the spherical Earth
+    struct GeoPoint{
+        double lat_deg;
+        double lon_deg;
+    };
+
+    /// @brief Great-circle distance between two locations (haversine formula)
+    /// @param from Start location
+    /// @param to   End location
+    /// @return Distance along the great circle (km)
+    double greatCircleDistance_km(const GeoPoint& from, const GeoPoint& to);
+
+    /// @brief Location at a fraction of the great-circle path between two locations
+    /// @param from     Start location
+    /// @param to       End location
+    /// @param fraction Fraction of the path length, 0 returns from and 1 returns to
+    /// @return Intermediate location, longitude in [-180, 180)
+    GeoPoint greatCircleIntermediatePoint(const GeoPoint& from, const GeoPoint& to, const double& fraction);
+
+    /// @brief Wrap a longitude into [-180, 180)
+    double normalizeLongitude_deg(const double& lon_deg);
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_GREAT_CIRCLE_H */
@@ -0,0 +1,86 @@
+#ifndef TERRAIN_PROFILE_BATCH_H
+#define TERRAIN_PROFILE_BATCH_H
+
+#include "TerrainModel/GreatCircle.h"
+#include "MainModel/PathProfile.h"
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace TerrainModel {
+
+    /// @brief Terrain profiles of many links stored in one flat height buffer.
+    /// Profile i holds heights_m[offsets[i]] to heights_m[offsets[i+1]-1], from tx to rx
+    struct ProfileBatch{
+        std::vector<double> heights_m;              //heights above sea level of all profiles (m)
+        std::vector<std::size_t> offsets{0};        //start of each profile in heights_m, plus the total size
+        std::vector<double> stepDistances_km;       //distance between points of each profile (km)
+        std::vector<double> distances_km;           //great-circle length of each profile (km)
+        std::vector<GeoPoint> midpoints;            //great-circle midpoint of each profile
+        //only filled when the profiles are sampled with zone classification
+        std::vector<PathProfile::ZoneType> zones;   //zone of every point, indexed like heights_m
+        std::vector<double> txDistancesToCoast_km;  //distance from tx to the coast of each profile (km), 0 at sea
+        std::vector<double> rxDistancesToCoast_km;  //distance from rx to the coast of each profile (km), 0 at sea
+
+        /// @brief Number of profiles
+        std::size_t size() const {return stepDistances_km.size();}
+        bool empty() const {return stepDistances_km.empty();}
+        /// @brief Check if the batch holds zones and distances to the coast
+        bool hasZones() const {return !empty() && zones.size()==heights_m.size();}
+
+        /// @brief Heights of one profile
+        std::span<const double> heights(const std::size_t& profileInd) const{
+            return std::span<const double>(heights_m.data()+offsets[profileInd], offsets[profileInd+1]-offsets[profileInd]);
+        }
+
+        /// @brief Zones of one profile (empty if the batch has no zones)
+        std::span<const PathProfile::ZoneType> profileZones(const std::size_t& profileInd) const{
+            if(!hasZones()){
+                return std::span<const PathProfile::ZoneType>();
+            }
+            return std::span<const PathProfile::ZoneType>(zones.data()+offsets[profileInd], offsets[profileInd+1]-offsets[profileInd]);
+        }
+
+        /// @brief Add a profile at the end of the batch, throws std::invalid_argument if it has less than 
+        ///        PathProfile::MIN_PROFILE_POINTS points
+        void append(std::span<const double> profileHeights_m, const double& stepDistance_km, const double& distance_km, 
+                const GeoPoint& midpoint){
+            if(profileHeights_m.size()<PathProfile::MIN_PROFILE_POINTS){
+                throw std::invalid_argument("ERROR: ProfileBatch::append(): A profile needs at least " 
+                        + std::to_string(PathProfile::MIN_PROFILE_POINTS) + " points, got " + std::to_string(profileHeights_m.size()));
+            }
+            heights_m.insert(heights_m.end(), profileHeights_m.begin(), profileHeights_m.end());
+            offsets.push_back(heights_m.size());
+            stepDistances_km.push_back(stepDistance_km);
+            distances_km.push_back(distance_km);
+            midpoints.push_back(midpoint);
+        }
+
+        /// @brief Add a profile with zones at the end of the batch (all profiles of the batch must have zones)
+        void append(std::span<const double> profileHeights_m, std::span<const PathProfile::ZoneType> profileZones,
+                const double& stepDistance_km, const double& distance_km, const GeoPoint& midpoint,
+                const double& txDistanceToCoast_km, const double& rxDistanceToCoast_km){
+            append(profileHeights_m, stepDistance_km, distance_km, midpoint);
+            zones.insert(zones.end(), profileZones.begin(), profileZones.end());
+            txDistancesToCoast_km.push_back(txDistanceToCoast_km);
+            rxDistancesToCoast_km.push_back(rxDistanceToCoast_km);
+        }
+
+        /// @brief Remove all profiles, keeping the allocated capacity
+        void clear(){
+            heights_m.clear();
+            offsets.assign(1, 0);
+            stepDistances_km.clear();
+            distances_km.clear();
+            midpoints.clear();
+            zones.clear();
+            txDistancesToCoast_km.clear();
+            rxDistancesToCoast_km.clear();
+        }
+    };
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_PROFILE_BATCH_H */
@@ -0,0 +1,98 @@
+#ifndef TERRAIN_RASTER_TILE_H
+#define TERRAIN_RASTER_TILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace TerrainModel {
+
+    /// @brief Georeferencing of a raster tile. Values are stored at grid points (not cell centres):
+    ///        row r is at northLat_deg - r*latStep_deg, column c is at westLon_deg + c*lonStep_deg
+    struct TileGeometry{
+        double northLat_deg;
+        double westLon_deg;
+        double latStep_deg;
+        double lonStep_deg;
+        uint32_t numRows;
+        uint32_t numCols;
+    };
+
+    /// @brief Regular lat/lon grid of 32 bit float values (terrain heights in m for DEM tiles).
+    /// Missing values (SRTM voids) are stored as NaN. The values are immutable and shared by the copies of a tile,
+/// they are either owned by the tile or by another object such as a shared memory segment (see SharedTileSet).
+    ///
+    /// Supported file formats:
+    ///  - SRTM .hgt: square grid of big-endian int16 heights (1201x1201 for 3 arc-second, 3601x3601 for 1 arc-second,
+    ///    any square size is accepted), the south-west corner is taken from the file name (e.g. N29E047.hgt),
+    ///    -32768 marks a void
+    ///  - raw float tile: header (magic "P452RST1", uint32 rows, uint32 columns, float64 north latitude, west longitude,
+    ///    latitude step, longitude step) followed by the float32 values in row-major order, native byte order
+    class RasterTile{
+    public:
+        RasterTile();
+
+        /// @brief Create a tile from values in row-major order
+        /// @param geometry Georeferencing of the tile
+        /// @param values   numRows*numCols values
+        RasterTile(const TileGeometry& geometry, std::vector<float> values);
+
+        /// @brief Create a tile over values owned by another object, without copying them
+        /// @param geometry Georeferencing of the tile
+        /// @param values   numRows*numCols values in row-major order
+        /// @param owner    Keeps the values alive as long as the tile or one of its copies exists
+        RasterTile(const TileGeometry& geometry, std::span<const float> values, std::shared_ptr<const void> owner);
+
+        /// @brief Load an SRTM .hgt tile, the location is parsed from the file name
+        /// @param filePath Path to the .hgt file
+        static RasterTile loadHgt(const std::string& filePath);
+
+        /// @brief Load a raw float tile written by saveRawFloat()
+        /// @param filePath Path to the raw float tile
+        static RasterTile loadRawFloat(const std::string& filePath);
+
+        /// @brief Write the tile in the raw float format
+        /// @param filePath Path to the raw float tile
+        void saveRawFloat(const std::string& filePath) const;
+
+        /// @brief Check if a location is inside the area covered by the grid points
+        bool contains(const double& lat_deg, const double& lon_deg) const;
+
+        /// @brief Bilinear interpolation of the four grid points around a location. Locations outside the
+        ///        tile are clamped to its border. Void grid points are skipped (weights are renormalised)
+        /// @param lat_deg Latitude (deg)
+        /// @param lon_deg Longitude (deg)
+        /// @return Interpolated value, NaN if all four grid points are voids
+        double interpolate(const double& lat_deg, const double& lon_deg) const;
+
+        /// @brief Value of the grid point nearest to a location (clamped to the tile border)
+        double nearest(const double& lat_deg, const double& lon_deg) const;
+
+        /// @brief Value at a row and column of the grid
+        float at(const uint32_t& rowInd, const uint32_t& colInd) const {return m_values[static_cast<std::size_t>(rowInd)*m_geometry.numCols+colInd];}
+
+        const TileGeometry& geometry() const {return m_geometry;}
+        std::span<const float> values() const {return m_values;}
+
+        /// @brief Memory used by the values (bytes)
+        std::size_t byteSize() const {return m_values.size()*sizeof(float);}
+
+    private:
+        TileGeometry m_geometry;
+        std::shared_ptr<const void> m_owner;    //owner of the values
+        std::span<const float> m_values;        //row-major grid values
+
+        void checkGeometry() const;
+    };
+
+    /// @brief SRTM style name of the 1x1 degree tile holding a location, e.g. "N29E047" or "S01W001"
+    /// @param lat_deg Latitude (deg)
+    /// @param lon_deg Longitude (deg)
+    /// @return Tile name without extension
+    std::string tileNameFor(const double& lat_deg, const double& lon_deg);
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_RASTER_TILE_H */
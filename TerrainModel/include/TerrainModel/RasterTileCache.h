@@ -0,0 +1,95 @@
+#ifndef TERRAIN_RASTER_TILE_CACHE_H
+#define TERRAIN_RASTER_TILE_CACHE_H
+
+#include "TerrainModel/RasterTile.h"
+#include "TerrainModel/SharedTileSet.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace TerrainModel {
+
+    /// Default memory budget of a tile cache, about ten 1 arc-second SRTM tiles (bytes)
+    constexpr std::size_t DEFAULT_TILE_CACHE_BYTES = 512u*1024u*1024u;
+
+    /// Behaviour when no tile file exists for a location
+    enum class MissingTilePolicy {
+        SeaLevel,   //use a height of 0 m (SRTM does not provide tiles over the open sea)
+        Throw       //throw std::runtime_error
+    };
+
+    /// @brief Counters of a RasterTileCache
+    struct TileCacheStats{
+        std::size_t hits;
+        std::size_t misses;         //tile files loaded (or looked up and found missing)
+        std::size_t evictions;
+        std::size_t cachedTiles;
+        std::size_t cachedBytes;
+    };
+
+    /// @brief Thread-safe, memory-bounded cache of 1x1 degree raster tiles read from a directory.
+    /// The tile holding a location is found by its SRTM style name (e.g. N29E047) and loaded from
+    /// "<name>.hgt" or, if that does not exist, from "<name>.f32" (raw float tile, see RasterTile).
+    /// Least recently used tiles are evicted once the cached values exceed the memory budget. Tiles are handed out 
+    /// as shared pointers, so an evicted tile stays valid for callers still holding it.
+    /// Tiles of an optional SharedTileSet are used before the files, they are not counted in the cache or its stats
+    class RasterTileCache{
+    public:
+        /// @param tileDirectory    Directory holding the tile files
+        /// @param maxBytes         Memory budget for the cached tile values (bytes), the most recent tile is always kept
+        /// @param missingTilePolicy Behaviour when no tile file exists for a location
+        /// @param sharedTiles      Optional tiles already loaded in shared memory (e.g. by the parent process)
+        explicit RasterTileCache(const std::string& tileDirectory, const std::size_t& maxBytes=DEFAULT_TILE_CACHE_BYTES,
+                const MissingTilePolicy& missingTilePolicy=MissingTilePolicy::SeaLevel,
+                std::shared_ptr<const SharedTileSet> sharedTiles=nullptr);
+
+        RasterTileCache(const RasterTileCache&) = delete;
+        RasterTileCache& operator=(const RasterTileCache&) = delete;
+
+        /// @brief Tile covering a location, loading it if needed
+        /// @param lat_deg Latitude (deg)
+        /// @param lon_deg Longitude (deg)
+        /// @return Tile, nullptr if there is no tile file and the policy is SeaLevel
+        std::shared_ptr<const RasterTile> tileFor(const double& lat_deg, const double& lon_deg);
+
+        /// @brief Bilinearly interpolated value at a location (terrain height in m for DEM tiles).
+        ///        Missing tiles (with the SeaLevel policy) and voids give 0
+        /// @param lat_deg Latitude (deg)
+        /// @param lon_deg Longitude (deg)
+        double elevation_m(const double& lat_deg, const double& lon_deg);
+
+        TileCacheStats stats() const;
+        const std::string& tileDirectory() const {return m_tileDirectory;}
+
+    private:
+        struct CacheEntry{
+            std::shared_ptr<const RasterTile> tile;
+            std::list<std::string>::iterator lruPosition;
+        };
+
+        std::string m_tileDirectory;
+        std::size_t m_maxBytes;
+        MissingTilePolicy m_missingTilePolicy;
+        std::shared_ptr<const SharedTileSet> m_sharedTiles; //immutable, read without the lock
+
+        mutable std::mutex m_mutex;                     //guards every member below
+        std::list<std::string> m_lruList;               //tile names, most recently used first
+        std::unordered_map<std::string, CacheEntry> m_tiles;
+        std::unordered_set<std::string> m_missingTiles; //names without a tile file
+        std::size_t m_cachedBytes;
+        std::size_t m_hits;
+        std::size_t m_misses;
+        std::size_t m_evictions;
+
+        /// @brief Read a tile file from the tile directory (called without holding the lock)
+        /// @return Tile, nullptr if no file exists
+        std::shared_ptr<const RasterTile> loadTile(const std::string& tileName) const;
+    };
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_RASTER_TILE_CACHE_H */
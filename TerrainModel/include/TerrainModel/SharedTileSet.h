@@ -0,0 +1,55 @@
+#ifndef TERRAIN_SHARED_TILE_SET_H
+#define TERRAIN_SHARED_TILE_SET_H
+
+#include "TerrainModel/GreatCircle.h"
+#include "TerrainModel/RasterTile.h"
+#include "MainModel/SharedMemory.h"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+namespace TerrainModel {
+
+    class RasterTileCache;
+
+    /// @brief Read-only raster tiles stored in one POSIX shared memory segment (ITUR_P452::SharedMemorySegment),
+    /// so worker processes read the same copy of the tiles instead of loading their own.
+    /// The tiles handed out are views of the segment and keep it mapped.
+    ///
+    /// Segment layout (native byte order): magic "P452TSH1", uint64 number of tiles, one entry per tile
+    /// (char[16] tile name, TileGeometry, uint64 offset of the values from the segment start), then the float32 values
+    /// of every tile in row-major order, each starting on a 64 byte boundary
+    class SharedTileSet{
+    public:
+        /// @brief Copy the tiles covering a list of locations from a tile cache into a new shared memory segment
+        /// @param segmentName  Name of the segment to create, starting with '/'
+        /// @param terrain      Tile cache the tiles are read from, locations without a tile are skipped
+        /// @param locations    Locations whose tiles are shared
+        static std::shared_ptr<const SharedTileSet> create(const std::string& segmentName, RasterTileCache& terrain,
+                std::span<const GeoPoint> locations);
+
+        /// @brief Map a segment created by another process
+        /// @param segmentName Name of the segment
+        static std::shared_ptr<const SharedTileSet> open(const std::string& segmentName);
+
+        /// @brief Shared tile with an SRTM style name (see tileNameFor), nullptr if the set does not hold it
+        std::shared_ptr<const RasterTile> find(const std::string& tileName) const;
+
+        /// @brief Number of tiles
+        std::size_t size() const {return m_tiles.size();}
+        /// @brief Size of the shared memory segment (bytes)
+        std::size_t byteSize() const {return m_segment->size();}
+        const std::string& segmentName() const {return m_segment->name();}
+
+    private:
+        explicit SharedTileSet(std::shared_ptr<const ITUR_P452::SharedMemorySegment> segment);
+
+        std::shared_ptr<const ITUR_P452::SharedMemorySegment> m_segment;
+        std::unordered_map<std::string, std::shared_ptr<const RasterTile>> m_tiles;
+    };
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_SHARED_TILE_SET_H */
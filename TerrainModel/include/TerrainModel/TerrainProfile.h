@@ -0,0 +1,40 @@
+#ifndef TERRAIN_PROFILE_H
+#define TERRAIN_PROFILE_H
+
+#include "TerrainModel/GreatCircle.h"
+#include "TerrainModel/RasterTileCache.h"
+#include "TerrainModel/ZoneClassifier.h"
+#include "MainModel/PathProfile.h"
+
+#include <vector>
+
+namespace TerrainModel {
+
+    /// Default maximum distance between profile points, close to the 3 arc-second SRTM resolution (km)
+    constexpr double DEFAULT_PROFILE_STEP_KM = 0.1;
+
+    /// @brief Equally spaced terrain heights along the great-circle path between two locations,
+    ///        in the form expected by P452::calculateP452Loss_dB
+    struct TerrainProfile{
+        std::vector<double> elevationList_m;    //heights above sea level from tx to rx (m)
+        double stepDistance_km;                 //distance between points (km)
+        double distance_km;                     //great-circle path length (km)
+        GeoPoint midpoint;                      //midpoint of the great-circle path
+        std::vector<PathProfile::ZoneType> zoneList;    //zone of each point, empty unless sampled with a ZoneClassifier
+        double txDistanceToCoast_km;            //distance from tx to the coast (km), 0 at sea (only with a ZoneClassifier)
+        double rxDistanceToCoast_km;            //distance from rx to the coast (km), 0 at sea (only with a ZoneClassifier)
+    };
+
+    /// @brief Sample a terrain profile along the great-circle path from tx to rx using bilinear interpolation of the DEM
+    /// @param terrain              DEM tile cache
+    /// @param tx                   Tx location
+    /// @param rx                   Rx location
+    /// @param maxStepDistance_km   Maximum distance between profile points (km), the path is split into equal steps
+    /// @param zoneClassifier       Optional land/sea rasters, if given the zones and terminal distances to the coast
+    ///                             are sampled in the same pass as the heights
+    /// @return Terrain profile with at least 3 points
+    TerrainProfile sampleGreatCircleProfile(RasterTileCache& terrain, const GeoPoint& tx, const GeoPoint& rx,
+            const double& maxStepDistance_km=DEFAULT_PROFILE_STEP_KM, ZoneClassifier* zoneClassifier=nullptr);
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_PROFILE_H */
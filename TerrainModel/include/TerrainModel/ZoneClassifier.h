@@ -0,0 +1,59 @@
+#ifndef TERRAIN_ZONE_CLASSIFIER_H
+#define TERRAIN_ZONE_CLASSIFIER_H
+
+#include "MainModel/PathProfile.h"
+#include "TerrainModel/RasterTile.h"
+#include "TerrainModel/RasterTileCache.h"
+
+#include <memory>
+
+namespace TerrainModel {
+
+    /// Maximum height of coastal land (zone A1 in ITU-R P.452-17) (m)
+    constexpr double COASTAL_LAND_MAX_HEIGHT_M = 100.0;
+    /// Maximum distance of coastal land from the sea (zone A1 in ITU-R P.452-17) (km)
+    constexpr double COASTAL_LAND_MAX_DISTANCE_KM = 50.0;
+    /// Distance to the coast used where no distance-to-coast tile exists, same default as P452::createP452Path (km)
+    constexpr double FAR_FROM_COAST_KM = 500.0;
+
+    /// @brief Zone classification (ITU-R P.452-17 zones A1, A2 and B) from two rasters sharing the DEM tile naming:
+    ///  - a land/sea mask: values >= 0.5 are land, values < 0.5 (or voids) are sea or large inland water
+    ///  - a distance-to-coast raster: distance from land to the nearest sea grid point (km)
+    /// Every sample is classified with one nearest-neighbour mask read and one bilinear distance read,
+    /// so the zones and the terminal distances to the coast cost O(1) per profile point
+    class ZoneClassifier{
+    public:
+        /// @param landSeaMask      Land/sea mask tiles, missing tiles are sea
+        /// @param distanceToCoast  Distance-to-coast tiles (km), missing tiles give FAR_FROM_COAST_KM
+        ZoneClassifier(RasterTileCache& landSeaMask, RasterTileCache& distanceToCoast);
+
+        /// @brief Classify one profile point from already fetched tiles (either may be nullptr)
+        /// @param maskTile     Mask tile holding the location
+        /// @param distanceTile Distance-to-coast tile holding the location
+        /// @param lat_deg      Latitude (deg)
+        /// @param lon_deg      Longitude (deg)
+        /// @param height_m     Terrain height above sea level (m)
+        /// @param out_distanceToCoast_km Returns the distance to the coast (km), 0 at sea
+        /// @return Zone type
+        static PathProfile::ZoneType classify(const RasterTile* maskTile, const RasterTile* distanceTile,
+                const double& lat_deg, const double& lon_deg, const double& height_m, double& out_distanceToCoast_km);
+
+        /// @brief Classify one location, fetching the tiles from the caches
+        PathProfile::ZoneType classify(const double& lat_deg, const double& lon_deg, const double& height_m,
+                double& out_distanceToCoast_km);
+
+        /// @brief Distance from a location to the coast (km), 0 at sea
+        /// @param lat_deg Latitude (deg)
+        /// @param lon_deg Longitude (deg)
+        double distanceToCoast_km(const double& lat_deg, const double& lon_deg);
+
+        RasterTileCache& landSeaMask() {return m_landSeaMask;}
+        RasterTileCache& distanceToCoast() {return m_distanceToCoast;}
+
+    private:
+        RasterTileCache& m_landSeaMask;
+        RasterTileCache& m_distanceToCoast;
+    };
+
+} // end namespace TerrainModel
+#endif /* TERRAIN_ZONE_CLASSIFIER_H */
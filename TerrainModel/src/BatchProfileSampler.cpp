@@ -0,0 +1,159 @@
+#include "TerrainModel/BatchProfileSampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <sstream>
+#include <stdexcept>
+
+namespace{
+    constexpr double DEG_TO_RAD = std::numbers::pi/180.0;
+    constexpr double RAD_TO_DEG = 180.0/std::numbers::pi;
+
+    //unique key of the 1x1 degree tile holding a location, consistent with tileNameFor()
+    int32_t tileKey(const double& lat_deg, const double& lon_deg){
+        const auto southLat = static_cast<int32_t>(std::floor(lat_deg));
+        const auto westLon = static_cast<int32_t>(std::floor(TerrainModel::normalizeLongitude_deg(lon_deg)));
+        return (southLat+90)*360 + (westLon+180);
+    }
+}
+
+TerrainModel::BatchProfileSampler::BatchProfileSampler(RasterTileCache& terrain, const double& maxStepDistance_km,
+        ZoneClassifier* zoneClassifier):
+        m_terrain{terrain}, m_maxStepDistance_km{maxStepDistance_km}, m_zoneClassifier{zoneClassifier}{
+    if(!(m_maxStepDistance_km>0.0)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: BatchProfileSampler::BatchProfileSampler(): The maximum step distance must be positive: " 
+                    << m_maxStepDistance_km;
+        throw std::domain_error(oStrStream.str());
+    }
+}
+
+void TerrainModel::BatchProfileSampler::sample(const GeoPoint& origin, std::span<const GeoPoint> destinations, ProfileBatch& out_batch){
+    out_batch.clear();
+
+    //Step 1 profile layout, same number of points as sampleGreatCircleProfile
+    for(const auto& destination : destinations){
+        const double distance_km = greatCircleDistance_km(origin, destination);
+        const auto numPoints = std::max<std::size_t>(3, static_cast<std::size_t>(std::ceil(distance_km/m_maxStepDistance_km))+1);
+        out_batch.offsets.push_back(out_batch.offsets.back()+numPoints);
+        out_batch.stepDistances_km.push_back(distance_km/(numPoints-1));
+        out_batch.distances_km.push_back(distance_km);
+        out_batch.midpoints.push_back(greatCircleIntermediatePoint(origin, destination, 0.5));
+    }
+    const std::size_t numSamples = out_batch.offsets.back();
+    out_batch.heights_m.resize(numSamples);
+    m_lat_deg.resize(numSamples);
+    m_lon_deg.resize(numSamples);
+    m_tileGroup.resize(numSamples);
+    if(m_zoneClassifier!=nullptr){
+        out_batch.zones.resize(numSamples);
+        m_distanceToCoast_km.resize(numSamples);
+    }
+
+    //Step 2 sample coordinates. Each path is the rotation of the origin unit vector a towards the
+    //unit vector u orthogonal to it in the plane of the great circle: p(theta) = a*cos(theta) + u*sin(theta).
+    //The angle steps evenly, so cos/sin of consecutive samples follow from the angle addition formulas
+    const double originLat_rad = origin.lat_deg*DEG_TO_RAD;
+    const double originLon_rad = origin.lon_deg*DEG_TO_RAD;
+    const double ax = std::cos(originLat_rad)*std::cos(originLon_rad);
+    const double ay = std::cos(originLat_rad)*std::sin(originLon_rad);
+    const double az = std::sin(originLat_rad);
+    for(std::size_t profileInd = 0; profileInd<destinations.size(); profileInd++){
+        const double destLat_rad = destinations[profileInd].lat_deg*DEG_TO_RAD;
+        const double destLon_rad = destinations[profileInd].lon_deg*DEG_TO_RAD;
+        const double bx = std::cos(destLat_rad)*std::cos(destLon_rad);
+        const double by = std::cos(destLat_rad)*std::sin(destLon_rad);
+        const double bz = std::sin(destLat_rad);
+
+        const double delta_rad = out_batch.distances_km[profileInd]/EARTH_RADIUS_KM;
+        double ux = 0.0, uy = 0.0, uz = 0.0;
+        if(delta_rad>1.0e-12){
+            const double cosDelta = std::cos(delta_rad);
+            const double sinDelta = std::sin(delta_rad);
+            ux = (bx-ax*cosDelta)/sinDelta;
+            uy = (by-ay*cosDelta)/sinDelta;
+            uz = (bz-az*cosDelta)/sinDelta;
+        }
+
+        const std::size_t first = out_batch.offsets[profileInd];
+        const std::size_t numPoints = out_batch.offsets[profileInd+1]-first;
+        const double stepAngle_rad = delta_rad/(numPoints-1);
+        const double cosStep = std::cos(stepAngle_rad);
+        const double sinStep = std::sin(stepAngle_rad);
+        double cosTheta = 1.0, sinTheta = 0.0;
+        for(std::size_t pointInd = 0; pointInd<numPoints; pointInd++){
+            const double x = ax*cosTheta+ux*sinTheta;
+            const double y = ay*cosTheta+uy*sinTheta;
+            const double z = az*cosTheta+uz*sinTheta;
+            m_lat_deg[first+pointInd] = std::atan2(z, std::sqrt(x*x+y*y))*RAD_TO_DEG;
+            m_lon_deg[first+pointInd] = std::atan2(y, x)*RAD_TO_DEG;
+
+            const double nextCos = cosTheta*cosStep-sinTheta*sinStep;
+            sinTheta = sinTheta*cosStep+cosTheta*sinStep;
+            cosTheta = nextCos;
+        }
+        //end exactly on the destination
+        m_lat_deg[first+numPoints-1] = destinations[profileInd].lat_deg;
+        m_lon_deg[first+numPoints-1] = normalizeLongitude_deg(destinations[profileInd].lon_deg);
+    }
+
+    //Step 3 group the samples by tile. The group of a tile is found by a linear lookup in m_tileKeys (the number of tiles 
+    //per batch is small and consecutive samples usually share their tile), then a counting sort orders the samples by group
+    m_tileKeys.clear();
+    int32_t lastKey = -1;
+    uint32_t lastGroup = 0;
+    for(std::size_t sampleInd = 0; sampleInd<numSamples; sampleInd++){
+        const int32_t key = tileKey(m_lat_deg[sampleInd], m_lon_deg[sampleInd]);
+        if(key!=lastKey){
+            const auto it = std::find(m_tileKeys.begin(), m_tileKeys.end(), key);
+            lastGroup = static_cast<uint32_t>(it-m_tileKeys.begin());
+            if(it==m_tileKeys.end()){
+                m_tileKeys.push_back(key);
+            }
+            lastKey = key;
+        }
+        m_tileGroup[sampleInd] = lastGroup;
+    }
+    m_groupStart.assign(m_tileKeys.size()+1, 0);
+    for(std::size_t sampleInd = 0; sampleInd<numSamples; sampleInd++){
+        m_groupStart[m_tileGroup[sampleInd]+1]++;
+    }
+    for(std::size_t groupInd = 0; groupInd<m_tileKeys.size(); groupInd++){
+        m_groupStart[groupInd+1]+=m_groupStart[groupInd];
+    }
+    m_order.resize(numSamples);
+    for(std::size_t sampleInd = 0; sampleInd<numSamples; sampleInd++){
+        m_order[m_groupStart[m_tileGroup[sampleInd]]++] = sampleInd;
+    }
+
+    //Step 4 interpolate the heights (and classify the zones) tile by tile (m_groupStart[g] now points at the end of group g)
+    std::size_t groupBegin = 0;
+    for(std::size_t groupInd = 0; groupInd<m_tileKeys.size(); groupInd++){
+        const std::size_t groupEnd = m_groupStart[groupInd];
+        const std::size_t firstSample = m_order[groupBegin];
+        const auto tile = m_terrain.tileFor(m_lat_deg[firstSample], m_lon_deg[firstSample]);
+        for(std::size_t orderInd = groupBegin; orderInd<groupEnd; orderInd++){
+            const std::size_t sampleInd = m_order[orderInd];
+            const double height_m = (tile==nullptr) ? 0.0 : tile->interpolate(m_lat_deg[sampleInd], m_lon_deg[sampleInd]);
+            out_batch.heights_m[sampleInd] = std::isnan(height_m) ? 0.0 : height_m;
+        }
+        if(m_zoneClassifier!=nullptr){
+            const auto maskTile = m_zoneClassifier->landSeaMask().tileFor(m_lat_deg[firstSample], m_lon_deg[firstSample]);
+            const auto distanceTile = m_zoneClassifier->distanceToCoast().tileFor(m_lat_deg[firstSample], m_lon_deg[firstSample]);
+            for(std::size_t orderInd = groupBegin; orderInd<groupEnd; orderInd++){
+                const std::size_t sampleInd = m_order[orderInd];
+                out_batch.zones[sampleInd] = ZoneClassifier::classify(maskTile.get(), distanceTile.get(), 
+                        m_lat_deg[sampleInd], m_lon_deg[sampleInd], out_batch.heights_m[sampleInd], m_distanceToCoast_km[sampleInd]);
+            }
+        }
+        groupBegin = groupEnd;
+    }
+
+    if(m_zoneClassifier!=nullptr){
+        for(std::size_t profileInd = 0; profileInd<destinations.size(); profileInd++){
+            out_batch.txDistancesToCoast_km.push_back(m_distanceToCoast_km[out_batch.offsets[profileInd]]);
+            out_batch.rxDistancesToCoast_km.push_back(m_distanceToCoast_km[out_batch.offsets[profileInd+1]-1]);
+        }
+    }
+}
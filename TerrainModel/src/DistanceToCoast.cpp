@@ -0,0 +1,190 @@
+#include "TerrainModel/DistanceToCoast.h"
+#include "TerrainModel/GreatCircle.h"
+#include "TerrainModel/RasterTileCache.h"
+#include "TerrainModel/ZoneClassifier.h"
+#include "MainModel/TaskScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <numbers>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace{
+    //squared distance used for points with no sea found yet (km^2)
+    constexpr double UNREACHED_KM2 = 1.0e20;
+    constexpr double KM_PER_DEG = TerrainModel::EARTH_RADIUS_KM*std::numbers::pi/180.0;
+
+    //Working buffers of the 1D transform, sized for the longest grid axis
+    struct TransformBuffers{
+        std::vector<double> input;
+        std::vector<double> output;
+        std::vector<std::size_t> parabolaVertex;
+        std::vector<double> parabolaBoundary;
+
+        explicit TransformBuffers(const std::size_t& length):
+            input(length), output(length), parabolaVertex(length), parabolaBoundary(length+1){}
+    };
+
+    //1D squared distance transform with uniform spacing (Felzenszwalb & Huttenlocher, lower envelope of parabolas):
+    //out[q] = min_p (spacing*(q-p))^2 + in[p]
+    void transform1D(TransformBuffers& buffers, const std::size_t& length, const double& spacing){
+        const double* f = buffers.input.data();
+        std::size_t* v = buffers.parabolaVertex.data();
+        double* z = buffers.parabolaBoundary.data();
+
+        auto position = [&spacing](const std::size_t& index){return spacing*index;};
+        std::size_t k = 0;
+        v[0] = 0;
+        z[0] = -std::numeric_limits<double>::infinity();
+        z[1] = std::numeric_limits<double>::infinity();
+        //intersection of the parabolas rooted at q and at the vertex k of the envelope
+        auto intersection = [&](const std::size_t& q){
+            const double xq = position(q);
+            const double xv = position(v[k]);
+            return ((f[q]+xq*xq)-(f[v[k]]+xv*xv))/(2.0*(xq-xv));
+        };
+        for(std::size_t q = 1; q<length; q++){
+            double s = intersection(q);
+            //z[0] is -infinity so this stops at the first parabola
+            while(s<=z[k]){
+                k--;
+                s = intersection(q);
+            }
+            k++;
+            v[k] = q;
+            z[k] = s;
+            z[k+1] = std::numeric_limits<double>::infinity();
+        }
+        k = 0;
+        for(std::size_t q = 0; q<length; q++){
+            while(z[k+1]<position(q)){
+                k++;
+            }
+            const double dx = position(q)-position(v[k]);
+            buffers.output[q] = dx*dx+f[v[k]];
+        }
+    }
+}
+
+TerrainModel::RasterTile TerrainModel::computeDistanceToCoast(const RasterTile& landSeaMask, const unsigned int& threadCount){
+    const TileGeometry& geometry = landSeaMask.geometry();
+    const std::size_t numRows = geometry.numRows;
+    const std::size_t numCols = geometry.numCols;
+    const std::size_t bufferLength = std::max(numRows, numCols);
+    const ITUR_P452::SchedulerOptions schedulerOptions{threadCount};
+
+    //one set of buffers per worker, both passes have at most bufferLength items
+    std::vector<TransformBuffers> workerBuffers(ITUR_P452::resolveThreadCount(threadCount, bufferLength),
+            TransformBuffers(bufferLength));
+
+    //Step 1 squared distance along each column (rows are equally spaced)
+    std::vector<double> columnDistance_km2(numRows*numCols);
+    const double rowSpacing_km = geometry.latStep_deg*KM_PER_DEG;
+    ITUR_P452::runParallel(numCols, {}, [&](const std::size_t& colInd, const unsigned int& workerInd){
+        TransformBuffers& buffers = workerBuffers[workerInd];
+        for(std::size_t rowInd = 0; rowInd<numRows; rowInd++){
+            const float maskValue = landSeaMask.at(static_cast<uint32_t>(rowInd), static_cast<uint32_t>(colInd));
+            buffers.input[rowInd] = (maskValue>=0.5f) ? UNREACHED_KM2 : 0.0;
+        }
+        transform1D(buffers, numRows, rowSpacing_km);
+        for(std::size_t rowInd = 0; rowInd<numRows; rowInd++){
+            columnDistance_km2[rowInd*numCols+colInd] = buffers.output[rowInd];
+        }
+    }, schedulerOptions);
+
+    //Step 2 combine along each row with the column spacing at the row latitude
+    std::vector<float> distance_km(numRows*numCols);
+    ITUR_P452::runParallel(numRows, {}, [&](const std::size_t& rowInd, const unsigned int& workerInd){
+        TransformBuffers& buffers = workerBuffers[workerInd];
+        const double lat_deg = geometry.northLat_deg-rowInd*geometry.latStep_deg;
+        const double colSpacing_km = std::max(geometry.lonStep_deg*KM_PER_DEG*std::cos(lat_deg*std::numbers::pi/180.0), 1.0e-9);
+        std::copy_n(columnDistance_km2.begin()+rowInd*numCols, numCols, buffers.input.begin());
+        transform1D(buffers, numCols, colSpacing_km);
+        for(std::size_t colInd = 0; colInd<numCols; colInd++){
+            const double squaredDistance_km2 = buffers.output[colInd];
+            distance_km[rowInd*numCols+colInd] = (squaredDistance_km2>=UNREACHED_KM2/2.0) 
+                    ? static_cast<float>(FAR_FROM_COAST_KM) : static_cast<float>(std::sqrt(squaredDistance_km2));
+        }
+    }, schedulerOptions);
+
+    return RasterTile(geometry, std::move(distance_km));
+}
+
+std::size_t TerrainModel::buildDistanceToCoastTiles(const std::string& maskDirectory, const std::string& outputDirectory,
+        const unsigned int& threadCount){
+
+    //find the SRTM named mask tiles
+    std::vector<std::string> tileNameList;
+    for(const auto& entry : std::filesystem::directory_iterator(maskDirectory)){
+        const std::string extension = entry.path().extension().string();
+        const std::string stem = entry.path().stem().string();
+        const bool isTileName = stem.size()==7 && (stem[0]=='N' || stem[0]=='S') && (stem[3]=='E' || stem[3]=='W');
+        if(entry.is_regular_file() && (extension==".hgt" || extension==".f32") && isTileName){
+            tileNameList.push_back(stem);
+        }
+    }
+    std::sort(tileNameList.begin(), tileNameList.end());
+    tileNameList.erase(std::unique(tileNameList.begin(), tileNameList.end()), tileNameList.end());
+    std::filesystem::create_directories(outputDirectory);
+
+    //a tile and its neighbours are needed at the same time
+    RasterTileCache maskTiles(maskDirectory, DEFAULT_TILE_CACHE_BYTES, MissingTilePolicy::SeaLevel);
+    std::size_t numTilesWritten = 0;
+    for(const auto& tileName : tileNameList){
+        const double southLat_deg = std::stoi(tileName.substr(1,2))*(tileName[0]=='N' ? 1 : -1);
+        const double westLon_deg = std::stoi(tileName.substr(4,3))*(tileName[3]=='E' ? 1 : -1);
+        const auto centreTile = maskTiles.tileFor(southLat_deg+0.5, westLon_deg+0.5);
+        if(centreTile==nullptr){
+            continue;
+        }
+        const TileGeometry& geometry = centreTile->geometry();
+
+        //3x3 mosaic, adjacent tiles share their edge rows/columns
+        const std::size_t stepRows = geometry.numRows-1;
+        const std::size_t stepCols = geometry.numCols-1;
+        const auto mosaicRows = static_cast<uint32_t>(3*stepRows+1);
+        const auto mosaicCols = static_cast<uint32_t>(3*stepCols+1);
+        std::vector<float> mosaicValues(static_cast<std::size_t>(mosaicRows)*mosaicCols, 0.0f);
+        for(int tileRow = 0; tileRow<3; tileRow++){
+            for(int tileCol = 0; tileCol<3; tileCol++){
+                const auto tile = maskTiles.tileFor(southLat_deg+0.5+(1-tileRow), westLon_deg+0.5+(tileCol-1));
+                if(tile==nullptr){
+                    continue;
+                }
+                if(tile->geometry().numRows!=geometry.numRows || tile->geometry().numCols!=geometry.numCols){
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: buildDistanceToCoastTiles(): The neighbours of tile " << tileName 
+                                << " do not have the same grid size";
+                    throw std::runtime_error(oStrStream.str());
+                }
+                for(std::size_t rowInd = 0; rowInd<geometry.numRows; rowInd++){
+                    for(std::size_t colInd = 0; colInd<geometry.numCols; colInd++){
+                        mosaicValues[(tileRow*stepRows+rowInd)*mosaicCols+tileCol*stepCols+colInd] = 
+                                tile->at(static_cast<uint32_t>(rowInd), static_cast<uint32_t>(colInd));
+                    }
+                }
+            }
+        }
+        const RasterTile mosaic(TileGeometry{geometry.northLat_deg+stepRows*geometry.latStep_deg, 
+                geometry.westLon_deg-stepCols*geometry.lonStep_deg, geometry.latStep_deg, geometry.lonStep_deg,
+                mosaicRows, mosaicCols}, std::move(mosaicValues));
+        const RasterTile mosaicDistance = computeDistanceToCoast(mosaic, threadCount);
+
+        //keep the centre tile
+        std::vector<float> distance_km;
+        distance_km.reserve(static_cast<std::size_t>(geometry.numRows)*geometry.numCols);
+        for(std::size_t rowInd = 0; rowInd<geometry.numRows; rowInd++){
+            for(std::size_t colInd = 0; colInd<geometry.numCols; colInd++){
+                distance_km.push_back(mosaicDistance.at(static_cast<uint32_t>(stepRows+rowInd), static_cast<uint32_t>(stepCols+colInd)));
+            }
+        }
+        RasterTile(geometry, std::move(distance_km)).saveRawFloat(
+                (std::filesystem::path(outputDirectory)/(tileName+".f32")).string());
+        numTilesWritten++;
+    }
+    return numTilesWritten;
+}
@@ -0,0 +1,52 @@
+#include "TerrainModel/GreatCircle.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace{
+    constexpr double DEG_TO_RAD = std::numbers::pi/180.0;
+    constexpr double RAD_TO_DEG = 180.0/std::numbers::pi;
+}
+
+double TerrainModel::greatCircleDistance_km(const GeoPoint& from, const GeoPoint& to){
+    const double lat1_rad = from.lat_deg*DEG_TO_RAD;
+    const double lat2_rad = to.lat_deg*DEG_TO_RAD;
+    const double sinHalfDeltaLat = std::sin((lat2_rad-lat1_rad)/2.0);
+    const double sinHalfDeltaLon = std::sin((to.lon_deg-from.lon_deg)*DEG_TO_RAD/2.0);
+    const double a = sinHalfDeltaLat*sinHalfDeltaLat + std::cos(lat1_rad)*std::cos(lat2_rad)*sinHalfDeltaLon*sinHalfDeltaLon;
+    return 2.0*EARTH_RADIUS_KM*std::asin(std::sqrt(std::clamp(a, 0.0, 1.0)));
+}
+
+TerrainModel::GeoPoint TerrainModel::greatCircleIntermediatePoint(const GeoPoint& from, const GeoPoint& to, const double& fraction){
+    const double lat1_rad = from.lat_deg*DEG_TO_RAD;
+    const double lon1_rad = from.lon_deg*DEG_TO_RAD;
+    const double lat2_rad = to.lat_deg*DEG_TO_RAD;
+    const double lon2_rad = to.lon_deg*DEG_TO_RAD;
+
+    //angular distance between the end points
+    const double delta_rad = greatCircleDistance_km(from, to)/EARTH_RADIUS_KM;
+    if(delta_rad<1.0e-12){
+        return GeoPoint{from.lat_deg, normalizeLongitude_deg(from.lon_deg)};
+    }
+
+    //spherical linear interpolation of the unit vectors
+    const double weightFrom = std::sin((1.0-fraction)*delta_rad)/std::sin(delta_rad);
+    const double weightTo = std::sin(fraction*delta_rad)/std::sin(delta_rad);
+    const double x = weightFrom*std::cos(lat1_rad)*std::cos(lon1_rad) + weightTo*std::cos(lat2_rad)*std::cos(lon2_rad);
+    const double y = weightFrom*std::cos(lat1_rad)*std::sin(lon1_rad) + weightTo*std::cos(lat2_rad)*std::sin(lon2_rad);
+    const double z = weightFrom*std::sin(lat1_rad) + weightTo*std::sin(lat2_rad);
+
+    return GeoPoint{
+        std::atan2(z, std::sqrt(x*x+y*y))*RAD_TO_DEG,
+        normalizeLongitude_deg(std::atan2(y, x)*RAD_TO_DEG)
+    };
+}
+
+double TerrainModel::normalizeLongitude_deg(const double& lon_deg){
+    double wrapped = std::fmod(lon_deg+180.0, 360.0);
+    if(wrapped<0.0){
+        wrapped+=360.0;
+    }
+    return wrapped-180.0;
+}
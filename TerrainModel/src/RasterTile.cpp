@@ -0,0 +1,238 @@
+#include "TerrainModel/RasterTile.h"
+#include "TerrainModel/GreatCircle.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace{
+    //identifies the raw float tile format (first 8 bytes of the file)
+    constexpr char RawTileMagic[8] = {'P','4','5','2','R','S','T','1'};
+    //SRTM void marker
+    constexpr int16_t HgtVoid = -32768;
+
+    std::vector<char> readWholeFile(const std::string& filePath, const std::string& caller){
+        std::ifstream file(filePath, std::ios::binary);
+        if(!file.is_open()){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: RasterTile::" << caller << "(): Failed to open file \"" << filePath << "\"";
+            throw std::runtime_error(oStrStream.str());
+        }
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    //parse the south-west corner from an SRTM file name such as N29E047.hgt
+    bool parseHgtName(const std::string& fileName, int& out_lat, int& out_lon){
+        if(fileName.size()<7){
+            return false;
+        }
+        const char latHemisphere = std::toupper(static_cast<unsigned char>(fileName[0]));
+        const char lonHemisphere = std::toupper(static_cast<unsigned char>(fileName[3]));
+        const auto isDigit = [&fileName](const std::size_t& ind){return std::isdigit(static_cast<unsigned char>(fileName[ind]))!=0;};
+        if((latHemisphere!='N' && latHemisphere!='S') || (lonHemisphere!='E' && lonHemisphere!='W')
+                || !isDigit(1) || !isDigit(2) || !isDigit(4) || !isDigit(5) || !isDigit(6)){
+            return false;
+        }
+        out_lat = std::stoi(fileName.substr(1,2))*(latHemisphere=='N' ? 1 : -1);
+        out_lon = std::stoi(fileName.substr(4,3))*(lonHemisphere=='E' ? 1 : -1);
+        return true;
+    }
+
+    //longitude east of the western edge of a tile, wrapped across the antimeridian.
+    //Locations outside the tile are given the offset of the nearer edge (negative if closer to the western edge)
+    double longitudeOffset_deg(const TerrainModel::TileGeometry& geometry, const double& lon_deg){
+        const double lonExtent_deg = (geometry.numCols-1)*geometry.lonStep_deg;
+        double lonOffset_deg = std::fmod(TerrainModel::normalizeLongitude_deg(lon_deg)
+                -TerrainModel::normalizeLongitude_deg(geometry.westLon_deg)+360.0, 360.0);
+        if(lonOffset_deg>lonExtent_deg && lonOffset_deg-lonExtent_deg>360.0-lonOffset_deg){
+            lonOffset_deg-=360.0;
+        }
+        return lonOffset_deg;
+    }
+}
+
+TerrainModel::RasterTile::RasterTile(): m_geometry{0.0, 0.0, 1.0, 1.0, 0, 0}{
+}
+
+TerrainModel::RasterTile::RasterTile(const TileGeometry& geometry, std::vector<float> values): m_geometry{geometry}{
+    auto ownedValues = std::make_shared<const std::vector<float>>(std::move(values));
+    m_values = std::span<const float>(*ownedValues);
+    m_owner = std::move(ownedValues);
+    checkGeometry();
+}
+
+TerrainModel::RasterTile::RasterTile(const TileGeometry& geometry, std::span<const float> values, std::shared_ptr<const void> owner):
+        m_geometry{geometry}, m_owner{std::move(owner)}, m_values{values}{
+    checkGeometry();
+}
+
+void TerrainModel::RasterTile::checkGeometry() const{
+    if(m_values.size()!=static_cast<std::size_t>(m_geometry.numRows)*m_geometry.numCols || m_values.empty()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTile::RasterTile(): Expected " << m_geometry.numRows << "x" << m_geometry.numCols 
+                    << " values but " << m_values.size() << " were given";
+        throw std::invalid_argument(oStrStream.str());
+    }
+    if(!(m_geometry.latStep_deg>0.0) || !(m_geometry.lonStep_deg>0.0)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTile::RasterTile(): Grid steps must be positive: " << m_geometry.latStep_deg 
+                    << ", " << m_geometry.lonStep_deg;
+        throw std::invalid_argument(oStrStream.str());
+    }
+}
+
+TerrainModel::RasterTile TerrainModel::RasterTile::loadHgt(const std::string& filePath){
+    int southLat, westLon;
+    const std::string fileName = std::filesystem::path(filePath).filename().string();
+    if(!parseHgtName(fileName, southLat, westLon)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTile::loadHgt(): Cannot parse the tile location from the file name \"" << fileName << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+
+    const std::vector<char> buffer = readWholeFile(filePath, "loadHgt");
+    const std::size_t numSamples = buffer.size()/sizeof(int16_t);
+    const auto gridSize = static_cast<uint32_t>(std::lround(std::sqrt(static_cast<double>(numSamples))));
+    if(gridSize<2 || static_cast<std::size_t>(gridSize)*gridSize*sizeof(int16_t)!=buffer.size()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTile::loadHgt(): File \"" << filePath << "\" of " << buffer.size() 
+                    << " bytes is not a square grid of int16 values";
+        throw std::runtime_error(oStrStream.str());
+    }
+
+    //values are big-endian, first row is the northern edge
+    std::vector<float> values(numSamples);
+    const auto* bytes = reinterpret_cast<const unsigned char*>(buffer.data());
+    for(std::size_t sampleInd = 0; sampleInd<numSamples; sampleInd++){
+        const auto raw = static_cast<int16_t>(static_cast<uint16_t>((bytes[2*sampleInd]<<8) | bytes[2*sampleInd+1]));
+        values[sampleInd] = (raw==HgtVoid) ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>(raw);
+    }
+
+    const double step_deg = 1.0/(gridSize-1);
+    return RasterTile(TileGeometry{southLat+1.0, static_cast<double>(westLon), step_deg, step_deg, gridSize, gridSize}, 
+            std::move(values));
+}
+
+TerrainModel::RasterTile TerrainModel::RasterTile::loadRawFloat(const std::string& filePath){
+    const std::vector<char> buffer = readWholeFile(filePath, "loadRawFloat");
+    TileGeometry geometry;
+    const std::size_t headerSize = sizeof(RawTileMagic)+2*sizeof(uint32_t)+4*sizeof(double);
+    if(buffer.size()<headerSize || std::memcmp(buffer.data(), RawTileMagic, sizeof(RawTileMagic))!=0){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTile::loadRawFloat(): File \"" << filePath << "\" is not a raw float tile";
+        throw std::runtime_error(oStrStream.str());
+    }
+    const char* cursor = buffer.data()+sizeof(RawTileMagic);
+    auto readValue = [&cursor](auto& out_value){
+        std::memcpy(&out_value, cursor, sizeof(out_value));
+        cursor+=sizeof(out_value);
+    };
+    readValue(geometry.numRows);
+    readValue(geometry.numCols);
+    readValue(geometry.northLat_deg);
+    readValue(geometry.westLon_deg);
+    readValue(geometry.latStep_deg);
+    readValue(geometry.lonStep_deg);
+
+    const std::size_t numValues = static_cast<std::size_t>(geometry.numRows)*geometry.numCols;
+    if(buffer.size()!=headerSize+numValues*sizeof(float)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTile::loadRawFloat(): File \"" << filePath << "\" has " << buffer.size() 
+                    << " bytes, expected " << headerSize+numValues*sizeof(float) << " for a " 
+                    << geometry.numRows << "x" << geometry.numCols << " tile";
+        throw std::runtime_error(oStrStream.str());
+    }
+    std::vector<float> values(numValues);
+    std::memcpy(values.data(), cursor, numValues*sizeof(float));
+    return RasterTile(geometry, std::move(values));
+}
+
+void TerrainModel::RasterTile::saveRawFloat(const std::string& filePath) const{
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if(!file.is_open()){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTile::saveRawFloat(): Failed to open file \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+    file.write(RawTileMagic, sizeof(RawTileMagic));
+    file.write(reinterpret_cast<const char*>(&m_geometry.numRows), sizeof(m_geometry.numRows));
+    file.write(reinterpret_cast<const char*>(&m_geometry.numCols), sizeof(m_geometry.numCols));
+    file.write(reinterpret_cast<const char*>(&m_geometry.northLat_deg), sizeof(m_geometry.northLat_deg));
+    file.write(reinterpret_cast<const char*>(&m_geometry.westLon_deg), sizeof(m_geometry.westLon_deg));
+    file.write(reinterpret_cast<const char*>(&m_geometry.latStep_deg), sizeof(m_geometry.latStep_deg));
+    file.write(reinterpret_cast<const char*>(&m_geometry.lonStep_deg), sizeof(m_geometry.lonStep_deg));
+    file.write(reinterpret_cast<const char*>(m_values.data()), byteSize());
+    if(!file){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTile::saveRawFloat(): Failed writing file \"" << filePath << "\"";
+        throw std::runtime_error(oStrStream.str());
+    }
+}
+
+bool TerrainModel::RasterTile::contains(const double& lat_deg, const double& lon_deg) const{
+    const double southLat_deg = m_geometry.northLat_deg-(m_geometry.numRows-1)*m_geometry.latStep_deg;
+    const double lonOffset_deg = longitudeOffset_deg(m_geometry, lon_deg);
+    return lat_deg>=southLat_deg && lat_deg<=m_geometry.northLat_deg 
+            && lonOffset_deg>=0.0 && lonOffset_deg<=(m_geometry.numCols-1)*m_geometry.lonStep_deg;
+}
+
+double TerrainModel::RasterTile::interpolate(const double& lat_deg, const double& lon_deg) const{
+    const double lonOffset_deg = longitudeOffset_deg(m_geometry, lon_deg);
+
+    //fractional grid position clamped to the grid
+    const double rowPos = std::clamp((m_geometry.northLat_deg-lat_deg)/m_geometry.latStep_deg, 0.0, m_geometry.numRows-1.0);
+    const double colPos = std::clamp(lonOffset_deg/m_geometry.lonStep_deg, 0.0, m_geometry.numCols-1.0);
+    const uint32_t row0 = std::min(static_cast<uint32_t>(rowPos), m_geometry.numRows>1 ? m_geometry.numRows-2 : 0u);
+    const uint32_t col0 = std::min(static_cast<uint32_t>(colPos), m_geometry.numCols>1 ? m_geometry.numCols-2 : 0u);
+    const uint32_t row1 = std::min(row0+1, m_geometry.numRows-1);
+    const uint32_t col1 = std::min(col0+1, m_geometry.numCols-1);
+    const double rowFrac = rowPos-row0;
+    const double colFrac = colPos-col0;
+
+    const double corners[4] = {at(row0,col0), at(row0,col1), at(row1,col0), at(row1,col1)};
+    const double weights[4] = {
+        (1.0-rowFrac)*(1.0-colFrac), (1.0-rowFrac)*colFrac, rowFrac*(1.0-colFrac), rowFrac*colFrac
+    };
+    double sum = 0.0;
+    double weightSum = 0.0;
+    for(int cornerInd = 0; cornerInd<4; cornerInd++){
+        if(!std::isnan(corners[cornerInd])){
+            sum+=weights[cornerInd]*corners[cornerInd];
+            weightSum+=weights[cornerInd];
+        }
+    }
+    if(weightSum==0.0){
+        //all neighbours are voids or the location is exactly on a void
+        for(int cornerInd = 0; cornerInd<4; cornerInd++){
+            if(!std::isnan(corners[cornerInd])){
+                return corners[cornerInd];
+            }
+        }
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return sum/weightSum;
+}
+
+double TerrainModel::RasterTile::nearest(const double& lat_deg, const double& lon_deg) const{
+    const double lonOffset_deg = longitudeOffset_deg(m_geometry, lon_deg);
+    const double rowPos = std::clamp((m_geometry.northLat_deg-lat_deg)/m_geometry.latStep_deg, 0.0, m_geometry.numRows-1.0);
+    const double colPos = std::clamp(lonOffset_deg/m_geometry.lonStep_deg, 0.0, m_geometry.numCols-1.0);
+    return at(static_cast<uint32_t>(std::lround(rowPos)), static_cast<uint32_t>(std::lround(colPos)));
+}
+
+std::string TerrainModel::tileNameFor(const double& lat_deg, const double& lon_deg){
+    const int southLat = static_cast<int>(std::floor(lat_deg));
+    const int westLon = static_cast<int>(std::floor(normalizeLongitude_deg(lon_deg)));
+    std::ostringstream oStrStream;
+    oStrStream << (southLat>=0 ? 'N' : 'S') << std::setfill('0') << std::setw(2) << std::abs(southLat)
+                << (westLon>=0 ? 'E' : 'W') << std::setw(3) << std::abs(westLon);
+    return oStrStream.str();
+}
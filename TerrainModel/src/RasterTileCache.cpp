@@ -0,0 +1,97 @@
+#include "TerrainModel/RasterTileCache.h"
+
+#include <cmath>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+TerrainModel::RasterTileCache::RasterTileCache(const std::string& tileDirectory, const std::size_t& maxBytes,
+        const MissingTilePolicy& missingTilePolicy, std::shared_ptr<const SharedTileSet> sharedTiles):
+        m_tileDirectory{tileDirectory}, m_maxBytes{maxBytes}, m_missingTilePolicy{missingTilePolicy}, m_sharedTiles{std::move(sharedTiles)},
+        m_cachedBytes{0}, m_hits{0}, m_misses{0}, m_evictions{0}{
+}
+
+std::shared_ptr<const TerrainModel::RasterTile> TerrainModel::RasterTileCache::tileFor(const double& lat_deg, const double& lon_deg){
+    const std::string tileName = tileNameFor(lat_deg, lon_deg);
+    if(m_sharedTiles!=nullptr){
+        if(auto sharedTile = m_sharedTiles->find(tileName)){
+            return sharedTile;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_tiles.find(tileName);
+        if(it!=m_tiles.end()){
+            m_hits++;
+            m_lruList.splice(m_lruList.begin(), m_lruList, it->second.lruPosition);
+            return it->second.tile;
+        }
+        if(m_missingTiles.count(tileName)>0){
+            m_hits++;
+            return nullptr;
+        }
+    }
+
+    //load without holding the lock so other threads can keep reading cached tiles.
+    //Two threads may load the same tile at the same time, the first one to finish is cached
+    std::shared_ptr<const RasterTile> tile = loadTile(tileName);
+    if(tile==nullptr && m_missingTilePolicy==MissingTilePolicy::Throw){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: RasterTileCache::tileFor(): No tile \"" << tileName << "\" in directory \"" << m_tileDirectory 
+                    << "\" for location (" << lat_deg << ", " << lon_deg << ")";
+        throw std::runtime_error(oStrStream.str());
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_misses++;
+    if(tile==nullptr){
+        m_missingTiles.insert(tileName);
+        return nullptr;
+    }
+    const auto it = m_tiles.find(tileName);
+    if(it!=m_tiles.end()){
+        m_lruList.splice(m_lruList.begin(), m_lruList, it->second.lruPosition);
+        return it->second.tile;
+    }
+    m_lruList.push_front(tileName);
+    m_tiles.emplace(tileName, CacheEntry{tile, m_lruList.begin()});
+    m_cachedBytes+=tile->byteSize();
+
+    //evict least recently used tiles, always keeping the new one
+    while(m_cachedBytes>m_maxBytes && m_lruList.size()>1){
+        const auto evicted = m_tiles.find(m_lruList.back());
+        m_cachedBytes-=evicted->second.tile->byteSize();
+        m_tiles.erase(evicted);
+        m_lruList.pop_back();
+        m_evictions++;
+    }
+    return tile;
+}
+
+double TerrainModel::RasterTileCache::elevation_m(const double& lat_deg, const double& lon_deg){
+    const auto tile = tileFor(lat_deg, lon_deg);
+    if(tile==nullptr){
+        return 0.0;
+    }
+    const double value = tile->interpolate(lat_deg, lon_deg);
+    return std::isnan(value) ? 0.0 : value;
+}
+
+TerrainModel::TileCacheStats TerrainModel::RasterTileCache::stats() const{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return TileCacheStats{m_hits, m_misses, m_evictions, m_tiles.size(), m_cachedBytes};
+}
+
+std::shared_ptr<const TerrainModel::RasterTile> TerrainModel::RasterTileCache::loadTile(const std::string& tileName) const{
+    const std::filesystem::path directory(m_tileDirectory);
+    const std::filesystem::path hgtPath = directory/(tileName+".hgt");
+    if(std::filesystem::exists(hgtPath)){
+        return std::make_shared<const RasterTile>(RasterTile::loadHgt(hgtPath.string()));
+    }
+    const std::filesystem::path rawPath = directory/(tileName+".f32");
+    if(std::filesystem::exists(rawPath)){
+        return std::make_shared<const RasterTile>(RasterTile::loadRawFloat(rawPath.string()));
+    }
+    return nullptr;
+}
@@ -0,0 +1,110 @@
+#include "TerrainModel/SharedTileSet.h"
+#include "TerrainModel/RasterTileCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace{
+    constexpr char SharedTileMagic[8] = {'P','4','5','2','T','S','H','1'};
+    constexpr std::size_t ValueAlignment = 64;
+
+    struct SegmentHeader{
+        char magic[8];
+        uint64_t numTiles;
+    };
+
+    struct TileEntry{
+        char name[16];
+        TerrainModel::TileGeometry geometry;
+        uint64_t valueOffset;
+    };
+    static_assert(std::is_trivially_copyable_v<TileEntry>);
+
+    std::size_t alignUp(const std::size_t& offset){
+        return (offset+ValueAlignment-1)/ValueAlignment*ValueAlignment;
+    }
+}
+
+TerrainModel::SharedTileSet::SharedTileSet(std::shared_ptr<const ITUR_P452::SharedMemorySegment> segment):
+        m_segment{std::move(segment)}{
+    const char* data = m_segment->data();
+    const std::size_t size = m_segment->size();
+    SegmentHeader header;
+    if(size>=sizeof(SegmentHeader)){
+        std::memcpy(&header, data, sizeof(header));
+    }
+    if(size<sizeof(SegmentHeader) || std::memcmp(header.magic, SharedTileMagic, sizeof(SharedTileMagic))!=0
+            || header.numTiles>(size-sizeof(SegmentHeader))/sizeof(TileEntry)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: SharedTileSet::SharedTileSet(): Segment \"" << m_segment->name() << "\" is not a shared tile set";
+        throw std::runtime_error(oStrStream.str());
+    }
+    for(uint64_t tileInd = 0; tileInd<header.numTiles; tileInd++){
+        TileEntry entry;
+        std::memcpy(&entry, data+sizeof(SegmentHeader)+tileInd*sizeof(TileEntry), sizeof(entry));
+        const std::size_t numValues = static_cast<std::size_t>(entry.geometry.numRows)*entry.geometry.numCols;
+        if(entry.valueOffset%alignof(float)!=0 || entry.valueOffset>size || numValues>(size-entry.valueOffset)/sizeof(float)){
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: SharedTileSet::SharedTileSet(): Tile " << tileInd << " exceeds segment \"" << m_segment->name() << "\"";
+            throw std::runtime_error(oStrStream.str());
+        }
+        const std::string name(entry.name, strnlen(entry.name, sizeof(entry.name)));
+        const float* values = reinterpret_cast<const float*>(data+entry.valueOffset);
+        m_tiles.emplace(name, std::make_shared<const RasterTile>(entry.geometry, std::span<const float>(values, numValues), m_segment));
+    }
+}
+
+std::shared_ptr<const TerrainModel::SharedTileSet> TerrainModel::SharedTileSet::create(const std::string& segmentName,
+        RasterTileCache& terrain, std::span<const GeoPoint> locations){
+    //ordered by name, so the same locations always give the same layout
+    std::map<std::string, std::shared_ptr<const RasterTile>> tiles;
+    for(const GeoPoint& location : locations){
+        const std::string tileName = tileNameFor(location.lat_deg, location.lon_deg);
+        if(tiles.count(tileName)==0){
+            tiles.emplace(tileName, terrain.tileFor(location.lat_deg, location.lon_deg));
+        }
+    }
+    std::erase_if(tiles, [](const auto& namedTile){return namedTile.second==nullptr;});
+
+    std::vector<TileEntry> entries;
+    std::size_t segmentSize = alignUp(sizeof(SegmentHeader)+tiles.size()*sizeof(TileEntry));
+    for(const auto& [tileName, tile] : tiles){
+        TileEntry entry{};
+        std::memcpy(entry.name, tileName.c_str(), std::min(tileName.size(), sizeof(entry.name)-1));
+        entry.geometry = tile->geometry();
+        entry.valueOffset = segmentSize;
+        entries.push_back(entry);
+        segmentSize = alignUp(segmentSize+tile->byteSize());
+    }
+
+    auto segment = std::make_shared<ITUR_P452::SharedMemorySegment>(ITUR_P452::SharedMemorySegment::create(segmentName, segmentSize));
+    char* data = segment->data();
+    SegmentHeader header;
+    std::memcpy(header.magic, SharedTileMagic, sizeof(SharedTileMagic));
+    header.numTiles = entries.size();
+    std::memcpy(data, &header, sizeof(header));
+    std::size_t tileInd = 0;
+    for(const auto& [tileName, tile] : tiles){
+        std::memcpy(data+sizeof(SegmentHeader)+tileInd*sizeof(TileEntry), &entries[tileInd], sizeof(TileEntry));
+        std::memcpy(data+entries[tileInd].valueOffset, tile->values().data(), tile->byteSize());
+        tileInd++;
+    }
+    return std::shared_ptr<const SharedTileSet>(new SharedTileSet(std::move(segment)));
+}
+
+std::shared_ptr<const TerrainModel::SharedTileSet> TerrainModel::SharedTileSet::open(const std::string& segmentName){
+    return std::shared_ptr<const SharedTileSet>(new SharedTileSet(
+            std::make_shared<const ITUR_P452::SharedMemorySegment>(ITUR_P452::SharedMemorySegment::open(segmentName))));
+}
+
+std::shared_ptr<const TerrainModel::RasterTile> TerrainModel::SharedTileSet::find(const std::string& tileName) const{
+    const auto it = m_tiles.find(tileName);
+    return it==m_tiles.end() ? nullptr : it->second;
+}
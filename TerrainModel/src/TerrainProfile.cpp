@@ -0,0 +1,58 @@
+#include "TerrainModel/TerrainProfile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+TerrainModel::TerrainProfile TerrainModel::sampleGreatCircleProfile(RasterTileCache& terrain, const GeoPoint& tx, const GeoPoint& rx,
+        const double& maxStepDistance_km, ZoneClassifier* zoneClassifier){
+    if(!(maxStepDistance_km>0.0)){
+        std::ostringstream oStrStream;
+        oStrStream << "ERROR: sampleGreatCircleProfile(): The maximum step distance must be positive: " << maxStepDistance_km;
+        throw std::domain_error(oStrStream.str());
+    }
+
+    TerrainProfile profile;
+    profile.distance_km = greatCircleDistance_km(tx, rx);
+    profile.midpoint = greatCircleIntermediatePoint(tx, rx, 0.5);
+
+    const auto numPoints = std::max<std::size_t>(3, static_cast<std::size_t>(std::ceil(profile.distance_km/maxStepDistance_km))+1);
+    profile.stepDistance_km = profile.distance_km/(numPoints-1);
+    profile.elevationList_m.resize(numPoints);
+    profile.txDistanceToCoast_km = FAR_FROM_COAST_KM;
+    profile.rxDistanceToCoast_km = FAR_FROM_COAST_KM;
+    if(zoneClassifier!=nullptr){
+        profile.zoneList.resize(numPoints);
+    }
+
+    //consecutive points are almost always on the same tile, only go back to the cache when leaving it
+    std::shared_ptr<const RasterTile> tile, maskTile, distanceTile;
+    for(std::size_t pointInd = 0; pointInd<numPoints; pointInd++){
+        const GeoPoint location = greatCircleIntermediatePoint(tx, rx, static_cast<double>(pointInd)/(numPoints-1));
+        if(tile==nullptr || !tile->contains(location.lat_deg, location.lon_deg)){
+            tile = terrain.tileFor(location.lat_deg, location.lon_deg);
+        }
+        const double height_m = (tile==nullptr) ? 0.0 : tile->interpolate(location.lat_deg, location.lon_deg);
+        profile.elevationList_m[pointInd] = std::isnan(height_m) ? 0.0 : height_m;
+
+        if(zoneClassifier!=nullptr){
+            if(maskTile==nullptr || !maskTile->contains(location.lat_deg, location.lon_deg)){
+                maskTile = zoneClassifier->landSeaMask().tileFor(location.lat_deg, location.lon_deg);
+            }
+            if(distanceTile==nullptr || !distanceTile->contains(location.lat_deg, location.lon_deg)){
+                distanceTile = zoneClassifier->distanceToCoast().tileFor(location.lat_deg, location.lon_deg);
+            }
+            double distanceToCoast_km;
+            profile.zoneList[pointInd] = ZoneClassifier::classify(maskTile.get(), distanceTile.get(), 
+                    location.lat_deg, location.lon_deg, profile.elevationList_m[pointInd], distanceToCoast_km);
+            if(pointInd==0){
+                profile.txDistanceToCoast_km = distanceToCoast_km;
+            }
+            if(pointInd==numPoints-1){
+                profile.rxDistanceToCoast_km = distanceToCoast_km;
+            }
+        }
+    }
+    return profile;
+}
@@ -0,0 +1,38 @@
+#include "TerrainModel/ZoneClassifier.h"
+
+#include <cmath>
+
+TerrainModel::ZoneClassifier::ZoneClassifier(RasterTileCache& landSeaMask, RasterTileCache& distanceToCoast):
+        m_landSeaMask{landSeaMask}, m_distanceToCoast{distanceToCoast}{
+}
+
+PathProfile::ZoneType TerrainModel::ZoneClassifier::classify(const RasterTile* maskTile, const RasterTile* distanceTile,
+        const double& lat_deg, const double& lon_deg, const double& height_m, double& out_distanceToCoast_km){
+
+    const double maskValue = (maskTile==nullptr) ? 0.0 : maskTile->nearest(lat_deg, lon_deg);
+    if(!(maskValue>=0.5)){
+        out_distanceToCoast_km = 0.0;
+        return PathProfile::ZoneType::Sea;
+    }
+
+    const double distance_km = (distanceTile==nullptr) ? FAR_FROM_COAST_KM : distanceTile->interpolate(lat_deg, lon_deg);
+    out_distanceToCoast_km = std::isnan(distance_km) ? FAR_FROM_COAST_KM : distance_km;
+    if(height_m<=COASTAL_LAND_MAX_HEIGHT_M && out_distanceToCoast_km<=COASTAL_LAND_MAX_DISTANCE_KM){
+        return PathProfile::ZoneType::CoastalLand;
+    }
+    return PathProfile::ZoneType::Inland;
+}
+
+PathProfile::ZoneType TerrainModel::ZoneClassifier::classify(const double& lat_deg, const double& lon_deg, const double& height_m,
+        double& out_distanceToCoast_km){
+    const auto maskTile = m_landSeaMask.tileFor(lat_deg, lon_deg);
+    const auto distanceTile = m_distanceToCoast.tileFor(lat_deg, lon_deg);
+    return classify(maskTile.get(), distanceTile.get(), lat_deg, lon_deg, height_m, out_distanceToCoast_km);
+}
+
+double TerrainModel::ZoneClassifier::distanceToCoast_km(const double& lat_deg, const double& lon_deg){
+    double distance_km;
+    //the height does not change the distance
+    classify(lat_deg, lon_deg, 0.0, distance_km);
+    return distance_km;
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "TerrainModel/BatchProfileSampler.h"
+#include "TerrainModel/TerrainProfile.h"
+
+#include <cmath>
+#include <filesystem>
+
+namespace {
+	//1x1 degree raw float tile with a smooth non-linear surface so interpolation errors would show
+	void writeSurfaceTile(const std::filesystem::path& directory, const int& southLat, const int& westLon, const uint32_t& gridSize){
+		const double step_deg = 1.0/(gridSize-1);
+		std::vector<float> values;
+		for(uint32_t row = 0; row<gridSize; row++){
+			for(uint32_t col = 0; col<gridSize; col++){
+				const double lat_deg = southLat+1.0-row*step_deg;
+				const double lon_deg = westLon+col*step_deg;
+				values.push_back(static_cast<float>(500.0+300.0*std::sin(3.0*lat_deg)*std::cos(2.0*lon_deg)));
+			}
+		}
+		TerrainModel::RasterTile(TerrainModel::TileGeometry{southLat+1.0, static_cast<double>(westLon), 
+				step_deg, step_deg, gridSize, gridSize}, values)
+				.saveRawFloat((directory/(TerrainModel::tileNameFor(southLat+0.5, westLon+0.5)+".f32")).string());
+	}
+}
+
+//The batched sampler must give the same profiles as sampling every link on its own
+TEST(BatchProfileSamplerTests, matchesSingleProfileSamplingTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_batch_sampler_test";
+	std::filesystem::remove_all(DIRECTORY);
+	std::filesystem::create_directories(DIRECTORY);
+	for(int lat = 29; lat<31; lat++){
+		for(int lon = 47; lon<49; lon++){
+			writeSurfaceTile(DIRECTORY, lat, lon, 121);
+		}
+	}
+	TerrainModel::RasterTileCache terrain(DIRECTORY.string());
+
+	const TerrainModel::GeoPoint ORIGIN{29.8, 47.9};
+	const std::vector<TerrainModel::GeoPoint> DESTINATIONS = {
+		{29.9, 47.95}, {30.6, 48.7}, {29.1, 47.2}, {30.9, 47.05}, 
+		{29.8, 47.9},   //zero length link
+		{29.5, 49.6},   //ends on a missing (sea level) tile
+	};
+	const double MAX_STEP_KM = 0.5;
+
+	TerrainModel::BatchProfileSampler sampler(terrain, MAX_STEP_KM);
+	TerrainModel::ProfileBatch batch;
+	//sample twice to check that the buffers are reset between calls
+	sampler.sample(ORIGIN, std::vector<TerrainModel::GeoPoint>{{30.0, 48.0}}, batch);
+	sampler.sample(ORIGIN, DESTINATIONS, batch);
+	std::filesystem::remove_all(DIRECTORY);
+
+	ASSERT_EQ(DESTINATIONS.size(), batch.size());
+	EXPECT_EQ(batch.offsets.back(), batch.heights_m.size());
+	for(std::size_t linkInd = 0; linkInd<DESTINATIONS.size(); linkInd++){
+		const auto PROFILE = TerrainModel::sampleGreatCircleProfile(terrain, ORIGIN, DESTINATIONS[linkInd], MAX_STEP_KM);
+		const auto HEIGHTS = batch.heights(linkInd);
+		ASSERT_EQ(PROFILE.elevationList_m.size(), HEIGHTS.size());
+		EXPECT_DOUBLE_EQ(PROFILE.stepDistance_km, batch.stepDistances_km[linkInd]);
+		EXPECT_DOUBLE_EQ(PROFILE.distance_km, batch.distances_km[linkInd]);
+		EXPECT_DOUBLE_EQ(PROFILE.midpoint.lat_deg, batch.midpoints[linkInd].lat_deg);
+		for(std::size_t pointInd = 0; pointInd<HEIGHTS.size(); pointInd++){
+			EXPECT_NEAR(PROFILE.elevationList_m[pointInd], HEIGHTS[pointInd], 1.0e-6) << "link " << linkInd << " point " << pointInd;
+		}
+	}
+	EXPECT_NEAR(0.0, batch.heights(5).back(), 1.0e-9);
+}
@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include "TerrainModel/DistanceToCoast.h"
+#include "TerrainModel/GreatCircle.h"
+#include "TerrainModel/ZoneClassifier.h"
+
+#include <cmath>
+#include <filesystem>
+#include <numbers>
+
+namespace {
+	const double KM_PER_DEG = TerrainModel::EARTH_RADIUS_KM*std::numbers::pi/180.0;
+
+	//distance to the nearest sea point by exhaustive search, with the same flat grid approximation
+	double bruteForceDistance_km(const TerrainModel::RasterTile& mask, const uint32_t& row, const uint32_t& col){
+		const auto& geometry = mask.geometry();
+		const double lat_deg = geometry.northLat_deg-row*geometry.latStep_deg;
+		const double rowSpacing_km = geometry.latStep_deg*KM_PER_DEG;
+		const double colSpacing_km = geometry.lonStep_deg*KM_PER_DEG*std::cos(lat_deg*std::numbers::pi/180.0);
+		double minDistance_km = TerrainModel::FAR_FROM_COAST_KM;
+		for(uint32_t seaRow = 0; seaRow<geometry.numRows; seaRow++){
+			for(uint32_t seaCol = 0; seaCol<geometry.numCols; seaCol++){
+				if(mask.at(seaRow, seaCol)<0.5f){
+					minDistance_km = std::min(minDistance_km, std::hypot(rowSpacing_km*(static_cast<double>(row)-seaRow), 
+							colSpacing_km*(static_cast<double>(col)-seaCol)));
+				}
+			}
+		}
+		return minDistance_km;
+	}
+
+	//1x1 degree mask tile, land unless isSea(lat, lon)
+	template<typename SeaFunc>
+	void writeMaskTile(const std::filesystem::path& directory, const int& southLat, const int& westLon, SeaFunc isSea){
+		const uint32_t GRID_SIZE = 21;
+		const double STEP_DEG = 1.0/(GRID_SIZE-1);
+		std::vector<float> values;
+		for(uint32_t row = 0; row<GRID_SIZE; row++){
+			for(uint32_t col = 0; col<GRID_SIZE; col++){
+				values.push_back(isSea(southLat+1.0-row*STEP_DEG, westLon+col*STEP_DEG) ? 0.0f : 1.0f);
+			}
+		}
+		TerrainModel::RasterTile(TerrainModel::TileGeometry{southLat+1.0, static_cast<double>(westLon), STEP_DEG, STEP_DEG, 
+				GRID_SIZE, GRID_SIZE}, values).saveRawFloat((directory/(TerrainModel::tileNameFor(southLat+0.5, westLon+0.5)+".f32")).string());
+	}
+}
+
+//The distance transform must match an exhaustive search
+TEST(DistanceToCoastTests, matchesBruteForceTest){
+	const TerrainModel::TileGeometry GEOMETRY{45.0, 10.0, 0.02, 0.03, 37, 53};
+	std::vector<float> values;
+	for(uint32_t row = 0; row<GEOMETRY.numRows; row++){
+		for(uint32_t col = 0; col<GEOMETRY.numCols; col++){
+			//a bay, a lake and a sea strip along the southern edge
+			const bool isBay = std::hypot(row-8.0, col-40.0)<6.0;
+			const bool isLake = row>=20 && row<=22 && col>=10 && col<=11;
+			const bool isSouthSea = row>=35 && col<20;
+			values.push_back((isBay || isLake || isSouthSea) ? 0.0f : 1.0f);
+		}
+	}
+	const TerrainModel::RasterTile MASK(GEOMETRY, values);
+	const auto DISTANCE = TerrainModel::computeDistanceToCoast(MASK, 3);
+	for(uint32_t row = 0; row<GEOMETRY.numRows; row++){
+		for(uint32_t col = 0; col<GEOMETRY.numCols; col++){
+			EXPECT_NEAR(bruteForceDistance_km(MASK, row, col), DISTANCE.at(row, col), 1.0e-3) << row << ", " << col;
+		}
+	}
+
+	//no sea at all
+	const TerrainModel::RasterTile LAND(GEOMETRY, std::vector<float>(values.size(), 1.0f));
+	EXPECT_NEAR(TerrainModel::FAR_FROM_COAST_KM, TerrainModel::computeDistanceToCoast(LAND).at(10, 10), 1.0e-9);
+}
+
+//Coasts in neighbouring tiles are found when building the tiles of a directory
+TEST(DistanceToCoastTests, buildTilesTest){
+	const std::filesystem::path ROOT = std::filesystem::temp_directory_path()/"p452_distance_to_coast_test";
+	std::filesystem::remove_all(ROOT);
+	std::filesystem::create_directories(ROOT/"mask");
+	for(int lat = 28; lat<=30; lat++){
+		for(int lon = 46; lon<=49; lon++){
+			writeMaskTile(ROOT/"mask", lat, lon, [](double, double lon_deg){return lon_deg>48.5;});
+		}
+	}
+	EXPECT_EQ(12u, TerrainModel::buildDistanceToCoastTiles((ROOT/"mask").string(), (ROOT/"coast").string(), 2));
+
+	TerrainModel::RasterTileCache mask((ROOT/"mask").string());
+	TerrainModel::RasterTileCache coast((ROOT/"coast").string());
+	TerrainModel::ZoneClassifier classifier(mask, coast);
+	const double COL_SPACING_KM = 0.05*KM_PER_DEG*std::cos(29.5*std::numbers::pi/180.0);
+	//the first sea grid point (48.55) is 13 columns east, in the next tile
+	EXPECT_NEAR(13.0*COL_SPACING_KM, classifier.distanceToCoast_km(29.5, 47.9), 1.0e-3);
+	EXPECT_NEAR(0.0, classifier.distanceToCoast_km(29.5, 48.8), 1.0e-9);
+	std::filesystem::remove_all(ROOT);
+}
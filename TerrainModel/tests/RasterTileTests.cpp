@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "TerrainModel/GreatCircle.h"
+#include "TerrainModel/RasterTile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+
+namespace {
+	double constexpr TOLERANCE = 1.0e-6;
+
+	//write a square SRTM tile with big-endian heights given by heightFunc(row, col)
+	template<typename HeightFunc>
+	std::string writeHgtTile(const std::string& tileName, const int& gridSize, HeightFunc heightFunc){
+		const std::filesystem::path directory = std::filesystem::temp_directory_path()/"p452_hgt_test";
+		std::filesystem::create_directories(directory);
+		const std::filesystem::path filePath = directory/(tileName+".hgt");
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		for(int row = 0; row<gridSize; row++){
+			for(int col = 0; col<gridSize; col++){
+				const auto raw = static_cast<uint16_t>(static_cast<int16_t>(heightFunc(row, col)));
+				const char bytes[2] = {static_cast<char>(raw>>8), static_cast<char>(raw&0xFF)};
+				file.write(bytes, 2);
+			}
+		}
+		return filePath.string();
+	}
+}
+
+TEST(GreatCircleTests, distanceAndIntermediatePointTest){
+	//one degree along the equator and along a meridian
+	const double ONE_DEGREE_KM = TerrainModel::EARTH_RADIUS_KM*std::numbers::pi/180.0;
+	EXPECT_NEAR(ONE_DEGREE_KM, TerrainModel::greatCircleDistance_km({0.0, 10.0}, {0.0, 11.0}), TOLERANCE);
+	EXPECT_NEAR(ONE_DEGREE_KM, TerrainModel::greatCircleDistance_km({29.0, 48.0}, {30.0, 48.0}), TOLERANCE);
+
+	const auto MIDPOINT = TerrainModel::greatCircleIntermediatePoint({0.0, 10.0}, {0.0, 12.0}, 0.5);
+	EXPECT_NEAR(0.0, MIDPOINT.lat_deg, TOLERANCE);
+	EXPECT_NEAR(11.0, MIDPOINT.lon_deg, TOLERANCE);
+
+	//paths crossing the antimeridian stay short
+	EXPECT_NEAR(2.0*ONE_DEGREE_KM, TerrainModel::greatCircleDistance_km({0.0, 179.0}, {0.0, -179.0}), TOLERANCE);
+	EXPECT_NEAR(-180.0, TerrainModel::greatCircleIntermediatePoint({0.0, 179.0}, {0.0, -179.0}, 0.5).lon_deg, TOLERANCE);
+
+	const TerrainModel::GeoPoint TX{29.3, 47.6}, RX{29.9, 48.4};
+	const auto END = TerrainModel::greatCircleIntermediatePoint(TX, RX, 1.0);
+	EXPECT_NEAR(RX.lat_deg, END.lat_deg, TOLERANCE);
+	EXPECT_NEAR(RX.lon_deg, END.lon_deg, TOLERANCE);
+}
+
+TEST(RasterTileTests, tileNameTest){
+	EXPECT_EQ("N29E047", TerrainModel::tileNameFor(29.5, 47.2));
+	EXPECT_EQ("S01W001", TerrainModel::tileNameFor(-0.5, -0.5));
+	EXPECT_EQ("N00E000", TerrainModel::tileNameFor(0.0, 0.0));
+	EXPECT_EQ("S34W180", TerrainModel::tileNameFor(-33.2, 180.5));
+}
+
+//Bilinear interpolation reproduces a plane exactly
+TEST(RasterTileTests, bilinearInterpolationTest){
+	const TerrainModel::TileGeometry GEOMETRY{30.0, 47.0, 0.1, 0.1, 11, 11};
+	std::vector<float> values;
+	for(uint32_t row = 0; row<GEOMETRY.numRows; row++){
+		for(uint32_t col = 0; col<GEOMETRY.numCols; col++){
+			values.push_back(static_cast<float>(100.0*row+10.0*col));
+		}
+	}
+	const TerrainModel::RasterTile TILE(GEOMETRY, values);
+	//row 2.5, col 3.25
+	EXPECT_NEAR(282.5, TILE.interpolate(29.75, 47.325), 1.0e-3);
+	EXPECT_NEAR(330.0, TILE.nearest(29.75, 47.325), TOLERANCE);
+	EXPECT_NEAR(1100.0, TILE.interpolate(29.0, 48.0), 1.0e-3);
+	//outside the tile the border value is used
+	EXPECT_NEAR(0.0, TILE.interpolate(30.5, 46.5), TOLERANCE);
+	EXPECT_TRUE(TILE.contains(29.5, 47.5));
+	EXPECT_FALSE(TILE.contains(29.5, 48.5));
+
+	//raw float round trip
+	const std::string FILE_PATH = (std::filesystem::temp_directory_path()/"p452_raw_tile_test.f32").string();
+	TILE.saveRawFloat(FILE_PATH);
+	const auto LOADED = TerrainModel::RasterTile::loadRawFloat(FILE_PATH);
+	std::filesystem::remove(FILE_PATH);
+	EXPECT_TRUE(std::ranges::equal(TILE.values(), LOADED.values()));
+	EXPECT_NEAR(282.5, LOADED.interpolate(29.75, 47.325), 1.0e-3);
+
+	EXPECT_THROW(TerrainModel::RasterTile(GEOMETRY, std::vector<float>(5)), std::invalid_argument);
+}
+
+TEST(RasterTileTests, loadHgtTest){
+	const int GRID_SIZE = 11;
+	const std::string FILE_PATH = writeHgtTile("N29E047", GRID_SIZE, [](int row, int col){
+		//one void in the middle of the tile
+		return (row==5 && col==5) ? -32768 : 1000-10*row+col;
+	});
+	const auto TILE = TerrainModel::RasterTile::loadHgt(FILE_PATH);
+	std::filesystem::remove(FILE_PATH);
+
+	EXPECT_EQ(GRID_SIZE, static_cast<int>(TILE.geometry().numRows));
+	EXPECT_NEAR(30.0, TILE.geometry().northLat_deg, TOLERANCE);
+	EXPECT_NEAR(47.0, TILE.geometry().westLon_deg, TOLERANCE);
+	EXPECT_NEAR(0.1, TILE.geometry().latStep_deg, TOLERANCE);
+	//north-west and south-east corners
+	EXPECT_NEAR(1000.0, TILE.interpolate(30.0, 47.0), TOLERANCE);
+	EXPECT_NEAR(910.0, TILE.interpolate(29.0, 48.0), TOLERANCE);
+	//the void is skipped by the interpolation
+	EXPECT_TRUE(std::isnan(TILE.at(5,5)));
+	EXPECT_NEAR((956.0+945.0+946.0)/3.0, TILE.interpolate(29.45, 47.55), 1.0e-3);
+
+	//size or name that is not an hgt tile
+	EXPECT_THROW(TerrainModel::RasterTile::loadHgt(writeHgtTile("N29E047", 1, [](int, int){return 0;})), std::runtime_error);
+	EXPECT_THROW(TerrainModel::RasterTile::loadHgt(writeHgtTile("tile", 3, [](int, int){return 0;})), std::runtime_error);
+}
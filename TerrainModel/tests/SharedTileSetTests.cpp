@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include "TerrainModel/RasterTileCache.h"
+#include "TerrainModel/SharedTileSet.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+	//1x1 degree raw float tile with heights offset*1000 + row + col
+	void writeTile(const std::filesystem::path& directory, const int& southLat, const int& westLon, const float& offset){
+		const uint32_t GRID_SIZE = 51;
+		const double STEP_DEG = 1.0/(GRID_SIZE-1);
+		std::vector<float> values;
+		for(uint32_t row = 0; row<GRID_SIZE; row++){
+			for(uint32_t col = 0; col<GRID_SIZE; col++){
+				values.push_back(1000.0f*offset+row+col);
+			}
+		}
+		TerrainModel::RasterTile(TerrainModel::TileGeometry{southLat+1.0, static_cast<double>(westLon), STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, 
+				values).saveRawFloat((directory/(TerrainModel::tileNameFor(southLat+0.5, westLon+0.5)+".f32")).string());
+	}
+}
+
+//Tiles copied into shared memory match the files and are used by caches before the files
+TEST(SharedTileSetTests, shareTilesTest){
+	const std::filesystem::path DIRECTORY = std::filesystem::temp_directory_path()/"p452_shared_tile_set_test";
+	std::filesystem::remove_all(DIRECTORY);
+	std::filesystem::create_directories(DIRECTORY);
+	writeTile(DIRECTORY, 29, 47, 1.0f);
+	writeTile(DIRECTORY, 29, 48, 2.0f);
+	const std::string SEGMENT_NAME = "/p452_shared_tile_set_test_"+std::to_string(::getpid());
+
+	TerrainModel::RasterTileCache fileCache(DIRECTORY.string());
+	//duplicate and missing (sea) locations are skipped
+	const std::vector<TerrainModel::GeoPoint> LOCATIONS = {{29.5, 47.5}, {29.1, 47.9}, {29.5, 48.5}, {10.5, 10.5}};
+	auto sharedTiles = TerrainModel::SharedTileSet::create(SEGMENT_NAME, fileCache, LOCATIONS);
+	ASSERT_EQ(2u, sharedTiles->size());
+	EXPECT_EQ(SEGMENT_NAME, sharedTiles->segmentName());
+	EXPECT_EQ(nullptr, sharedTiles->find("N10E010"));
+	//the segment name cannot be reused while the set exists
+	EXPECT_THROW(TerrainModel::SharedTileSet::create(SEGMENT_NAME, fileCache, LOCATIONS), std::runtime_error);
+
+	//another mapping of the same segment, as opened by a worker process
+	const auto OPENED = TerrainModel::SharedTileSet::open(SEGMENT_NAME);
+	ASSERT_EQ(2u, OPENED->size());
+	for(const TerrainModel::GeoPoint& location : {TerrainModel::GeoPoint{29.5, 47.5}, TerrainModel::GeoPoint{29.5, 48.5}}){
+		const auto FILE_TILE = fileCache.tileFor(location.lat_deg, location.lon_deg);
+		const auto SHARED_TILE = OPENED->find(TerrainModel::tileNameFor(location.lat_deg, location.lon_deg));
+		ASSERT_NE(nullptr, SHARED_TILE);
+		EXPECT_EQ(FILE_TILE->byteSize(), SHARED_TILE->byteSize());
+		EXPECT_TRUE(std::ranges::equal(FILE_TILE->values(), SHARED_TILE->values()));
+		EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(SHARED_TILE->values().data())%64);
+	}
+
+	TerrainModel::RasterTileCache sharedCache(DIRECTORY.string(), TerrainModel::DEFAULT_TILE_CACHE_BYTES,
+			TerrainModel::MissingTilePolicy::SeaLevel, OPENED);
+	EXPECT_DOUBLE_EQ(fileCache.elevation_m(29.37, 48.61), sharedCache.elevation_m(29.37, 48.61));
+	EXPECT_EQ(OPENED->find("N29E048"), sharedCache.tileFor(29.37, 48.61));
+	EXPECT_EQ(0u, sharedCache.stats().misses);
+
+	//tiles keep their segment mapped after the set is gone, the name is removed with the last of them
+	auto tile = sharedTiles->find("N29E047");
+	sharedTiles.reset();
+	EXPECT_DOUBLE_EQ(fileCache.elevation_m(29.5, 47.5), tile->interpolate(29.5, 47.5));
+	tile.reset();
+	EXPECT_THROW(TerrainModel::SharedTileSet::open(SEGMENT_NAME), std::runtime_error);
+	EXPECT_DOUBLE_EQ(fileCache.elevation_m(29.5, 47.5), OPENED->find("N29E047")->interpolate(29.5, 47.5));
+	std::filesystem::remove_all(DIRECTORY);
+}
@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+#include "TerrainModel/RasterTileCache.h"
+#include "TerrainModel/TerrainProfile.h"
+
+#include <filesystem>
+#include <thread>
+
+namespace {
+	double constexpr TOLERANCE = 1.0e-3;
+
+	//1x1 degree raw float tile whose heights are a plane h = 1000*(lat-south) + 100*(lon-west)
+	void writePlaneTile(const std::filesystem::path& directory, const int& southLat, const int& westLon, const uint32_t& gridSize){
+		const double step_deg = 1.0/(gridSize-1);
+		std::vector<float> values;
+		for(uint32_t row = 0; row<gridSize; row++){
+			for(uint32_t col = 0; col<gridSize; col++){
+				values.push_back(static_cast<float>(1000.0*(1.0-row*step_deg)+100.0*col*step_deg));
+			}
+		}
+		const TerrainModel::RasterTile TILE(TerrainModel::TileGeometry{southLat+1.0, static_cast<double>(westLon), 
+				step_deg, step_deg, gridSize, gridSize}, values);
+		TILE.saveRawFloat((directory/(TerrainModel::tileNameFor(southLat+0.5, westLon+0.5)+".f32")).string());
+	}
+
+	std::filesystem::path makeTileDirectory(const std::string& name){
+		const std::filesystem::path directory = std::filesystem::temp_directory_path()/name;
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory);
+		return directory;
+	}
+}
+
+TEST(RasterTileCacheTests, evictionAndMissingTileTest){
+	const auto DIRECTORY = makeTileDirectory("p452_tile_cache_test");
+	const uint32_t GRID_SIZE = 101;
+	writePlaneTile(DIRECTORY, 29, 47, GRID_SIZE);
+	writePlaneTile(DIRECTORY, 29, 48, GRID_SIZE);
+	writePlaneTile(DIRECTORY, 30, 47, GRID_SIZE);
+
+	//room for two tiles
+	const std::size_t TILE_BYTES = GRID_SIZE*GRID_SIZE*sizeof(float);
+	TerrainModel::RasterTileCache cache(DIRECTORY.string(), 2*TILE_BYTES);
+	EXPECT_NEAR(500.0+50.0, cache.elevation_m(29.5, 47.5), TOLERANCE);
+	const auto FIRST_TILE = cache.tileFor(29.5, 47.5);
+	EXPECT_NEAR(250.0+25.0, cache.elevation_m(29.25, 48.25), TOLERANCE);
+	EXPECT_NEAR(750.0, cache.elevation_m(30.75, 47.0), TOLERANCE);
+
+	auto stats = cache.stats();
+	EXPECT_EQ(3u, stats.misses);
+	EXPECT_EQ(1u, stats.evictions);
+	EXPECT_EQ(2u, stats.cachedTiles);
+	EXPECT_EQ(2*TILE_BYTES, stats.cachedBytes);
+	//the evicted tile is still usable by its holder
+	EXPECT_NEAR(550.0, FIRST_TILE->interpolate(29.5, 47.5), TOLERANCE);
+
+	//no tile over the sea
+	EXPECT_EQ(nullptr, cache.tileFor(10.5, 10.5));
+	EXPECT_NEAR(0.0, cache.elevation_m(10.5, 10.5), TOLERANCE);
+	EXPECT_EQ(4u, cache.stats().misses);
+
+	TerrainModel::RasterTileCache strictCache(DIRECTORY.string(), 2*TILE_BYTES, TerrainModel::MissingTilePolicy::Throw);
+	EXPECT_THROW(strictCache.elevation_m(10.5, 10.5), std::runtime_error);
+	std::filesystem::remove_all(DIRECTORY);
+}
+
+TEST(RasterTileCacheTests, concurrentAccessTest){
+	const auto DIRECTORY = makeTileDirectory("p452_tile_cache_thread_test");
+	const uint32_t GRID_SIZE = 51;
+	for(int lon = 40; lon<44; lon++){
+		writePlaneTile(DIRECTORY, 29, lon, GRID_SIZE);
+	}
+	//budget smaller than the tile set so threads keep evicting and reloading
+	TerrainModel::RasterTileCache cache(DIRECTORY.string(), 2*GRID_SIZE*GRID_SIZE*sizeof(float));
+
+	std::vector<std::thread> threadList;
+	std::vector<int> errorCount(8, 0);
+	for(int threadInd = 0; threadInd<8; threadInd++){
+		threadList.emplace_back([&cache, &errorCount, threadInd](){
+			for(int sampleInd = 0; sampleInd<2000; sampleInd++){
+				const double lon_deg = 40.25+((sampleInd+threadInd)%4);
+				if(std::abs(cache.elevation_m(29.5, lon_deg)-525.0)>TOLERANCE){
+					errorCount[threadInd]++;
+				}
+			}
+		});
+	}
+	for(auto& thread : threadList){
+		thread.join();
+	}
+	for(const int& errors : errorCount){
+		EXPECT_EQ(0, errors);
+	}
+	EXPECT_LE(cache.stats().cachedTiles, 2u);
+	std::filesystem::remove_all(DIRECTORY);
+}
+
+TEST(TerrainProfileTests, sampleGreatCircleProfileTest){
+	const auto DIRECTORY = makeTileDirectory("p452_terrain_profile_test");
+	writePlaneTile(DIRECTORY, 29, 47, 121);
+	writePlaneTile(DIRECTORY, 29, 48, 121);
+	TerrainModel::RasterTileCache cache(DIRECTORY.string());
+
+	//path along a parallel crossing from one tile into the next, then onto the open sea
+	const TerrainModel::GeoPoint TX{29.5, 47.5}, RX{29.5, 49.5};
+	const auto PROFILE = TerrainModel::sampleGreatCircleProfile(cache, TX, RX, 1.0);
+	std::filesystem::remove_all(DIRECTORY);
+
+	EXPECT_NEAR(TerrainModel::greatCircleDistance_km(TX, RX), PROFILE.distance_km, 1.0e-9);
+	EXPECT_LE(PROFILE.stepDistance_km, 1.0);
+	EXPECT_NEAR(PROFILE.distance_km, PROFILE.stepDistance_km*(PROFILE.elevationList_m.size()-1), 1.0e-9);
+	EXPECT_NEAR(48.5, PROFILE.midpoint.lon_deg, 1.0e-9);
+	EXPECT_GT(PROFILE.midpoint.lat_deg, 29.5);
+
+	EXPECT_NEAR(550.0, PROFILE.elevationList_m.front(), TOLERANCE);
+	EXPECT_NEAR(0.0, PROFILE.elevationList_m.back(), TOLERANCE);
+	//the great circle bends north of the parallel, heights follow the plane of the current tile
+	const std::size_t MID_IND = (PROFILE.elevationList_m.size()-1)/2;
+	const auto MID_POINT = TerrainModel::greatCircleIntermediatePoint(TX, RX, static_cast<double>(MID_IND)/(PROFILE.elevationList_m.size()-1));
+	EXPECT_NEAR(1000.0*(MID_POINT.lat_deg-29.0)+100.0*(MID_POINT.lon_deg-48.0), PROFILE.elevationList_m[MID_IND], TOLERANCE);
+
+	//short paths still have at least 3 points
+	EXPECT_EQ(3u, TerrainModel::sampleGreatCircleProfile(cache, TX, TX).elevationList_m.size());
+	EXPECT_THROW(TerrainModel::sampleGreatCircleProfile(cache, TX, RX, 0.0), std::domain_error);
+}
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "TerrainModel/BatchProfileSampler.h"
+#include "TerrainModel/TerrainProfile.h"
+#include "TerrainModel/ZoneClassifier.h"
+
+#include <cmath>
+#include <filesystem>
+#include <numbers>
+
+namespace {
+	const uint32_t GRID_SIZE = 121;
+	const double STEP_DEG = 1.0/(GRID_SIZE-1);
+	//the coast runs north-south at this longitude, sea to the west
+	const double COAST_LON_DEG = 47.25;
+	const double KM_PER_DEG_LON = TerrainModel::EARTH_RADIUS_KM*std::numbers::pi/180.0*std::cos(29.5*std::numbers::pi/180.0);
+
+	//write a tile of N29E047 whose value is valueFunc(lat, lon) into directory
+	template<typename ValueFunc>
+	void writeTile(const std::filesystem::path& directory, ValueFunc valueFunc){
+		std::filesystem::create_directories(directory);
+		std::vector<float> values;
+		for(uint32_t row = 0; row<GRID_SIZE; row++){
+			for(uint32_t col = 0; col<GRID_SIZE; col++){
+				values.push_back(static_cast<float>(valueFunc(30.0-row*STEP_DEG, 47.0+col*STEP_DEG)));
+			}
+		}
+		TerrainModel::RasterTile(TerrainModel::TileGeometry{30.0, 47.0, STEP_DEG, STEP_DEG, GRID_SIZE, GRID_SIZE}, values)
+				.saveRawFloat((directory/"N29E047.f32").string());
+	}
+
+	class ZoneClassifierTests : public testing::Test{
+	protected:
+		void SetUp() override{
+			//one directory per test, tests may run in parallel
+			m_root = std::filesystem::temp_directory_path()/
+					(std::string("p452_zone_classifier_")+testing::UnitTest::GetInstance()->current_test_info()->name());
+			std::filesystem::remove_all(m_root);
+			//heights rise slowly inland, with a ridge above the coastal limit
+			writeTile(m_root/"dem", [](double lat, double lon){
+				return lon<COAST_LON_DEG ? 0.0 : (lon>47.6 && lon<47.7 ? 250.0 : 5.0+20.0*(lon-COAST_LON_DEG));
+			});
+			writeTile(m_root/"mask", [](double, double lon){return lon<COAST_LON_DEG ? 0.0 : 1.0;});
+			writeTile(m_root/"coast", [](double, double lon){return std::max(0.0, (lon-COAST_LON_DEG)*KM_PER_DEG_LON);});
+		}
+		void TearDown() override{
+			std::filesystem::remove_all(m_root);
+		}
+		std::filesystem::path m_root;
+	};
+}
+
+TEST_F(ZoneClassifierTests, classifyTest){
+	TerrainModel::RasterTileCache mask((m_root/"mask").string());
+	TerrainModel::RasterTileCache coast((m_root/"coast").string());
+	TerrainModel::ZoneClassifier classifier(mask, coast);
+
+	double distance_km;
+	EXPECT_EQ(PathProfile::ZoneType::Sea, classifier.classify(29.5, 47.1, 0.0, distance_km));
+	EXPECT_NEAR(0.0, distance_km, 1.0e-9);
+	//below sea level land is still land
+	EXPECT_EQ(PathProfile::ZoneType::CoastalLand, classifier.classify(29.5, 47.5, -10.0, distance_km));
+	EXPECT_NEAR(0.25*KM_PER_DEG_LON, distance_km, 1.0e-3);
+	//too high for coastal land
+	EXPECT_EQ(PathProfile::ZoneType::Inland, classifier.classify(29.5, 47.5, 150.0, distance_km));
+	//too far from the sea
+	EXPECT_EQ(PathProfile::ZoneType::Inland, classifier.classify(29.5, 47.9, 20.0, distance_km));
+	EXPECT_NEAR(0.65*KM_PER_DEG_LON, distance_km, 1.0e-3);
+	//no mask tile is sea
+	EXPECT_EQ(PathProfile::ZoneType::Sea, classifier.classify(10.5, 10.5, 20.0, distance_km));
+}
+
+TEST_F(ZoneClassifierTests, sampleProfileZonesTest){
+	TerrainModel::RasterTileCache terrain((m_root/"dem").string());
+	TerrainModel::RasterTileCache mask((m_root/"mask").string());
+	TerrainModel::RasterTileCache coast((m_root/"coast").string());
+	TerrainModel::ZoneClassifier classifier(mask, coast);
+
+	const TerrainModel::GeoPoint TX{29.5, 47.05}, RX{29.5, 47.95};
+	const auto PROFILE = TerrainModel::sampleGreatCircleProfile(terrain, TX, RX, 0.5, &classifier);
+	ASSERT_EQ(PROFILE.elevationList_m.size(), PROFILE.zoneList.size());
+	EXPECT_EQ(PathProfile::ZoneType::Sea, PROFILE.zoneList.front());
+	EXPECT_EQ(PathProfile::ZoneType::Inland, PROFILE.zoneList.back());
+	EXPECT_NEAR(0.0, PROFILE.txDistanceToCoast_km, 1.0e-9);
+	EXPECT_NEAR(0.7*KM_PER_DEG_LON, PROFILE.rxDistanceToCoast_km, 0.1);
+
+	bool hasCoastalLand = false;
+	for(std::size_t pointInd = 0; pointInd<PROFILE.zoneList.size(); pointInd++){
+		if(PROFILE.zoneList[pointInd]==PathProfile::ZoneType::CoastalLand){
+			hasCoastalLand = true;
+			EXPECT_LE(PROFILE.elevationList_m[pointInd], TerrainModel::COASTAL_LAND_MAX_HEIGHT_M);
+		}
+	}
+	EXPECT_TRUE(hasCoastalLand);
+
+	//the batched sampler classifies the same way
+	TerrainModel::BatchProfileSampler sampler(terrain, 0.5, &classifier);
+	TerrainModel::ProfileBatch batch;
+	sampler.sample(TX, std::vector<TerrainModel::GeoPoint>{RX, {29.6, 47.1}}, batch);
+	ASSERT_TRUE(batch.hasZones());
+	const auto ZONES = batch.profileZones(0);
+	ASSERT_EQ(PROFILE.zoneList.size(), ZONES.size());
+	for(std::size_t pointInd = 0; pointInd<ZONES.size(); pointInd++){
+		EXPECT_EQ(PROFILE.zoneList[pointInd], ZONES[pointInd]) << pointInd;
+	}
+	EXPECT_NEAR(PROFILE.rxDistanceToCoast_km, batch.rxDistancesToCoast_km[0], 1.0e-6);
+	EXPECT_NEAR(0.0, batch.rxDistancesToCoast_km[1], 1.0e-9);
+
+	//without a classifier the batch has no zones
+	TerrainModel::BatchProfileSampler(terrain, 0.5).sample(TX, std::vector<TerrainModel::GeoPoint>{RX}, batch);
+	EXPECT_FALSE(batch.hasZones());
+}
@@ -0,0 +1,25 @@
+#include "TerrainModel/DistanceToCoast.h"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+//Build distance-to-coast tiles from a directory of land/sea mask tiles
+//usage: DistanceToCoastTool <mask directory> <output directory> [thread count]
+int main(int argc, char* argv[]){
+    if(argc<3 || argc>4){
+        std::cerr << "usage: " << argv[0] << " <mask directory> <output directory> [thread count]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    try{
+        const unsigned int threadCount = (argc==4) ? static_cast<unsigned int>(std::stoul(argv[3])) : 0;
+        const std::size_t numTiles = TerrainModel::buildDistanceToCoastTiles(argv[1], argv[2], threadCount);
+        std::cout << "Wrote " << numTiles << " distance-to-coast tiles to " << argv[2] << std::endl;
+    }
+    catch(const std::exception& err){
+        std::cerr << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#ifndef TEST_SUPPORT_ALLOCATION_COUNTER_H
+#define TEST_SUPPORT_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <span>
+#include <string>
+
+/// Heap allocation accounting for tests and benchmarks. Linking the TestSupport object library replaces the global
+/// operator new and delete of the program with versions that count every allocation, so it must only be linked into
+/// test and benchmark executables
+namespace TestSupport{
+
+    /// @brief Heap allocations counted over a period
+    struct AllocationStats{
+        std::size_t numAllocations = 0;     //calls of any operator new
+        std::size_t numBytes = 0;           //bytes requested from operator new
+        std::size_t numDeallocations = 0;   //calls of any operator delete with a non null pointer
+    };
+
+    /// @brief Counts the heap allocations made while it is alive, by the calling thread or by every thread
+    class AllocationCounter{
+    public:
+        /// @param allThreads   Count the allocations of every thread instead of the calling thread only
+        explicit AllocationCounter(const bool& allThreads=false);
+
+        /// @brief Allocations since the construction (or the last restart)
+        AllocationStats stats() const;
+
+        /// @brief Start counting again from 0
+        void restart();
+
+    private:
+        bool m_allThreads;
+        AllocationStats m_start;
+    };
+
+    /// @brief Allocations of one entry point over a number of evaluated links
+    struct EntryPointAllocations{
+        std::string entryPoint;     //name of the measured function (e.g. "P452::calculateP452Loss_dB")
+        std::size_t numLinks;       //number of links evaluated while counting
+        AllocationStats stats;
+
+        double allocationsPerLink() const {return numLinks>0 ? static_cast<double>(stats.numAllocations)/numLinks : 0.0;}
+        double bytesPerLink() const {return numLinks>0 ? static_cast<double>(stats.numBytes)/numLinks : 0.0;}
+    };
+
+    /// @brief Write one line per entry point: name, links, allocations per link and bytes per link
+    /// @param output       Output stream
+    /// @param report       Measured entry points
+    void writeAllocationReport(std::ostream& output, std::span<const EntryPointAllocations> report);
+
+}//end namespace TestSupport
+#endif /* TEST_SUPPORT_ALLOCATION_COUNTER_H */
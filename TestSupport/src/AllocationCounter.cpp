@@ -0,0 +1,160 @@
+#include "TestSupport/AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <ostream>
+
+namespace{
+    //the counters are always on, a counter takes the difference between two snapshots
+    struct ThreadCounts{
+        std::size_t numAllocations;
+        std::size_t numBytes;
+        std::size_t numDeallocations;
+    };
+    constinit thread_local ThreadCounts threadCounts{0, 0, 0};
+    constinit std::atomic<std::size_t> processAllocations{0};
+    constinit std::atomic<std::size_t> processBytes{0};
+    constinit std::atomic<std::size_t> processDeallocations{0};
+
+    void countAllocation(const std::size_t& size){
+        threadCounts.numAllocations++;
+        threadCounts.numBytes += size;
+        processAllocations.fetch_add(1, std::memory_order_relaxed);
+        processBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void countDeallocation(void* ptr){
+        if(ptr!=nullptr){
+            threadCounts.numDeallocations++;
+            processDeallocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void* allocate(const std::size_t& size){
+        countAllocation(size);
+        if(void* ptr = std::malloc(size==0 ? 1 : size)){
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(const std::size_t& size, const std::align_val_t& alignment){
+        countAllocation(size);
+        const std::size_t align = static_cast<std::size_t>(alignment);
+        //aligned_alloc needs a size that is a multiple of the alignment
+        if(void* ptr = std::aligned_alloc(align, ((size==0 ? 1 : size)+align-1)/align*align)){
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    void deallocate(void* ptr){
+        countDeallocation(ptr);
+        std::free(ptr);
+    }
+
+    TestSupport::AllocationStats snapshot(const bool& allThreads){
+        if(allThreads){
+            return TestSupport::AllocationStats{processAllocations.load(std::memory_order_relaxed),
+                    processBytes.load(std::memory_order_relaxed), processDeallocations.load(std::memory_order_relaxed)};
+        }
+        return TestSupport::AllocationStats{threadCounts.numAllocations, threadCounts.numBytes, threadCounts.numDeallocations};
+    }
+}
+
+//replaceable global allocation functions, every form is replaced so no allocation bypasses the counters
+void* operator new(std::size_t size){
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size){
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept{
+    try{
+        return allocate(size);
+    }
+    catch(const std::bad_alloc&){
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept{
+    try{
+        return allocate(size);
+    }
+    catch(const std::bad_alloc&){
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment){
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment){
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept{
+    deallocate(ptr);
+}
+
+TestSupport::AllocationCounter::AllocationCounter(const bool& allThreads):
+    m_allThreads{allThreads}, m_start{snapshot(allThreads)}{
+}
+
+TestSupport::AllocationStats TestSupport::AllocationCounter::stats() const{
+    const AllocationStats now = snapshot(m_allThreads);
+    return AllocationStats{now.numAllocations-m_start.numAllocations, now.numBytes-m_start.numBytes,
+            now.numDeallocations-m_start.numDeallocations};
+}
+
+void TestSupport::AllocationCounter::restart(){
+    m_start = snapshot(m_allThreads);
+}
+
+void TestSupport::writeAllocationReport(std::ostream& output, std::span<const EntryPointAllocations> report){
+    const auto oldFlags = output.flags();
+    const auto oldPrecision = output.precision(2);
+    output << std::fixed;
+    for(const EntryPointAllocations& entry : report){
+        output << std::left << std::setw(48) << entry.entryPoint << std::right
+                << " links " << std::setw(6) << entry.numLinks
+                << "  allocations/link " << std::setw(8) << entry.allocationsPerLink()
+                << "  bytes/link " << std::setw(12) << entry.bytesPerLink() << "\n";
+    }
+    output.flags(oldFlags);
+    output.precision(oldPrecision);
+}
@@ -0,0 +1,168 @@
+#include "BenchmarkBaseline.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace{
+    template<typename Entries>
+    auto findEntry(Entries& entries, const std::string& name) -> decltype(&entries.front()){
+        const auto entry = std::find_if(entries.begin(), entries.end(),
+                [&name](const BenchmarkBaseline::BaselineEntry& candidate){return candidate.name==name;});
+        return entry==entries.end() ? nullptr : &*entry;
+    }
+
+    /// @brief Value of the next "key": "value" string member after position, moves position past it
+    std::string readStringMember(const std::string& text, const std::string& key, std::size_t& position){
+        const std::string prefix = "\"" + key + "\": \"";
+        const std::size_t start = text.find(prefix, position);
+        const std::size_t end = start==std::string::npos ? std::string::npos : text.find('"', start+prefix.size());
+        if(end==std::string::npos){
+            std::ostringstream message;
+            message << "ERROR: BenchmarkBaseline::readBaseline(): missing string member \"" << key << "\"";
+            throw std::runtime_error(message.str());
+        }
+        position = end+1;
+        return text.substr(start+prefix.size(), end-start-prefix.size());
+    }
+
+    /// @brief Value of the next "key": number member after position, moves position past it
+    double readNumberMember(const std::string& text, const std::string& key, std::size_t& position){
+        const std::string prefix = "\"" + key + "\": ";
+        const std::size_t start = text.find(prefix, position);
+        std::istringstream value(start==std::string::npos ? std::string() : text.substr(start+prefix.size(), 32));
+        double number;
+        if(!(value >> number)){
+            std::ostringstream message;
+            message << "ERROR: BenchmarkBaseline::readBaseline(): missing number member \"" << key << "\"";
+            throw std::runtime_error(message.str());
+        }
+        position = start+prefix.size();
+        return number;
+    }
+}
+
+std::string BenchmarkBaseline::hostDescription(const benchmark::CPUInfo& cpuInfo){
+    std::array<char, 256> hostName{};
+    if(gethostname(hostName.data(), hostName.size()-1)!=0){
+        hostName.fill('\0');
+    }
+    std::ostringstream host;
+    host << (hostName[0]=='\0' ? "unknown host" : hostName.data()) << ", " << cpuInfo.num_cpus << " CPUs";
+    return host.str();
+}
+
+bool BenchmarkBaseline::RecordingReporter::ReportContext(const Context& context){
+    m_baseline.host = hostDescription(context.cpu_info);
+    return ConsoleReporter::ReportContext(context);
+}
+
+void BenchmarkBaseline::RecordingReporter::ReportRuns(const std::vector<Run>& reports){
+    for(const Run& run : reports){
+        const bool isMedian = run.run_type==Run::RT_Aggregate && run.aggregate_name=="median";
+        if(run.error_occurred || run.report_big_o || run.report_rms || (run.run_type==Run::RT_Aggregate && !isMedian)){
+            continue;
+        }
+        //aggregates are named <benchmark>_median, the baseline keeps the benchmark name
+        const std::string name = run.run_name.str();
+        const double cpuTime_ns = run.GetAdjustedCPUTime()*1e9/benchmark::GetTimeUnitMultiplier(run.time_unit);
+        BaselineEntry* entry = findEntry(m_baseline.entries, name);
+        if(entry==nullptr){
+            m_baseline.entries.push_back(BaselineEntry{name, cpuTime_ns});
+        }
+        else if(isMedian){
+            entry->cpuTime_ns = cpuTime_ns;
+        }
+    }
+    ConsoleReporter::ReportRuns(reports);
+}
+
+void BenchmarkBaseline::writeBaseline(const std::string& filePath, const Baseline& baseline){
+    std::ofstream file(filePath);
+    if(!file){
+        std::ostringstream message;
+        message << "ERROR: BenchmarkBaseline::writeBaseline(): cannot open " << filePath;
+        throw std::runtime_error(message.str());
+    }
+    file << "{\n  \"host\": \"" << baseline.host << "\",\n  \"benchmarks\": [";
+    file << std::setprecision(6);
+    for(std::size_t entryInd = 0; entryInd<baseline.entries.size(); entryInd++){
+        const BaselineEntry& entry = baseline.entries[entryInd];
+        file << (entryInd==0 ? "\n" : ",\n") << "    {\"name\": \"" << entry.name << "\", \"cpu_time_ns\": " << entry.cpuTime_ns
+                << ", \"items_per_second\": " << entry.throughput_per_s() << "}";
+    }
+    file << "\n  ]\n}\n";
+}
+
+BenchmarkBaseline::Baseline BenchmarkBaseline::readBaseline(const std::string& filePath){
+    std::ifstream file(filePath);
+    if(!file){
+        std::ostringstream message;
+        message << "ERROR: BenchmarkBaseline::readBaseline(): cannot open " << filePath;
+        throw std::runtime_error(message.str());
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    const std::string text = contents.str();
+
+    Baseline baseline;
+    std::size_t position = 0;
+    baseline.host = readStringMember(text, "host", position);
+    while(text.find("\"name\": \"", position)!=std::string::npos){
+        BaselineEntry entry;
+        entry.name = readStringMember(text, "name", position);
+        entry.cpuTime_ns = readNumberMember(text, "cpu_time_ns", position);
+        if(!(entry.cpuTime_ns>0)){
+            std::ostringstream message;
+            message << "ERROR: BenchmarkBaseline::readBaseline(): invalid cpu_time_ns of " << entry.name;
+            throw std::runtime_error(message.str());
+        }
+        baseline.entries.push_back(entry);
+    }
+    return baseline;
+}
+
+std::size_t BenchmarkBaseline::compareWithBaseline(const Baseline& baseline, const Baseline& current, const double& tolerance,
+        std::ostream& output){
+    if(!(tolerance>=0)){
+        throw std::invalid_argument("ERROR: BenchmarkBaseline::compareWithBaseline(): tolerance must be >= 0");
+    }
+    std::size_t nameWidth = 10;
+    for(const BaselineEntry& entry : current.entries){
+        nameWidth = std::max(nameWidth, entry.name.size());
+    }
+
+    const auto oldFlags = output.flags();
+    const auto oldPrecision = output.precision(1);
+    output << "Baseline host: " << baseline.host << "\nCurrent host:  " << current.host << "\n"
+            << std::left << std::setw(nameWidth) << "Benchmark" << std::right
+            << std::setw(16) << "baseline/s" << std::setw(16) << "current/s" << std::setw(10) << "change" << "\n"
+            << std::fixed;
+    std::size_t numRegressions = 0;
+    for(const BaselineEntry& entry : current.entries){
+        output << std::left << std::setw(nameWidth) << entry.name << std::right;
+        const BaselineEntry* stored = findEntry(baseline.entries, entry.name);
+        if(stored==nullptr){
+            output << std::setw(16) << "-" << std::setw(16) << entry.throughput_per_s() << std::setw(10) << "new" << "\n";
+            continue;
+        }
+        //a throughput drop of more than the tolerance regresses, faster runs always pass
+        const double ratio = entry.throughput_per_s()/stored->throughput_per_s();
+        const bool isRegression = ratio<1.0-tolerance;
+        numRegressions += isRegression ? 1 : 0;
+        output << std::setw(16) << stored->throughput_per_s() << std::setw(16) << entry.throughput_per_s()
+                << std::setw(9) << std::showpos << 100.0*(ratio-1.0) << std::noshowpos << "%"
+                << (isRegression ? "  REGRESSION" : "") << "\n";
+    }
+    output << numRegressions << " of " << current.entries.size() << " benchmarks regressed by more than "
+            << 100.0*tolerance << "%\n";
+    output.flags(oldFlags);
+    output.precision(oldPrecision);
+    return numRegressions;
+}
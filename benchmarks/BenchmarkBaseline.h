@@ -0,0 +1,70 @@
+#ifndef BENCHMARK_BASELINE_H
+#define BENCHMARK_BASELINE_H
+
+#include <benchmark/benchmark.h>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// Throughput baselines of the benchmarks. A baseline is a JSON file with the CPU time per iteration of every benchmark,
+/// a new run is compared against it and fails when a benchmark is slower than the baseline by more than the tolerance.
+/// Throughput only compares on the machine that recorded the baseline, so a baseline also names its host
+namespace BenchmarkBaseline{
+
+    /// @brief Result of one benchmark
+    struct BaselineEntry{
+        std::string name;           //benchmark name, e.g. BM_DiffractionLoss/TestPath/0
+        double cpuTime_ns;          //CPU time per iteration (ns)
+
+        /// @brief Iterations (submodel calls or links) per second
+        double throughput_per_s() const {return 1e9/cpuTime_ns;}
+    };
+
+    /// @brief Benchmark results with a description of the machine that produced them
+    struct Baseline{
+        std::string host;           //host name and CPU count of the machine, see hostDescription
+        std::vector<BaselineEntry> entries;
+    };
+
+    /// @brief Description of the machine stored in and checked against a baseline. The CPU frequency is left out,
+    ///        it changes between runs with frequency scaling
+    /// @param cpuInfo      CPU of the machine (benchmark::CPUInfo::Get())
+    std::string hostDescription(const benchmark::CPUInfo& cpuInfo);
+
+    /// @brief Console reporter that also keeps the result of every benchmark. With repetitions the median aggregate
+    ///        is kept, runs with errors and complexity fits are left out
+    class RecordingReporter : public benchmark::ConsoleReporter{
+    public:
+        bool ReportContext(const Context& context) override;
+        void ReportRuns(const std::vector<Run>& reports) override;
+
+        /// @brief Results of the benchmarks run so far
+        const Baseline& baseline() const {return m_baseline;}
+
+    private:
+        Baseline m_baseline;
+    };
+
+    /// @brief Write a baseline file
+    /// @param filePath     Path of the JSON file, overwritten
+    /// @param baseline     Benchmark results
+    void writeBaseline(const std::string& filePath, const Baseline& baseline);
+
+    /// @brief Read a baseline file written by writeBaseline
+    /// @param filePath     Path of the JSON file
+    /// @return Benchmark results
+    Baseline readBaseline(const std::string& filePath);
+
+    /// @brief Compare the throughput of a run with a baseline, one line per benchmark of the run. Benchmarks missing
+    ///        from the baseline are reported as new and never fail
+    /// @param baseline     Stored results
+    /// @param current      Results of the new run
+    /// @param tolerance    Allowed relative throughput loss before a benchmark regresses (e.g. 0.1 for 10%)
+    /// @param output       Output stream of the comparison table
+    /// @return Number of regressed benchmarks
+    std::size_t compareWithBaseline(const Baseline& baseline, const Baseline& current, const double& tolerance,
+            std::ostream& output);
+
+}//end namespace BenchmarkBaseline
+#endif /* BENCHMARK_BASELINE_H */
@@ -0,0 +1,100 @@
+#include "PerfCounters.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace{
+#if defined(__linux__)
+    constexpr std::array<std::uint64_t,PerfCounters::NUM_PERF_EVENTS> EVENT_CONFIGS{
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+
+    //layout of a read of the group with PERF_FORMAT_GROUP|PERF_FORMAT_TOTAL_TIME_ENABLED|PERF_FORMAT_TOTAL_TIME_RUNNING
+    struct GroupReadFormat{
+        std::uint64_t numEvents;
+        std::uint64_t timeEnabled;
+        std::uint64_t timeRunning;
+        std::uint64_t values[PerfCounters::NUM_PERF_EVENTS];
+    };
+
+    int openEvent(const std::uint64_t& config, const int& groupFd){
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.disabled = groupFd<0 ? 1 : 0;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupFd, 0));
+    }
+#endif
+}
+
+PerfCounters::PerfCounts PerfCounters::operator-(const PerfCounts& end, const PerfCounts& start){
+    PerfCounts difference;
+    for(std::size_t eventInd = 0; eventInd<NUM_PERF_EVENTS; eventInd++){
+        difference.values[eventInd] = end.values[eventInd]-start.values[eventInd];
+    }
+    return difference;
+}
+
+PerfCounters::PerfCounterGroup::PerfCounterGroup(){
+    m_fds.fill(-1);
+#if defined(__linux__)
+    for(std::size_t eventInd = 0; eventInd<NUM_PERF_EVENTS; eventInd++){
+        m_fds[eventInd] = openEvent(EVENT_CONFIGS[eventInd], m_fds[0]);
+        if(m_fds[eventInd]<0){
+            m_unavailableReason = std::string("perf_event_open failed: ") + std::strerror(errno);
+            for(int& fd : m_fds){
+                if(fd>=0){
+                    close(fd);
+                }
+                fd = -1;
+            }
+            return;
+        }
+    }
+    ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+    m_unavailableReason = "perf_event_open is only available on Linux";
+#endif
+}
+
+PerfCounters::PerfCounterGroup::~PerfCounterGroup(){
+#if defined(__linux__)
+    for(const int& fd : m_fds){
+        if(fd>=0){
+            close(fd);
+        }
+    }
+#endif
+}
+
+PerfCounters::PerfCounts PerfCounters::PerfCounterGroup::read() const{
+    PerfCounts counts;
+#if defined(__linux__)
+    GroupReadFormat group;
+    if(!isAvailable() || ::read(m_fds[0], &group, sizeof(group))!=static_cast<ssize_t>(sizeof(group)) || group.timeRunning==0){
+        return counts;
+    }
+    //with more events than hardware counters the kernel multiplexes the group, scale to the enabled time
+    const double scale = static_cast<double>(group.timeEnabled)/group.timeRunning;
+    for(std::size_t eventInd = 0; eventInd<NUM_PERF_EVENTS; eventInd++){
+        counts.values[eventInd] = scale*group.values[eventInd];
+    }
+#endif
+    return counts;
+}
@@ -0,0 +1,55 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// Hardware performance counters of the calling thread read with perf_event_open (Linux). Where the counters cannot be
+/// opened (other systems, virtual machines without a PMU, perf_event_paranoid too strict) the group is unavailable and
+/// every read returns zeros, so the benchmarks run without them
+namespace PerfCounters{
+
+    enum class PerfEvent{
+        Cycles=0,
+        Instructions,
+        CacheMisses,        //last level cache misses
+        BranchMisses
+    };
+    constexpr std::size_t NUM_PERF_EVENTS = 4;
+
+    /// @brief Counts of every event, scaled for the time the group was multiplexed out
+    struct PerfCounts{
+        std::array<double,NUM_PERF_EVENTS> values{};
+
+        double operator[](const PerfEvent& event) const {return values[static_cast<std::size_t>(event)];}
+    };
+
+    /// @brief Difference of two reads of the same group
+    PerfCounts operator-(const PerfCounts& end, const PerfCounts& start);
+
+    /// @brief Counters of the user space code of the calling thread, counting from the construction
+    class PerfCounterGroup{
+    public:
+        PerfCounterGroup();
+        ~PerfCounterGroup();
+        PerfCounterGroup(const PerfCounterGroup&) = delete;
+        PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+        /// @brief True if every event of the group could be opened
+        bool isAvailable() const {return m_fds[0]>=0;}
+
+        /// @brief Why the counters are unavailable, empty if they are available
+        const std::string& unavailableReason() const {return m_unavailableReason;}
+
+        /// @brief Counts since the construction, zeros if the counters are unavailable
+        PerfCounts read() const;
+
+    private:
+        std::array<int,NUM_PERF_EVENTS> m_fds;      //file descriptors, the first one leads the group
+        std::string m_unavailableReason;
+    };
+
+}//end namespace PerfCounters
+#endif /* PERF_COUNTERS_H */
@@ -0,0 +1,335 @@
+#include "MainModel/AnomalousProp.h"
+#include "MainModel/BasicProp.h"
+#include "MainModel/DiffractionLoss.h"
+#include "MainModel/Helpers.h"
+#include "MainModel/P452TotalAttenuation.h"
+#include "MainModel/PathProfile.h"
+#include "MainModel/TropoScatter.h"
+#include "ClutterModel/ClutterLoss.h"
+#include "Common/Enumerations.h"
+#include "TestSupport/AllocationCounter.h"
+#include "BenchmarkBaseline.h"
+#include "PerfCounters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numbers>
+#include <string>
+#include <vector>
+
+//Each submodel is timed on the validation profiles of MainModel/tests/test_paths (BM_<model>/TestPath/<index>, labelled with
+//the file name) and on synthetic profiles of 10^2 to 10^5 points (BM_<model>/Synthetic/<points>, with the fitted complexity).
+//The inputs of a submodel (clutter model, horizon values, ...) are prepared once per profile outside of the timed loop,
+//so each benchmark measures one call of the submodel alone.
+//Where perf_event_open gives hardware counters, every benchmark also reports the instructions per cycle and the cycles,
+//instructions, cache misses and branch misses per profile point. The profile kernels are the Bullington loops (4 passes
+//of BM_DiffractionLoss), the horizon loop (BM_HorizonAnglesAndDistances) and the least squares smooth-Earth loop
+//(BM_SmoothEarthHeights).
+
+namespace {
+    const std::filesystem::path testPathsFullPath = CMAKE_CLEARAIR_SRC_DIR / std::filesystem::path("tests/test_paths");
+
+    constexpr std::array<const char*,5> TEST_PATH_FILES{
+        "test_profile_flat_land_5km.csv",
+        "test_profile_mixed_109km.csv",
+        "test_profile_flat_land_100km.csv",
+        "test_profile_land_70km.csv",
+        "test_profile_flat_land_1000km.csv",
+    };
+
+    //inputs of the clear air model validation profiles
+    constexpr double FREQ_GHZ = 2.0;
+    constexpr double P_PERCENT = 10.0;
+    constexpr double HTG_M = 10.0;
+    constexpr double HRG_M = 10.0;
+    constexpr double CENTER_LATITUDE_DEG = 40.25;
+    constexpr double TX_GAIN_DBI = 10.0;
+    constexpr double RX_GAIN_DBI = 22.0;
+    constexpr Enumerations::PolarizationType POL = Enumerations::PolarizationType::HorizontalPolarized;
+    constexpr double DIST_COAST_TX_KM = 500.0;
+    constexpr double DIST_COAST_RX_KM = 500.0;
+    constexpr double DELTA_N = 50.0;
+    constexpr double N0 = 301.0;
+    constexpr double TEMP_K = 288.15;
+    constexpr double DRY_PRESSURE_HPA = 1013.0;
+    constexpr ClutterModel::ClutterType TX_CLUTTER = ClutterModel::ClutterType::NoClutter;
+    constexpr ClutterModel::ClutterType RX_CLUTTER = ClutterModel::ClutterType::NoClutter;
+    //the clutter model benchmark uses clutter at both ends, without clutter the path is returned unchanged
+    constexpr ClutterModel::ClutterType BENCHMARK_CLUTTER = ClutterModel::ClutterType::DenseUrban;
+
+    //spacing of the synthetic profiles (km), about the spacing of a 1 arc-second DEM
+    constexpr double SYNTHETIC_STEP_KM = 0.03;
+
+    /// @brief A profile and the submodel inputs derived from it, as calculated by TotalClearAirAttenuation
+    struct PreparedProfile{
+        std::string name;
+        PathProfile::Path path;
+        ClutterModel::ClutterResults clutter;
+        double height_tx_asl_m;
+        double height_rx_asl_m;
+        double d_tot_km;
+        double fracOverSea;
+        double b0_percent;
+        double effRadius_km;
+        ITUR_P452::HorizonAnglesAndDistances horizonVals;
+    };
+
+    void prepare(PreparedProfile& profile){
+        profile.clutter = ClutterModel::calculateClutterModel(FREQ_GHZ, profile.path, HTG_M, HRG_M, TX_CLUTTER, RX_CLUTTER);
+        const PathProfile::PathView& modPath = profile.clutter.modifiedPath;
+        profile.height_tx_asl_m = profile.clutter.modifiedHeights_m.first + modPath.front().h_asl_m;
+        profile.height_rx_asl_m = profile.clutter.modifiedHeights_m.second + modPath.back().h_asl_m;
+        profile.d_tot_km = modPath.back().d_km;
+        profile.fracOverSea = modPath.calcFracOverSea();
+        profile.b0_percent = modPath.calcTimePercentBeta0(CENTER_LATITUDE_DEG);
+        profile.effRadius_km = ITUR_P452::Helpers::calcMedianEffectiveRadius_km(DELTA_N);
+        profile.horizonVals = ITUR_P452::Helpers::calcHorizonAnglesAndDistances(modPath, profile.height_tx_asl_m,
+                profile.height_rx_asl_m, profile.effRadius_km, FREQ_GHZ);
+    }
+
+    const PreparedProfile& testPathProfile(const int64_t& fileInd){
+        static std::map<int64_t,std::unique_ptr<PreparedProfile>> profiles;
+        std::unique_ptr<PreparedProfile>& profile = profiles[fileInd];
+        if(!profile){
+            profile = std::make_unique<PreparedProfile>();
+            profile->name = TEST_PATH_FILES.at(fileInd);
+            profile->path = PathProfile::Path((testPathsFullPath / profile->name).string());
+            prepare(*profile);
+        }
+        return *profile;
+    }
+
+    /// @brief Rolling inland terrain with a sea crossing over the middle fifth of the path,
+    ///        the same profile for the same number of points
+    const PreparedProfile& syntheticProfile(const int64_t& numPoints){
+        static std::map<int64_t,std::unique_ptr<PreparedProfile>> profiles;
+        std::unique_ptr<PreparedProfile>& profile = profiles[numPoints];
+        if(!profile){
+            profile = std::make_unique<PreparedProfile>();
+            profile->name = "synthetic_" + std::to_string(numPoints);
+            profile->path.reserve(numPoints);
+            for(int64_t pointInd = 0; pointInd<numPoints; pointInd++){
+                const double d_km = pointInd*SYNTHETIC_STEP_KM;
+                const double pathFrac = static_cast<double>(pointInd)/(numPoints-1);
+                if(pathFrac>0.4 && pathFrac<0.6){
+                    profile->path.emplace_back(d_km, 0.0, PathProfile::ZoneType::Sea);
+                    continue;
+                }
+                const double h_m = 150.0 + 120.0*std::sin(2.0*std::numbers::pi*d_km/37.0) + 45.0*std::sin(2.0*std::numbers::pi*d_km/5.3)
+                        + 8.0*std::sin(2.0*std::numbers::pi*d_km/0.7);
+                profile->path.emplace_back(d_km, h_m, PathProfile::ZoneType::Inland);
+            }
+            prepare(*profile);
+        }
+        return *profile;
+    }
+
+    void runBasicProp(benchmark::State& state, const PreparedProfile& profile){
+        double freeSpaceWithGasLoss_dB, basicTransmissionLoss_p_percent_dB, basicTransmissionLoss_b0_percent_dB;
+        for(auto _ : state){
+            ITUR_P452::BasicProp(profile.d_tot_km, profile.height_tx_asl_m, profile.height_rx_asl_m, FREQ_GHZ, TEMP_K,
+                    DRY_PRESSURE_HPA, profile.fracOverSea, P_PERCENT, profile.b0_percent, profile.horizonVals.second)
+                    .calcTransmissionlosses_dB(freeSpaceWithGasLoss_dB, basicTransmissionLoss_p_percent_dB,
+                    basicTransmissionLoss_b0_percent_dB);
+            benchmark::DoNotOptimize(basicTransmissionLoss_p_percent_dB);
+        }
+    }
+
+    void runDiffractionLoss(benchmark::State& state, const PreparedProfile& profile){
+        double diffLoss_median_dB, diffLoss_p_percent_dB;
+        for(auto _ : state){
+            ITUR_P452::DiffractionLoss(profile.clutter.modifiedPath, profile.height_tx_asl_m, profile.height_rx_asl_m, FREQ_GHZ,
+                    DELTA_N, POL, P_PERCENT, profile.b0_percent, profile.fracOverSea)
+                    .calcDiffractionLoss_dB(diffLoss_median_dB, diffLoss_p_percent_dB);
+            benchmark::DoNotOptimize(diffLoss_p_percent_dB);
+        }
+    }
+
+    void runAnomalousProp(benchmark::State& state, const PreparedProfile& profile){
+        for(auto _ : state){
+            benchmark::DoNotOptimize(ITUR_P452::AnomalousProp(profile.clutter.modifiedPath, FREQ_GHZ, profile.height_tx_asl_m,
+                    profile.height_rx_asl_m, TEMP_K, DRY_PRESSURE_HPA, DIST_COAST_TX_KM, DIST_COAST_RX_KM, P_PERCENT,
+                    profile.b0_percent, profile.effRadius_km, profile.horizonVals, profile.fracOverSea).calcAnomalousPropLoss_dB());
+        }
+    }
+
+    void runTroposcatter(benchmark::State& state, const PreparedProfile& profile){
+        for(auto _ : state){
+            benchmark::DoNotOptimize(ITUR_P452::TropoScatter::calcTroposcatterLoss_dB(profile.d_tot_km, FREQ_GHZ,
+                    profile.height_tx_asl_m, profile.height_rx_asl_m, profile.horizonVals.first, profile.effRadius_km, N0,
+                    TX_GAIN_DBI, RX_GAIN_DBI, TEMP_K, DRY_PRESSURE_HPA, P_PERCENT));
+        }
+    }
+
+    void runClutterModel(benchmark::State& state, const PreparedProfile& profile){
+        for(auto _ : state){
+            benchmark::DoNotOptimize(ClutterModel::calculateClutterModel(FREQ_GHZ, profile.path, HTG_M, HRG_M, BENCHMARK_CLUTTER,
+                    BENCHMARK_CLUTTER));
+        }
+    }
+
+    void runHorizonAnglesAndDistances(benchmark::State& state, const PreparedProfile& profile){
+        for(auto _ : state){
+            benchmark::DoNotOptimize(ITUR_P452::Helpers::calcHorizonAnglesAndDistances(profile.clutter.modifiedPath,
+                    profile.height_tx_asl_m, profile.height_rx_asl_m, profile.effRadius_km, FREQ_GHZ));
+        }
+    }
+
+    void runSmoothEarthHeights(benchmark::State& state, const PreparedProfile& profile){
+        for(auto _ : state){
+            benchmark::DoNotOptimize(ITUR_P452::Helpers::calcLeastSquaresSmoothEarthTxRxHeights_helper_amsl_m(
+                    profile.clutter.modifiedPath));
+        }
+    }
+
+    void runTotalClearAirAttenuation(benchmark::State& state, const PreparedProfile& profile){
+        for(auto _ : state){
+            benchmark::DoNotOptimize(ITUR_P452::TotalClearAirAttenuation(FREQ_GHZ, P_PERCENT, profile.path, HTG_M, HRG_M,
+                    CENTER_LATITUDE_DEG, TX_GAIN_DBI, RX_GAIN_DBI, POL, DIST_COAST_TX_KM, DIST_COAST_RX_KM, DELTA_N, N0, TEMP_K,
+                    DRY_PRESSURE_HPA, TX_CLUTTER, RX_CLUTTER).calcTotalClearAirAttenuation());
+        }
+    }
+
+    //hardware counters of the benchmark thread, opened once
+    const PerfCounters::PerfCounterGroup& perfCounters(){
+        static const PerfCounters::PerfCounterGroup counters;
+        return counters;
+    }
+
+    //heap allocations and bytes per iteration of the timed loop and hardware counts per profile point,
+    //the profile is prepared before counting
+    template<void (*run)(benchmark::State&, const PreparedProfile&)>
+    void runMeasured(benchmark::State& state, const PreparedProfile& profile){
+        const TestSupport::AllocationCounter counter;
+        const PerfCounters::PerfCounts perfStart = perfCounters().read();
+        run(state, profile);
+        const PerfCounters::PerfCounts perfCounts = perfCounters().read()-perfStart;
+        const TestSupport::AllocationStats stats = counter.stats();
+        state.counters["allocs"] = benchmark::Counter(static_cast<double>(stats.numAllocations), benchmark::Counter::kAvgIterations);
+        state.counters["allocBytes"] = benchmark::Counter(static_cast<double>(stats.numBytes), benchmark::Counter::kAvgIterations);
+
+        if(perfCounters().isAvailable() && perfCounts[PerfCounters::PerfEvent::Cycles]>0){
+            const double numPoints = static_cast<double>(profile.path.size());
+            const auto perPoint = [&](const PerfCounters::PerfEvent& event){
+                return benchmark::Counter(perfCounts[event]/numPoints, benchmark::Counter::kAvgIterations);
+            };
+            state.counters["IPC"] = perfCounts[PerfCounters::PerfEvent::Instructions]/perfCounts[PerfCounters::PerfEvent::Cycles];
+            state.counters["cycles/pt"] = perPoint(PerfCounters::PerfEvent::Cycles);
+            state.counters["instr/pt"] = perPoint(PerfCounters::PerfEvent::Instructions);
+            state.counters["cacheMiss/pt"] = perPoint(PerfCounters::PerfEvent::CacheMisses);
+            state.counters["branchMiss/pt"] = perPoint(PerfCounters::PerfEvent::BranchMisses);
+        }
+    }
+
+    template<void (*run)(benchmark::State&, const PreparedProfile&)>
+    void runOnTestPath(benchmark::State& state){
+        const PreparedProfile& profile = testPathProfile(state.range(0));
+        state.SetLabel(profile.name);
+        runMeasured<run>(state, profile);
+        state.counters["points"] = static_cast<double>(profile.path.size());
+    }
+
+    template<void (*run)(benchmark::State&, const PreparedProfile&)>
+    void runOnSyntheticPath(benchmark::State& state){
+        const PreparedProfile& profile = syntheticProfile(state.range(0));
+        runMeasured<run>(state, profile);
+        state.SetComplexityN(state.range(0));
+    }
+}
+
+//registers BM_<model>/TestPath over every validation profile and BM_<model>/Synthetic over 10^2..10^5 points
+#define P452_SUBMODEL_BENCHMARK(model) \
+    BENCHMARK(runOnTestPath<run##model>)->Name("BM_" #model "/TestPath")->DenseRange(0, TEST_PATH_FILES.size()-1); \
+    BENCHMARK(runOnSyntheticPath<run##model>)->Name("BM_" #model "/Synthetic") \
+            ->RangeMultiplier(10)->Range(100, 100000)->Complexity()
+
+P452_SUBMODEL_BENCHMARK(BasicProp);
+P452_SUBMODEL_BENCHMARK(DiffractionLoss);
+P452_SUBMODEL_BENCHMARK(AnomalousProp);
+P452_SUBMODEL_BENCHMARK(Troposcatter);
+P452_SUBMODEL_BENCHMARK(ClutterModel);
+P452_SUBMODEL_BENCHMARK(HorizonAnglesAndDistances);
+P452_SUBMODEL_BENCHMARK(SmoothEarthHeights);
+P452_SUBMODEL_BENCHMARK(TotalClearAirAttenuation);
+
+//Besides the Google Benchmark flags:
+//  --baseline_out=<file>           store the results as a throughput baseline (e.g. build/benchmark_baseline.json)
+//  --baseline_compare=<file>       compare the results with a stored baseline, exit with 1 if any benchmark regressed.
+//                                  A baseline recorded on another host is refused
+//  --baseline_tolerance=<fraction> throughput loss tolerated as noise before a benchmark regresses (default 0.2)
+//  --baseline_force                compare with a baseline recorded on another host anyway
+int main(int argc, char** argv){
+    std::string baselineOutPath, baselineComparePath;
+    double tolerance = 0.2;
+    bool forceCompare = false;
+    std::vector<char*> benchmarkArgs;
+    for(int argInd = 0; argInd<argc; argInd++){
+        const std::string arg = argv[argInd];
+        if(arg.starts_with("--baseline_out=")){
+            baselineOutPath = arg.substr(std::strlen("--baseline_out="));
+        }
+        else if(arg.starts_with("--baseline_compare=")){
+            baselineComparePath = arg.substr(std::strlen("--baseline_compare="));
+        }
+        else if(arg.starts_with("--baseline_tolerance=")){
+            tolerance = std::stod(arg.substr(std::strlen("--baseline_tolerance=")));
+        }
+        else if(arg=="--baseline_force"){
+            forceCompare = true;
+        }
+        else{
+            benchmarkArgs.push_back(argv[argInd]);
+        }
+    }
+    int benchmarkArgc = static_cast<int>(benchmarkArgs.size());
+    benchmark::Initialize(&benchmarkArgc, benchmarkArgs.data());
+    if(benchmark::ReportUnrecognizedArguments(benchmarkArgc, benchmarkArgs.data())){
+        return 1;
+    }
+
+    if(!perfCounters().isAvailable()){
+        std::cerr << "Hardware counters disabled (" << perfCounters().unavailableReason() << ")" << std::endl;
+    }
+
+    try{
+        //read before running, a missing baseline fails without waiting for the benchmarks
+        const BenchmarkBaseline::Baseline baseline = baselineComparePath.empty() ? BenchmarkBaseline::Baseline{}
+                : BenchmarkBaseline::readBaseline(baselineComparePath);
+        const std::string host = BenchmarkBaseline::hostDescription(benchmark::CPUInfo::Get());
+        if(!baselineComparePath.empty() && baseline.host!=host){
+            std::cerr << "ERROR: " << baselineComparePath << " was recorded on \"" << baseline.host << "\", this is \""
+                    << host << "\".\nThroughput of different machines does not compare, record a baseline on this machine "
+                    << "with --baseline_out (make benchmark_baseline) or pass --baseline_force" << std::endl;
+            if(!forceCompare){
+                return 1;
+            }
+            std::cerr << "WARNING: --baseline_force given, comparing anyway" << std::endl;
+        }
+        BenchmarkBaseline::RecordingReporter reporter;
+        benchmark::RunSpecifiedBenchmarks(&reporter);
+        benchmark::Shutdown();
+
+        if(!baselineOutPath.empty()){
+            BenchmarkBaseline::writeBaseline(baselineOutPath, reporter.baseline());
+            std::cout << "Baseline written to " << baselineOutPath << std::endl;
+        }
+        if(!baselineComparePath.empty()){
+            std::cout << std::endl;
+            return BenchmarkBaseline::compareWithBaseline(baseline, reporter.baseline(), tolerance, std::cout)==0 ? 0 : 1;
+        }
+    }
+    catch(const std::exception& error){
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}